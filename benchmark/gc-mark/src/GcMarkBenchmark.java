@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class GcMarkBenchmark {
+    static class Node {
+        Node left;
+        Node right;
+        Object payload;
+    }
+
+    // A wide, balanced object graph gives the parallel marker plenty of independent work.
+    private static final int TREE_DEPTH = 20;  // ~1M nodes.
+    // A long linked list is the worst case: it can only be marked one object at a time.
+    private static final int LIST_LENGTH = 1 << 20;
+    private static final int ARRAY_COUNT = 4096;
+    private static final int ARRAY_LENGTH = 256;
+
+    private Node tree;
+    private Node list;
+    private Object[][] arrays;
+
+    public GcMarkBenchmark() {
+        tree = makeTree(TREE_DEPTH);
+        list = makeList(LIST_LENGTH);
+        arrays = makeArrays(ARRAY_COUNT, ARRAY_LENGTH);
+    }
+
+    private static Node makeTree(int depth) {
+        Node node = new Node();
+        if (depth > 0) {
+            node.left = makeTree(depth - 1);
+            node.right = makeTree(depth - 1);
+        } else {
+            node.payload = new int[4];
+        }
+        return node;
+    }
+
+    private static Node makeList(int length) {
+        Node head = null;
+        for (int i = 0; i < length; ++i) {
+            Node node = new Node();
+            node.right = head;
+            head = node;
+        }
+        return head;
+    }
+
+    private static Object[][] makeArrays(int count, int length) {
+        Object[][] result = new Object[count][];
+        for (int i = 0; i < count; ++i) {
+            Object[] array = new Object[length];
+            for (int j = 0; j < length; ++j) {
+                array[j] = new Object();
+            }
+            result[i] = array;
+        }
+        return result;
+    }
+
+    // Every explicit GC marks the whole live graph, so its time tracks the mark phase.
+    public void timeMarkBalancedTree(int count) {
+        Node saved_list = list;
+        Object[][] saved_arrays = arrays;
+        list = null;
+        arrays = null;
+        for (int i = 0; i < count; ++i) {
+            Runtime.getRuntime().gc();
+        }
+        list = saved_list;
+        arrays = saved_arrays;
+    }
+
+    public void timeMarkLinkedList(int count) {
+        Node saved_tree = tree;
+        Object[][] saved_arrays = arrays;
+        tree = null;
+        arrays = null;
+        for (int i = 0; i < count; ++i) {
+            Runtime.getRuntime().gc();
+        }
+        tree = saved_tree;
+        arrays = saved_arrays;
+    }
+
+    public void timeMarkObjectArrays(int count) {
+        Node saved_tree = tree;
+        Node saved_list = list;
+        tree = null;
+        list = null;
+        for (int i = 0; i < count; ++i) {
+            Runtime.getRuntime().gc();
+        }
+        tree = saved_tree;
+        list = saved_list;
+    }
+
+    public void timeMarkAll(int count) {
+        for (int i = 0; i < count; ++i) {
+            Runtime.getRuntime().gc();
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The loops below avoid invokes, so that the time is spent dispatching and
+ * executing simple instructions rather than in method entry and exit.
+ */
+public class InterpreterDispatchBenchmark {
+    private static final int ITERATIONS = 1000;
+
+    private int field;
+    private final int[] array = new int[64];
+
+    public void timeArithmetic(int count) {
+        int result = 0;
+        for (int i = 0; i < count; ++i) {
+            int a = i;
+            for (int j = 0; j < ITERATIONS; ++j) {
+                a = a * 31 + j;
+                a ^= a >>> 7;
+                a += j << 2;
+                a -= j & 0xff;
+                a |= j % 3;
+            }
+            result += a;
+        }
+        field = result;
+    }
+
+    public void timeLongArithmetic(int count) {
+        long result = 0;
+        for (int i = 0; i < count; ++i) {
+            long a = i;
+            for (int j = 0; j < ITERATIONS; ++j) {
+                a = a * 31L + j;
+                a ^= a >>> 17;
+                a += (long) j << 33;
+            }
+            result += a;
+        }
+        field = (int) result;
+    }
+
+    public void timeArrayAccess(int count) {
+        int[] local = array;
+        int result = 0;
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < ITERATIONS; ++j) {
+                int index = j & 63;
+                local[index] = local[index] + j;
+                result += local[(index + 1) & 63];
+            }
+        }
+        field = result;
+    }
+
+    public void timeFieldAccess(int count) {
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < ITERATIONS; ++j) {
+                field = field + j;
+                field = field ^ (field >>> 3);
+            }
+        }
+    }
+
+    public void timeBranches(int count) {
+        int result = 0;
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < ITERATIONS; ++j) {
+                if ((j & 1) == 0) {
+                    result += 3;
+                } else if ((j & 2) == 0) {
+                    result -= 1;
+                } else {
+                    result ^= j;
+                }
+                switch (j & 3) {
+                    case 0: result += 1; break;
+                    case 1: result += 2; break;
+                    case 2: result -= 3; break;
+                    default: result ^= 4; break;
+                }
+            }
+        }
+        field = result;
+    }
+}
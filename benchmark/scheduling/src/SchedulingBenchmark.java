@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class SchedulingBenchmark {
+    private static final int ARRAY_SIZE = 1024;
+
+    private final int[] intArray = new int[ARRAY_SIZE];
+    private final long[] longArray = new long[ARRAY_SIZE];
+    private final float[] floatArray = new float[ARRAY_SIZE];
+    private final double[] doubleArray = new double[ARRAY_SIZE];
+
+    public static int intResult;
+    public static long longResult;
+    public static float floatResult;
+    public static double doubleResult;
+
+    public SchedulingBenchmark() {
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            intArray[i] = i * 31 + 7;
+            longArray[i] = i * 131L + 17L;
+            floatArray[i] = i * 0.5f + 1.0f;
+            doubleArray[i] = i * 0.25 + 1.0;
+        }
+    }
+
+    // Two independent multiply chains, each also depending on a load.
+    public void timeIntMulChains(int count) {
+        int[] array = intArray;
+        for (int iter = 0; iter < count; ++iter) {
+            int a = 1;
+            int b = 3;
+            for (int i = 0; i < ARRAY_SIZE; ++i) {
+                int x = array[i];
+                a = a * x + i;
+                b = b * (x ^ i) - a;
+            }
+            intResult += a + b;
+        }
+    }
+
+    public void timeLongMulChains(int count) {
+        long[] array = longArray;
+        for (int iter = 0; iter < count; ++iter) {
+            long a = 1;
+            long b = 3;
+            for (int i = 0; i < ARRAY_SIZE; ++i) {
+                long x = array[i];
+                a = a * x + i;
+                b = b * (x ^ i) - a;
+            }
+            longResult += a + b;
+        }
+    }
+
+    // A division whose latency can be overlapped with independent work.
+    public void timeIntDivWithIndependentWork(int count) {
+        int[] array = intArray;
+        for (int iter = 0; iter < count; ++iter) {
+            int quotients = 0;
+            int sum = 0;
+            for (int i = 0; i < ARRAY_SIZE; ++i) {
+                int x = array[i];
+                quotients += x / (i + 1);
+                sum += (x << 3) - (x >> 1) + i;
+            }
+            intResult += quotients + sum;
+        }
+    }
+
+    public void timeFloatMulAddChains(int count) {
+        float[] array = floatArray;
+        for (int iter = 0; iter < count; ++iter) {
+            float a = 0.0f;
+            float b = 1.0f;
+            for (int i = 0; i < ARRAY_SIZE; ++i) {
+                float x = array[i];
+                a = a * 0.5f + x;
+                b = b * 0.25f + x * x;
+            }
+            floatResult += a + b;
+        }
+    }
+
+    public void timeDoubleDivWithIndependentWork(int count) {
+        double[] array = doubleArray;
+        for (int iter = 0; iter < count; ++iter) {
+            double quotients = 0.0;
+            double sum = 0.0;
+            for (int i = 0; i < ARRAY_SIZE; ++i) {
+                double x = array[i];
+                quotients += 1.0 / x;
+                sum += x * 3.0 + i;
+            }
+            doubleResult += quotients + sum;
+        }
+    }
+
+    // Loads and stores of independent array elements.
+    public void timeIntArrayUpdate(int count) {
+        int[] array = intArray;
+        for (int iter = 0; iter < count; ++iter) {
+            for (int i = 0; i + 1 < ARRAY_SIZE; i += 2) {
+                int x = array[i];
+                int y = array[i + 1];
+                array[i] = x * 3 + y;
+                array[i + 1] = y * 5 - x;
+            }
+        }
+        intResult += array[0];
+    }
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Every stack walk looks up the stack map of each compiled frame by native pc.
+ * The frames here belong to a method with many calls, and thus many stack maps,
+ * and with a catch block, whose stack map comes after the others.
+ */
+public class StackWalkBenchmark {
+    private static final int DEPTH = 64;
+
+    private static int sink;
+
+    public void timeGetStackTrace(int count) {
+        for (int i = 0; i < count; ++i) {
+            recurse(DEPTH, Action.GET_STACK_TRACE);
+        }
+    }
+
+    public void timeThrowThroughFrames(int count) {
+        for (int i = 0; i < count; ++i) {
+            try {
+                recurse(DEPTH, Action.THROW);
+            } catch (IllegalStateException expected) {
+                sink++;
+            }
+        }
+    }
+
+    public void timeCatchInFrame(int count) {
+        for (int i = 0; i < count; ++i) {
+            recurse(DEPTH, Action.THROW_AND_CATCH);
+        }
+    }
+
+    public void timeGcWithDeepStack(int count) {
+        for (int i = 0; i < count; ++i) {
+            recurse(DEPTH, Action.GC);
+        }
+    }
+
+    private enum Action {
+        GET_STACK_TRACE,
+        THROW,
+        THROW_AND_CATCH,
+        GC,
+    }
+
+    // A method with a large number of safepoints before and after the recursive call.
+    private static int recurse(int depth, Action action) {
+        int sum = 0;
+        sum += $noinline$value(depth, 0);
+        sum += $noinline$value(depth, 1);
+        sum += $noinline$value(depth, 2);
+        sum += $noinline$value(depth, 3);
+        sum += $noinline$value(depth, 4);
+        sum += $noinline$value(depth, 5);
+        sum += $noinline$value(depth, 6);
+        sum += $noinline$value(depth, 7);
+        sum += $noinline$value(depth, 8);
+        sum += $noinline$value(depth, 9);
+        sum += $noinline$value(depth, 10);
+        sum += $noinline$value(depth, 11);
+        sum += $noinline$value(depth, 12);
+        sum += $noinline$value(depth, 13);
+        sum += $noinline$value(depth, 14);
+        sum += $noinline$value(depth, 15);
+        sum += $noinline$value(depth, 16);
+        sum += $noinline$value(depth, 17);
+        sum += $noinline$value(depth, 18);
+        sum += $noinline$value(depth, 19);
+        sum += $noinline$value(depth, 20);
+        sum += $noinline$value(depth, 21);
+        sum += $noinline$value(depth, 22);
+        sum += $noinline$value(depth, 23);
+        sum += $noinline$value(depth, 24);
+        sum += $noinline$value(depth, 25);
+        sum += $noinline$value(depth, 26);
+        sum += $noinline$value(depth, 27);
+        sum += $noinline$value(depth, 28);
+        sum += $noinline$value(depth, 29);
+        sum += $noinline$value(depth, 30);
+        sum += $noinline$value(depth, 31);
+        sum += $noinline$value(depth, 32);
+        sum += $noinline$value(depth, 33);
+        sum += $noinline$value(depth, 34);
+        sum += $noinline$value(depth, 35);
+        sum += $noinline$value(depth, 36);
+        sum += $noinline$value(depth, 37);
+        sum += $noinline$value(depth, 38);
+        sum += $noinline$value(depth, 39);
+        sum += $noinline$value(depth, 40);
+        sum += $noinline$value(depth, 41);
+        sum += $noinline$value(depth, 42);
+        sum += $noinline$value(depth, 43);
+        sum += $noinline$value(depth, 44);
+        sum += $noinline$value(depth, 45);
+        sum += $noinline$value(depth, 46);
+        sum += $noinline$value(depth, 47);
+        sum += $noinline$value(depth, 48);
+        sum += $noinline$value(depth, 49);
+        sum += $noinline$value(depth, 50);
+        sum += $noinline$value(depth, 51);
+        sum += $noinline$value(depth, 52);
+        sum += $noinline$value(depth, 53);
+        sum += $noinline$value(depth, 54);
+        sum += $noinline$value(depth, 55);
+        sum += $noinline$value(depth, 56);
+        sum += $noinline$value(depth, 57);
+        sum += $noinline$value(depth, 58);
+        sum += $noinline$value(depth, 59);
+        sum += $noinline$value(depth, 60);
+        sum += $noinline$value(depth, 61);
+        sum += $noinline$value(depth, 62);
+        sum += $noinline$value(depth, 63);
+        if (depth == 0) {
+            return sum + act(action);
+        }
+        if (action == Action.THROW_AND_CATCH && depth == 1) {
+            try {
+                sum += recurse(depth - 1, Action.THROW);
+            } catch (IllegalStateException expected) {
+                sum++;
+            }
+        } else {
+            sum += recurse(depth - 1, action);
+        }
+        sum += $noinline$value(depth, 0);
+        sum += $noinline$value(depth, 1);
+        sum += $noinline$value(depth, 2);
+        sum += $noinline$value(depth, 3);
+        sum += $noinline$value(depth, 4);
+        sum += $noinline$value(depth, 5);
+        sum += $noinline$value(depth, 6);
+        sum += $noinline$value(depth, 7);
+        sum += $noinline$value(depth, 8);
+        sum += $noinline$value(depth, 9);
+        sum += $noinline$value(depth, 10);
+        sum += $noinline$value(depth, 11);
+        sum += $noinline$value(depth, 12);
+        sum += $noinline$value(depth, 13);
+        sum += $noinline$value(depth, 14);
+        sum += $noinline$value(depth, 15);
+        sum += $noinline$value(depth, 16);
+        sum += $noinline$value(depth, 17);
+        sum += $noinline$value(depth, 18);
+        sum += $noinline$value(depth, 19);
+        sum += $noinline$value(depth, 20);
+        sum += $noinline$value(depth, 21);
+        sum += $noinline$value(depth, 22);
+        sum += $noinline$value(depth, 23);
+        sum += $noinline$value(depth, 24);
+        sum += $noinline$value(depth, 25);
+        sum += $noinline$value(depth, 26);
+        sum += $noinline$value(depth, 27);
+        sum += $noinline$value(depth, 28);
+        sum += $noinline$value(depth, 29);
+        sum += $noinline$value(depth, 30);
+        sum += $noinline$value(depth, 31);
+        sum += $noinline$value(depth, 32);
+        sum += $noinline$value(depth, 33);
+        sum += $noinline$value(depth, 34);
+        sum += $noinline$value(depth, 35);
+        sum += $noinline$value(depth, 36);
+        sum += $noinline$value(depth, 37);
+        sum += $noinline$value(depth, 38);
+        sum += $noinline$value(depth, 39);
+        sum += $noinline$value(depth, 40);
+        sum += $noinline$value(depth, 41);
+        sum += $noinline$value(depth, 42);
+        sum += $noinline$value(depth, 43);
+        sum += $noinline$value(depth, 44);
+        sum += $noinline$value(depth, 45);
+        sum += $noinline$value(depth, 46);
+        sum += $noinline$value(depth, 47);
+        sum += $noinline$value(depth, 48);
+        sum += $noinline$value(depth, 49);
+        sum += $noinline$value(depth, 50);
+        sum += $noinline$value(depth, 51);
+        sum += $noinline$value(depth, 52);
+        sum += $noinline$value(depth, 53);
+        sum += $noinline$value(depth, 54);
+        sum += $noinline$value(depth, 55);
+        sum += $noinline$value(depth, 56);
+        sum += $noinline$value(depth, 57);
+        sum += $noinline$value(depth, 58);
+        sum += $noinline$value(depth, 59);
+        sum += $noinline$value(depth, 60);
+        sum += $noinline$value(depth, 61);
+        sum += $noinline$value(depth, 62);
+        sum += $noinline$value(depth, 63);
+        return sum;
+    }
+
+    private static int act(Action action) {
+        switch (action) {
+            case GET_STACK_TRACE:
+                return Thread.currentThread().getStackTrace().length;
+            case GC:
+                Runtime.getRuntime().gc();
+                return 0;
+            default:
+                throw new IllegalStateException();
+        }
+    }
+
+    private static int $noinline$value(int depth, int index) {
+        if (sink < 0) {
+            throw new Error();
+        }
+        return depth ^ index;
+    }
+}
@@ -39,6 +39,8 @@ using android::base::StringPrintf;
 const bool kEnableQuickening = true;
 // Control check-cast elision.
 const bool kEnableCheckCastEllision = true;
+// Controls fusion of quickened instructions into superinstructions.
+const bool kEnableSuperinstructions = true;
 
 struct QuickenedInfo {
   QuickenedInfo(uint32_t pc, uint16_t index) : dex_pc(pc), dex_member_index(index) {}
@@ -96,6 +98,12 @@ class DexCompiler {
   void CompileInvokeVirtual(Instruction* inst, uint32_t dex_pc,
                             Instruction::Code new_opcode, bool is_range);
 
+  // Fuses a quickened instruction with the instruction following it into a superinstruction,
+  // which the interpreter executes with a single dispatch. Only the opcode of the quickened
+  // instruction is changed: the following instruction stays in place, so that branches to it
+  // remain valid and the quickening info does not need an entry for it.
+  void CompileSuperinstruction(Instruction* inst, uint32_t dex_pc);
+
   CompilerDriver& driver_;
   const DexCompilationUnit& unit_;
   const DexToDexCompilationLevel dex_to_dex_compilation_level_;
@@ -128,6 +136,7 @@ void DexCompiler::Compile() {
 
       case Instruction::IGET:
         CompileInstanceFieldAccess(inst, dex_pc, Instruction::IGET_QUICK, false);
+        CompileSuperinstruction(inst, dex_pc);
         break;
 
       case Instruction::IGET_WIDE:
@@ -140,6 +149,7 @@ void DexCompiler::Compile() {
 
       case Instruction::IGET_BOOLEAN:
         CompileInstanceFieldAccess(inst, dex_pc, Instruction::IGET_BOOLEAN_QUICK, false);
+        CompileSuperinstruction(inst, dex_pc);
         break;
 
       case Instruction::IGET_BYTE:
@@ -184,6 +194,7 @@ void DexCompiler::Compile() {
 
       case Instruction::INVOKE_VIRTUAL:
         CompileInvokeVirtual(inst, dex_pc, Instruction::INVOKE_VIRTUAL_QUICK, false);
+        CompileSuperinstruction(inst, dex_pc);
         break;
 
       case Instruction::INVOKE_VIRTUAL_RANGE:
@@ -315,6 +326,60 @@ void DexCompiler::CompileInvokeVirtual(Instruction* inst, uint32_t dex_pc,
   quickened_info_.push_back(QuickenedInfo(dex_pc, method_idx));
 }
 
+// Returns the superinstruction executing `first` and then `second`, or `first` if the
+// interpreter has no fused handler for this pair.
+static Instruction::Code GetSuperinstruction(Instruction::Code first, Instruction::Code second) {
+  switch (first) {
+    case Instruction::IGET_QUICK:
+      if (second == Instruction::IF_EQZ) {
+        return Instruction::IGET_QUICK_IF_EQZ;
+      } else if (second == Instruction::IF_NEZ) {
+        return Instruction::IGET_QUICK_IF_NEZ;
+      }
+      break;
+    case Instruction::IGET_BOOLEAN_QUICK:
+      if (second == Instruction::IF_EQZ) {
+        return Instruction::IGET_BOOLEAN_QUICK_IF_EQZ;
+      } else if (second == Instruction::IF_NEZ) {
+        return Instruction::IGET_BOOLEAN_QUICK_IF_NEZ;
+      }
+      break;
+    case Instruction::INVOKE_VIRTUAL_QUICK:
+      if (second == Instruction::MOVE_RESULT) {
+        return Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT;
+      } else if (second == Instruction::MOVE_RESULT_OBJECT) {
+        return Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT;
+      }
+      break;
+    default:
+      break;
+  }
+  return first;
+}
+
+void DexCompiler::CompileSuperinstruction(Instruction* inst, uint32_t dex_pc) {
+  if (!kEnableSuperinstructions || !inst->IsQuickened()) {
+    return;
+  }
+  const DexFile::CodeItem* code_item = unit_.GetCodeItem();
+  uint32_t next_dex_pc = dex_pc + inst->SizeInCodeUnits();
+  Instruction::Code fused_opcode = inst->Opcode();
+  if (next_dex_pc < code_item->insns_size_in_code_units_) {
+    const Instruction* next = Instruction::At(code_item->insns_ + next_dex_pc);
+    fused_opcode = GetSuperinstruction(inst->Opcode(), next->Opcode());
+  }
+  if (fused_opcode == inst->Opcode()) {
+    driver_.RecordSuperinstruction(false);
+    return;
+  }
+  VLOG(compiler) << "Fusing " << Instruction::Name(inst->Opcode())
+                 << " into " << Instruction::Name(fused_opcode)
+                 << " at dex pc " << StringPrintf("0x%x", dex_pc) << " in method "
+                 << GetDexFile().PrettyMethod(unit_.GetDexMethodIndex(), true);
+  inst->SetOpcode(fused_opcode);
+  driver_.RecordSuperinstruction(true);
+}
+
 CompiledMethod* ArtCompileDEX(
     CompilerDriver* driver,
     const DexFile::CodeItem* code_item,
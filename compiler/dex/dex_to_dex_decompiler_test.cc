@@ -23,6 +23,7 @@
 #include "compiler/driver/compiler_driver.h"
 #include "compiler_callbacks.h"
 #include "dex_file.h"
+#include "dex_instruction-inl.h"
 #include "handle_scope-inl.h"
 #include "verifier/method_verifier-inl.h"
 #include "mirror/class_loader.h"
@@ -45,7 +46,36 @@ class DexToDexDecompilerTest : public CommonCompilerTest {
                                  &timings);
   }
 
-  void RunTest(const char* dex_name) {
+  // Returns whether `dex_file` contains the superinstruction `opcode` in any of its methods.
+  static bool ContainsOpcode(const DexFile& dex_file, Instruction::Code opcode) {
+    for (uint32_t i = 0; i < dex_file.NumClassDefs(); ++i) {
+      const uint8_t* class_data = dex_file.GetClassData(dex_file.GetClassDef(i));
+      if (class_data == nullptr) {
+        continue;
+      }
+      ClassDataItemIterator it(dex_file, class_data);
+      while (it.HasNextStaticField() || it.HasNextInstanceField()) {
+        it.Next();
+      }
+      for (; it.HasNextDirectMethod() || it.HasNextVirtualMethod(); it.Next()) {
+        const DexFile::CodeItem* code_item = it.GetMethodCodeItem();
+        if (code_item == nullptr) {
+          continue;
+        }
+        const uint16_t* insns_end = code_item->insns_ + code_item->insns_size_in_code_units_;
+        for (const Instruction* inst = Instruction::At(code_item->insns_);
+             reinterpret_cast<const uint16_t*>(inst) < insns_end;
+             inst = inst->Next()) {
+          if (inst->Opcode() == opcode) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  void RunTest(const char* dex_name, bool expect_superinstructions = false) {
     Thread* self = Thread::Current();
     // First load the original dex file.
     jobject original_class_loader;
@@ -77,6 +107,17 @@ class DexToDexDecompilerTest : public CommonCompilerTest {
     cmp = memcmp(original_dex_file->Begin(), updated_dex_file->Begin(), updated_dex_file->Size());
     ASSERT_NE(0, cmp);
 
+    if (expect_superinstructions) {
+      // Every kind of fused pair must have been formed, so that unquickening covers all of them.
+      ASSERT_TRUE(ContainsOpcode(*updated_dex_file, Instruction::IGET_QUICK_IF_EQZ));
+      ASSERT_TRUE(ContainsOpcode(*updated_dex_file, Instruction::IGET_QUICK_IF_NEZ));
+      ASSERT_TRUE(ContainsOpcode(*updated_dex_file, Instruction::IGET_BOOLEAN_QUICK_IF_EQZ));
+      ASSERT_TRUE(ContainsOpcode(*updated_dex_file, Instruction::IGET_BOOLEAN_QUICK_IF_NEZ));
+      ASSERT_TRUE(ContainsOpcode(*updated_dex_file, Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT));
+      ASSERT_TRUE(
+          ContainsOpcode(*updated_dex_file, Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT));
+    }
+
     // Unquicken the dex file.
     for (uint32_t i = 0; i < updated_dex_file->NumClassDefs(); ++i) {
       const DexFile::ClassDef& class_def = updated_dex_file->GetClassDef(i);
@@ -132,7 +173,7 @@ TEST_F(DexToDexDecompilerTest, VerifierDeps) {
 }
 
 TEST_F(DexToDexDecompilerTest, DexToDexDecompiler) {
-  RunTest("DexToDexDecompiler");
+  RunTest("DexToDexDecompiler", /* expect_superinstructions */ true);
 }
 
 }  // namespace art
@@ -49,6 +49,8 @@
 #include "dex/verified_method.h"
 #include "driver/compiler_options.h"
 #include "intrinsics_enum.h"
+#include "jit/jit.h"
+#include "jit/jit_code_cache.h"
 #include "jni_internal.h"
 #include "object_lock.h"
 #include "runtime.h"
@@ -106,7 +108,8 @@ class CompilerDriver::AOTCompilationStats {
         resolved_instance_fields_(0), unresolved_instance_fields_(0),
         resolved_local_static_fields_(0), resolved_static_fields_(0), unresolved_static_fields_(0),
         type_based_devirtualization_(0),
-        safe_casts_(0), not_safe_casts_(0) {
+        safe_casts_(0), not_safe_casts_(0),
+        fused_instructions_(0), not_fused_instructions_(0) {
     for (size_t i = 0; i <= kMaxInvokeType; i++) {
       resolved_methods_[i] = 0;
       unresolved_methods_[i] = 0;
@@ -124,6 +127,8 @@ class CompilerDriver::AOTCompilationStats {
     DumpStat(resolved_local_static_fields_, resolved_static_fields_ + unresolved_static_fields_,
              "static fields local to a class");
     DumpStat(safe_casts_, not_safe_casts_, "check-casts removed based on type information");
+    DumpStat(fused_instructions_, not_fused_instructions_,
+             "quickened instructions fused with the next instruction");
     // Note, the code below subtracts the stat value so that when added to the stat value we have
     // 100% of samples. TODO: clean this up.
     DumpStat(type_based_devirtualization_,
@@ -220,6 +225,18 @@ class CompilerDriver::AOTCompilationStats {
     not_safe_casts_++;
   }
 
+  // A quickened instruction was fused with the next instruction into a superinstruction.
+  void FusedInstruction() REQUIRES(!stats_lock_) {
+    STATS_LOCK();
+    fused_instructions_++;
+  }
+
+  // A quickened instruction with superinstruction forms was not followed by a fusable one.
+  void NotFusedInstruction() REQUIRES(!stats_lock_) {
+    STATS_LOCK();
+    not_fused_instructions_++;
+  }
+
  private:
   Mutex stats_lock_;
 
@@ -244,6 +261,9 @@ class CompilerDriver::AOTCompilationStats {
   size_t safe_casts_;
   size_t not_safe_casts_;
 
+  size_t fused_instructions_;
+  size_t not_fused_instructions_;
+
   DISALLOW_COPY_AND_ASSIGN(AOTCompilationStats);
 };
 
@@ -1361,6 +1381,11 @@ bool CompilerDriver::CanAssumeClassIsLoaded(mirror::Class* klass) {
   Runtime* runtime = Runtime::Current();
   if (!runtime->IsAotCompiler()) {
     DCHECK(runtime->UseJitCompilation());
+    if (runtime->GetJit() != nullptr && runtime->GetJit()->GetCodeCache()->IsPersistent()) {
+      // Persisted code gets installed in later runs, where only the boot image classes
+      // are known to be loaded, like for AOT compiled apps.
+      return runtime->GetHeap()->FindSpaceFromObject(klass, false)->IsImageSpace();
+    }
     // Having the klass reference here implies that the klass is already loaded.
     return true;
   }
@@ -1519,6 +1544,14 @@ bool CompilerDriver::IsSafeCast(const DexCompilationUnit* mUnit, uint32_t dex_pc
   return result;
 }
 
+void CompilerDriver::RecordSuperinstruction(bool fused) {
+  if (fused) {
+    stats_->FusedInstruction();
+  } else {
+    stats_->NotFusedInstruction();
+  }
+}
+
 class CompilationVisitor {
  public:
   virtual ~CompilationVisitor() {}
@@ -2538,6 +2571,8 @@ void CompilerDriver::Compile(jobject class_loader,
                    parallel_thread_pool_.get(),
                    parallel_thread_count_,
                    timings);
+    // Give back the memory of the arenas freed while compiling this dex file.
+    Runtime::Current()->GetArenaPool()->TrimMaps();
   }
   current_dex_to_dex_methods_ = nullptr;
 
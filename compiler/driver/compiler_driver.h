@@ -254,6 +254,9 @@ class CompilerDriver {
   const VerifiedMethod* GetVerifiedMethod(const DexFile* dex_file, uint32_t method_idx) const;
   bool IsSafeCast(const DexCompilationUnit* mUnit, uint32_t dex_pc);
 
+  // Record whether a quickened instruction was fused with the instruction following it.
+  void RecordSuperinstruction(bool fused);
+
   bool GetSupportBootImageFixup() const {
     return support_boot_image_fixup_;
   }
@@ -47,6 +47,7 @@ CompilerOptions::CompilerOptions()
       dump_cfg_append_(false),
       force_determinism_(false),
       register_allocation_strategy_(RegisterAllocator::kRegisterAllocatorDefault),
+      jit_fast_register_allocation_strategy_(RegisterAllocator::kRegisterAllocatorJitFast),
       passes_to_run_(nullptr) {
 }
 
@@ -104,6 +105,7 @@ CompilerOptions::CompilerOptions(CompilerFilter::Filter compiler_filter,
       dump_cfg_append_(dump_cfg_append),
       force_determinism_(force_determinism),
       register_allocation_strategy_(regalloc_strategy),
+      jit_fast_register_allocation_strategy_(RegisterAllocator::kRegisterAllocatorJitFast),
       passes_to_run_(passes_to_run) {
 }
 
@@ -146,15 +148,20 @@ void CompilerOptions::ParseDumpInitFailures(const StringPiece& option,
 }
 
 void CompilerOptions::ParseRegisterAllocationStrategy(const StringPiece& option,
+                                                      const char* option_name,
+                                                      RegisterAllocator::Strategy* strategy,
                                                       UsageFn Usage) {
-  DCHECK(option.starts_with("--register-allocation-strategy="));
-  StringPiece choice = option.substr(strlen("--register-allocation-strategy=")).data();
+  DCHECK(option.starts_with(option_name));
+  StringPiece choice = option.substr(strlen(option_name)).data();
   if (choice == "linear-scan") {
-    register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorLinearScan;
+    *strategy = RegisterAllocator::Strategy::kRegisterAllocatorLinearScan;
   } else if (choice == "graph-color") {
-    register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorGraphColor;
+    *strategy = RegisterAllocator::Strategy::kRegisterAllocatorGraphColor;
+  } else if (choice == "second-chance") {
+    *strategy = RegisterAllocator::Strategy::kRegisterAllocatorSecondChance;
   } else {
-    Usage("Unrecognized register allocation strategy. Try linear-scan, or graph-color.");
+    Usage("Unrecognized register allocation strategy. Try linear-scan, graph-color, "
+          "or second-chance.");
   }
 }
 
@@ -203,7 +210,15 @@ bool CompilerOptions::ParseCompilerOption(const StringPiece& option, UsageFn Usa
   } else if (option == "--dump-cfg-append") {
     dump_cfg_append_ = true;
   } else if (option.starts_with("--register-allocation-strategy=")) {
-    ParseRegisterAllocationStrategy(option, Usage);
+    ParseRegisterAllocationStrategy(option,
+                                    "--register-allocation-strategy=",
+                                    &register_allocation_strategy_,
+                                    Usage);
+  } else if (option.starts_with("--jit-fast-register-allocation-strategy=")) {
+    ParseRegisterAllocationStrategy(option,
+                                    "--jit-fast-register-allocation-strategy=",
+                                    &jit_fast_register_allocation_strategy_,
+                                    Usage);
   } else {
     // Option not recognized.
     return false;
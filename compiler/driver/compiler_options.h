@@ -253,6 +253,12 @@ class CompilerOptions FINAL {
     return register_allocation_strategy_;
   }
 
+  // Strategy used by the JIT for baseline compilation and for large methods,
+  // where compile time matters more than the quality of the allocation.
+  RegisterAllocator::Strategy GetJitFastRegisterAllocationStrategy() const {
+    return jit_fast_register_allocation_strategy_;
+  }
+
   const std::vector<std::string>* GetPassesToRun() const {
     return passes_to_run_;
   }
@@ -266,7 +272,10 @@ class CompilerOptions FINAL {
   void ParseSmallMethodMax(const StringPiece& option, UsageFn Usage);
   void ParseLargeMethodMax(const StringPiece& option, UsageFn Usage);
   void ParseHugeMethodMax(const StringPiece& option, UsageFn Usage);
-  void ParseRegisterAllocationStrategy(const StringPiece& option, UsageFn Usage);
+  void ParseRegisterAllocationStrategy(const StringPiece& option,
+                                       const char* option_name,
+                                       RegisterAllocator::Strategy* strategy,
+                                       UsageFn Usage);
 
   CompilerFilter::Filter compiler_filter_;
   size_t huge_method_threshold_;
@@ -312,6 +321,7 @@ class CompilerOptions FINAL {
   bool force_determinism_;
 
   RegisterAllocator::Strategy register_allocation_strategy_;
+  RegisterAllocator::Strategy jit_fast_register_allocation_strategy_;
 
   // If not null, specifies optimization passes which will be run instead of defaults.
   // Note that passes_to_run_ is not checked for correctness and providing an incorrect
@@ -575,6 +575,11 @@ void CodeGenerator::AllocateLocations(HInstruction* instruction) {
     if (instruction->NeedsCurrentMethod()) {
       SetRequiresCurrentMethod();
     }
+  } else if (GetGraph()->IsCompilingBaseline()) {
+    // Baseline code counts method entries in the entry suspend check, which needs
+    // the current method and may call the runtime.
+    MarkNotLeaf();
+    SetRequiresCurrentMethod();
   }
 }
 
@@ -894,6 +899,7 @@ void CodeGenerator::MaybeRecordNativeDebugInfo(HInstruction* instruction,
 
 void CodeGenerator::RecordCatchBlockInfo() {
   ArenaAllocator* arena = graph_->GetArena();
+  stack_map_stream_.BeginCatchStackMaps();
 
   for (HBasicBlock* block : *block_order_) {
     if (!block->IsCatchBlock()) {
@@ -1445,6 +1451,19 @@ void CodeGenerator::EmitJitRoots(uint8_t* code,
   EmitJitRootPatches(code, roots_data);
 }
 
+std::vector<jit::JitRootReference> CodeGenerator::GetJitRootReferences() const {
+  std::vector<jit::JitRootReference> references(GetNumberOfJitRoots());
+  for (const auto& entry : jit_string_roots_) {
+    references[entry.second] = jit::JitRootReference {
+        /* is_class */ false, entry.first.dex_file, entry.first.string_index.index_ };
+  }
+  for (const auto& entry : jit_class_roots_) {
+    references[entry.second] = jit::JitRootReference {
+        /* is_class */ true, entry.first.dex_file, entry.first.type_index.index_ };
+  }
+  return references;
+}
+
 QuickEntrypointEnum CodeGenerator::GetArrayAllocationEntrypoint(Handle<mirror::Class> array_klass) {
   ScopedObjectAccess soa(Thread::Current());
   if (array_klass == nullptr) {
@@ -23,9 +23,11 @@
 #include "base/arena_object.h"
 #include "base/bit_field.h"
 #include "base/bit_utils.h"
+#include "base/casts.h"
 #include "base/enums.h"
 #include "globals.h"
 #include "graph_visualizer.h"
+#include "jit/persistent_code_cache.h"
 #include "locations.h"
 #include "memory_region.h"
 #include "nodes.h"
@@ -356,6 +358,21 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
                     const uint8_t* roots_data)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Returns the strings and classes of the root table, in table order. Only valid
+  // after `EmitJitRoots`.
+  std::vector<jit::JitRootReference> GetJitRootReferences() const;
+
+  // Record that the code at `code_offset` holds the 32-bit address of the root table
+  // entry `index_in_table`, for relocating the code in a persistent JIT code cache.
+  void RecordJitRootPatch(uint32_t code_offset, uint64_t index_in_table) {
+    jit_root_patches_.push_back(
+        jit::JitRootPatch { code_offset, dchecked_integral_cast<uint32_t>(index_in_table) });
+  }
+
+  const ArenaVector<jit::JitRootPatch>& GetJitRootPatches() const {
+    return jit_root_patches_;
+  }
+
   bool IsLeafMethod() const {
     return is_leaf_;
   }
@@ -618,6 +635,7 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
                           graph->GetArena()->Adapter(kArenaAllocCodeGenerator)),
         jit_class_roots_(TypeReferenceValueComparator(),
                          graph->GetArena()->Adapter(kArenaAllocCodeGenerator)),
+        jit_root_patches_(graph->GetArena()->Adapter(kArenaAllocCodeGenerator)),
         disasm_info_(nullptr),
         stats_(stats),
         graph_(graph),
@@ -726,6 +744,9 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
   // will compute all the indices.
   ArenaSafeMap<TypeReference, uint64_t, TypeReferenceValueComparator> jit_class_roots_;
 
+  // Code locations patched by `EmitJitRootPatches` with the address of a root table entry.
+  ArenaVector<jit::JitRootPatch> jit_root_patches_;
+
   DisassemblyInformation* disasm_info_;
 
  private:
@@ -8687,7 +8687,8 @@ void InstructionCodeGeneratorARM::VisitClassTableGet(HClassTableGet* instruction
   }
 }
 
-static void PatchJitRootUse(uint8_t* code,
+static void PatchJitRootUse(CodeGenerator* codegen,
+                            uint8_t* code,
                             const uint8_t* roots_data,
                             Literal* literal,
                             uint64_t index_in_table) {
@@ -8697,18 +8698,19 @@ static void PatchJitRootUse(uint8_t* code,
       reinterpret_cast<uintptr_t>(roots_data) + index_in_table * sizeof(GcRoot<mirror::Object>);
   uint8_t* data = code + literal_offset;
   reinterpret_cast<uint32_t*>(data)[0] = dchecked_integral_cast<uint32_t>(address);
+  codegen->RecordJitRootPatch(literal_offset, index_in_table);
 }
 
 void CodeGeneratorARM::EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) {
   for (const auto& entry : jit_string_patches_) {
     const auto& it = jit_string_roots_.find(entry.first);
     DCHECK(it != jit_string_roots_.end());
-    PatchJitRootUse(code, roots_data, entry.second, it->second);
+    PatchJitRootUse(this, code, roots_data, entry.second, it->second);
   }
   for (const auto& entry : jit_class_patches_) {
     const auto& it = jit_class_roots_.find(entry.first);
     DCHECK(it != jit_class_roots_.end());
-    PatchJitRootUse(code, roots_data, entry.second, it->second);
+    PatchJitRootUse(this, code, roots_data, entry.second, it->second);
   }
 }
 
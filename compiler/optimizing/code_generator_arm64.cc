@@ -26,10 +26,12 @@
 #include "gc/accounting/card_table.h"
 #include "intrinsics.h"
 #include "intrinsics_arm64.h"
+#include "jit/profiling_info.h"
 #include "linker/arm64/relative_patcher_arm64.h"
 #include "mirror/array-inl.h"
 #include "mirror/class-inl.h"
 #include "offsets.h"
+#include "scoped_thread_state_change-inl.h"
 #include "thread.h"
 #include "utils/arm64/assembler_arm64.h"
 #include "utils/assembler.h"
@@ -524,6 +526,29 @@ class SuspendCheckSlowPathARM64 : public SlowPathCodeARM64 {
   DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathARM64);
 };
 
+class CompileOptimizedSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  explicit CompileOptimizedSlowPathARM64(HSuspendCheck* instruction)
+      : SlowPathCodeARM64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    LocationSummary* locations = instruction_->GetLocations();
+    CodeGeneratorARM64* arm64_codegen = down_cast<CodeGeneratorARM64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);  // Only saves live 128-bit regs for SIMD.
+    arm64_codegen->InvokeRuntime(
+        kQuickCompileOptimized, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickCompileOptimized, void, void>();
+    RestoreLiveRegisters(codegen, locations);  // Only restores live 128-bit regs for SIMD.
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const OVERRIDE { return "CompileOptimizedSlowPathARM64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CompileOptimizedSlowPathARM64);
+};
+
 class TypeCheckSlowPathARM64 : public SlowPathCodeARM64 {
  public:
   TypeCheckSlowPathARM64(HInstruction* instruction, bool is_fatal)
@@ -2192,6 +2217,25 @@ void InstructionCodeGeneratorARM64::GenerateSuspendCheck(HSuspendCheck* instruct
   UseScratchRegisterScope temps(codegen_->GetVIXLAssembler());
   Register temp = temps.AcquireW();
 
+  if (GetGraph()->IsCompilingBaseline()) {
+    // Count method entries and loop back edges. The runtime primes the hotness counter so
+    // that it wraps around to zero when the method should be recompiled with all
+    // optimizations, which we then request through a dedicated entrypoint.
+    SlowPathCodeARM64* compile_slow_path =
+        new (GetGraph()->GetArena()) CompileOptimizedSlowPathARM64(instruction);
+    codegen_->AddSlowPath(compile_slow_path);
+    Register method = temps.AcquireX();
+    uint32_t hotness_offset = ArtMethod::HotnessCountOffset().Uint32Value();
+    __ Ldr(method, MemOperand(sp, kCurrentMethodStackOffset));
+    __ Ldrh(temp, MemOperand(method, hotness_offset));
+    __ Add(temp, temp, 1);
+    __ Strh(temp, MemOperand(method, hotness_offset));
+    __ Tst(temp, 0xffff);
+    __ B(eq, compile_slow_path->GetEntryLabel());
+    __ Bind(compile_slow_path->GetExitLabel());
+    temps.Release(method);
+  }
+
   __ Ldrh(temp, MemOperand(tr, Thread::ThreadFlagsOffset<kArm64PointerSize>().SizeValue()));
   if (successor == nullptr) {
     __ Cbnz(temp, slow_path->GetEntryLabel());
@@ -4363,7 +4407,6 @@ void InstructionCodeGeneratorARM64::VisitInvokeInterface(HInvokeInterface* invok
   MacroAssembler* masm = GetVIXLAssembler();
   UseScratchRegisterScope scratch_scope(masm);
   scratch_scope.Exclude(ip1);
-  __ Mov(ip1, invoke->GetDexMethodIndex());
 
   // Ensure that between load and MaybeRecordImplicitNullCheck there are no pools emitted.
   if (receiver.IsStackSlot()) {
@@ -4389,6 +4432,11 @@ void InstructionCodeGeneratorARM64::VisitInvokeInterface(HInvokeInterface* invok
   // intact/accessible until the end of the marking phase (the
   // concurrent copying collector may not in the future).
   GetAssembler()->MaybeUnpoisonHeapReference(temp.W());
+
+  // The inline cache update uses ip1, so set the hidden argument after it.
+  codegen_->MaybeGenerateInlineCacheUpdate(invoke, temp);
+  __ Mov(ip1, invoke->GetDexMethodIndex());
+
   __ Ldr(temp,
       MemOperand(temp, mirror::Class::ImtPtrOffset(kArm64PointerSize).Uint32Value()));
   uint32_t method_offset = static_cast<uint32_t>(ImTable::OffsetOfElement(
@@ -4534,6 +4582,45 @@ void CodeGeneratorARM64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invok
   DCHECK(!IsLeafMethod());
 }
 
+void CodeGeneratorARM64::MaybeGenerateInlineCacheUpdate(HInvoke* invoke, Register klass) {
+  // We know the destination of an intrinsic, so no need to record inline caches.
+  if (!GetGraph()->IsCompilingBaseline() || invoke->GetLocations()->Intrinsified()) {
+    return;
+  }
+  InlineCache* cache = nullptr;
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    ProfilingInfo* info = GetGraph()->GetArtMethod()->GetProfilingInfo(kRuntimePointerSize);
+    if (info == nullptr) {
+      return;
+    }
+    cache = info->GetInlineCache(invoke->GetDexPc());
+  }
+  // The update entrypoint expects the class in w0 and the cache in ip1.
+  DCHECK_EQ(klass.GetCode(), 0u);
+  vixl::aarch64::Label done, update;
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  temps.Exclude(ip1);
+  Register temp = temps.AcquireW();
+  __ Mov(ip1, reinterpret_cast64<uint64_t>(cache));
+  __ Ldr(temp, MemOperand(ip1, InlineCache::ClassesOffset().Int32Value()));
+  __ Cmp(temp, klass.W());
+  __ B(ne, &update);
+  // Fast path for the first receiver class: count the call inline, unless the count saturated.
+  __ Ldr(temp, MemOperand(ip1, InlineCache::CountOffset().Int32Value()));
+  __ Adds(temp, temp, 1);
+  __ B(cs, &done);
+  __ Str(temp, MemOperand(ip1, InlineCache::CountOffset().Int32Value()));
+  __ Ldr(temp, MemOperand(ip1, InlineCache::ClassCountsOffset().Int32Value()));
+  __ Add(temp, temp, 1);
+  __ Str(temp, MemOperand(ip1, InlineCache::ClassCountsOffset().Int32Value()));
+  __ B(&done);
+  __ Bind(&update);
+  // The entrypoint preserves all registers, including the arguments of `invoke`.
+  InvokeRuntime(kQuickUpdateInlineCache, invoke, invoke->GetDexPc());
+  __ Bind(&done);
+}
+
 void CodeGeneratorARM64::GenerateVirtualCall(HInvokeVirtual* invoke, Location temp_in) {
   // Use the calling convention instead of the location of the receiver, as
   // intrinsics may have put the receiver in a different register. In the intrinsics
@@ -4563,6 +4650,9 @@ void CodeGeneratorARM64::GenerateVirtualCall(HInvokeVirtual* invoke, Location te
   // intact/accessible until the end of the marking phase (the
   // concurrent copying collector may not in the future).
   GetAssembler()->MaybeUnpoisonHeapReference(temp.W());
+
+  MaybeGenerateInlineCacheUpdate(invoke, temp);
+
   // temp = temp->GetMethodAt(method_offset);
   __ Ldr(temp, MemOperand(temp, method_offset));
   // lr = temp->GetEntryPoint();
@@ -6482,7 +6572,8 @@ void InstructionCodeGeneratorARM64::VisitClassTableGet(HClassTableGet* instructi
   }
 }
 
-static void PatchJitRootUse(uint8_t* code,
+static void PatchJitRootUse(CodeGenerator* codegen,
+                            uint8_t* code,
                             const uint8_t* roots_data,
                             vixl::aarch64::Literal<uint32_t>* literal,
                             uint64_t index_in_table) {
@@ -6491,18 +6582,19 @@ static void PatchJitRootUse(uint8_t* code,
       reinterpret_cast<uintptr_t>(roots_data) + index_in_table * sizeof(GcRoot<mirror::Object>);
   uint8_t* data = code + literal_offset;
   reinterpret_cast<uint32_t*>(data)[0] = dchecked_integral_cast<uint32_t>(address);
+  codegen->RecordJitRootPatch(literal_offset, index_in_table);
 }
 
 void CodeGeneratorARM64::EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) {
   for (const auto& entry : jit_string_patches_) {
     const auto& it = jit_string_roots_.find(entry.first);
     DCHECK(it != jit_string_roots_.end());
-    PatchJitRootUse(code, roots_data, entry.second, it->second);
+    PatchJitRootUse(this, code, roots_data, entry.second, it->second);
   }
   for (const auto& entry : jit_class_patches_) {
     const auto& it = jit_class_roots_.find(entry.first);
     DCHECK(it != jit_class_roots_.end());
-    PatchJitRootUse(code, roots_data, entry.second, it->second);
+    PatchJitRootUse(this, code, roots_data, entry.second, it->second);
   }
 }
 
@@ -544,6 +544,10 @@ class CodeGeneratorARM64 : public CodeGenerator {
   void GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invoke, Location temp) OVERRIDE;
   void GenerateVirtualCall(HInvokeVirtual* invoke, Location temp) OVERRIDE;
 
+  // In baseline code, record the receiver class `klass` of `invoke` in the inline cache
+  // of the ProfilingInfo of the compiled method.
+  void MaybeGenerateInlineCacheUpdate(HInvoke* invoke, vixl::aarch64::Register klass);
+
   void MoveFromReturnRegister(Location trg ATTRIBUTE_UNUSED,
                               Primitive::Type type ATTRIBUTE_UNUSED) OVERRIDE {
     UNIMPLEMENTED(FATAL);
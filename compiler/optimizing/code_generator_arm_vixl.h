@@ -329,6 +329,16 @@ class InstructionCodeGeneratorARMVIXL : public InstructionCodeGenerator {
   void GenerateAndConst(vixl::aarch32::Register out, vixl::aarch32::Register first, uint32_t value);
   void GenerateOrrConst(vixl::aarch32::Register out, vixl::aarch32::Register first, uint32_t value);
   void GenerateEorConst(vixl::aarch32::Register out, vixl::aarch32::Register first, uint32_t value);
+  vixl::aarch32::MemOperand VecAddress(
+      HVecMemoryOperation* instruction,
+      // This function may acquire a scratch register.
+      vixl::aarch32::UseScratchRegisterScope* temps_scope,
+      /*out*/ vixl::aarch32::Register* scratch);
+  vixl::aarch32::AlignedMemOperand VecAddressUnaligned(
+      HVecMemoryOperation* instruction,
+      // This function acquires a scratch register.
+      vixl::aarch32::UseScratchRegisterScope* temps_scope,
+      /*out*/ vixl::aarch32::Register* scratch);
   void GenerateAddLongConst(Location out, Location first, uint64_t value);
   void HandleBitwiseOperation(HBinaryOperation* operation);
   void HandleCondition(HCondition* condition);
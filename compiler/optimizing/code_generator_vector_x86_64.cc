@@ -23,6 +23,12 @@ namespace x86_64 {
 // NOLINT on __ macro to suppress wrong warning/fix (misc-macro-parentheses) from clang-tidy.
 #define __ down_cast<X86_64Assembler*>(GetAssembler())->  // NOLINT
 
+// Returns true if the vector operation works on 256-bit AVX2 vectors rather than
+// on 128-bit SSE vectors.
+static bool IsAVX2Vector(HVecOperation* instruction) {
+  return instruction->GetVectorNumberOfBytes() == 32u;
+}
+
 void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
   switch (instruction->GetPackedType()) {
@@ -49,41 +55,66 @@ void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instru
 void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(is_avx2 ? 32u : 16u, instruction->GetVectorLength());
       __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
-      __ punpcklbw(reg, reg);
-      __ punpcklwd(reg, reg);
-      __ pshufd(reg, reg, Immediate(0));
+      if (is_avx2) {
+        __ vpbroadcastb(reg, reg);
+      } else {
+        __ punpcklbw(reg, reg);
+        __ punpcklwd(reg, reg);
+        __ pshufd(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
       __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
-      __ punpcklwd(reg, reg);
-      __ pshufd(reg, reg, Immediate(0));
+      if (is_avx2) {
+        __ vpbroadcastw(reg, reg);
+      } else {
+        __ punpcklwd(reg, reg);
+        __ pshufd(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
       __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
-      __ pshufd(reg, reg, Immediate(0));
+      if (is_avx2) {
+        __ vpbroadcastd(reg, reg);
+      } else {
+        __ pshufd(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
       __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());  // is 64-bit
-      __ punpcklqdq(reg, reg);
+      if (is_avx2) {
+        __ vpbroadcastq(reg, reg);
+      } else {
+        __ punpcklqdq(reg, reg);
+      }
       break;
     case Primitive::kPrimFloat:
       DCHECK(locations->InAt(0).Equals(locations->Out()));
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ shufps(reg, reg, Immediate(0));
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vbroadcastss(reg, reg);
+      } else {
+        __ shufps(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimDouble:
       DCHECK(locations->InAt(0).Equals(locations->Out()));
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ shufpd(reg, reg, Immediate(0));
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vbroadcastsd(reg, reg);
+      } else {
+        __ shufpd(reg, reg, Immediate(0));
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -92,19 +123,147 @@ void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar
 }
 
 void LocationsBuilderX86_64::VisitVecSetScalars(HVecSetScalars* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
+  DCHECK_EQ(1u, instruction->InputCount());  // only one input currently implemented
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+    case Primitive::kPrimLong:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetOut(Location::RequiresFpuRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
 void InstructionCodeGeneratorX86_64::VisitVecSetScalars(HVecSetScalars* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = instruction->GetLocations();
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  CpuRegister src = locations->InAt(0).AsRegister<CpuRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
+  // Zero out all other elements first (a legacy movd leaves the upper half of a ymm intact).
+  if (is_avx2) {
+    __ vpxor(dst, dst, dst);
+  } else {
+    __ pxor(dst, dst);
+  }
+  // Set required elements.
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      __ movd(dst, src, /* is64bit */ false);
+      break;
+    case Primitive::kPrimLong:
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      __ movd(dst, src, /* is64bit */ true);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
+}
+
+void LocationsBuilderX86_64::VisitVecExtractScalar(HVecExtractScalar* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+    case Primitive::kPrimLong:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
-void LocationsBuilderX86_64::VisitVecSumReduce(HVecSumReduce* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+void InstructionCodeGeneratorX86_64::VisitVecExtractScalar(HVecExtractScalar* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  CpuRegister dst = locations->Out().AsRegister<CpuRegister>();
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      __ movd(dst, src, /* is64bit */ false);
+      break;
+    case Primitive::kPrimLong:
+      __ movd(dst, src, /* is64bit */ true);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
-void InstructionCodeGeneratorX86_64::VisitVecSumReduce(HVecSumReduce* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+// Helper to combine the int elements of two xmm registers for a reduction.
+static void EmitReduceIntOp(X86_64Assembler* assembler,
+                            HVecReduce::ReductionKind kind,
+                            XmmRegister dst,
+                            XmmRegister src) {
+  switch (kind) {
+    case HVecReduce::kSum:
+      assembler->paddd(dst, src);
+      break;
+    case HVecReduce::kMin:
+      assembler->pminsd(dst, src);
+      break;
+    case HVecReduce::kMax:
+      assembler->pmaxsd(dst, src);
+      break;
+  }
+}
+
+void LocationsBuilderX86_64::VisitVecReduce(HVecReduce* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+    case Primitive::kPrimLong:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetOut(Location::SameAsFirstInput());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitVecReduce(HVecReduce* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  HVecReduce::ReductionKind kind = instruction->GetKind();
+  X86_64Assembler* assembler = down_cast<X86_64Assembler*>(GetAssembler());
+  bool is_avx2 = IsAVX2Vector(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      // Fold the upper half of a ymm into the lower half first, and then fold
+      // the xmm halves twice, leaving the reduction in the lowest element.
+      if (is_avx2) {
+        __ vextracti128(tmp, dst, Immediate(1));
+        EmitReduceIntOp(assembler, kind, dst, tmp);
+      }
+      __ pshufd(tmp, dst, Immediate(0x4E));  // swap quadwords
+      EmitReduceIntOp(assembler, kind, dst, tmp);
+      __ pshufd(tmp, dst, Immediate(0xB1));  // swap doublewords
+      EmitReduceIntOp(assembler, kind, dst, tmp);
+      break;
+    case Primitive::kPrimLong:
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_EQ(HVecReduce::kSum, kind);  // no long min/max
+      if (is_avx2) {
+        __ vextracti128(tmp, dst, Immediate(1));
+        __ paddq(dst, tmp);
+      }
+      __ pshufd(tmp, dst, Immediate(0x4E));  // swap quadwords
+      __ paddq(dst, tmp);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
 // Helper to set up locations for vector unary operations.
@@ -139,8 +298,13 @@ void InstructionCodeGeneratorX86_64::VisitVecCnv(HVecCnv* instruction) {
   Primitive::Type from = instruction->GetInputType();
   Primitive::Type to = instruction->GetResultType();
   if (from == Primitive::kPrimInt && to == Primitive::kPrimFloat) {
-    DCHECK_EQ(4u, instruction->GetVectorLength());
-    __ cvtdq2ps(dst, src);
+    bool is_avx2 = IsAVX2Vector(instruction);
+    DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+    if (is_avx2) {
+      __ vcvtdq2ps(dst, src);
+    } else {
+      __ cvtdq2ps(dst, src);
+    }
   } else {
     LOG(FATAL) << "Unsupported SIMD type";
   }
@@ -154,37 +318,68 @@ void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubb(dst, src);
+      DCHECK_EQ(is_avx2 ? 32u : 16u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubb(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubb(dst, src);
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubw(dst, src);
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubw(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubd(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubd(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubd(dst, src);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubq(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubq(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubq(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ xorps(dst, dst);
-      __ subps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vxorps(dst, dst, dst);
+        __ vsubps(dst, dst, src);
+      } else {
+        __ xorps(dst, dst);
+        __ subps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ xorpd(dst, dst);
-      __ subpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vxorpd(dst, dst, dst);
+        __ vsubpd(dst, dst, src);
+      } else {
+        __ xorpd(dst, dst);
+        __ subpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -194,8 +389,8 @@ void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
 
 void LocationsBuilderX86_64::VisitVecAbs(HVecAbs* instruction) {
   CreateVecUnOpLocations(GetGraph()->GetArena(), instruction);
-  // Integral-abs requires a temporary for the comparison.
-  if (instruction->GetPackedType() == Primitive::kPrimInt) {
+  // Integral-abs requires a temporary for the comparison, unless AVX2 provides vpabsd.
+  if (instruction->GetPackedType() == Primitive::kPrimInt && !IsAVX2Vector(instruction)) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
 }
@@ -204,8 +399,14 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimInt: {
+      if (is_avx2) {
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        __ vpabsd(dst, src);
+        break;
+      }
       DCHECK_EQ(4u, instruction->GetVectorLength());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
       __ movaps(dst, src);
@@ -216,12 +417,26 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
       break;
     }
     case Primitive::kPrimFloat:
+      if (is_avx2) {
+        DCHECK_EQ(8u, instruction->GetVectorLength());
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vpsrld(dst, dst, Immediate(1));
+        __ vandps(dst, dst, src);
+        break;
+      }
       DCHECK_EQ(4u, instruction->GetVectorLength());
       __ pcmpeqb(dst, dst);  // all ones
       __ psrld(dst, Immediate(1));
       __ andps(dst, src);
       break;
     case Primitive::kPrimDouble:
+      if (is_avx2) {
+        DCHECK_EQ(4u, instruction->GetVectorLength());
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vpsrlq(dst, dst, Immediate(1));
+        __ vandpd(dst, dst, src);
+        break;
+      }
       DCHECK_EQ(2u, instruction->GetVectorLength());
       __ pcmpeqb(dst, dst);  // all ones
       __ psrlq(dst, Immediate(1));
@@ -235,7 +450,7 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
 
 void LocationsBuilderX86_64::VisitVecNot(HVecNot* instruction) {
   CreateVecUnOpLocations(GetGraph()->GetArena(), instruction);
-  // Boolean-not requires a temporary to construct the 16 x one.
+  // Boolean-not requires a temporary to construct the 16 (or 32) x one.
   if (instruction->GetPackedType() == Primitive::kPrimBoolean) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
@@ -245,10 +460,18 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean: {  // special case boolean-not
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(is_avx2 ? 32u : 16u, instruction->GetVectorLength());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+      if (is_avx2) {
+        __ vpxor(dst, dst, dst);
+        __ vpcmpeqb(tmp, tmp, tmp);  // all ones
+        __ vpsubb(dst, dst, tmp);  // 32 x one
+        __ vpxor(dst, dst, src);
+        break;
+      }
       __ pxor(dst, dst);
       __ pcmpeqb(tmp, tmp);  // all ones
       __ psubb(dst, tmp);  // 16 x one
@@ -260,20 +483,35 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pcmpeqb(dst, dst);  // all ones
-      __ pxor(dst, src);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vpxor(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ pxor(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pcmpeqb(dst, dst);  // all ones
-      __ xorps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vxorps(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ xorps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ pcmpeqb(dst, dst);  // all ones
-      __ xorpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vxorpd(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ xorpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -312,31 +550,56 @@ void InstructionCodeGeneratorX86_64::VisitVecAdd(HVecAdd* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ paddb(dst, src);
+      DCHECK_EQ(is_avx2 ? 32u : 16u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpaddb(dst, dst, src);
+      } else {
+        __ paddb(dst, src);
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ paddw(dst, src);
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpaddw(dst, dst, src);
+      } else {
+        __ paddw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ paddd(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpaddd(dst, dst, src);
+      } else {
+        __ paddd(dst, src);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ paddq(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpaddq(dst, dst, src);
+      } else {
+        __ paddq(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ addps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vaddps(dst, dst, src);
+      } else {
+        __ addps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ addpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vaddpd(dst, dst, src);
+      } else {
+        __ addpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -353,15 +616,24 @@ void InstructionCodeGeneratorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instruct
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-     __ pavgb(dst, src);
-     return;
+      DCHECK_EQ(is_avx2 ? 32u : 16u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpavgb(dst, dst, src);
+      } else {
+        __ pavgb(dst, src);
+      }
+      return;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ pavgw(dst, src);
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpavgw(dst, dst, src);
+      } else {
+        __ pavgw(dst, src);
+      }
       return;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -378,31 +650,56 @@ void InstructionCodeGeneratorX86_64::VisitVecSub(HVecSub* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ psubb(dst, src);
+      DCHECK_EQ(is_avx2 ? 32u : 16u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsubb(dst, dst, src);
+      } else {
+        __ psubb(dst, src);
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psubw(dst, src);
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsubw(dst, dst, src);
+      } else {
+        __ psubw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ psubd(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsubd(dst, dst, src);
+      } else {
+        __ psubd(dst, src);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ psubq(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsubq(dst, dst, src);
+      } else {
+        __ psubq(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ subps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vsubps(dst, dst, src);
+      } else {
+        __ subps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ subpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vsubpd(dst, dst, src);
+      } else {
+        __ subpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -419,23 +716,40 @@ void InstructionCodeGeneratorX86_64::VisitVecMul(HVecMul* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ pmullw(dst, src);
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpmullw(dst, dst, src);
+      } else {
+        __ pmullw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pmulld(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpmulld(dst, dst, src);
+      } else {
+        __ pmulld(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ mulps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vmulps(dst, dst, src);
+      } else {
+        __ mulps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ mulpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vmulpd(dst, dst, src);
+      } else {
+        __ mulpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -452,14 +766,23 @@ void InstructionCodeGeneratorX86_64::VisitVecDiv(HVecDiv* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ divps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vdivps(dst, dst, src);
+      } else {
+        __ divps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ divpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vdivpd(dst, dst, src);
+      } else {
+        __ divpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -472,7 +795,24 @@ void LocationsBuilderX86_64::VisitVecMin(HVecMin* instruction) {
 }
 
 void InstructionCodeGeneratorX86_64::VisitVecMin(HVecMin* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = instruction->GetLocations();
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpminsd(dst, dst, src);
+      } else {
+        __ pminsd(dst, src);
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
 void LocationsBuilderX86_64::VisitVecMax(HVecMax* instruction) {
@@ -480,7 +820,24 @@ void LocationsBuilderX86_64::VisitVecMax(HVecMax* instruction) {
 }
 
 void InstructionCodeGeneratorX86_64::VisitVecMax(HVecMax* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = instruction->GetLocations();
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpmaxsd(dst, dst, src);
+      } else {
+        __ pmaxsd(dst, src);
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
 void LocationsBuilderX86_64::VisitVecAnd(HVecAnd* instruction) {
@@ -492,6 +849,7 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
@@ -499,17 +857,29 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pand(dst, src);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        __ vpand(dst, dst, src);
+      } else {
+        __ pand(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ andps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vandps(dst, dst, src);
+      } else {
+        __ andps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ andpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vandpd(dst, dst, src);
+      } else {
+        __ andpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -526,6 +896,7 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
@@ -533,17 +904,29 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pandn(dst, src);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        __ vpandn(dst, dst, src);
+      } else {
+        __ pandn(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ andnps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vandnps(dst, dst, src);
+      } else {
+        __ andnps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ andnpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vandnpd(dst, dst, src);
+      } else {
+        __ andnpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -560,6 +943,7 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
@@ -567,17 +951,29 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ por(dst, src);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        __ vpor(dst, dst, src);
+      } else {
+        __ por(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ orps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vorps(dst, dst, src);
+      } else {
+        __ orps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ orpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vorpd(dst, dst, src);
+      } else {
+        __ orpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -594,6 +990,7 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
@@ -601,17 +998,29 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pxor(dst, src);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        __ vpxor(dst, dst, src);
+      } else {
+        __ pxor(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ xorps(dst, src);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vxorps(dst, dst, src);
+      } else {
+        __ xorps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ xorpd(dst, src);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vxorpd(dst, dst, src);
+      } else {
+        __ xorpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -646,19 +1055,32 @@ void InstructionCodeGeneratorX86_64::VisitVecShl(HVecShl* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psllw(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsllw(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psllw(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pslld(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpslld(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ pslld(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ psllq(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsllq(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psllq(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -675,15 +1097,24 @@ void InstructionCodeGeneratorX86_64::VisitVecShr(HVecShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psraw(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsraw(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psraw(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ psrad(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsrad(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psrad(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -700,19 +1131,32 @@ void InstructionCodeGeneratorX86_64::VisitVecUShr(HVecUShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instruction);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psrlw(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsrlw(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psrlw(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ psrld(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsrld(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psrld(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ psrlq(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        __ vpsrlq(dst, dst, Immediate(static_cast<int8_t>(value)));
+      } else {
+        __ psrlq(dst, Immediate(static_cast<int8_t>(value)));
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -721,11 +1165,44 @@ void InstructionCodeGeneratorX86_64::VisitVecUShr(HVecUShr* instruction) {
 }
 
 void LocationsBuilderX86_64::VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instr) {
-  LOG(FATAL) << "No SIMD for " << instr->GetId();
+  // Only the widening dot-product form of short operands is supported.
+  if (!instr->IsWidening() || instr->GetMulPackedType() != Primitive::kPrimShort) {
+    LOG(FATAL) << "No SIMD for " << instr->GetId();
+  }
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instr);
+  locations->SetInAt(
+      HVecMultiplyAccumulate::kInputAccumulatorIndex, Location::RequiresFpuRegister());
+  locations->SetInAt(
+      HVecMultiplyAccumulate::kInputMulLeftIndex, Location::RequiresFpuRegister());
+  locations->SetInAt(
+      HVecMultiplyAccumulate::kInputMulRightIndex, Location::RequiresFpuRegister());
+  DCHECK_EQ(HVecMultiplyAccumulate::kInputAccumulatorIndex, 0);
+  locations->SetOut(Location::SameAsFirstInput());
+  locations->AddTemp(Location::RequiresFpuRegister());
 }
 
 void InstructionCodeGeneratorX86_64::VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instr) {
-  LOG(FATAL) << "No SIMD for " << instr->GetId();
+  LocationSummary* locations = instr->GetLocations();
+  XmmRegister acc =
+      locations->InAt(HVecMultiplyAccumulate::kInputAccumulatorIndex).AsFpuRegister<XmmRegister>();
+  XmmRegister left =
+      locations->InAt(HVecMultiplyAccumulate::kInputMulLeftIndex).AsFpuRegister<XmmRegister>();
+  XmmRegister right =
+      locations->InAt(HVecMultiplyAccumulate::kInputMulRightIndex).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  bool is_avx2 = IsAVX2Vector(instr);
+  DCHECK_EQ(Primitive::kPrimInt, instr->GetPackedType());
+  DCHECK_EQ(is_avx2 ? 8u : 4u, instr->GetVectorLength());
+  DCHECK(instr->GetOpKind() == HInstruction::kAdd);
+  // Multiply the shorts and add adjacent products into ints, then accumulate.
+  if (is_avx2) {
+    __ vpmaddwd(tmp, left, right);
+    __ vpaddd(acc, acc, tmp);
+  } else {
+    __ movaps(tmp, left);
+    __ pmaddwd(tmp, right);
+    __ paddd(acc, tmp);
+  }
 }
 
 // Helper to set up locations for vector memory operations.
@@ -775,8 +1252,11 @@ static Address VecAddress(LocationSummary* locations, size_t size, bool is_strin
 
 void LocationsBuilderX86_64::VisitVecLoad(HVecLoad* instruction) {
   CreateVecMemLocations(GetGraph()->GetArena(), instruction, /*is_load*/ true);
-  // String load requires a temporary for the compressed load.
-  if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+  // String load requires a temporary for the compressed load, unless AVX2 zero extends
+  // directly from memory.
+  if (mirror::kUseStringCompression &&
+      instruction->IsStringCharAt() &&
+      !IsAVX2Vector(instruction)) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
 }
@@ -786,28 +1266,38 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
   size_t size = Primitive::ComponentSize(instruction->GetPackedType());
   Address address = VecAddress(locations, size, instruction->IsStringCharAt());
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
-  bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
+  bool is_avx2 = IsAVX2Vector(instruction);
+  bool is_aligned = instruction->GetAlignment().IsAlignedAt(is_avx2 ? 32 : 16);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(is_avx2 ? 16u : 8u, instruction->GetVectorLength());
       // Special handling of compressed/uncompressed string load.
       if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
         NearLabel done, not_compressed;
-        XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
         // Test compression bit.
         static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
                       "Expecting 0=compressed, 1=uncompressed");
         uint32_t count_offset = mirror::String::CountOffset().Uint32Value();
         __ testb(Address(locations->InAt(0).AsRegister<CpuRegister>(), count_offset), Immediate(1));
         __ j(kNotZero, &not_compressed);
-        // Zero extend 8 compressed bytes into 8 chars.
-        __ movsd(reg, VecAddress(locations, 1, /*is_string_char_at*/ true));
-        __ pxor(tmp, tmp);
-        __ punpcklbw(reg, tmp);
+        if (is_avx2) {
+          // Zero extend 16 compressed bytes into 16 chars.
+          __ vpmovzxbw(reg, VecAddress(locations, 1, /*is_string_char_at*/ true));
+        } else {
+          // Zero extend 8 compressed bytes into 8 chars.
+          XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+          __ movsd(reg, VecAddress(locations, 1, /*is_string_char_at*/ true));
+          __ pxor(tmp, tmp);
+          __ punpcklbw(reg, tmp);
+        }
         __ jmp(&done);
-        // Load 8 direct uncompressed chars.
+        // Load 8 (or 16) direct uncompressed chars.
         __ Bind(&not_compressed);
-        is_aligned16 ?  __ movdqa(reg, address) :  __ movdqu(reg, address);
+        if (is_avx2) {
+          is_aligned ? __ vmovdqa(reg, address) : __ vmovdqu(reg, address);
+        } else {
+          is_aligned ? __ movdqa(reg, address) : __ movdqu(reg, address);
+        }
         __ Bind(&done);
         return;
       }
@@ -817,17 +1307,29 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      is_aligned16 ? __ movdqa(reg, address) : __ movdqu(reg, address);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        is_aligned ? __ vmovdqa(reg, address) : __ vmovdqu(reg, address);
+      } else {
+        is_aligned ? __ movdqa(reg, address) : __ movdqu(reg, address);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      is_aligned16 ? __ movaps(reg, address) : __ movups(reg, address);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        is_aligned ? __ vmovaps(reg, address) : __ vmovups(reg, address);
+      } else {
+        is_aligned ? __ movaps(reg, address) : __ movups(reg, address);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      is_aligned16 ? __ movapd(reg, address) : __ movupd(reg, address);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        is_aligned ? __ vmovapd(reg, address) : __ vmovupd(reg, address);
+      } else {
+        is_aligned ? __ movapd(reg, address) : __ movupd(reg, address);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -844,7 +1346,8 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
   size_t size = Primitive::ComponentSize(instruction->GetPackedType());
   Address address = VecAddress(locations, size, /*is_string_char_at*/ false);
   XmmRegister reg = locations->InAt(2).AsFpuRegister<XmmRegister>();
-  bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
+  bool is_avx2 = IsAVX2Vector(instruction);
+  bool is_aligned = instruction->GetAlignment().IsAlignedAt(is_avx2 ? 32 : 16);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
@@ -852,17 +1355,29 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
     case Primitive::kPrimShort:
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      is_aligned16 ? __ movdqa(address, reg) : __ movdqu(address, reg);
+      DCHECK_LE(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      DCHECK_LE(instruction->GetVectorLength(), is_avx2 ? 32u : 16u);
+      if (is_avx2) {
+        is_aligned ? __ vmovdqa(address, reg) : __ vmovdqu(address, reg);
+      } else {
+        is_aligned ? __ movdqa(address, reg) : __ movdqu(address, reg);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      is_aligned16 ? __ movaps(address, reg) : __ movups(address, reg);
+      DCHECK_EQ(is_avx2 ? 8u : 4u, instruction->GetVectorLength());
+      if (is_avx2) {
+        is_aligned ? __ vmovaps(address, reg) : __ vmovups(address, reg);
+      } else {
+        is_aligned ? __ movaps(address, reg) : __ movups(address, reg);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      is_aligned16 ? __ movapd(address, reg) : __ movupd(address, reg);
+      DCHECK_EQ(is_avx2 ? 4u : 2u, instruction->GetVectorLength());
+      if (is_avx2) {
+        is_aligned ? __ vmovapd(address, reg) : __ vmovupd(address, reg);
+      } else {
+        is_aligned ? __ movapd(address, reg) : __ movupd(address, reg);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -7813,13 +7813,14 @@ void CodeGeneratorX86::MoveFromReturnRegister(Location target, Primitive::Type t
 void CodeGeneratorX86::PatchJitRootUse(uint8_t* code,
                                        const uint8_t* roots_data,
                                        const PatchInfo<Label>& info,
-                                       uint64_t index_in_table) const {
+                                       uint64_t index_in_table) {
   uint32_t code_offset = info.label.Position() - kLabelPositionToLiteralOffsetAdjustment;
   uintptr_t address =
       reinterpret_cast<uintptr_t>(roots_data) + index_in_table * sizeof(GcRoot<mirror::Object>);
   typedef __attribute__((__aligned__(1))) uint32_t unaligned_uint32_t;
   reinterpret_cast<unaligned_uint32_t*>(code + code_offset)[0] =
      dchecked_integral_cast<uint32_t>(address);
+  RecordJitRootPatch(code_offset, index_in_table);
 }
 
 void CodeGeneratorX86::EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) {
@@ -435,7 +435,7 @@ class CodeGeneratorX86 : public CodeGenerator {
   void PatchJitRootUse(uint8_t* code,
                        const uint8_t* roots_data,
                        const PatchInfo<Label>& info,
-                       uint64_t index_in_table) const;
+                       uint64_t index_in_table);
   void EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) OVERRIDE;
 
   // Emit a write barrier.
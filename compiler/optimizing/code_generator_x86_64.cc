@@ -23,9 +23,11 @@
 #include "gc/accounting/card_table.h"
 #include "intrinsics.h"
 #include "intrinsics_x86_64.h"
+#include "jit/profiling_info.h"
 #include "mirror/array-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/object_reference.h"
+#include "scoped_thread_state_change-inl.h"
 #include "thread.h"
 #include "utils/assembler.h"
 #include "utils/stack_checks.h"
@@ -144,6 +146,7 @@ class SuspendCheckSlowPathX86_64 : public SlowPathCode {
     CodeGeneratorX86_64* x86_64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
     __ Bind(GetEntryLabel());
     SaveLiveRegisters(codegen, locations);  // Only saves full width XMM for SIMD.
+    x86_64_codegen->MaybeEmitVZeroUpper();  // Live YMM registers were saved above.
     x86_64_codegen->InvokeRuntime(kQuickTestSuspend, instruction_, instruction_->GetDexPc(), this);
     CheckEntrypointTypes<kQuickTestSuspend, void, void>();
     RestoreLiveRegisters(codegen, locations);  // Only restores full width XMM for SIMD.
@@ -172,6 +175,30 @@ class SuspendCheckSlowPathX86_64 : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathX86_64);
 };
 
+class CompileOptimizedSlowPathX86_64 : public SlowPathCode {
+ public:
+  explicit CompileOptimizedSlowPathX86_64(HSuspendCheck* instruction)
+      : SlowPathCode(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    LocationSummary* locations = instruction_->GetLocations();
+    CodeGeneratorX86_64* x86_64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);  // Only saves full width XMM for SIMD.
+    x86_64_codegen->MaybeEmitVZeroUpper();  // Live YMM registers were saved above.
+    x86_64_codegen->InvokeRuntime(
+        kQuickCompileOptimized, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickCompileOptimized, void, void>();
+    RestoreLiveRegisters(codegen, locations);  // Only restores full width XMM for SIMD.
+    __ jmp(GetExitLabel());
+  }
+
+  const char* GetDescription() const OVERRIDE { return "CompileOptimizedSlowPathX86_64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CompileOptimizedSlowPathX86_64);
+};
+
 class BoundsCheckSlowPathX86_64 : public SlowPathCode {
  public:
   explicit BoundsCheckSlowPathX86_64(HBoundsCheck* instruction)
@@ -1027,6 +1054,7 @@ void CodeGeneratorX86_64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invo
   // All registers are assumed to be correctly set up.
   Location callee_method = GenerateCalleeMethodStaticOrDirectCall(invoke, temp);
 
+  MaybeEmitVZeroUpper();
   switch (invoke->GetCodePtrLocation()) {
     case HInvokeStaticOrDirect::CodePtrLocation::kCallSelf:
       __ call(&frame_entry_label_);
@@ -1042,6 +1070,39 @@ void CodeGeneratorX86_64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invo
   DCHECK(!IsLeafMethod());
 }
 
+void CodeGeneratorX86_64::MaybeGenerateInlineCacheUpdate(HInvoke* invoke, CpuRegister klass) {
+  // We know the destination of an intrinsic, so no need to record inline caches.
+  if (!GetGraph()->IsCompilingBaseline() || invoke->GetLocations()->Intrinsified()) {
+    return;
+  }
+  InlineCache* cache = nullptr;
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    ProfilingInfo* info = GetGraph()->GetArtMethod()->GetProfilingInfo(kRuntimePointerSize);
+    if (info == nullptr) {
+      return;
+    }
+    cache = info->GetInlineCache(invoke->GetDexPc());
+  }
+  // The update entrypoint expects the class in RDI and the cache in TMP.
+  DCHECK_EQ(RDI, klass.AsRegister());
+  NearLabel done, update;
+  Load64BitValue(CpuRegister(TMP), reinterpret_cast64<uint64_t>(cache));
+  __ cmpl(klass, Address(CpuRegister(TMP), InlineCache::ClassesOffset().Int32Value()));
+  __ j(kNotEqual, &update);
+  // Fast path for the first receiver class: count the call inline, unless the count saturated.
+  __ cmpl(Address(CpuRegister(TMP), InlineCache::CountOffset().Int32Value()), Immediate(-1));
+  __ j(kEqual, &done);
+  __ addl(Address(CpuRegister(TMP), InlineCache::CountOffset().Int32Value()), Immediate(1));
+  __ addl(Address(CpuRegister(TMP), InlineCache::ClassCountsOffset().Int32Value()), Immediate(1));
+  __ jmp(&done);
+  __ Bind(&update);
+  MaybeEmitVZeroUpper();
+  // The entrypoint preserves all registers, including the arguments of `invoke`.
+  InvokeRuntime(kQuickUpdateInlineCache, invoke, invoke->GetDexPc());
+  __ Bind(&done);
+}
+
 void CodeGeneratorX86_64::GenerateVirtualCall(HInvokeVirtual* invoke, Location temp_in) {
   CpuRegister temp = temp_in.AsRegister<CpuRegister>();
   size_t method_offset = mirror::Class::EmbeddedVTableEntryOffset(
@@ -1066,8 +1127,12 @@ void CodeGeneratorX86_64::GenerateVirtualCall(HInvokeVirtual* invoke, Location t
   // intact/accessible until the end of the marking phase (the
   // concurrent copying collector may not in the future).
   __ MaybeUnpoisonHeapReference(temp);
+
+  MaybeGenerateInlineCacheUpdate(invoke, temp);
+
   // temp = temp->GetMethodAt(method_offset);
   __ movq(temp, Address(temp, method_offset));
+  MaybeEmitVZeroUpper();
   // call temp->GetEntryPoint();
   __ call(Address(temp, ArtMethod::EntryPointFromQuickCompiledCodeOffset(
       kX86_64PointerSize).SizeValue()));
@@ -1161,7 +1226,9 @@ size_t CodeGeneratorX86_64::RestoreCoreRegister(size_t stack_index, uint32_t reg
 }
 
 size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (HasAVX2Vectors()) {
+    __ vmovups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   } else {
     __ movsd(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
@@ -1170,7 +1237,9 @@ size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32
 }
 
 size_t CodeGeneratorX86_64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (HasAVX2Vectors()) {
+    __ vmovups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   } else {
     __ movsd(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
@@ -1338,11 +1407,18 @@ void CodeGeneratorX86_64::GenerateFrameExit() {
       }
     }
   }
+  MaybeEmitVZeroUpper();
   __ ret();
   __ cfi().RestoreState();
   __ cfi().DefCFAOffset(GetFrameSize());
 }
 
+void CodeGeneratorX86_64::MaybeEmitVZeroUpper() {
+  if (HasAVX2Vectors()) {
+    __ vzeroupper();
+  }
+}
+
 void CodeGeneratorX86_64::Bind(HBasicBlock* block) {
   __ Bind(GetLabelOf(block));
 }
@@ -2421,6 +2497,9 @@ void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invo
   // intact/accessible until the end of the marking phase (the
   // concurrent copying collector may not in the future).
   __ MaybeUnpoisonHeapReference(temp);
+
+  codegen_->MaybeGenerateInlineCacheUpdate(invoke, temp);
+
   // temp = temp->GetAddressOfIMT()
   __ movq(temp,
       Address(temp, mirror::Class::ImtPtrOffset(kX86_64PointerSize).Uint32Value()));
@@ -2429,6 +2508,7 @@ void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invo
       invoke->GetImtIndex(), kX86_64PointerSize));
   // temp = temp->GetImtEntryAt(method_offset);
   __ movq(temp, Address(temp, method_offset));
+  codegen_->MaybeEmitVZeroUpper();
   // call temp->GetEntryPoint();
   __ call(Address(
       temp, ArtMethod::EntryPointFromQuickCompiledCodeOffset(kX86_64PointerSize).SizeValue()));
@@ -5200,6 +5280,20 @@ void InstructionCodeGeneratorX86_64::GenerateSuspendCheck(HSuspendCheck* instruc
     DCHECK_EQ(slow_path->GetSuccessor(), successor);
   }
 
+  if (GetGraph()->IsCompilingBaseline()) {
+    // Count method entries and loop back edges. The runtime primes the hotness counter so
+    // that it wraps around to zero when the method should be recompiled with all
+    // optimizations, which we then request through a dedicated entrypoint.
+    SlowPathCode* compile_slow_path =
+        new (GetGraph()->GetArena()) CompileOptimizedSlowPathX86_64(instruction);
+    codegen_->AddSlowPath(compile_slow_path);
+    __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), kCurrentMethodStackOffset));
+    __ addw(Address(CpuRegister(TMP), ArtMethod::HotnessCountOffset().Int32Value()),
+            Immediate(1));
+    __ j(kEqual, compile_slow_path->GetEntryLabel());
+    __ Bind(compile_slow_path->GetExitLabel());
+  }
+
   __ gs()->cmpw(Address::Absolute(Thread::ThreadFlagsOffset<kX86_64PointerSize>().Int32Value(),
                                   /* no_rip */ true),
                 Immediate(0));
@@ -5258,8 +5352,13 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsSIMDStackSlot()) {
     DCHECK(destination.IsFpuRegister());
-    __ movups(destination.AsFpuRegister<XmmRegister>(),
-              Address(CpuRegister(RSP), source.GetStackIndex()));
+    if (codegen_->HasAVX2Vectors()) {
+      __ vmovups(destination.AsFpuRegister<XmmRegister>(),
+                 Address(CpuRegister(RSP), source.GetStackIndex()));
+    } else {
+      __ movups(destination.AsFpuRegister<XmmRegister>(),
+                Address(CpuRegister(RSP), source.GetStackIndex()));
+    }
   } else if (source.IsConstant()) {
     HConstant* constant = source.GetConstant();
     if (constant->IsIntConstant() || constant->IsNullConstant()) {
@@ -5306,7 +5405,12 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsFpuRegister()) {
     if (destination.IsFpuRegister()) {
-      __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      if (codegen_->HasAVX2Vectors()) {
+        // A legacy SSE move would leave the upper half of the YMM register unchanged.
+        __ vmovaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      } else {
+        __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      }
     } else if (destination.IsStackSlot()) {
       __ movss(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
@@ -5315,8 +5419,13 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
                source.AsFpuRegister<XmmRegister>());
     } else {
        DCHECK(destination.IsSIMDStackSlot());
-      __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
-                source.AsFpuRegister<XmmRegister>());
+      if (codegen_->HasAVX2Vectors()) {
+        __ vmovups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                   source.AsFpuRegister<XmmRegister>());
+      } else {
+        __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                  source.AsFpuRegister<XmmRegister>());
+      }
     }
   }
 }
@@ -5397,9 +5506,23 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
   } else if (source.IsDoubleStackSlot() && destination.IsDoubleStackSlot()) {
     Exchange64(destination.GetStackIndex(), source.GetStackIndex());
   } else if (source.IsFpuRegister() && destination.IsFpuRegister()) {
-    __ movd(CpuRegister(TMP), source.AsFpuRegister<XmmRegister>());
-    __ movaps(source.AsFpuRegister<XmmRegister>(), destination.AsFpuRegister<XmmRegister>());
-    __ movd(destination.AsFpuRegister<XmmRegister>(), CpuRegister(TMP));
+    XmmRegister src = source.AsFpuRegister<XmmRegister>();
+    XmmRegister dst = destination.AsFpuRegister<XmmRegister>();
+    if (codegen_->HasAVX2Vectors()) {
+      // Swap the full YMM registers, without a vector scratch register.
+      __ vxorps(src, src, dst);
+      __ vxorps(dst, dst, src);
+      __ vxorps(src, src, dst);
+    } else if (codegen_->GetGraph()->HasSIMD()) {
+      // Swap the full XMM registers, without a vector scratch register.
+      __ xorps(src, dst);
+      __ xorps(dst, src);
+      __ xorps(src, dst);
+    } else {
+      __ movd(CpuRegister(TMP), src);
+      __ movaps(src, dst);
+      __ movd(dst, CpuRegister(TMP));
+    }
   } else if (source.IsFpuRegister() && destination.IsStackSlot()) {
     Exchange32(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
   } else if (source.IsStackSlot() && destination.IsFpuRegister()) {
@@ -7120,13 +7243,14 @@ void CodeGeneratorX86_64::MoveInt64ToAddress(const Address& addr_low,
 void CodeGeneratorX86_64::PatchJitRootUse(uint8_t* code,
                                           const uint8_t* roots_data,
                                           const PatchInfo<Label>& info,
-                                          uint64_t index_in_table) const {
+                                          uint64_t index_in_table) {
   uint32_t code_offset = info.label.Position() - kLabelPositionToLiteralOffsetAdjustment;
   uintptr_t address =
       reinterpret_cast<uintptr_t>(roots_data) + index_in_table * sizeof(GcRoot<mirror::Object>);
   typedef __attribute__((__aligned__(1))) uint32_t unaligned_uint32_t;
   reinterpret_cast<unaligned_uint32_t*>(code + code_offset)[0] =
      dchecked_integral_cast<uint32_t>(address);
+  RecordJitRootPatch(code_offset, index_in_table);
 }
 
 void CodeGeneratorX86_64::EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) {
@@ -326,11 +326,23 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   }
 
   size_t GetFloatingPointSpillSlotSize() const OVERRIDE {
-    return GetGraph()->HasSIMD()
-        ? 2 * kX86_64WordSize   // 16 bytes == 2 x86_64 words for each spill
-        : 1 * kX86_64WordSize;  //  8 bytes == 1 x86_64 words for each spill
+    return HasAVX2Vectors()
+        ? 4 * kX86_64WordSize   // 32 bytes == 4 x86_64 words for each spill
+        : GetGraph()->HasSIMD()
+            ? 2 * kX86_64WordSize   // 16 bytes == 2 x86_64 words for each spill
+            : 1 * kX86_64WordSize;  //  8 bytes == 1 x86_64 words for each spill
   }
 
+  // Whether the loop optimizer may have vectorized this graph with 256-bit YMM
+  // registers, which then need VEX-encoded full width moves and spills.
+  bool HasAVX2Vectors() const {
+    return GetGraph()->HasSIMD() && isa_features_.HasAVX2();
+  }
+
+  // Clears the upper halves of the YMM registers before leaving AVX2 code, to
+  // avoid the AVX-SSE transition penalty in legacy SSE code of the callee or caller.
+  void MaybeEmitVZeroUpper();
+
   HGraphVisitor* GetLocationBuilder() OVERRIDE {
     return &location_builder_;
   }
@@ -408,6 +420,10 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   void GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invoke, Location temp) OVERRIDE;
   void GenerateVirtualCall(HInvokeVirtual* invoke, Location temp) OVERRIDE;
 
+  // In baseline code, record the receiver class `klass` of `invoke` in the inline cache
+  // of the ProfilingInfo of the compiled method.
+  void MaybeGenerateInlineCacheUpdate(HInvoke* invoke, CpuRegister klass);
+
   void RecordBootStringPatch(HLoadString* load_string);
   void RecordBootTypePatch(HLoadClass* load_class);
   Label* NewTypeBssEntryPatch(HLoadClass* load_class);
@@ -427,7 +443,7 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   void PatchJitRootUse(uint8_t* code,
                        const uint8_t* roots_data,
                        const PatchInfo<Label>& info,
-                       uint64_t index_in_table) const;
+                       uint64_t index_in_table);
 
   void EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) OVERRIDE;
 
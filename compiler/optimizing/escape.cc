@@ -100,4 +100,37 @@ bool DoesNotEscape(HInstruction* reference, bool (*no_escape)(HInstruction*, HIn
   return is_singleton_and_not_returned;
 }
 
+bool CalculatePartialEscape(HInstruction* reference, /*out*/ ArenaVector<HInstruction*>* escapes) {
+  escapes->clear();
+  // For references not allocated in the method, don't assume anything.
+  if (!reference->IsNewInstance() && !reference->IsNewArray()) {
+    return false;
+  }
+  // Visit all uses, using the same classification as CalculateEscape().
+  for (const HUseListNode<HInstruction*>& use : reference->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (user->IsBoundType() || user->IsNullCheck() || user->IsPhi() || user->IsSelect()) {
+      // The reference is aliased or merged with other values, which
+      // cannot be materialized at a single point.
+      return false;
+    } else if ((user->IsUnresolvedInstanceFieldGet() && (reference == user->InputAt(0))) ||
+               (user->IsUnresolvedInstanceFieldSet() && (reference == user->InputAt(0)))) {
+      // The field is accessed in an unresolved way.
+      return false;
+    } else if (user->IsInvoke() ||
+               (user->IsInstanceFieldSet() && (reference == user->InputAt(1))) ||
+               (user->IsUnresolvedInstanceFieldSet() && (reference == user->InputAt(1))) ||
+               (user->IsStaticFieldSet() && (reference == user->InputAt(1))) ||
+               (user->IsUnresolvedStaticFieldSet() && (reference == user->InputAt(0))) ||
+               (user->IsArraySet() && (reference == user->InputAt(2))) ||
+               user->IsReturn()) {
+      // The reference escapes at this user. A user may refer to the reference more than once.
+      if (std::find(escapes->begin(), escapes->end(), user) == escapes->end()) {
+        escapes->push_back(user);
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace art
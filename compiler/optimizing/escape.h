@@ -17,6 +17,8 @@
 #ifndef ART_COMPILER_OPTIMIZING_ESCAPE_H_
 #define ART_COMPILER_OPTIMIZING_ESCAPE_H_
 
+#include "base/arena_containers.h"
+
 namespace art {
 
 class HInstruction;
@@ -63,6 +65,19 @@ void CalculateEscape(HInstruction* reference,
  */
 bool DoesNotEscape(HInstruction* reference, bool (*no_escape)(HInstruction*, HInstruction*));
 
+/*
+ * Performs partial escape analysis on the given instruction, typically a reference to an
+ * allocation. Rather than classifying the reference as a whole, the method collects every
+ * user through which the reference escapes (passed to a callee, stored to heap memory, or
+ * returned to the caller) into 'escapes', without duplicates. All other users only access
+ * the reference locally, so that a client may keep the allocation scalar replaced on paths
+ * without any escape and materialize it just before the escapes. The method returns false
+ * if the reference is not allocated in the method or has a user that prevents this, such
+ * as a merge into HPhi/HSelect, an alias through HBoundType/HNullCheck, or an unresolved
+ * field access.
+ */
+bool CalculatePartialEscape(HInstruction* reference, /*out*/ ArenaVector<HInstruction*>* escapes);
+
 }  // namespace art
 
 #endif  // ART_COMPILER_OPTIMIZING_ESCAPE_H_
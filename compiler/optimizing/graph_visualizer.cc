@@ -514,8 +514,19 @@ class HGraphVisualizerPrinter : public HGraphDelegateVisitor {
     StartAttributeStream("rounded") << std::boolalpha << hadd->IsRounded() << std::noboolalpha;
   }
 
+  void VisitVecReduce(HVecReduce* instruction) OVERRIDE {
+    switch (instruction->GetKind()) {
+      case HVecReduce::kSum: StartAttributeStream("kind") << "sum"; break;
+      case HVecReduce::kMin: StartAttributeStream("kind") << "min"; break;
+      case HVecReduce::kMax: StartAttributeStream("kind") << "max"; break;
+    }
+  }
+
   void VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instruction) OVERRIDE {
     StartAttributeStream("kind") << instruction->GetOpKind();
+    if (instruction->IsWidening()) {
+      StartAttributeStream("widening") << instruction->GetMulPackedType();
+    }
   }
 
 #if defined(ART_ENABLE_CODEGEN_arm) || defined(ART_ENABLE_CODEGEN_arm64)
@@ -361,6 +361,19 @@ void InductionVarRange::Replace(HInstruction* instruction,
   }
 }
 
+void InductionVarRange::ReplaceAll(HInstruction* fetch, HInstruction* replacement) {
+  for (auto& loop_info : induction_analysis_->induction_) {
+    for (auto& info : loop_info.second) {
+      ReplaceInduction(info.second, fetch, replacement);
+    }
+  }
+}
+
+bool InductionVarRange::IsClassified(HInstruction* instruction) const {
+  HLoopInformation* loop = instruction->GetBlock()->GetLoopInformation();
+  return loop != nullptr && induction_analysis_->LookupInfo(loop, instruction) != nullptr;
+}
+
 bool InductionVarRange::IsFinite(HLoopInformation* loop, /*out*/ int64_t* tc) const {
   HInductionVarAnalysis::InductionInfo *trip =
       induction_analysis_->LookupInfo(loop, GetLoopControl(loop));
@@ -132,6 +132,12 @@ class InductionVarRange {
    */
   void Replace(HInstruction* instruction, HInstruction* fetch, HInstruction* replacement);
 
+  /**
+   * Updates all matching fetches with the given replacement in the induction information
+   * of all loops, including trip-counts.
+   */
+  void ReplaceAll(HInstruction* fetch, HInstruction* replacement);
+
   /**
    * Incrementally updates induction information for just the given loop.
    */
@@ -150,6 +156,12 @@ class InductionVarRange {
     return induction_analysis_->LookupCycle(phi);
   }
 
+  /**
+   * Checks if the given instruction has been classified as an induction
+   * in its closest enveloping loop.
+   */
+  bool IsClassified(HInstruction* instruction) const;
+
   /**
    * Checks if header logic of a loop terminates. Sets trip-count tc if known.
    */
@@ -65,6 +65,18 @@ static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
+// A call site is considered cold when the profile shows it executed less than
+// 1/kColdCallSiteRatio times as often as the hottest call site of the same method.
+// Only small methods are inlined at cold call sites.
+static constexpr uint64_t kColdCallSiteRatio = 256;
+
+// When the profile knows how often each receiver of a virtual or interface call was
+// seen, only receivers accounting for at least 1/kDominantReceiverRatio of the calls
+// are guarded and inlined, at most kMaximumNumberOfDominantReceivers of them. Other
+// receivers use the original call.
+static constexpr uint64_t kDominantReceiverRatio = 10;
+static constexpr size_t kMaximumNumberOfDominantReceivers = 3;
+
 // We check for line numbers to make sure the DepthString implementation
 // aligns the output nicely.
 #define LOG_INTERNAL(msg) \
@@ -148,35 +160,61 @@ void HInliner::Run() {
   //   inline that method.
   const bool honor_inlining_directives = IsCompilingWithCoreImage();
 
-  // Keep a copy of all blocks when starting the visit.
-  ArenaVector<HBasicBlock*> blocks = graph_->GetReversePostOrder();
-  DCHECK(!blocks.empty());
+  // Keep a copy of all invokes when starting the visit.
   // Because we are changing the graph when inlining,
-  // we just iterate over the blocks of the outer method.
+  // we just iterate over the invokes of the outer method.
   // This avoids doing the inlining work again on the inlined blocks.
-  for (HBasicBlock* block : blocks) {
-    for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
-      HInstruction* next = instruction->GetNext();
-      HInvoke* call = instruction->AsInvoke();
+  ArenaVector<HInvoke*> calls(graph_->GetArena()->Adapter(kArenaAllocOptimization));
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInvoke* call = it.Current()->AsInvoke();
       // As long as the call is not intrinsified, it is worth trying to inline.
       if (call != nullptr && call->GetIntrinsic() == Intrinsics::kNone) {
-        if (honor_inlining_directives) {
-          // Debugging case: directives in method names control or assert on inlining.
-          std::string callee_name = outer_compilation_unit_.GetDexFile()->PrettyMethod(
-              call->GetDexMethodIndex(), /* with_signature */ false);
-          // Tests prevent inlining by having $noinline$ in their method names.
-          if (callee_name.find("$noinline$") == std::string::npos) {
-            if (!TryInline(call)) {
-              bool should_have_inlined = (callee_name.find("$inline$") != std::string::npos);
-              CHECK(!should_have_inlined) << "Could not inline " << callee_name;
-            }
-          }
-        } else {
-          // Normal case: try to inline.
-          TryInline(call);
+        calls.push_back(call);
+      }
+    }
+  }
+
+  // When the profile knows how often each call site executed, try the hottest call
+  // sites first so that they get the inlining budget, and only inline small methods
+  // at cold call sites. Inlining directives take precedence over the profile.
+  ArenaSafeMap<uint32_t, uint32_t> invoke_counts(
+      std::less<uint32_t>(), graph_->GetArena()->Adapter(kArenaAllocOptimization));
+  const bool use_invoke_counts = !honor_inlining_directives && GetInvokeCounts(&invoke_counts);
+  auto get_count = [&invoke_counts](HInvoke* call) {
+    auto it = invoke_counts.find(call->GetDexPc());
+    return (it == invoke_counts.end()) ? 0u : it->second;
+  };
+  uint64_t hottest_count = 0u;
+  if (use_invoke_counts) {
+    std::stable_sort(calls.begin(), calls.end(), [&get_count](HInvoke* lhs, HInvoke* rhs) {
+      return get_count(lhs) > get_count(rhs);
+    });
+    hottest_count = calls.empty() ? 0u : get_count(calls.front());
+  }
+
+  for (HInvoke* call : calls) {
+    if (honor_inlining_directives) {
+      // Debugging case: directives in method names control or assert on inlining.
+      std::string callee_name = outer_compilation_unit_.GetDexFile()->PrettyMethod(
+          call->GetDexMethodIndex(), /* with_signature */ false);
+      // Tests prevent inlining by having $noinline$ in their method names.
+      if (callee_name.find("$noinline$") == std::string::npos) {
+        if (!TryInline(call)) {
+          bool should_have_inlined = (callee_name.find("$inline$") != std::string::npos);
+          CHECK(!should_have_inlined) << "Could not inline " << callee_name;
         }
       }
-      instruction = next;
+    } else if (use_invoke_counts && get_count(call) * kColdCallSiteRatio < hottest_count) {
+      // Cold call site: only inline small methods, which do not grow the code.
+      inlining_budget_ = kMaximumNumberOfInstructionsForSmallMethod;
+      if (!TryInline(call)) {
+        MaybeRecordStat(kNotInlinedColdCallSite);
+      }
+      UpdateInliningBudget();
+    } else {
+      // Normal case: try to inline.
+      TryInline(call);
     }
   }
 }
@@ -480,9 +518,25 @@ bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
 
   StackHandleScope<1> hs(Thread::Current());
   Handle<mirror::ObjectArray<mirror::Class>> inline_cache;
+  ReceiverCounts receiver_counts;
   InlineCacheType inline_cache_type = Runtime::Current()->IsAotCompiler()
-      ? GetInlineCacheAOT(caller_dex_file, invoke_instruction, &hs, &inline_cache)
-      : GetInlineCacheJIT(invoke_instruction, &hs, &inline_cache);
+      ? GetInlineCacheAOT(caller_dex_file, invoke_instruction, &hs, &inline_cache, &receiver_counts)
+      : GetInlineCacheJIT(invoke_instruction, &hs, &inline_cache, &receiver_counts);
+
+  bool has_other_receivers = false;
+  if ((inline_cache_type == kInlineCachePolymorphic ||
+       inline_cache_type == kInlineCacheMegamorphic) &&
+      SelectDominantReceivers(inline_cache, receiver_counts, &has_other_receivers)) {
+    // Only the dominant receivers are left in the inline cache, ordered by frequency.
+    if (inline_cache->Get(0) == nullptr) {
+      inline_cache_type = kInlineCacheMegamorphic;
+    } else if (has_other_receivers) {
+      // Other receivers need the original call, which only polymorphic inlining keeps.
+      inline_cache_type = kInlineCachePolymorphic;
+    } else {
+      inline_cache_type = GetInlineCacheType(inline_cache);
+    }
+  }
 
   switch (inline_cache_type) {
     case kInlineCacheNoData: {
@@ -506,7 +560,8 @@ bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
       if (outermost_graph_->IsCompilingOsr()) {
         // If we are compiling OSR, we pretend this call is polymorphic, as we may come from the
         // interpreter and it may have seen different receiver types.
-        return TryInlinePolymorphicCall(invoke_instruction, resolved_method, inline_cache);
+        return TryInlinePolymorphicCall(
+            invoke_instruction, resolved_method, inline_cache, /* has_other_receivers */ false);
       } else {
         return TryInlineMonomorphicCall(invoke_instruction, resolved_method, inline_cache);
       }
@@ -514,7 +569,8 @@ bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
 
     case kInlineCachePolymorphic: {
       MaybeRecordStat(kPolymorphicCall);
-      return TryInlinePolymorphicCall(invoke_instruction, resolved_method, inline_cache);
+      return TryInlinePolymorphicCall(
+          invoke_instruction, resolved_method, inline_cache, has_other_receivers);
     }
 
     case kInlineCacheMegamorphic: {
@@ -537,10 +593,55 @@ bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
   UNREACHABLE();
 }
 
+bool HInliner::GetInvokeCounts(/*out*/ ArenaSafeMap<uint32_t, uint32_t>* invoke_counts) {
+  ScopedObjectAccess soa(Thread::Current());
+  bool has_counts = false;
+  if (Runtime::Current()->UseJitCompilation()) {
+    ArtMethod* caller = graph_->GetArtMethod();
+    if (caller == nullptr || caller->IsNative()) {
+      return false;
+    }
+    ScopedProfilingInfoInlineUse spiis(caller, Thread::Current());
+    ProfilingInfo* profiling_info = spiis.GetProfilingInfo();
+    if (profiling_info == nullptr) {
+      return false;
+    }
+    for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+      for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+        HInvoke* call = it.Current()->AsInvoke();
+        if (call != nullptr) {
+          uint32_t count = profiling_info->GetInvokeCount(call->GetDexPc());
+          invoke_counts->Overwrite(call->GetDexPc(), count);
+          has_counts = has_counts || (count != 0u);
+        }
+      }
+    }
+  } else if (Runtime::Current()->IsAotCompiler()) {
+    const ProfileCompilationInfo* pci = compiler_driver_->GetProfileCompilationInfo();
+    if (pci == nullptr) {
+      return false;
+    }
+    const DexFile& caller_dex_file = *caller_compilation_unit_.GetDexFile();
+    ProfileCompilationInfo::OfflineProfileMethodInfo offline_profile;
+    if (!pci->GetMethod(caller_dex_file.GetLocation(),
+                        caller_dex_file.GetLocationChecksum(),
+                        caller_compilation_unit_.GetDexMethodIndex(),
+                        &offline_profile)) {
+      return false;
+    }
+    for (const auto& invoke_count_it : offline_profile.invoke_counts) {
+      invoke_counts->Overwrite(invoke_count_it.first, invoke_count_it.second);
+      has_counts = has_counts || (invoke_count_it.second != 0u);
+    }
+  }
+  return has_counts;
+}
+
 HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
     HInvoke* invoke_instruction,
     StackHandleScope<1>* hs,
-    /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache)
+    /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache,
+    /*out*/ReceiverCounts* receiver_counts)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(Runtime::Current()->UseJitCompilation());
 
@@ -561,7 +662,9 @@ HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
   } else {
     Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(
         *profiling_info->GetInlineCache(invoke_instruction->GetDexPc()),
-        *inline_cache);
+        *inline_cache,
+        receiver_counts->class_counts);
+    receiver_counts->invoke_count = profiling_info->GetInvokeCount(invoke_instruction->GetDexPc());
     return GetInlineCacheType(*inline_cache);
   }
 }
@@ -570,7 +673,8 @@ HInliner::InlineCacheType HInliner::GetInlineCacheAOT(
     const DexFile& caller_dex_file,
     HInvoke* invoke_instruction,
     StackHandleScope<1>* hs,
-    /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache)
+    /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache,
+    /*out*/ReceiverCounts* receiver_counts)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(Runtime::Current()->IsAotCompiler());
   const ProfileCompilationInfo* pci = compiler_driver_->GetProfileCompilationInfo();
@@ -594,19 +698,25 @@ HInliner::InlineCacheType HInliner::GetInlineCacheAOT(
   } else {
     return ExtractClassesFromOfflineProfile(invoke_instruction,
                                             offline_profile,
-                                            *inline_cache);
+                                            *inline_cache,
+                                            receiver_counts);
   }
 }
 
 HInliner::InlineCacheType HInliner::ExtractClassesFromOfflineProfile(
     const HInvoke* invoke_instruction,
     const ProfileCompilationInfo::OfflineProfileMethodInfo& offline_profile,
-    /*out*/Handle<mirror::ObjectArray<mirror::Class>> inline_cache)
+    /*out*/Handle<mirror::ObjectArray<mirror::Class>> inline_cache,
+    /*out*/ReceiverCounts* receiver_counts)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   const auto it = offline_profile.inline_caches.find(invoke_instruction->GetDexPc());
   if (it == offline_profile.inline_caches.end()) {
     return kInlineCacheUninitialized;
   }
+  const auto count_it = offline_profile.invoke_counts.find(invoke_instruction->GetDexPc());
+  if (count_it != offline_profile.invoke_counts.end()) {
+    receiver_counts->invoke_count = count_it->second;
+  }
 
   const ProfileCompilationInfo::DexPcData& dex_pc_data = it->second;
 
@@ -653,6 +763,7 @@ HInliner::InlineCacheType HInliner::ExtractClassesFromOfflineProfile(
           dex_cache,
           caller_compilation_unit_.GetClassLoader().Get());
     if (clazz != nullptr) {
+      receiver_counts->class_counts[ic_index] = dex_pc_data.GetClassCount(class_ref);
       inline_cache->Set(ic_index++, clazz);
     } else {
       VLOG(compiler) << "Could not resolve class from inline cache in AOT mode "
@@ -666,6 +777,57 @@ HInliner::InlineCacheType HInliner::ExtractClassesFromOfflineProfile(
   return GetInlineCacheType(inline_cache);
 }
 
+bool HInliner::SelectDominantReceivers(Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                       const ReceiverCounts& receiver_counts,
+                                       /*out*/bool* has_other_receivers) {
+  const uint32_t* class_counts = receiver_counts.class_counts;
+  size_t number_of_receivers = 0;
+  uint64_t receivers_count = 0;
+  while (number_of_receivers < InlineCache::kIndividualCacheSize &&
+         classes->Get(number_of_receivers) != nullptr) {
+    receivers_count += class_counts[number_of_receivers];
+    ++number_of_receivers;
+  }
+  if (receivers_count == 0u) {
+    return false;
+  }
+  // Receivers that did not fit in the inline cache are only accounted for in the
+  // invoke count.
+  uint64_t total_count = std::max<uint64_t>(receivers_count, receiver_counts.invoke_count);
+
+  size_t order[InlineCache::kIndividualCacheSize];
+  for (size_t i = 0; i < number_of_receivers; ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order, order + number_of_receivers, [class_counts](size_t a, size_t b) {
+    return class_counts[a] > class_counts[b];
+  });
+
+  // No suspension point below, so the classes can be kept in raw pointers while
+  // `classes` is rewritten.
+  ObjPtr<mirror::Class> dominant_classes[InlineCache::kIndividualCacheSize];
+  size_t number_of_dominant_receivers = 0;
+  uint64_t dominant_count = 0;
+  for (size_t i = 0; i < number_of_receivers; ++i) {
+    uint32_t count = class_counts[order[i]];
+    if (number_of_dominant_receivers == kMaximumNumberOfDominantReceivers ||
+        count * kDominantReceiverRatio < total_count) {
+      break;
+    }
+    dominant_classes[number_of_dominant_receivers++] = classes->Get(order[i]);
+    dominant_count += count;
+  }
+  for (size_t i = 0; i < number_of_receivers; ++i) {
+    classes->Set(i, i < number_of_dominant_receivers ? dominant_classes[i] : nullptr);
+  }
+
+  // A full inline cache means more receivers than it can hold may have been seen.
+  *has_other_receivers = (number_of_dominant_receivers != number_of_receivers) ||
+      (number_of_receivers == InlineCache::kIndividualCacheSize) ||
+      (receiver_counts.invoke_count > dominant_count);
+  return true;
+}
+
 HInstanceFieldGet* HInliner::BuildGetReceiverClass(ClassLinker* class_linker,
                                                    HInstruction* receiver,
                                                    uint32_t dex_pc) const {
@@ -863,11 +1025,13 @@ HInstruction* HInliner::AddTypeGuard(HInstruction* receiver,
 
 bool HInliner::TryInlinePolymorphicCall(HInvoke* invoke_instruction,
                                         ArtMethod* resolved_method,
-                                        Handle<mirror::ObjectArray<mirror::Class>> classes) {
+                                        Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                        bool has_other_receivers) {
   DCHECK(invoke_instruction->IsInvokeVirtual() || invoke_instruction->IsInvokeInterface())
       << invoke_instruction->DebugName();
 
-  if (TryInlinePolymorphicCallToSameTarget(invoke_instruction, resolved_method, classes)) {
+  if (TryInlinePolymorphicCallToSameTarget(
+          invoke_instruction, resolved_method, classes, has_other_receivers)) {
     return true;
   }
 
@@ -914,7 +1078,8 @@ bool HInliner::TryInlinePolymorphicCall(HInvoke* invoke_instruction,
 
       // If we have inlined all targets before, and this receiver is the last seen,
       // we deoptimize instead of keeping the original invoke instruction.
-      bool deoptimize = all_targets_inlined &&
+      bool deoptimize = !has_other_receivers &&
+          all_targets_inlined &&
           (i != InlineCache::kIndividualCacheSize - 1) &&
           (classes->Get(i + 1) == nullptr);
 
@@ -1042,7 +1207,8 @@ void HInliner::CreateDiamondPatternForPolymorphicInline(HInstruction* compare,
 bool HInliner::TryInlinePolymorphicCallToSameTarget(
     HInvoke* invoke_instruction,
     ArtMethod* resolved_method,
-    Handle<mirror::ObjectArray<mirror::Class>> classes) {
+    Handle<mirror::ObjectArray<mirror::Class>> classes,
+    bool has_other_receivers) {
   // This optimization only works under JIT for now.
   if (!Runtime::Current()->UseJitCompilation()) {
     return false;
@@ -1130,7 +1296,8 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
   bb_cursor->InsertInstructionAfter(class_table_get, receiver_class);
   bb_cursor->InsertInstructionAfter(compare, class_table_get);
 
-  if (outermost_graph_->IsCompilingOsr()) {
+  if (outermost_graph_->IsCompilingOsr() || has_other_receivers) {
+    // Other receivers may call other targets, and must use the original call.
     CreateDiamondPatternForPolymorphicInline(compare, return_replacement, invoke_instruction);
   } else {
     HDeoptimize* deoptimize = new (graph_->GetArena()) HDeoptimize(
@@ -1601,6 +1768,7 @@ bool HInliner::TryBuildAndInlineHelper(HInvoke* invoke_instruction,
       invoke_type,
       graph_->IsDebuggable(),
       /* osr */ false,
+      /* baseline */ false,
       caller_instruction_counter);
   callee_graph->SetArtMethod(resolved_method);
 
@@ -21,6 +21,7 @@
 #include "invoke_type.h"
 #include "optimization.h"
 #include "jit/profile_compilation_info.h"
+#include "jit/profiling_info.h"
 
 namespace art {
 
@@ -73,8 +74,24 @@ class HInliner : public HOptimization {
     kInlineCacheMissingTypes = 5
   };
 
+  // How often the receivers of an inline cache have been seen, according to the profile.
+  struct ReceiverCounts {
+    ReceiverCounts() : class_counts(), invoke_count(0u) {}
+
+    // Number of times each class of the inline cache was seen, in the same order.
+    uint32_t class_counts[InlineCache::kIndividualCacheSize];
+    // Number of times the invoke was executed, which includes receivers that did
+    // not fit in the inline cache. 0 if unknown.
+    uint32_t invoke_count;
+  };
+
   bool TryInline(HInvoke* invoke_instruction);
 
+  // Collect the number of times each invoke of the method being inlined into has been
+  // executed, keyed by dex pc, from the JIT profiling info or the AOT profile.
+  // Return false if there are no such counts.
+  bool GetInvokeCounts(/*out*/ ArenaSafeMap<uint32_t, uint32_t>* invoke_counts);
+
   // Try to inline `resolved_method` in place of `invoke_instruction`. `do_rtp` is whether
   // reference type propagation can run after the inlining. If the inlining is successful, this
   // method will replace and remove the `invoke_instruction`. If `cha_devirtualize` is true,
@@ -134,7 +151,8 @@ class HInliner : public HOptimization {
   InlineCacheType GetInlineCacheJIT(
       HInvoke* invoke_instruction,
       StackHandleScope<1>* hs,
-      /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache)
+      /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache,
+      /*out*/ReceiverCounts* receiver_counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Try getting the inline cache from AOT offline profile.
@@ -143,7 +161,8 @@ class HInliner : public HOptimization {
   InlineCacheType GetInlineCacheAOT(const DexFile& caller_dex_file,
       HInvoke* invoke_instruction,
       StackHandleScope<1>* hs,
-      /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache)
+      /*out*/Handle<mirror::ObjectArray<mirror::Class>>* inline_cache,
+      /*out*/ReceiverCounts* receiver_counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Extract the mirror classes from the offline profile and add them to the `inline_cache`.
@@ -152,7 +171,8 @@ class HInliner : public HOptimization {
   InlineCacheType ExtractClassesFromOfflineProfile(
       const HInvoke* invoke_instruction,
       const ProfileCompilationInfo::OfflineProfileMethodInfo& offline_profile,
-      /*out*/Handle<mirror::ObjectArray<mirror::Class>> inline_cache)
+      /*out*/Handle<mirror::ObjectArray<mirror::Class>> inline_cache,
+      /*out*/ReceiverCounts* receiver_counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Compute the inline cache type.
@@ -169,15 +189,28 @@ class HInliner : public HOptimization {
                                 Handle<mirror::ObjectArray<mirror::Class>> classes)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Try to inline targets of a polymorphic call.
+  // Try to inline targets of a polymorphic call. If `has_other_receivers` is true,
+  // receivers not in `classes` have been seen, so the original call is kept as
+  // fallback instead of deoptimizing.
   bool TryInlinePolymorphicCall(HInvoke* invoke_instruction,
                                 ArtMethod* resolved_method,
-                                Handle<mirror::ObjectArray<mirror::Class>> classes)
+                                Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                bool has_other_receivers)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   bool TryInlinePolymorphicCallToSameTarget(HInvoke* invoke_instruction,
                                             ArtMethod* resolved_method,
-                                            Handle<mirror::ObjectArray<mirror::Class>> classes)
+                                            Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                            bool has_other_receivers)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Reorder `classes` by decreasing frequency and only keep the dominant receivers,
+  // clearing the other entries. Sets `has_other_receivers` to whether receivers not
+  // kept in `classes` have been seen. Returns false, leaving `classes` untouched, if
+  // the profile has no receiver frequencies.
+  static bool SelectDominantReceivers(Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                      const ReceiverCounts& receiver_counts,
+                                      /*out*/bool* has_other_receivers)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Try CHA-based devirtualization to change virtual method calls into
@@ -22,6 +22,7 @@
 #include "dex_instruction-inl.h"
 #include "driver/compiler_options.h"
 #include "imtable-inl.h"
+#include "optimizing_compiler.h"
 #include "sharpening.h"
 #include "scoped_thread_state_change-inl.h"
 
@@ -662,6 +663,8 @@ static InvokeType GetInvokeTypeFromOpCode(Instruction::Code opcode) {
       return kDirect;
     case Instruction::INVOKE_VIRTUAL:
     case Instruction::INVOKE_VIRTUAL_QUICK:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
     case Instruction::INVOKE_VIRTUAL_RANGE:
     case Instruction::INVOKE_VIRTUAL_RANGE_QUICK:
       return kVirtual;
@@ -989,6 +992,11 @@ bool HInstructionBuilder::IsInitialized(Handle<mirror::Class> cls) const {
   // check whether the class is in an image for the AOT compilation.
   if (cls->IsInitialized() &&
       compiler_driver_->CanAssumeClassIsLoaded(cls.Get())) {
+    if (IsCompilingForPersistentJitCodeCache()) {
+      // The class may not be initialized yet in the run that installs the persisted code,
+      // which needs to check it.
+      graph_->AddAssumedInitializedClass(TypeReference(&cls->GetDexFile(), cls->GetDexTypeIndex()));
+    }
     return true;
   }
 
@@ -1915,9 +1923,11 @@ bool HInstructionBuilder::ProcessDexInstruction(const Instruction& instruction,
     case Instruction::INVOKE_STATIC:
     case Instruction::INVOKE_SUPER:
     case Instruction::INVOKE_VIRTUAL:
-    case Instruction::INVOKE_VIRTUAL_QUICK: {
+    case Instruction::INVOKE_VIRTUAL_QUICK:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT: {
       uint16_t method_idx;
-      if (instruction.Opcode() == Instruction::INVOKE_VIRTUAL_QUICK) {
+      if (instruction.IsQuickened()) {
         if (!CanDecodeQuickenedInfo()) {
           return false;
         }
@@ -2591,12 +2601,16 @@ bool HInstructionBuilder::ProcessDexInstruction(const Instruction& instruction,
 
     case Instruction::IGET:
     case Instruction::IGET_QUICK:
+    case Instruction::IGET_QUICK_IF_EQZ:
+    case Instruction::IGET_QUICK_IF_NEZ:
     case Instruction::IGET_WIDE:
     case Instruction::IGET_WIDE_QUICK:
     case Instruction::IGET_OBJECT:
     case Instruction::IGET_OBJECT_QUICK:
     case Instruction::IGET_BOOLEAN:
     case Instruction::IGET_BOOLEAN_QUICK:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_EQZ:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_NEZ:
     case Instruction::IGET_BYTE:
     case Instruction::IGET_BYTE_QUICK:
     case Instruction::IGET_CHAR:
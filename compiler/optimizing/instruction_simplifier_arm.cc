@@ -15,6 +15,7 @@
  */
 
 #include "code_generator.h"
+#include "code_generator_arm_vixl.h"
 #include "common_arm.h"
 #include "instruction_simplifier_arm.h"
 #include "instruction_simplifier_shared.h"
@@ -235,5 +236,12 @@ void InstructionSimplifierArmVisitor::VisitUShr(HUShr* instruction) {
   }
 }
 
+void InstructionSimplifierArmVisitor::VisitVecMul(HVecMul* instruction) {
+  // Vector operations are only generated for the VIXL-based backend.
+  if (kArmUseVIXL32 && TryCombineVecMultiplyAccumulate(instruction, kArm)) {
+    RecordSimplification();
+  }
+}
+
 }  // namespace arm
 }  // namespace art
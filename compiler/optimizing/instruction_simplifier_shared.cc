@@ -282,6 +282,8 @@ bool TryExtractArrayAccessAddress(HInstruction* access,
 bool TryCombineVecMultiplyAccumulate(HVecMul* mul, InstructionSet isa) {
   Primitive::Type type = mul->GetPackedType();
   switch (isa) {
+    case kArm:
+    case kThumb2:
     case kArm64:
       if (!(type == Primitive::kPrimByte ||
             type == Primitive::kPrimChar ||
@@ -1114,37 +1114,352 @@ class LSEVisitor : public HGraphVisitor {
   DISALLOW_COPY_AND_ASSIGN(LSEVisitor);
 };
 
-void LoadStoreElimination::Run() {
-  if (graph_->IsDebuggable() || graph_->HasTryCatch()) {
-    // Debugger may set heap values or trigger deoptimization of callers.
-    // Try/catch support not implemented yet.
-    // Skip this optimization.
-    return;
+// A PartialEscapeMaterializer moves allocations that only escape on some paths to
+// those paths. An allocation that escapes is materialized just before each escape
+// that is not dominated by another escape: a copy of the allocation is created there
+// and initialized with the field values of the original allocation at that point.
+// All uses dominated by the copy are then redirected to it, which leaves only local
+// field accesses on the original allocation, so that it becomes a singleton that is
+// eliminated on all other paths by the load/store elimination proper.
+class PartialEscapeMaterializer : public ValueObject {
+ public:
+  PartialEscapeMaterializer(HGraph* graph, const SideEffectsAnalysis& side_effects)
+      : graph_(graph),
+        side_effects_(side_effects),
+        escapes_(graph->GetArena()->Adapter(kArenaAllocLSE)),
+        points_(graph->GetArena()->Adapter(kArenaAllocLSE)),
+        users_(graph->GetArena()->Adapter(kArenaAllocLSE)),
+        stores_(graph->GetArena()->Adapter(kArenaAllocLSE)),
+        worklist_(graph->GetArena()->Adapter(kArenaAllocLSE)),
+        visited_(graph->GetArena(), graph->GetBlocks().size(), false, kArenaAllocLSE) {}
+
+  // Materializes the given allocation on the paths where it escapes, if possible.
+  // Returns true if the graph has been changed.
+  bool TryMaterialize(HNewInstance* new_instance) {
+    if (new_instance->IsFinalizable() ||
+        new_instance->NeedsChecks() ||
+        !CalculatePartialEscape(new_instance, &escapes_) ||
+        escapes_.empty() ||
+        escapes_.size() > kMaxPartialEscapes) {
+      return false;
+    }
+    // Find the materialization points, i.e. the escapes not dominated by another escape.
+    // Escaping right after the allocation leaves no path to eliminate the allocation on.
+    points_.clear();
+    for (HInstruction* escape : escapes_) {
+      if (escape->GetBlock() == new_instance->GetBlock()) {
+        return false;
+      }
+      bool is_dominated = false;
+      for (HInstruction* other : escapes_) {
+        if (other != escape && other->StrictlyDominates(escape)) {
+          is_dominated = true;
+          break;
+        }
+      }
+      if (!is_dominated) {
+        points_.push_back(escape);
+      }
+    }
+    // Materializing in a loop must not introduce the first heap write in that loop,
+    // since side effects analysis is not updated for the new stores.
+    for (HInstruction* point : points_) {
+      HLoopInformation* loop_info = point->GetBlock()->GetLoopInformation();
+      if (loop_info != nullptr &&
+          !side_effects_.GetLoopEffects(loop_info->GetHeader()).DoesAnyWrite()) {
+        return false;
+      }
+    }
+    // Ensure each point executes at most once per allocation, and no
+    // point executes after another point without going through it.
+    for (HInstruction* point : points_) {
+      for (HInstruction* other : points_) {
+        if (CanReach(point, other, new_instance->GetBlock())) {
+          return false;
+        }
+      }
+    }
+    // Collect all users. A user that executes after a point must be dominated by that
+    // point, so that it can use the materialized allocation. All other users, which
+    // keep using the original allocation, must be local field accesses.
+    users_.clear();
+    stores_.clear();
+    for (const HUseListNode<HInstruction*>& use : new_instance->GetUses()) {
+      HInstruction* user = use.GetUser();
+      HInstruction* point = nullptr;
+      if (!FindPoint(user, new_instance->GetBlock(), &point)) {
+        return false;
+      } else if (point == nullptr) {
+        if (user->IsInstanceFieldSet() && user->InputAt(0) == new_instance) {
+          DCHECK_NE(user->InputAt(1), new_instance);  // an escape
+          stores_.push_back(user);
+        } else if (!user->IsInstanceFieldGet()) {
+          return false;
+        }
+      }
+      users_.push_back(std::make_pair(user, point));
+    }
+    // An environment user is allowed after a point without being dominated by it, since
+    // only deoptimization would observe the difference. Such uses are dropped instead.
+    for (const HUseListNode<HEnvironment*>& use : new_instance->GetEnvUses()) {
+      if (use.GetUser()->GetHolder()->IsDeoptimize()) {
+        return false;
+      }
+    }
+    // Ensure the field values at each point are known: any store that
+    // may execute before a point must dominate that point.
+    for (HInstruction* store : stores_) {
+      if (store->AsInstanceFieldSet()->IsVolatile()) {
+        return false;
+      }
+      for (HInstruction* point : points_) {
+        if (!store->StrictlyDominates(point) &&
+            CanReach(store, point, new_instance->GetBlock())) {
+          return false;
+        }
+      }
+    }
+    // All tests passed. Materialize the allocation at each point.
+    for (HInstruction* point : points_) {
+      Materialize(new_instance, point);
+    }
+    return true;
   }
-  HeapLocationCollector heap_location_collector(graph_);
-  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
-    heap_location_collector.VisitBasicBlock(block);
+
+ private:
+  // Maximum number of escapes of a single allocation that are considered.
+  static constexpr size_t kMaxPartialEscapes = 4;
+
+  // Detects if 'to' may execute after 'from' on a path that does not pass through
+  // 'stop', the block of the allocation, where the allocation would be executed again.
+  bool CanReach(HInstruction* from, HInstruction* to, HBasicBlock* stop) {
+    if (from->GetBlock() == to->GetBlock() && from->StrictlyDominates(to)) {
+      return true;
+    }
+    visited_.ClearAllBits();
+    worklist_.clear();
+    for (HBasicBlock* successor : from->GetBlock()->GetSuccessors()) {
+      worklist_.push_back(successor);
+    }
+    while (!worklist_.empty()) {
+      HBasicBlock* block = worklist_.back();
+      worklist_.pop_back();
+      if (block == stop || visited_.IsBitSet(block->GetBlockId())) {
+        continue;
+      } else if (block == to->GetBlock()) {
+        return true;
+      }
+      visited_.SetBit(block->GetBlockId());
+      for (HBasicBlock* successor : block->GetSuccessors()) {
+        worklist_.push_back(successor);
+      }
+    }
+    return false;
   }
-  if (heap_location_collector.GetNumberOfHeapLocations() > kMaxNumberOfHeapLocations) {
+
+  // Finds the point that is or dominates the given user. Sets 'point' to null if the
+  // user is not reachable from any point. Returns false if the user is reachable from
+  // a point without being dominated by it.
+  bool FindPoint(HInstruction* user, HBasicBlock* stop, /*out*/ HInstruction** point) {
+    *point = nullptr;
+    for (HInstruction* p : points_) {
+      if (p == user || p->StrictlyDominates(user)) {
+        *point = p;
+        return true;
+      }
+    }
+    for (HInstruction* p : points_) {
+      if (CanReach(p, user, stop)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Materialize(HNewInstance* new_instance, HInstruction* point) {
+    ArenaAllocator* arena = graph_->GetArena();
+    HBasicBlock* block = point->GetBlock();
+    // Allocate a copy. Since it replaces the original allocation, the original
+    // environment is used, which describes a state that dominates the point.
+    HNewInstance* copy = new (arena) HNewInstance(new_instance->InputAt(0),
+                                                  new_instance->GetDexPc(),
+                                                  new_instance->GetTypeIndex(),
+                                                  new_instance->GetDexFile(),
+                                                  new_instance->IsFinalizable(),
+                                                  new_instance->GetEntrypoint());
+    block->InsertInstructionBefore(copy, point);
+    copy->CopyEnvironmentFrom(new_instance->GetEnvironment());
+    copy->SetReferenceTypeInfo(new_instance->GetReferenceTypeInfo());
+    // Initialize each stored field with the value of the last store that dominates the point.
+    bool has_stores = false;
+    for (size_t i = 0; i < stores_.size(); i++) {
+      HInstanceFieldSet* store = stores_[i]->AsInstanceFieldSet();
+      if (!store->StrictlyDominates(point)) {
+        continue;
+      }
+      const FieldInfo& field_info = store->GetFieldInfo();
+      bool is_last = true;
+      for (size_t j = 0; j < stores_.size(); j++) {
+        HInstanceFieldSet* other = stores_[j]->AsInstanceFieldSet();
+        if (other != store &&
+            other->GetFieldOffset().SizeValue() == field_info.GetFieldOffset().SizeValue() &&
+            other->StrictlyDominates(point) &&
+            store->StrictlyDominates(other)) {
+          is_last = false;
+          break;
+        }
+      }
+      if (is_last) {
+        HInstanceFieldSet* init = new (arena) HInstanceFieldSet(
+            copy,
+            store->GetValue(),
+            field_info.GetField(),
+            field_info.GetFieldType(),
+            field_info.GetFieldOffset(),
+            field_info.IsVolatile(),
+            field_info.GetFieldIndex(),
+            field_info.GetDeclaringClassDefIndex(),
+            field_info.GetDexFile(),
+            store->GetDexPc());
+        if (!store->GetValueCanBeNull()) {
+          init->ClearValueCanBeNull();
+        }
+        block->InsertInstructionBefore(init, point);
+        has_stores = true;
+      }
+    }
+    // Publish the initialized fields before the copy escapes, as the
+    // constructor would have done for the original allocation.
+    if (has_stores) {
+      block->InsertInstructionBefore(new (arena) HMemoryBarrier(kStoreStore), point);
+    }
+    // Redirect all users at or dominated by the point.
+    for (const std::pair<HInstruction*, HInstruction*>& user : users_) {
+      if (user.second == point) {
+        HInputsRef inputs = user.first->GetInputs();
+        for (size_t i = 0; i < inputs.size(); i++) {
+          if (inputs[i] == new_instance) {
+            user.first->ReplaceInput(copy, i);
+          }
+        }
+      }
+    }
+    // Redirect environment uses dominated by the point, and drop
+    // the ones that execute after the point otherwise.
+    for (auto it = new_instance->GetEnvUses().begin(); it != new_instance->GetEnvUses().end();) {
+      HEnvironment* env = it->GetUser();
+      size_t index = it->GetIndex();
+      ++it;  // increment prior to removal
+      HInstruction* holder = env->GetHolder();
+      if (holder == point || point->StrictlyDominates(holder)) {
+        env->RemoveAsUserOfInput(index);
+        env->SetRawEnvAt(index, copy);
+        copy->AddEnvUseAt(env, index);
+      } else if (CanReach(point, holder, new_instance->GetBlock())) {
+        env->RemoveAsUserOfInput(index);
+        env->SetRawEnvAt(index, nullptr);
+      }
+    }
+  }
+
+  HGraph* const graph_;
+  const SideEffectsAnalysis& side_effects_;
+
+  // Temporary bookkeeping of the allocation being materialized.
+  ArenaVector<HInstruction*> escapes_;
+  ArenaVector<HInstruction*> points_;
+  ArenaVector<std::pair<HInstruction*, HInstruction*>> users_;  // user and its point, if any
+  ArenaVector<HInstruction*> stores_;  // stores that keep using the original allocation
+
+  // Temporary bookkeeping of reachability.
+  ArenaVector<HBasicBlock*> worklist_;
+  ArenaBitVector visited_;
+
+  DISALLOW_COPY_AND_ASSIGN(PartialEscapeMaterializer);
+};
+
+// Collects all heap locations. Returns false if load/store elimination should be skipped.
+static bool CollectHeapLocations(HGraph* graph, HeapLocationCollector* heap_location_collector) {
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    heap_location_collector->VisitBasicBlock(block);
+  }
+  if (heap_location_collector->GetNumberOfHeapLocations() > kMaxNumberOfHeapLocations) {
     // Bail out if there are too many heap locations to deal with.
-    return;
+    return false;
   }
-  if (!heap_location_collector.HasHeapStores()) {
+  if (!heap_location_collector->HasHeapStores()) {
     // Without heap stores, this pass would act mostly as GVN on heap accesses.
-    return;
+    return false;
   }
-  if (heap_location_collector.HasVolatile() || heap_location_collector.HasMonitorOps()) {
+  if (heap_location_collector->HasVolatile() || heap_location_collector->HasMonitorOps()) {
     // Don't do load/store elimination if the method has volatile field accesses or
     // monitor operations, for now.
     // TODO: do it right.
-    return;
+    return false;
+  }
+  heap_location_collector->BuildAliasingMatrix();
+  return true;
+}
+
+// Materializes allocations that escape on some paths only. Returns true if any
+// allocation has been materialized.
+static bool MaterializePartialEscapes(HGraph* graph,
+                                      const SideEffectsAnalysis& side_effects,
+                                      const HeapLocationCollector& heap_location_collector) {
+  // Collect the escaping allocations with field accesses in a deterministic order.
+  ArenaVector<HNewInstance*> candidates(graph->GetArena()->Adapter(kArenaAllocLSE));
+  for (size_t i = 0; i < heap_location_collector.GetNumberOfHeapLocations(); i++) {
+    ReferenceInfo* ref_info = heap_location_collector.GetHeapLocation(i)->GetReferenceInfo();
+    HInstruction* ref = ref_info->GetReference();
+    if (ref->IsNewInstance() &&
+        !ref_info->IsSingleton() &&
+        std::find(candidates.begin(), candidates.end(), ref) == candidates.end()) {
+      candidates.push_back(ref->AsNewInstance());
+    }
+  }
+  bool materialized = false;
+  PartialEscapeMaterializer materializer(graph, side_effects);
+  for (HNewInstance* new_instance : candidates) {
+    if (materializer.TryMaterialize(new_instance)) {
+      materialized = true;
+    }
   }
-  heap_location_collector.BuildAliasingMatrix();
-  LSEVisitor lse_visitor(graph_, heap_location_collector, side_effects_);
-  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+  return materialized;
+}
+
+static void EliminateLoadsAndStores(HGraph* graph,
+                                    const SideEffectsAnalysis& side_effects,
+                                    const HeapLocationCollector& heap_location_collector) {
+  LSEVisitor lse_visitor(graph, heap_location_collector, side_effects);
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
     lse_visitor.VisitBasicBlock(block);
   }
   lse_visitor.RemoveInstructions();
 }
 
+void LoadStoreElimination::Run() {
+  if (graph_->IsDebuggable() || graph_->HasTryCatch()) {
+    // Debugger may set heap values or trigger deoptimization of callers.
+    // Try/catch support not implemented yet.
+    // Skip this optimization.
+    return;
+  }
+  HeapLocationCollector heap_location_collector(graph_);
+  if (!CollectHeapLocations(graph_, &heap_location_collector)) {
+    return;
+  }
+  // Materialization drops environment uses that OSR entry may rely on.
+  if (!graph_->IsCompilingOsr() &&
+      MaterializePartialEscapes(graph_, side_effects_, heap_location_collector)) {
+    // Materialization changes the references and their escapes,
+    // so the heap locations are collected again.
+    HeapLocationCollector materialized_collector(graph_);
+    if (CollectHeapLocations(graph_, &materialized_collector)) {
+      EliminateLoadsAndStores(graph_, side_effects_, materialized_collector);
+    }
+    return;
+  }
+  EliminateLoadsAndStores(graph_, side_effects_, heap_location_collector);
+}
+
 }  // namespace art
@@ -26,11 +26,18 @@
 #include "driver/compiler_driver.h"
 #include "linear_order.h"
 
+#ifdef ART_ENABLE_CODEGEN_arm
+#include "code_generator_arm_vixl.h"
+#endif
+
 namespace art {
 
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
+// Maximum number of runtime tests that may be generated to version a vector loop.
+static constexpr size_t kMaxVectorRuntimeTests = 4;
+
 // Remove the instruction from the graph. A bit more elaborate than the usual
 // instruction removal, since there may be a cycle in the use structure.
 static void RemoveFromCycle(HInstruction* instruction) {
@@ -178,6 +185,54 @@ static bool HasVectorRestrictions(uint64_t restrictions, uint64_t tested) {
   return (restrictions & tested) != 0;
 }
 
+// Detect a reduction x = x op y, with the phi x used exactly once as operand.
+static bool HasReductionFormat(HInstruction* reduction, HInstruction* phi) {
+  if (reduction->IsAdd()) {
+    return (reduction->InputAt(0) == phi) != (reduction->InputAt(1) == phi);
+  } else if (reduction->IsSub()) {
+    return reduction->InputAt(0) == phi && reduction->InputAt(1) != phi;
+  } else if (reduction->IsInvokeStaticOrDirect()) {
+    switch (reduction->AsInvokeStaticOrDirect()->GetIntrinsic()) {
+      case Intrinsics::kMathMinIntInt:
+      case Intrinsics::kMathMaxIntInt:
+        return (reduction->InputAt(0) == phi) != (reduction->InputAt(1) == phi);
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+// Translate the operation of a vectorized reduction into the kind of its final reduction.
+static HVecReduce::ReductionKind GetReductionKind(HInstruction* reduction) {
+  if (reduction->IsVecAdd() || reduction->IsVecSub() || reduction->IsVecMultiplyAccumulate()) {
+    return HVecReduce::kSum;
+  } else if (reduction->IsVecMin()) {
+    return HVecReduce::kMin;
+  } else if (reduction->IsVecMax()) {
+    return HVecReduce::kMax;
+  }
+  LOG(FATAL) << "Unsupported SIMD reduction";
+  UNREACHABLE();
+}
+
+// Detect an environment of an instruction inside the loop-body that describes the same
+// (possibly inlined) frames as the environment of the loop header, which allows reusing
+// the latter for a copy of the instruction.
+static bool HasSameFrames(HEnvironment* env, HEnvironment* header_env) {
+  if (env->GetMethod() != header_env->GetMethod()) {
+    return false;
+  }
+  for (env = env->GetParent(), header_env = header_env->GetParent();
+       env != nullptr && header_env != nullptr;
+       env = env->GetParent(), header_env = header_env->GetParent()) {
+    if (env->GetMethod() != header_env->GetMethod() || env->GetDexPc() != header_env->GetDexPc()) {
+      return false;
+    }
+  }
+  return env == header_env;
+}
+
 // Insert an instruction.
 static HInstruction* Insert(HBasicBlock* block, HInstruction* instruction) {
   DCHECK(block != nullptr);
@@ -192,8 +247,9 @@ static HInstruction* Insert(HBasicBlock* block, HInstruction* instruction) {
 
 HLoopOptimization::HLoopOptimization(HGraph* graph,
                                      CompilerDriver* compiler_driver,
-                                     HInductionVarAnalysis* induction_analysis)
-    : HOptimization(graph, kLoopOptimizationPassName),
+                                     HInductionVarAnalysis* induction_analysis,
+                                     OptimizingCompilerStats* stats)
+    : HOptimization(graph, kLoopOptimizationPassName, stats),
       compiler_driver_(compiler_driver),
       induction_range_(induction_analysis),
       loop_allocator_(nullptr),
@@ -201,10 +257,13 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       top_loop_(nullptr),
       last_loop_(nullptr),
       iset_(nullptr),
+      reductions_(nullptr),
       induction_simplication_count_(0),
       simplified_(false),
       vector_length_(0),
       vector_refs_(nullptr),
+      vector_alias_tests_(nullptr),
+      vector_range_tests_(nullptr),
       vector_map_(nullptr) {
 }
 
@@ -250,18 +309,30 @@ void HLoopOptimization::LocalRun() {
   // should use the global allocator.
   if (top_loop_ != nullptr) {
     ArenaSet<HInstruction*> iset(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+    ArenaSafeMap<HInstruction*, HInstruction*> reds(
+        std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
     ArenaSet<ArrayReference> refs(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+    ArenaVector<std::pair<HInstruction*, HInstruction*>> alias_tests(
+        loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+    ArenaVector<std::pair<HInstruction*, HInstruction*>> range_tests(
+        loop_allocator_->Adapter(kArenaAllocLoopOptimization));
     ArenaSafeMap<HInstruction*, HInstruction*> map(
         std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
     // Attach.
     iset_ = &iset;
+    reductions_ = &reds;
     vector_refs_ = &refs;
+    vector_alias_tests_ = &alias_tests;
+    vector_range_tests_ = &range_tests;
     vector_map_ = &map;
     // Traverse.
     TraverseLoopsInnerToOuter(top_loop_);
     // Detach.
     iset_ = nullptr;
+    reductions_ = nullptr;
     vector_refs_ = nullptr;
+    vector_alias_tests_ = nullptr;
+    vector_range_tests_ = nullptr;
     vector_map_ = nullptr;
   }
 }
@@ -435,11 +506,12 @@ void HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
   // Detect either an empty loop (no side effects other than plain iteration) or
   // a trivial loop (just iterating once). Replace subsequent index uses, if any,
   // with the last value and remove the loop, possibly after unrolling its body.
-  HInstruction* phi = header->GetFirstPhi();
+  HPhi* phi = nullptr;
   iset_->clear();  // prepare phi induction
-  if (TrySetSimpleLoopHeader(header)) {
+  if (TrySetSimpleLoopHeader(header, &phi)) {
     bool is_empty = IsEmptyBody(body);
-    if ((is_empty || trip_count == 1) &&
+    if (reductions_->empty() &&  // TODO: possible with some effort
+        (is_empty || trip_count == 1) &&
         TryAssignLastValue(node->loop_info, phi, preheader, /*collect_loop_uses*/ true)) {
       if (!is_empty) {
         // Unroll the loop-body, which sees initial value of the index.
@@ -463,7 +535,7 @@ void HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
   // Vectorize loop, if possible and valid.
   if (kEnableVectorization) {
     iset_->clear();  // prepare phi induction
-    if (TrySetSimpleLoopHeader(header) &&
+    if (TrySetSimpleLoopHeader(header, &phi) &&
         CanVectorize(node, body, trip_count) &&
         TryAssignLastValue(node->loop_info, phi, preheader, /*collect_loop_uses*/ true)) {
       Vectorize(node, body, exit, trip_count);
@@ -483,8 +555,8 @@ bool HLoopOptimization::CanVectorize(LoopNode* node, HBasicBlock* block, int64_t
   // Reset vector bookkeeping.
   vector_length_ = 0;
   vector_refs_->clear();
-  vector_runtime_test_a_ =
-  vector_runtime_test_b_= nullptr;
+  vector_alias_tests_->clear();
+  vector_range_tests_->clear();
 
   // Phis in the loop-body prevent vectorization.
   if (!block->GetPhis().IsEmpty()) {
@@ -532,18 +604,33 @@ bool HLoopOptimization::CanVectorize(LoopNode* node, HBasicBlock* block, int64_t
           // Conservatively assume a potential loop-carried data dependence otherwise, avoided by
           // generating an explicit a != b disambiguation runtime test on the two references.
           if (x != y) {
-            // For now, we reject after one test to avoid excessive overhead.
-            if (vector_runtime_test_a_ != nullptr) {
-              return false;
+            if (a->GetId() > b->GetId()) {
+              std::swap(a, b);
+            }
+            auto test = std::make_pair(a, b);
+            if (std::find(vector_alias_tests_->begin(), vector_alias_tests_->end(), test) ==
+                vector_alias_tests_->end()) {
+              vector_alias_tests_->push_back(test);
             }
-            vector_runtime_test_a_ = a;
-            vector_runtime_test_b_ = b;
           }
         }
       }
     }
   }
 
+  // For now, we reject after a few runtime tests to avoid excessive overhead. The tests
+  // are sorted to generate them in an order that does not depend on memory layout.
+  if (vector_alias_tests_->size() + vector_range_tests_->size() > kMaxVectorRuntimeTests) {
+    return false;
+  }
+  std::sort(vector_alias_tests_->begin(),
+            vector_alias_tests_->end(),
+            [](const std::pair<HInstruction*, HInstruction*>& t1,
+               const std::pair<HInstruction*, HInstruction*>& t2) {
+              return t1.first->GetId() < t2.first->GetId() ||
+                  (t1.first == t2.first && t1.second->GetId() < t2.second->GetId());
+            });
+
   // Success!
   return true;
 }
@@ -561,8 +648,9 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   bool needs_cleanup = trip_count == 0 || (trip_count % vector_length_) != 0;
 
   // Adjust vector bookkeeping.
+  HPhi* main_phi = nullptr;
   iset_->clear();  // prepare phi induction
-  bool is_simple_loop_header = TrySetSimpleLoopHeader(header);  // fills iset_
+  bool is_simple_loop_header = TrySetSimpleLoopHeader(header, &main_phi);  // fills sets
   DCHECK(is_simple_loop_header);
 
   // Generate preheader:
@@ -579,16 +667,14 @@ void HLoopOptimization::Vectorize(LoopNode* node,
     vtc = Insert(preheader, new (global_allocator_) HSub(induc_type, stc, rem));
   }
 
-  // Generate runtime disambiguation test:
-  // vtc = a != b ? vtc : 0;
-  if (vector_runtime_test_a_ != nullptr) {
-    HInstruction* rt = Insert(
-        preheader,
-        new (global_allocator_) HNotEqual(vector_runtime_test_a_, vector_runtime_test_b_));
-    vtc = Insert(preheader,
-                 new (global_allocator_) HSelect(rt, vtc, graph_->GetIntConstant(0), kNoDexPc));
+  // Generate runtime tests that version the loop into the vector loop and the
+  // original loop, now acting as cleanup loop for all iterations when a test fails.
+  if (!vector_alias_tests_->empty() || !vector_range_tests_->empty()) {
+    vtc = GenerateRuntimeTests(preheader, vtc);
     needs_cleanup = true;
+    MaybeRecordStat(kLoopVersioned);
   }
+  MaybeRecordStat(kLoopVectorized);
 
   // Generate vector loop:
   // for (i = 0; i < vtc; i += VL)
@@ -615,6 +701,18 @@ void HLoopOptimization::Vectorize(LoopNode* node,
                     graph_->GetIntConstant(1));
   }
 
+  // Link reductions to their final uses.
+  for (auto i = reductions_->begin(); i != reductions_->end(); ++i) {
+    if (i->first->IsPhi()) {
+      HInstruction* phi = i->first;
+      HInstruction* repl = ReduceAndExtractIfNeeded(i->second);
+      for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+        induction_range_.Replace(use.GetUser(), phi, repl);  // update induction use
+      }
+      phi->ReplaceWith(repl);
+    }
+  }
+
   // Remove the original loop by disconnecting the body block
   // and removing all instructions from the header.
   block->DisconnectAndDelete();
@@ -627,6 +725,36 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   node->loop_info = vloop;
 }
 
+HInstruction* HLoopOptimization::GenerateRuntimeTests(HBasicBlock* preheader, HInstruction* vtc) {
+  // Each test selects the vector trip count or zero, so that any failing test
+  // passes all iterations to the cleanup loop, which retains all checks:
+  // vtc = a != b ? vtc : 0;
+  // vtc = x >= 0 ? vtc : 0;
+  // vtc = vtc <= length - x ? vtc : 0;
+  // All range tests are expressed in the original vector trip count, which bounds
+  // the normalized index i in the vector loop 0 <= i < vtc.
+  HInstruction* zero = graph_->GetIntConstant(0);
+  HInstruction* result = vtc;
+  for (const std::pair<HInstruction*, HInstruction*>& test : *vector_alias_tests_) {
+    HInstruction* rt = Insert(preheader,
+                              new (global_allocator_) HNotEqual(test.first, test.second));
+    result = Insert(preheader, new (global_allocator_) HSelect(rt, result, zero, kNoDexPc));
+  }
+  for (const std::pair<HInstruction*, HInstruction*>& test : *vector_range_tests_) {
+    HInstruction* offset = test.first;
+    HInstruction* length = test.second;
+    if (offset != nullptr) {
+      HInstruction* lo = Insert(preheader,
+                                new (global_allocator_) HGreaterThanOrEqual(offset, zero));
+      result = Insert(preheader, new (global_allocator_) HSelect(lo, result, zero, kNoDexPc));
+      length = Insert(preheader, new (global_allocator_) HSub(Primitive::kPrimInt, length, offset));
+    }
+    HInstruction* hi = Insert(preheader, new (global_allocator_) HLessThanOrEqual(vtc, length));
+    result = Insert(preheader, new (global_allocator_) HSelect(hi, result, zero, kNoDexPc));
+  }
+  return result;
+}
+
 void HLoopOptimization::GenerateNewLoop(LoopNode* node,
                                         HBasicBlock* block,
                                         HBasicBlock* new_preheader,
@@ -666,13 +794,20 @@ void HLoopOptimization::GenerateNewLoop(LoopNode* node,
       }
     }
   }
+  // Finalize phi inputs for the reductions (if any).
+  for (auto i = reductions_->begin(); i != reductions_->end(); ++i) {
+    if (!i->first->IsPhi()) {
+      DCHECK(i->second->IsPhi());
+      GenerateVecReductionPhiInputs(i->second->AsPhi(), i->first);
+    }
+  }
   // Finalize increment and phi.
   HInstruction* inc = new (global_allocator_) HAdd(induc_type, vector_phi_, step);
   vector_phi_->AddInput(lo);
   vector_phi_->AddInput(Insert(vector_body_, inc));
 }
 
-// TODO: accept reductions at left-hand-side, mixed-type store idioms, etc.
+// TODO: accept mixed-type store idioms, etc.
 bool HLoopOptimization::VectorizeDef(LoopNode* node,
                                      HInstruction* instruction,
                                      bool generate_code) {
@@ -702,6 +837,44 @@ bool HLoopOptimization::VectorizeDef(LoopNode* node,
     }
     return false;
   }
+  // Accept a bounds check base[index] for
+  // (1) loop-invariant length,
+  // (2) unit stride index,
+  // (3) same frames as loop header.
+  // The check is dropped from the vector loop, guarded by a runtime range test.
+  if (instruction->IsBoundsCheck()) {
+    HInstruction* index = instruction->InputAt(0);
+    HInstruction* length = instruction->InputAt(1);
+    HInstruction* offset = nullptr;
+    if (node->loop_info->IsDefinedOutOfTheLoop(length) &&
+        induction_range_.IsUnitStride(instruction, index, &offset) &&
+        HasSameFrames(instruction->GetEnvironment(),
+                      node->loop_info->GetSuspendCheck()->GetEnvironment()) &&
+        !IsUsedOutsideLoop(node->loop_info, instruction)) {
+      if (generate_code) {
+        GenerateVecSub(index, offset);
+        GenerateVecBoundsCheck(instruction, vector_map_->Get(index));
+      } else {
+        auto test = std::make_pair(offset, length);
+        if (std::find(vector_range_tests_->begin(), vector_range_tests_->end(), test) ==
+            vector_range_tests_->end()) {
+          vector_range_tests_->push_back(test);
+        }
+      }
+      return true;
+    }
+    return false;
+  }
+  // Accept a left-hand-side reduction for
+  // (1) supported vector type,
+  // (2) vectorizable right-hand-side value.
+  if (reductions_->find(instruction) != reductions_->end()) {
+    Primitive::Type type = instruction->GetType();
+    // Recognize the dot-product idiom or a direct reduction.
+    return VectorizeDotProdIdiom(node, instruction, generate_code, restrictions) ||
+        (TrySetVectorType(type, &restrictions) &&
+         VectorizeUse(node, instruction, generate_code, type, restrictions));
+  }
   // Branch back okay.
   if (instruction->IsGoto()) {
     return true;
@@ -732,6 +905,17 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
       GenerateVecInv(instruction, type);
     }
     return true;
+  } else if (reductions_->find(instruction) != reductions_->end()) {
+    DCHECK(instruction->IsPhi());
+    // Deal with vector restrictions.
+    if (HasVectorRestrictions(restrictions, kNoReduction)) {
+      return false;
+    }
+    // Accept a reduction phi, which is linked to its update when the new loop is finalized.
+    if (generate_code) {
+      GenerateVecReductionPhi(instruction->AsPhi());
+    }
+    return true;
   } else if (instruction->IsArrayGet()) {
     // Accept a right-hand-side array base[index] for
     // (1) exact matching vector type,
@@ -741,6 +925,10 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
     HInstruction* base = instruction->InputAt(0);
     HInstruction* index = instruction->InputAt(1);
     HInstruction* offset = nullptr;
+    if (instruction->AsArrayGet()->IsStringCharAt() &&
+        HasVectorRestrictions(restrictions, kNoStringCharAt)) {
+      return false;
+    }
     if (type == instruction->GetType() &&
         node->loop_info->IsDefinedOutOfTheLoop(base) &&
         induction_range_.IsUnitStride(instruction, index, &offset)) {
@@ -874,6 +1062,25 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
         }
         return false;
       }
+      case Intrinsics::kMathMinIntInt:
+      case Intrinsics::kMathMaxIntInt: {
+        // Deal with vector restrictions.
+        if (HasVectorRestrictions(restrictions, kNoMinMax) ||
+            HasVectorRestrictions(restrictions, kNoHiBits)) {
+          return false;
+        }
+        // Accept MIN/MAX(x, y) for vectorizable operands.
+        HInstruction* opa = instruction->InputAt(0);
+        HInstruction* opb = instruction->InputAt(1);
+        if (VectorizeUse(node, opa, generate_code, type, restrictions) &&
+            VectorizeUse(node, opb, generate_code, type, restrictions)) {
+          if (generate_code) {
+            GenerateVecOp(instruction, vector_map_->Get(opa), vector_map_->Get(opb), type);
+          }
+          return true;
+        }
+        return false;
+      }
       default:
         return false;
     }  // switch
@@ -886,55 +1093,94 @@ bool HLoopOptimization::TrySetVectorType(Primitive::Type type, uint64_t* restric
   switch (compiler_driver_->GetInstructionSet()) {
     case kArm:
     case kThumb2:
-      return false;
+      // Allow vectorization for all ARM devices, because Android assumes that
+      // ARMv7 always supports advanced SIMD (64-bit vectors). Floating-point is
+      // excluded, since NEON flushes denormals to zero, unlike Java arithmetic.
+      // Only the VIXL-based backend implements the vector instructions.
+#ifdef ART_ENABLE_CODEGEN_arm
+      if (!kArmUseVIXL32) {
+        return false;
+      }
+#endif
+      switch (type) {
+        case Primitive::kPrimBoolean:
+        case Primitive::kPrimByte:
+          *restrictions |= kNoDiv | kNoAbs | kNoMinMax | kNoDotProd;
+          return TrySetVectorLength(8);
+        case Primitive::kPrimChar:
+        case Primitive::kPrimShort:
+          *restrictions |= kNoDiv | kNoAbs | kNoStringCharAt | kNoMinMax | kNoDotProd;
+          return TrySetVectorLength(4);
+        case Primitive::kPrimInt:
+          *restrictions |= kNoDiv;
+          return TrySetVectorLength(2);
+        default:
+          return false;
+      }
     case kArm64:
       // Allow vectorization for all ARM devices, because Android assumes that
-      // ARMv8 AArch64 always supports advanced SIMD.
+      // ARMv8 AArch64 always supports advanced SIMD. Floating-point reductions
+      // are excluded, since reassociating the operations changes the result.
       switch (type) {
         case Primitive::kPrimBoolean:
         case Primitive::kPrimByte:
-          *restrictions |= kNoDiv | kNoAbs;
+          *restrictions |= kNoDiv | kNoAbs | kNoMinMax;
           return TrySetVectorLength(16);
         case Primitive::kPrimChar:
         case Primitive::kPrimShort:
-          *restrictions |= kNoDiv | kNoAbs;
+          *restrictions |= kNoDiv | kNoAbs | kNoMinMax;
           return TrySetVectorLength(8);
         case Primitive::kPrimInt:
           *restrictions |= kNoDiv;
           return TrySetVectorLength(4);
         case Primitive::kPrimLong:
-          *restrictions |= kNoDiv | kNoMul;
+          *restrictions |= kNoDiv | kNoMul | kNoMinMax;
           return TrySetVectorLength(2);
         case Primitive::kPrimFloat:
+          *restrictions |= kNoReduction;
           return TrySetVectorLength(4);
         case Primitive::kPrimDouble:
+          *restrictions |= kNoReduction;
           return TrySetVectorLength(2);
         default:
           return false;
       }
     case kX86:
     case kX86_64:
-      // Allow vectorization for SSE4-enabled X86 devices only (128-bit vectors).
+      // Allow vectorization for SSE4-enabled X86 devices only (128-bit vectors), using
+      // 256-bit vectors on AVX2-enabled X86_64 devices. AVX2 has no byte multiplications,
+      // byte shifts, long multiplications or long arithmetic shifts either. Reductions
+      // and min/max are only supported on X86_64 (and never for floating-point), where
+      // dot products are restricted to short operands.
       if (features->AsX86InstructionSetFeatures()->HasSSE4_1()) {
+        bool is_x86_64 = compiler_driver_->GetInstructionSet() == kX86_64;
+        uint32_t scale =
+            (is_x86_64 && features->AsX86InstructionSetFeatures()->HasAVX2()) ? 2u : 1u;
+        if (!is_x86_64) {
+          *restrictions |= kNoMinMax | kNoReduction | kNoDotProd;
+        }
         switch (type) {
           case Primitive::kPrimBoolean:
           case Primitive::kPrimByte:
             *restrictions |= kNoMul | kNoDiv | kNoShift | kNoAbs | kNoSignedHAdd | kNoUnroundedHAdd;
-            return TrySetVectorLength(16);
+            *restrictions |= kNoMinMax | kNoDotProd;
+            return TrySetVectorLength(16 * scale);
           case Primitive::kPrimChar:
           case Primitive::kPrimShort:
-            *restrictions |= kNoDiv | kNoAbs | kNoSignedHAdd | kNoUnroundedHAdd;
-            return TrySetVectorLength(8);
+            *restrictions |= kNoDiv | kNoAbs | kNoSignedHAdd | kNoUnroundedHAdd | kNoMinMax;
+            return TrySetVectorLength(8 * scale);
           case Primitive::kPrimInt:
             *restrictions |= kNoDiv;
-            return TrySetVectorLength(4);
+            return TrySetVectorLength(4 * scale);
           case Primitive::kPrimLong:
-            *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs;
-            return TrySetVectorLength(2);
+            *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoMinMax;
+            return TrySetVectorLength(2 * scale);
           case Primitive::kPrimFloat:
-            return TrySetVectorLength(4);
+            *restrictions |= kNoReduction;
+            return TrySetVectorLength(4 * scale);
           case Primitive::kPrimDouble:
-            return TrySetVectorLength(2);
+            *restrictions |= kNoReduction;
+            return TrySetVectorLength(2 * scale);
           default:
             break;
         }  // switch type
@@ -1018,6 +1264,90 @@ void HLoopOptimization::GenerateVecMem(HInstruction* org,
   vector_map_->Put(org, vector);
 }
 
+void HLoopOptimization::GenerateVecBoundsCheck(HInstruction* org, HInstruction* opa) {
+  if (vector_mode_ == kVector) {
+    // The vector loop only runs when the runtime range test passes,
+    // so that the subscript is used directly (viz. pass-through).
+    vector_map_->Put(org, opa);
+    MaybeRecordStat(kVersionedBoundsCheck);
+  } else {
+    // Scalar bounds check, which obtains its environment from the loop header.
+    DCHECK(vector_mode_ == kSequential);
+    HBoundsCheck* check = org->AsBoundsCheck();
+    vector_map_->Put(org, new (global_allocator_) HBoundsCheck(
+        opa, check->InputAt(1), check->GetDexPc(), check->IsStringCharAt()));
+  }
+}
+
+void HLoopOptimization::GenerateVecReductionPhi(HPhi* phi) {
+  DCHECK(reductions_->find(phi) != reductions_->end());
+  DCHECK(reductions_->Get(phi->InputAt(1)) == phi);
+  HPhi* new_phi = nullptr;
+  if (vector_mode_ == kVector) {
+    // A vector reduction phi carries a SIMD value.
+    new_phi = new (global_allocator_) HPhi(
+        global_allocator_, kNoRegNumber, 0, HVecOperation::kSIMDType);
+  } else {
+    // A scalar reduction phi is a plain copy.
+    DCHECK(vector_mode_ == kSequential);
+    new_phi = new (global_allocator_) HPhi(
+        global_allocator_, kNoRegNumber, 0, phi->GetType());
+  }
+  vector_header_->AddPhi(new_phi);
+  vector_map_->Put(phi, new_phi);
+}
+
+void HLoopOptimization::GenerateVecReductionPhiInputs(HPhi* phi, HInstruction* reduction) {
+  HPhi* new_phi = vector_map_->Get(phi)->AsPhi();
+  HInstruction* new_init = reductions_->Get(phi);
+  HInstruction* new_red = vector_map_->Get(reduction);
+  if (vector_mode_ == kVector) {
+    // Generate a [initial, 0, .., 0] vector for a sum or an
+    // [initial, .., initial] vector for a min/max reduction.
+    HVecOperation* red_vector = new_red->AsVecOperation();
+    Primitive::Type type = red_vector->GetPackedType();
+    size_t vector_length = red_vector->GetVectorLength();
+    if (GetReductionKind(red_vector) == HVecReduce::kSum) {
+      new_init = Insert(vector_preheader_, new (global_allocator_) HVecSetScalars(
+          global_allocator_, &new_init, type, vector_length, 1));
+    } else {
+      new_init = Insert(vector_preheader_, new (global_allocator_) HVecReplicateScalar(
+          global_allocator_, new_init, type, vector_length));
+    }
+  } else {
+    // Reduce the vector result of a preceding vector loop, if any.
+    DCHECK(vector_mode_ == kSequential);
+    new_init = ReduceAndExtractIfNeeded(new_init);
+  }
+  // Set the phi inputs.
+  new_phi->AddInput(new_init);
+  new_phi->AddInput(new_red);
+  // The new phi feeds any subsequent loop.
+  reductions_->find(phi)->second = new_phi;
+}
+
+HInstruction* HLoopOptimization::ReduceAndExtractIfNeeded(HInstruction* instruction) {
+  if (instruction->IsPhi()) {
+    HInstruction* input = instruction->InputAt(1);
+    if (input->IsVecOperation()) {
+      // Generate a vector reduction followed by a scalar extraction
+      //    x = REDUCE( [x_1, .., x_n] )
+      //    y = x_1
+      // at the start of the exit block of the defining vector loop.
+      Primitive::Type type = input->AsVecOperation()->GetPackedType();
+      size_t vector_length = input->AsVecOperation()->GetVectorLength();
+      HBasicBlock* exit = instruction->GetBlock()->GetSuccessors()[0];
+      HInstruction* reduce = new (global_allocator_) HVecReduce(
+          global_allocator_, instruction, type, vector_length, GetReductionKind(input));
+      exit->InsertInstructionBefore(reduce, exit->GetFirstInstruction());
+      instruction = new (global_allocator_) HVecExtractScalar(
+          global_allocator_, reduce, type, vector_length, 0);
+      exit->InsertInstructionAfter(instruction, reduce);
+    }
+  }
+  return instruction;
+}
+
 #define GENERATE_VEC(x, y) \
   if (vector_mode_ == kVector) { \
     vector = (x); \
@@ -1113,6 +1443,14 @@ void HLoopOptimization::GenerateVecOp(HInstruction* org,
             DCHECK(opb == nullptr);
             vector = new (global_allocator_) HVecAbs(global_allocator_, opa, type, vector_length_);
             break;
+          case Intrinsics::kMathMinIntInt:
+            vector = new (global_allocator_) HVecMin(
+                global_allocator_, opa, opb, type, vector_length_);
+            break;
+          case Intrinsics::kMathMaxIntInt:
+            vector = new (global_allocator_) HVecMax(
+                global_allocator_, opa, opb, type, vector_length_);
+            break;
           default:
             LOG(FATAL) << "Unsupported SIMD intrinsic";
             UNREACHABLE();
@@ -1238,6 +1576,72 @@ bool HLoopOptimization::VectorizeHalvingAddIdiom(LoopNode* node,
   return false;
 }
 
+// Method recognizes the following dot-product idiom:
+//   q += a * b for signed byte/short operands a, b and int accumulator q
+// Provided that the operands are promoted to int to do the arithmetic, the idiom
+// can be mapped into a widening multiply-accumulate that operates directly on the
+// narrower form, with every vector lane of the accumulator summing several products.
+// TODO: unsigned operands and long accumulators could be added later.
+bool HLoopOptimization::VectorizeDotProdIdiom(LoopNode* node,
+                                              HInstruction* instruction,
+                                              bool generate_code,
+                                              uint64_t restrictions) {
+  if (!instruction->IsAdd() || instruction->GetType() != Primitive::kPrimInt) {
+    return false;
+  }
+  // Test for a reduction q += a * b with sign-extended operands.
+  HInstruction* q = reductions_->Get(instruction);
+  bool is_phi_left = instruction->InputAt(0) == q;
+  HInstruction* v = is_phi_left ? instruction->InputAt(1) : instruction->InputAt(0);
+  if (!v->IsMul() || v->GetType() != Primitive::kPrimInt || v->HasEnvironmentUses()) {
+    return false;
+  }
+  HInstruction* a = v->InputAt(0);
+  HInstruction* b = v->InputAt(1);
+  Primitive::Type sub_type = a->IsConstant() ? b->GetType() : a->GetType();
+  HInstruction* r = nullptr;
+  HInstruction* s = nullptr;
+  if ((sub_type != Primitive::kPrimByte && sub_type != Primitive::kPrimShort) ||
+      !IsSignExtensionAndGet(a, sub_type, &r) ||
+      !IsSignExtensionAndGet(b, sub_type, &s)) {
+    return false;
+  }
+  // Deal with vector restrictions.
+  if (!TrySetVectorType(sub_type, &restrictions) ||
+      HasVectorRestrictions(restrictions, kNoDotProd)) {
+    return false;
+  }
+  // Accept recognized dot product for vectorizable operands. Vectorized code uses the
+  // widening multiply-accumulate. Sequential code uses the original scalar expressions.
+  DCHECK(r != nullptr && s != nullptr);
+  if (VectorizeUse(node, q, generate_code, Primitive::kPrimInt, restrictions) &&
+      VectorizeUse(node, r, generate_code, sub_type, restrictions) &&
+      VectorizeUse(node, s, generate_code, sub_type, restrictions)) {
+    if (generate_code) {
+      if (vector_mode_ == kVector) {
+        size_t vector_length = vector_length_ * Primitive::ComponentSize(sub_type) /
+            Primitive::ComponentSize(Primitive::kPrimInt);
+        vector_map_->Put(instruction, new (global_allocator_) HVecMultiplyAccumulate(
+            global_allocator_,
+            HInstruction::kAdd,
+            vector_map_->Get(q),
+            vector_map_->Get(r),
+            vector_map_->Get(s),
+            Primitive::kPrimInt,
+            vector_length));
+      } else {
+        GenerateVecOp(v, vector_map_->Get(r), vector_map_->Get(s), Primitive::kPrimInt);
+        GenerateVecOp(instruction,
+                      is_phi_left ? vector_map_->Get(q) : vector_map_->Get(v),
+                      is_phi_left ? vector_map_->Get(v) : vector_map_->Get(q),
+                      Primitive::kPrimInt);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
 //
 // Helpers.
 //
@@ -1268,17 +1672,54 @@ bool HLoopOptimization::TrySetPhiInduction(HPhi* phi, bool restrict_uses) {
   return false;
 }
 
+bool HLoopOptimization::TrySetPhiReduction(HPhi* phi) {
+  // Only an unclassified phi of the form x = phi(init, x op y) that is used
+  // nowhere else in the loop can be a reduction.
+  if (induction_range_.IsClassified(phi) ||
+      phi->InputCount() != 2 ||
+      (phi->GetType() != Primitive::kPrimInt && phi->GetType() != Primitive::kPrimLong)) {
+    return false;
+  }
+  HLoopInformation* loop_info = phi->GetBlock()->GetLoopInformation();
+  HInstruction* reduction = phi->InputAt(1);
+  if (!HasReductionFormat(reduction, phi) ||
+      !loop_info->Contains(*reduction->GetBlock()) ||
+      !reduction->GetUses().HasExactlyOneElement() ||  // only used by the phi
+      reduction->HasEnvironmentUses()) {
+    return false;
+  }
+  for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (user != reduction && loop_info->Contains(*user->GetBlock())) {
+      return false;
+    }
+  }
+  reductions_->Put(reduction, phi);
+  reductions_->Put(phi, phi->InputAt(0));
+  return true;
+}
+
 // Find: phi: Phi(init, addsub)
 //       s:   SuspendCheck
 //       c:   Condition(phi, bound)
 //       i:   If(c)
+// where any other phi in the header must be a reduction.
 // TODO: Find a less pattern matching approach?
-bool HLoopOptimization::TrySetSimpleLoopHeader(HBasicBlock* block) {
+bool HLoopOptimization::TrySetSimpleLoopHeader(HBasicBlock* block, /*out*/ HPhi** main_phi) {
   DCHECK(iset_->empty());
-  HInstruction* phi = block->GetFirstPhi();
-  if (phi != nullptr &&
-      phi->GetNext() == nullptr &&
-      TrySetPhiInduction(phi->AsPhi(), /*restrict_uses*/ false)) {
+  *main_phi = nullptr;
+  reductions_->clear();
+  for (HInstructionIterator it(block->GetPhis()); !it.Done(); it.Advance()) {
+    HPhi* phi = it.Current()->AsPhi();
+    if (*main_phi == nullptr &&
+        induction_range_.IsClassified(phi) &&
+        TrySetPhiInduction(phi, /*restrict_uses*/ false)) {
+      *main_phi = phi;
+    } else if (!TrySetPhiReduction(phi)) {
+      return false;
+    }
+  }
+  if (*main_phi != nullptr) {
     HInstruction* s = block->GetFirstInstruction();
     if (s != nullptr && s->IsSuspendCheck()) {
       HInstruction* c = s->GetNext();
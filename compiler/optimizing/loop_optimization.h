@@ -34,7 +34,8 @@ class HLoopOptimization : public HOptimization {
  public:
   HLoopOptimization(HGraph* graph,
                     CompilerDriver* compiler_driver,
-                    HInductionVarAnalysis* induction_analysis);
+                    HInductionVarAnalysis* induction_analysis,
+                    OptimizingCompilerStats* stats);
 
   void Run() OVERRIDE;
 
@@ -62,15 +63,19 @@ class HLoopOptimization : public HOptimization {
    * Vectorization restrictions (bit mask).
    */
   enum VectorRestrictions {
-    kNone            = 0,    // no restrictions
-    kNoMul           = 1,    // no multiplication
-    kNoDiv           = 2,    // no division
-    kNoShift         = 4,    // no shift
-    kNoShr           = 8,    // no arithmetic shift right
-    kNoHiBits        = 16,   // "wider" operations cannot bring in higher order bits
-    kNoSignedHAdd    = 32,   // no signed halving add
-    kNoUnroundedHAdd = 64,   // no unrounded halving add
-    kNoAbs           = 128,  // no absolute value
+    kNone            = 0,     // no restrictions
+    kNoMul           = 1,     // no multiplication
+    kNoDiv           = 2,     // no division
+    kNoShift         = 4,     // no shift
+    kNoShr           = 8,     // no arithmetic shift right
+    kNoHiBits        = 16,    // "wider" operations cannot bring in higher order bits
+    kNoSignedHAdd    = 32,    // no signed halving add
+    kNoUnroundedHAdd = 64,    // no unrounded halving add
+    kNoAbs           = 128,   // no absolute value
+    kNoStringCharAt  = 256,   // no StringCharAt
+    kNoMinMax        = 512,   // no min/max
+    kNoReduction     = 1024,  // no reduction
+    kNoDotProd       = 2048,  // no dot product
   };
 
   /*
@@ -116,6 +121,7 @@ class HLoopOptimization : public HOptimization {
   // Vectorization analysis and synthesis.
   bool CanVectorize(LoopNode* node, HBasicBlock* block, int64_t trip_count);
   void Vectorize(LoopNode* node, HBasicBlock* block, HBasicBlock* exit, int64_t trip_count);
+  HInstruction* GenerateRuntimeTests(HBasicBlock* preheader, HInstruction* vtc);
   void GenerateNewLoop(LoopNode* node,
                        HBasicBlock* block,
                        HBasicBlock* new_preheader,
@@ -136,7 +142,11 @@ class HLoopOptimization : public HOptimization {
                       HInstruction* opa,
                       HInstruction* opb,
                       Primitive::Type type);
+  void GenerateVecBoundsCheck(HInstruction* org, HInstruction* opa);
   void GenerateVecOp(HInstruction* org, HInstruction* opa, HInstruction* opb, Primitive::Type type);
+  void GenerateVecReductionPhi(HPhi* phi);
+  void GenerateVecReductionPhiInputs(HPhi* phi, HInstruction* reduction);
+  HInstruction* ReduceAndExtractIfNeeded(HInstruction* instruction);
 
   // Vectorization idioms.
   bool VectorizeHalvingAddIdiom(LoopNode* node,
@@ -144,10 +154,15 @@ class HLoopOptimization : public HOptimization {
                                 bool generate_code,
                                 Primitive::Type type,
                                 uint64_t restrictions);
+  bool VectorizeDotProdIdiom(LoopNode* node,
+                             HInstruction* instruction,
+                             bool generate_code,
+                             uint64_t restrictions);
 
   // Helpers.
   bool TrySetPhiInduction(HPhi* phi, bool restrict_uses);
-  bool TrySetSimpleLoopHeader(HBasicBlock* block);
+  bool TrySetPhiReduction(HPhi* phi);
+  bool TrySetSimpleLoopHeader(HBasicBlock* block, /*out*/ HPhi** main_phi);
   bool IsEmptyBody(HBasicBlock* block);
   bool IsOnlyUsedAfterLoop(HLoopInformation* loop_info,
                            HInstruction* instruction,
@@ -184,6 +199,13 @@ class HLoopOptimization : public HOptimization {
   // Contents reside in phase-local heap memory.
   ArenaSet<HInstruction*>* iset_;
 
+  // Temporary bookkeeping of reduction instructions. Mapping is two-fold:
+  // (1) reductions in the loop-body are mapped back to their phi definition,
+  // (2) phi definitions are mapped to their initial value (updated during
+  //     code generation to feed the proper values into the new chain).
+  // Contents reside in phase-local heap memory.
+  ArenaSafeMap<HInstruction*, HInstruction*>* reductions_;
+
   // Counter that tracks how many induction cycles have been simplified. Useful
   // to trigger incremental updates of induction variable analysis of outer loops
   // when the induction of inner loops has changed.
@@ -199,6 +221,13 @@ class HLoopOptimization : public HOptimization {
   // Contents reside in phase-local heap memory.
   ArenaSet<ArrayReference>* vector_refs_;
 
+  // Runtime tests that version the vector loop: pairs (a, b) of arrays that are
+  // tested for a != b, and pairs (offset, length) of bounds checks on i + offset
+  // that are tested for range. Both are kept in a deterministic order.
+  // Contents reside in phase-local heap memory.
+  ArenaVector<std::pair<HInstruction*, HInstruction*>>* vector_alias_tests_;
+  ArenaVector<std::pair<HInstruction*, HInstruction*>>* vector_range_tests_;
+
   // Mapping used during vectorization synthesis for both the scalar peeling/cleanup
   // loop (simd_ is false) and the actual vector loop (simd_ is true). The data
   // structure maps original instructions into the new instructions.
@@ -209,8 +238,6 @@ class HLoopOptimization : public HOptimization {
   HBasicBlock* vector_preheader_;  // preheader of the new loop
   HBasicBlock* vector_header_;  // header of the new loop
   HBasicBlock* vector_body_;  // body of the new loop
-  HInstruction* vector_runtime_test_a_;
-  HInstruction* vector_runtime_test_b_;  // defines a != b runtime test
   HPhi* vector_phi_;  // the Phi representing the normalized loop index
   VectorMode vector_mode_;  // selects synthesis mode
 
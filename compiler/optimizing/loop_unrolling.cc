@@ -0,0 +1,453 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "loop_unrolling.h"
+
+namespace art {
+
+// Maximum number of instructions that unrolling or peeling may add to a single loop.
+static constexpr int64_t kUnrollingBudget = 32;
+
+// Maximum factor for partial unrolling (power of two).
+static constexpr int64_t kMaxUnrollFactor = 4;
+
+// Detect an instruction in the loop-body that can be cloned into another iteration.
+static bool IsClonable(HInstruction* instruction) {
+  switch (instruction->GetKind()) {
+    case HInstruction::kAdd:
+    case HInstruction::kSub:
+    case HInstruction::kMul:
+    case HInstruction::kDiv:
+    case HInstruction::kRem:
+    case HInstruction::kAnd:
+    case HInstruction::kOr:
+    case HInstruction::kXor:
+    case HInstruction::kShl:
+    case HInstruction::kShr:
+    case HInstruction::kUShr:
+    case HInstruction::kNeg:
+    case HInstruction::kNot:
+    case HInstruction::kBooleanNot:
+    case HInstruction::kTypeConversion:
+    case HInstruction::kNullCheck:
+    case HInstruction::kDivZeroCheck:
+    case HInstruction::kBoundsCheck:
+    case HInstruction::kArrayLength:
+    case HInstruction::kArrayGet:
+      return true;
+    case HInstruction::kArraySet:
+      // Reference stores need a type check, with state that is not preserved by cloning.
+      return instruction->AsArraySet()->GetComponentType() != Primitive::kPrimNot;
+    default:
+      return false;
+  }
+}
+
+// Insert an instruction.
+static HInstruction* Insert(HBasicBlock* block, HInstruction* instruction) {
+  DCHECK(block != nullptr);
+  DCHECK(instruction != nullptr);
+  block->InsertInstructionBefore(instruction, block->GetLastInstruction());
+  return instruction;
+}
+
+//
+// Class methods.
+//
+
+HLoopUnrolling::HLoopUnrolling(HGraph* graph,
+                               HInductionVarAnalysis* induction_analysis,
+                               OptimizingCompilerStats* stats)
+    : HOptimization(graph, kLoopUnrollingPassName, stats),
+      induction_range_(induction_analysis),
+      loop_allocator_(nullptr),
+      global_allocator_(graph_->GetArena()),
+      body_instructions_(nullptr),
+      iteration_map_(nullptr) {
+}
+
+void HLoopUnrolling::Run() {
+  // Skip if there is no loop or the graph has try-catch/irreducible loops.
+  if (!graph_->HasLoops() || graph_->HasTryCatch() || graph_->HasIrreducibleLoops()) {
+    return;
+  }
+
+  // Phase-local allocator that draws from the global pool. Since the allocator
+  // itself resides on the stack, it is destructed on exiting Run(), which
+  // implies its underlying memory is released immediately.
+  ArenaAllocator allocator(global_allocator_->GetArenaPool());
+  loop_allocator_ = &allocator;
+
+  // Collect all loops up front, since full unrolling removes loops from the graph.
+  // Post order visits inner loops before their outer loops.
+  ArenaVector<HLoopInformation*> loops(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  for (HBasicBlock* block : graph_->GetPostOrder()) {
+    if (block->IsLoopHeader()) {
+      loops.push_back(block->GetLoopInformation());
+    }
+  }
+
+  ArenaVector<HInstruction*> instructions(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ArenaSafeMap<HInstruction*, HInstruction*> map(
+      std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  // Attach.
+  body_instructions_ = &instructions;
+  iteration_map_ = &map;
+
+  bool has_loops = false;
+  for (HLoopInformation* loop_info : loops) {
+    HBasicBlock* body = nullptr;
+    HBasicBlock* exit = nullptr;
+    int64_t body_size = 0;
+    int64_t trip_count = 0;
+    if (!induction_range_.IsFinite(loop_info, &trip_count) ||
+        trip_count <= 0 ||
+        !IsCandidateLoop(loop_info, &body, &exit, &body_size)) {
+      has_loops = true;
+      continue;
+    }
+    // Fully unroll a loop that fits the budget as a whole.
+    if (trip_count <= kUnrollingBudget && trip_count * body_size <= kUnrollingBudget) {
+      FullyUnroll(loop_info, body, exit, trip_count);
+      continue;
+    }
+    has_loops = true;
+    // Peel the first iteration if that turns a phi into an invariant.
+    if (body_size <= kUnrollingBudget && HasFirstIterationPhi(loop_info)) {
+      PeelFirstIteration(loop_info, body);
+      trip_count--;
+    }
+    // Partially unroll by the largest factor that divides the (remaining) trip count,
+    // so that no cleanup iterations are needed.
+    for (int64_t factor = kMaxUnrollFactor; factor > 1; factor >>= 1) {
+      if ((trip_count % factor) == 0 && (factor - 1) * body_size <= kUnrollingBudget) {
+        PartiallyUnroll(loop_info, body, factor);
+        break;
+      }
+    }
+  }
+  if (!has_loops) {
+    graph_->SetHasLoops(false);  // no more loops
+  }
+
+  // Detach.
+  body_instructions_ = nullptr;
+  iteration_map_ = nullptr;
+  loop_allocator_ = nullptr;
+}
+
+//
+// Analysis.
+//
+
+bool HLoopUnrolling::IsCandidateLoop(HLoopInformation* loop_info,
+                                     /*out*/ HBasicBlock** body,
+                                     /*out*/ HBasicBlock** exit,
+                                     /*out*/ int64_t* body_size) {
+  HBasicBlock* header = loop_info->GetHeader();
+  // Ensure the loop consists of the header and a single loop-body only.
+  if (loop_info->IsIrreducible() ||
+      loop_info->GetBlocks().NumSetBits() != 2 ||
+      header->GetSuccessors().size() != 2) {
+    return false;
+  }
+  *body = header->GetSuccessors()[0];
+  *exit = header->GetSuccessors()[1];
+  if (!loop_info->Contains(**body)) {
+    std::swap(*body, *exit);
+  }
+  if (!loop_info->Contains(**body) || loop_info->Contains(**exit)) {
+    return false;
+  }
+  // Ensure the loop-body branches straight back and the exit
+  // can only be reached by exiting the loop.
+  if ((*body)->GetPredecessors().size() != 1 ||
+      !(*body)->GetPhis().IsEmpty() ||
+      !(*body)->GetLastInstruction()->IsGoto() ||
+      (*exit)->GetPredecessors().size() != 1) {
+    return false;
+  }
+  // Ensure the header only contains loop control (besides the phis),
+  // so that an iteration is fully described by the loop-body.
+  HInstruction* control = header->GetLastInstruction();
+  if (!control->IsIf()) {
+    return false;
+  }
+  HInstruction* condition = control->InputAt(0);
+  if (condition->GetBlock() != header || !condition->HasOnlyOneNonEnvironmentUse()) {
+    return false;
+  }
+  for (HInstructionIterator it(header->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction != control && instruction != condition && !instruction->IsSuspendCheck()) {
+      return false;
+    }
+  }
+  // Ensure all instructions in the loop-body can be cloned.
+  body_instructions_->clear();
+  for (HInstructionIterator it((*body)->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction->IsGoto()) {
+      continue;
+    } else if (!IsClonable(instruction)) {
+      return false;
+    }
+    body_instructions_->push_back(instruction);
+  }
+  *body_size = body_instructions_->size();
+  return true;
+}
+
+bool HLoopUnrolling::HasFirstIterationPhi(HLoopInformation* loop_info) {
+  // Detect a phi x = phi(a, b) with loop-invariant b != a,
+  // which only takes a different value in the first iteration.
+  for (HInstructionIterator it(loop_info->GetHeader()->GetPhis()); !it.Done(); it.Advance()) {
+    HInstruction* phi = it.Current();
+    if (phi->InputAt(0) != phi->InputAt(1) && loop_info->IsDefinedOutOfTheLoop(phi->InputAt(1))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//
+// Transformations.
+//
+
+void HLoopUnrolling::FullyUnroll(HLoopInformation* loop_info,
+                                 HBasicBlock* body,
+                                 HBasicBlock* exit,
+                                 int64_t trip_count) {
+  HBasicBlock* header = loop_info->GetHeader();
+  HBasicBlock* preheader = loop_info->GetPreHeader();
+  // Generate all iterations in the preheader, starting from the initial values of the phis.
+  iteration_map_->clear();
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    iteration_map_->Put(it.Current(), it.Current()->InputAt(0));
+  }
+  for (int64_t i = 0; i < trip_count; i++) {
+    GenerateIteration(preheader);
+    MapPhisToNextIteration(header);
+  }
+  // Replace subsequent uses of the phis with their last value.
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    HInstruction* phi = it.Current();
+    HInstruction* last = Lookup(phi);
+    for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+      induction_range_.Replace(use.GetUser(), phi, last);  // update induction use
+    }
+    phi->ReplaceWith(last);
+  }
+  // Remove the loop.
+  body->DisconnectAndDelete();
+  exit->RemovePredecessor(header);
+  header->RemoveSuccessor(exit);
+  header->RemoveDominatedBlock(exit);
+  header->DisconnectAndDelete();
+  preheader->AddSuccessor(exit);
+  preheader->AddInstruction(new (global_allocator_) HGoto());
+  preheader->AddDominatedBlock(exit);
+  exit->SetDominator(preheader);
+  MaybeRecordStat(kLoopFullyUnrolled);
+}
+
+void HLoopUnrolling::PeelFirstIteration(HLoopInformation* loop_info, HBasicBlock* body) {
+  HBasicBlock* header = loop_info->GetHeader();
+  HBasicBlock* preheader = loop_info->GetPreHeader();
+  DCHECK_EQ(body->GetSingleSuccessor(), header);
+  // Generate the first iteration in the preheader. Since the trip count
+  // is known to be positive, this iteration is always taken.
+  iteration_map_->clear();
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    iteration_map_->Put(it.Current(), it.Current()->InputAt(0));
+  }
+  GenerateIteration(preheader);
+  MapPhisToNextIteration(header);
+  // The loop now starts at the second iteration. Phis that only
+  // differed in the first iteration have become invariant.
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    HPhi* phi = it.Current()->AsPhi();
+    HInstruction* next = Lookup(phi);
+    phi->ReplaceInput(next, 0);
+    if (next == phi->InputAt(1) && next != phi) {
+      for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+        induction_range_.Replace(use.GetUser(), phi, next);  // update induction use
+      }
+      phi->ReplaceWith(next);
+      header->RemovePhi(phi);
+    }
+  }
+  MaybeRecordStat(kLoopPeeled);
+}
+
+void HLoopUnrolling::PartiallyUnroll(HLoopInformation* loop_info,
+                                     HBasicBlock* body,
+                                     int64_t factor) {
+  HBasicBlock* header = loop_info->GetHeader();
+  // The original loop-body acts as the first copy. Each subsequent copy
+  // is appended to the loop-body and starts from the values of the
+  // previous copy. Since the factor divides the trip count, the loop
+  // condition only needs to be tested after every last copy.
+  iteration_map_->clear();
+  MapPhisToNextIteration(header);
+  for (int64_t i = 1; i < factor; i++) {
+    GenerateIteration(body);
+    MapPhisToNextIteration(header);
+  }
+  // Feed the values of the last copy back into the phis.
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    it.Current()->ReplaceInput(Lookup(it.Current()), 1);
+  }
+  MaybeRecordStat(kLoopPartiallyUnrolled);
+}
+
+//
+// Helpers.
+//
+
+void HLoopUnrolling::GenerateIteration(HBasicBlock* target) {
+  // Clone the loop-body in original program order into the end of the target block.
+  for (HInstruction* instruction : *body_instructions_) {
+    HInstruction* clone = Insert(target, Clone(instruction));
+    // Deal with instructions that need an environment, which is copied
+    // from the original instruction with the values of this iteration.
+    if (instruction->HasEnvironment()) {
+      clone->CopyEnvironmentFrom(instruction->GetEnvironment());
+      for (HEnvironment* env = clone->GetEnvironment(); env != nullptr; env = env->GetParent()) {
+        for (size_t i = 0, size = env->Size(); i < size; ++i) {
+          HInstruction* value = env->GetInstructionAt(i);
+          HInstruction* replacement = (value != nullptr) ? Lookup(value) : nullptr;
+          if (replacement != value) {
+            env->RemoveAsUserOfInput(i);
+            env->SetRawEnvAt(i, replacement);
+            replacement->AddEnvUseAt(env, i);
+          }
+        }
+      }
+    }
+    iteration_map_->Overwrite(instruction, clone);
+  }
+}
+
+void HLoopUnrolling::MapPhisToNextIteration(HBasicBlock* header) {
+  // Obtain all next values before updating the mapping,
+  // since the back-edge of a phi may refer to another phi.
+  ArenaVector<HInstruction*> next(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    next.push_back(Lookup(it.Current()->InputAt(1)));
+  }
+  size_t i = 0;
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    iteration_map_->Overwrite(it.Current(), next[i++]);
+  }
+}
+
+HInstruction* HLoopUnrolling::Lookup(HInstruction* instruction) const {
+  // Values defined outside the loop (and values of the original loop-body
+  // when it acts as the first copy) remain themselves.
+  auto it = iteration_map_->find(instruction);
+  return (it != iteration_map_->end()) ? it->second : instruction;
+}
+
+HInstruction* HLoopUnrolling::Clone(HInstruction* instruction) {
+  Primitive::Type type = instruction->GetType();
+  uint32_t dex_pc = instruction->GetDexPc();
+  HInstruction* opa = instruction->InputCount() > 0 ? Lookup(instruction->InputAt(0)) : nullptr;
+  HInstruction* opb = instruction->InputCount() > 1 ? Lookup(instruction->InputAt(1)) : nullptr;
+  HInstruction* clone = nullptr;
+  switch (instruction->GetKind()) {
+    case HInstruction::kAdd:
+      clone = new (global_allocator_) HAdd(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kSub:
+      clone = new (global_allocator_) HSub(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kMul:
+      clone = new (global_allocator_) HMul(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kDiv:
+      clone = new (global_allocator_) HDiv(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kRem:
+      clone = new (global_allocator_) HRem(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kAnd:
+      clone = new (global_allocator_) HAnd(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kOr:
+      clone = new (global_allocator_) HOr(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kXor:
+      clone = new (global_allocator_) HXor(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kShl:
+      clone = new (global_allocator_) HShl(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kShr:
+      clone = new (global_allocator_) HShr(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kUShr:
+      clone = new (global_allocator_) HUShr(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kNeg:
+      clone = new (global_allocator_) HNeg(type, opa, dex_pc);
+      break;
+    case HInstruction::kNot:
+      clone = new (global_allocator_) HNot(type, opa, dex_pc);
+      break;
+    case HInstruction::kBooleanNot:
+      clone = new (global_allocator_) HBooleanNot(opa, dex_pc);
+      break;
+    case HInstruction::kTypeConversion:
+      clone = new (global_allocator_) HTypeConversion(type, opa, dex_pc);
+      break;
+    case HInstruction::kNullCheck:
+      clone = new (global_allocator_) HNullCheck(opa, dex_pc);
+      break;
+    case HInstruction::kDivZeroCheck:
+      clone = new (global_allocator_) HDivZeroCheck(opa, dex_pc);
+      break;
+    case HInstruction::kBoundsCheck:
+      clone = new (global_allocator_) HBoundsCheck(
+          opa, opb, dex_pc, instruction->AsBoundsCheck()->IsStringCharAt());
+      break;
+    case HInstruction::kArrayLength:
+      clone = new (global_allocator_) HArrayLength(
+          opa, dex_pc, instruction->AsArrayLength()->IsStringLength());
+      break;
+    case HInstruction::kArrayGet:
+      clone = new (global_allocator_) HArrayGet(
+          opa, opb, type, dex_pc, instruction->AsArrayGet()->IsStringCharAt());
+      break;
+    case HInstruction::kArraySet:
+      clone = new (global_allocator_) HArraySet(
+          opa,
+          opb,
+          Lookup(instruction->InputAt(2)),
+          instruction->AsArraySet()->GetRawExpectedComponentType(),
+          dex_pc);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported clone " << instruction->DebugName();
+      UNREACHABLE();
+  }
+  if (type == Primitive::kPrimNot) {
+    clone->SetReferenceTypeInfo(instruction->GetReferenceTypeInfo());
+  }
+  return clone;
+}
+
+}  // namespace art
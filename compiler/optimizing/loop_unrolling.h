@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_LOOP_UNROLLING_H_
+#define ART_COMPILER_OPTIMIZING_LOOP_UNROLLING_H_
+
+#include "base/arena_containers.h"
+#include "induction_var_range.h"
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+/**
+ * Scalar loop unrolling and peeling. Applies to inner loops with a single
+ * loop-body block and a trip count that is known at compile time:
+ *  (1) fully unrolls small loops, which removes all loop control,
+ *  (2) peels the first iteration off loops with a phi that only differs
+ *      in the first iteration, which turns that phi into an invariant,
+ *  (3) partially unrolls small loop-bodies by a factor that divides the
+ *      trip count, which saves the loop control of the other copies.
+ * All transformations are bounded by a code size budget.
+ */
+class HLoopUnrolling : public HOptimization {
+ public:
+  HLoopUnrolling(HGraph* graph,
+                 HInductionVarAnalysis* induction_analysis,
+                 OptimizingCompilerStats* stats);
+
+  void Run() OVERRIDE;
+
+  static constexpr const char* kLoopUnrollingPassName = "loop_unrolling";
+
+ private:
+  // Analysis.
+  bool IsCandidateLoop(HLoopInformation* loop_info,
+                       /*out*/ HBasicBlock** body,
+                       /*out*/ HBasicBlock** exit,
+                       /*out*/ int64_t* body_size);
+  bool HasFirstIterationPhi(HLoopInformation* loop_info);
+
+  // Transformations.
+  void FullyUnroll(HLoopInformation* loop_info,
+                   HBasicBlock* body,
+                   HBasicBlock* exit,
+                   int64_t trip_count);
+  void PeelFirstIteration(HLoopInformation* loop_info, HBasicBlock* body);
+  void PartiallyUnroll(HLoopInformation* loop_info, HBasicBlock* body, int64_t factor);
+
+  // Helpers.
+  void GenerateIteration(HBasicBlock* target);
+  void MapPhisToNextIteration(HBasicBlock* header);
+  HInstruction* Lookup(HInstruction* instruction) const;
+  HInstruction* Clone(HInstruction* instruction);
+
+  // Range information based on prior induction variable analysis.
+  InductionVarRange induction_range_;
+
+  // Phase-local heap memory allocator for the loop unroller. Storage obtained
+  // through this allocator is immediately released when the loop unroller is done.
+  ArenaAllocator* loop_allocator_;
+
+  // Global heap memory allocator. Used to build HIR.
+  ArenaAllocator* global_allocator_;
+
+  // Instructions of the loop-body being transformed, in original program order
+  // and without the branch back. Contents reside in phase-local heap memory.
+  ArenaVector<HInstruction*>* body_instructions_;
+
+  // Mapping of the original loop values into the values of the iteration
+  // being generated. Contents reside in phase-local heap memory.
+  ArenaSafeMap<HInstruction*, HInstruction*>* iteration_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(HLoopUnrolling);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_LOOP_UNROLLING_H_
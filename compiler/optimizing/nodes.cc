@@ -2060,6 +2060,9 @@ HInstruction* HGraph::InlineInto(HGraph* outer_graph, HInvoke* invoke) {
     }
   }
   outer_graph->UpdateMaximumNumberOfOutVRegs(GetMaximumNumberOfOutVRegs());
+  for (TypeReference type : GetAssumedInitializedClasses()) {
+    outer_graph->AddAssumedInitializedClass(type);
+  }
 
   if (HasBoundsChecks()) {
     outer_graph->SetHasBoundsChecks(true);
@@ -41,6 +41,7 @@
 #include "offsets.h"
 #include "primitive.h"
 #include "utils/intrusive_forward_list.h"
+#include "utils/type_reference.h"
 
 namespace art {
 
@@ -309,6 +310,7 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
          InvokeType invoke_type = kInvalidInvokeType,
          bool debuggable = false,
          bool osr = false,
+         bool baseline = false,
          int start_instruction_id = 0)
       : arena_(arena),
         blocks_(arena->Adapter(kArenaAllocBlockList)),
@@ -342,7 +344,10 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         art_method_(nullptr),
         inexact_object_rti_(ReferenceTypeInfo::CreateInvalid()),
         osr_(osr),
-        cha_single_implementation_list_(arena->Adapter(kArenaAllocCHA)) {
+        baseline_(baseline),
+        cha_single_implementation_list_(arena->Adapter(kArenaAllocCHA)),
+        assumed_initialized_classes_(TypeReferenceValueComparator(),
+                                     arena->Adapter(kArenaAllocGraph)) {
     blocks_.reserve(kDefaultNumberOfBlocks);
   }
 
@@ -547,6 +552,8 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
 
   bool IsCompilingOsr() const { return osr_; }
 
+  bool IsCompilingBaseline() const { return baseline_; }
+
   ArenaSet<ArtMethod*>& GetCHASingleImplementationList() {
     return cha_single_implementation_list_;
   }
@@ -555,6 +562,15 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
     cha_single_implementation_list_.insert(method);
   }
 
+  const ArenaSet<TypeReference, TypeReferenceValueComparator>&
+  GetAssumedInitializedClasses() const {
+    return assumed_initialized_classes_;
+  }
+
+  void AddAssumedInitializedClass(TypeReference type) {
+    assumed_initialized_classes_.insert(type);
+  }
+
   bool HasShouldDeoptimizeFlag() const {
     return number_of_cha_guards_ != 0;
   }
@@ -724,9 +740,19 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // compiled code entries which the interpreter can directly jump to.
   const bool osr_;
 
+  // Whether we are compiling baseline code for the JIT: only a minimal set of
+  // optimizations is run, and the generated code counts method entries and loop
+  // back edges so that the runtime can recompile the method once it stays hot.
+  const bool baseline_;
+
   // List of methods that are assumed to have single implementation.
   ArenaSet<ArtMethod*> cha_single_implementation_list_;
 
+  // Classes the code assumes to be initialized, without a class initialization check.
+  // Only recorded when compiling for the persistent JIT code cache, which installs the
+  // code in later runs.
+  ArenaSet<TypeReference, TypeReferenceValueComparator> assumed_initialized_classes_;
+
   friend class SsaBuilder;           // For caching constants.
   friend class SsaLivenessAnalysis;  // For the linear order.
   friend class HInliner;             // For the reverse post order.
@@ -1362,7 +1388,8 @@ class HLoopInformationOutwardIterator : public ValueObject {
   M(UShr, BinaryOperation)                                              \
   M(Xor, BinaryOperation)                                               \
   M(VecReplicateScalar, VecUnaryOperation)                              \
-  M(VecSumReduce, VecUnaryOperation)                                    \
+  M(VecExtractScalar, VecUnaryOperation)                                \
+  M(VecReduce, VecUnaryOperation)                                       \
   M(VecCnv, VecUnaryOperation)                                          \
   M(VecNeg, VecUnaryOperation)                                          \
   M(VecAbs, VecUnaryOperation)                                          \
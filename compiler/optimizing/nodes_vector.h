@@ -87,8 +87,9 @@ class HVecOperation : public HVariableInputSizeInstruction {
 
   // Returns the type of the vector operation: a SIMD operation looks like a FPU location.
   // TODO: we could introduce SIMD types in HIR.
+  static constexpr Primitive::Type kSIMDType = Primitive::kPrimDouble;
   Primitive::Type GetType() const OVERRIDE {
-    return Primitive::kPrimDouble;
+    return kSIMDType;
   }
 
   // Returns the true component type packed in a vector.
@@ -96,6 +97,21 @@ class HVecOperation : public HVariableInputSizeInstruction {
     return GetPackedField<TypeField>();
   }
 
+  // Returns true if the given instruction produces a SIMD value, i.e. it is a vector
+  // operation other than a scalar extraction, or a phi that carries a vectorized reduction.
+  static bool ReturnsSIMDValue(HInstruction* instruction) {
+    if (instruction->IsVecOperation()) {
+      return !instruction->IsVecExtractScalar();  // only scalar returning vec op
+    } else if (instruction->IsPhi()) {
+      // The vectorizer only uses phis for reductions, so checking for a 2-way
+      // phi with a direct vector operand as second argument suffices.
+      return instruction->GetType() == kSIMDType &&
+             instruction->InputCount() == 2 &&
+             instruction->InputAt(1)->IsVecOperation();
+    }
+    return false;
+  }
+
   DECLARE_ABSTRACT_INSTRUCTION(VecOperation);
 
  protected:
@@ -194,6 +210,9 @@ class HVecMemoryOperation : public HVecOperation {
 
 // Packed type consistency checker (same vector length integral types may mix freely).
 inline static bool HasConsistentPackedTypes(HInstruction* input, Primitive::Type type) {
+  if (input->IsPhi()) {
+    return input->GetType() == HVecOperation::kSIMDType;  // carries SIMD
+  }
   DCHECK(input->IsVecOperation());
   Primitive::Type input_type = input->AsVecOperation()->GetPackedType();
   switch (input_type) {
@@ -231,24 +250,63 @@ class HVecReplicateScalar FINAL : public HVecUnaryOperation {
   DISALLOW_COPY_AND_ASSIGN(HVecReplicateScalar);
 };
 
-// Sum-reduces the given vector into a shorter vector (m < n) or scalar (m = 1),
-// viz. sum-reduce[ x1, .. , xn ] = [ y1, .., ym ], where yi = sum_j x_j.
-class HVecSumReduce FINAL : public HVecUnaryOperation {
-  HVecSumReduce(ArenaAllocator* arena,
-                HInstruction* input,
-                Primitive::Type packed_type,
-                size_t vector_length,
-                uint32_t dex_pc = kNoDexPc)
+// Extracts a particular scalar from the given vector,
+// viz. extract[ x1, .. , xn ] = x_i.
+//
+// TODO: for now only i == 1 case supported.
+class HVecExtractScalar FINAL : public HVecUnaryOperation {
+ public:
+  HVecExtractScalar(ArenaAllocator* arena,
+                    HInstruction* input,
+                    Primitive::Type packed_type,
+                    size_t vector_length,
+                    size_t index,
+                    uint32_t dex_pc = kNoDexPc)
       : HVecUnaryOperation(arena, input, packed_type, vector_length, dex_pc) {
     DCHECK(HasConsistentPackedTypes(input, packed_type));
+    DCHECK_LT(index, vector_length);
+    DCHECK_EQ(index, 0u);
   }
 
-  // TODO: probably integral promotion
-  Primitive::Type GetType() const OVERRIDE { return GetPackedType(); }
+  // Yields a single component in the vector.
+  Primitive::Type GetType() const OVERRIDE {
+    return GetPackedType();
+  }
 
-  DECLARE_INSTRUCTION(VecSumReduce);
+  DECLARE_INSTRUCTION(VecExtractScalar);
  private:
-  DISALLOW_COPY_AND_ASSIGN(HVecSumReduce);
+  DISALLOW_COPY_AND_ASSIGN(HVecExtractScalar);
+};
+
+// Reduces the given vector into the first element as sum/min/max,
+// viz. sum-reduce[ x1, .. , xn ] = [ y, ---- ], where y = sum xi
+// and the "-" denotes "don't care" (implementation dependent).
+class HVecReduce FINAL : public HVecUnaryOperation {
+ public:
+  enum ReductionKind {
+    kSum = 1,
+    kMin = 2,
+    kMax = 3
+  };
+
+  HVecReduce(ArenaAllocator* arena,
+             HInstruction* input,
+             Primitive::Type packed_type,
+             size_t vector_length,
+             ReductionKind kind,
+             uint32_t dex_pc = kNoDexPc)
+      : HVecUnaryOperation(arena, input, packed_type, vector_length, dex_pc),
+        kind_(kind) {
+    DCHECK(HasConsistentPackedTypes(input, packed_type));
+  }
+
+  ReductionKind GetKind() const { return kind_; }
+
+  DECLARE_INSTRUCTION(VecReduce);
+ private:
+  const ReductionKind kind_;
+
+  DISALLOW_COPY_AND_ASSIGN(HVecReduce);
 };
 
 // Converts every component in the vector,
@@ -611,22 +669,26 @@ class HVecUShr FINAL : public HVecBinaryOperation {
 //
 
 // Assigns the given scalar elements to a vector,
-// viz. set( array(x1, .., xn) ) = [ x1, .. , xn ].
+// viz. set( array(x1, .. , xm) ) = [ x1, .. , xm, 0, .. , 0 ] if m <  n,
+//      set( array(x1, .. , xn) ) = [ x1, .. ,            xn ] if m == n.
 class HVecSetScalars FINAL : public HVecOperation {
+ public:
   HVecSetScalars(ArenaAllocator* arena,
-                 HInstruction** scalars,  // array
+                 HInstruction* scalars[],
                  Primitive::Type packed_type,
                  size_t vector_length,
+                 size_t number_of_scalars,
                  uint32_t dex_pc = kNoDexPc)
       : HVecOperation(arena,
                       packed_type,
                       SideEffects::None(),
-                      /* number_of_inputs */ vector_length,
+                      number_of_scalars,
                       vector_length,
                       dex_pc) {
-    for (size_t i = 0; i < vector_length; i++) {
-      DCHECK(!scalars[i]->IsVecOperation());
-      SetRawInputAt(0, scalars[i]);
+    DCHECK_LE(number_of_scalars, vector_length);
+    for (size_t i = 0; i < number_of_scalars; i++) {
+      DCHECK(!HVecOperation::ReturnsSIMDValue(scalars[i]));
+      SetRawInputAt(i, scalars[i]);
     }
   }
   DECLARE_INSTRUCTION(VecSetScalars);
@@ -637,6 +699,13 @@ class HVecSetScalars FINAL : public HVecOperation {
 // Multiplies every component in the two vectors, adds the result vector to the accumulator vector.
 // viz. [ acc1, .., accn ] + [ x1, .. , xn ] * [ y1, .. , yn ] =
 //     [ acc1 + x1 * y1, .. , accn + xn * yn ].
+// The operands may also be packed in a narrower type than the accumulator (with the same
+// vector width in bytes), in which case each accumulator component adds the widened products
+// of several operand components, viz. for two operands per component
+//     [ acc1, .., accm ] + [ x1, .. , xn ] * [ y1, .. , yn ] =
+//     [ acc1 + x1 * y1 + x2 * y2, .. , accm + xn-1 * yn-1 + xn * yn ].
+// Only the sum over all accumulator components is well-defined for such a widening
+// multiply-accumulate, so it may only be used to compute dot-product reductions.
 class HVecMultiplyAccumulate FINAL : public HVecOperation {
  public:
   HVecMultiplyAccumulate(ArenaAllocator* arena,
@@ -656,8 +725,9 @@ class HVecMultiplyAccumulate FINAL : public HVecOperation {
         op_kind_(op) {
     DCHECK(op == InstructionKind::kAdd || op == InstructionKind::kSub);
     DCHECK(HasConsistentPackedTypes(accumulator, packed_type));
-    DCHECK(HasConsistentPackedTypes(mul_left, packed_type));
-    DCHECK(HasConsistentPackedTypes(mul_right, packed_type));
+    DCHECK(HasConsistentPackedTypes(mul_left, packed_type) ||
+           IsWideningOf(mul_left->AsVecOperation(), packed_type, vector_length));
+    DCHECK(HasConsistentPackedTypes(mul_right, mul_left->AsVecOperation()->GetPackedType()));
     SetRawInputAt(kInputAccumulatorIndex, accumulator);
     SetRawInputAt(kInputMulLeftIndex, mul_left);
     SetRawInputAt(kInputMulRightIndex, mul_right);
@@ -675,9 +745,30 @@ class HVecMultiplyAccumulate FINAL : public HVecOperation {
 
   InstructionKind GetOpKind() const { return op_kind_; }
 
+  // Returns the component type packed in the multiplication operands.
+  Primitive::Type GetMulPackedType() const {
+    return InputAt(kInputMulLeftIndex)->AsVecOperation()->GetPackedType();
+  }
+
+  // Returns true if the products are widened into a wider accumulator.
+  bool IsWidening() const {
+    return Primitive::ComponentSize(GetMulPackedType()) <
+        Primitive::ComponentSize(GetPackedType());
+  }
+
   DECLARE_INSTRUCTION(VecMultiplyAccumulate);
 
  private:
+  // Tests if the operand packs a narrower signed integral type into the same vector width.
+  static bool IsWideningOf(HVecOperation* operand,
+                           Primitive::Type packed_type,
+                           size_t vector_length) {
+    Primitive::Type operand_type = operand->GetPackedType();
+    return (operand_type == Primitive::kPrimByte || operand_type == Primitive::kPrimShort) &&
+        packed_type == Primitive::kPrimInt &&
+        operand->GetVectorNumberOfBytes() == vector_length * Primitive::ComponentSize(packed_type);
+  }
+
   // Indicates if this is a MADD or MSUB.
   const InstructionKind op_kind_;
 
@@ -54,6 +54,7 @@
 #include "base/timing_logger.h"
 #include "bounds_check_elimination.h"
 #include "builder.h"
+#include "bytecode_utils.h"
 #include "cha_guard_optimization.h"
 #include "code_generator.h"
 #include "code_sinking.h"
@@ -85,9 +86,12 @@
 #include "licm.h"
 #include "load_store_elimination.h"
 #include "loop_optimization.h"
+#include "loop_unrolling.h"
 #include "nodes.h"
 #include "oat_quick_method_header.h"
+#include "partial_redundancy_elimination.h"
 #include "prepare_for_register_allocation.h"
+#include "range_simplification.h"
 #include "reference_type_propagation.h"
 #include "register_allocator_linear_scan.h"
 #include "select_generator.h"
@@ -146,8 +150,11 @@ class PassObserver : public ValueObject {
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
                CompilerDriver* compiler_driver,
+               OptimizingCompilerStats* stats,
                Mutex& dump_mutex)
       : graph_(graph),
+        stats_(stats),
+        arena_bytes_at_pass_start_(0u),
         cached_method_name_(),
         timing_logger_enabled_(compiler_driver->GetDumpPasses()),
         timing_logger_(timing_logger_enabled_ ? GetMethodName() : "", true, true),
@@ -205,6 +212,9 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (stats_ != nullptr) {
+      arena_bytes_at_pass_start_ = graph_->GetArena()->BytesUsed();
+    }
   }
 
   void FlushVisualizer() REQUIRES(!visualizer_dump_mutex_) {
@@ -220,6 +230,12 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
+    if (stats_ != nullptr) {
+      // Arena memory is only released when the method is done, so the growth during
+      // the pass is what the pass adds to the peak memory of the compilation.
+      size_t arena_bytes = graph_->GetArena()->BytesUsed() - arena_bytes_at_pass_start_;
+      stats_->RecordPassArenaBytes(Thread::Current(), pass_name, arena_bytes);
+    }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass */ true, graph_in_bad_state_);
       FlushVisualizer();
@@ -256,6 +272,10 @@ class PassObserver : public ValueObject {
 
   HGraph* const graph_;
 
+  // Compilation statistics, if requested with --dump-stats.
+  OptimizingCompilerStats* const stats_;
+  size_t arena_bytes_at_pass_start_;
+
   std::string cached_method_name_;
 
   bool timing_logger_enabled_;
@@ -338,7 +358,11 @@ class OptimizingCompiler FINAL : public Compiler {
     }
   }
 
-  bool JitCompile(Thread* self, jit::JitCodeCache* code_cache, ArtMethod* method, bool osr)
+  bool JitCompile(Thread* self,
+                  jit::JitCodeCache* code_cache,
+                  ArtMethod* method,
+                  bool osr,
+                  bool baseline)
       OVERRIDE
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -381,6 +405,7 @@ class OptimizingCompiler FINAL : public Compiler {
                             Handle<mirror::DexCache> dex_cache,
                             ArtMethod* method,
                             bool osr,
+                            bool baseline,
                             VariableSizedHandleScope* handles) const;
 
   void MaybeRunInliner(HGraph* graph,
@@ -505,13 +530,23 @@ static HOptimization* BuildOptimization(
   } else if (opt_name == LICM::kLoopInvariantCodeMotionPassName) {
     CHECK(most_recent_side_effects != nullptr);
     return new (arena) LICM(graph, *most_recent_side_effects, stats);
+  } else if (opt_name ==
+             HPartialRedundancyElimination::kPartialRedundancyEliminationPassName) {
+    CHECK(most_recent_side_effects != nullptr);
+    return new (arena) HPartialRedundancyElimination(graph, *most_recent_side_effects, stats);
   } else if (opt_name == LoadStoreElimination::kLoadStoreEliminationPassName) {
     CHECK(most_recent_side_effects != nullptr);
     return new (arena) LoadStoreElimination(graph, *most_recent_side_effects);
   } else if (opt_name == SideEffectsAnalysis::kSideEffectsAnalysisPassName) {
     return new (arena) SideEffectsAnalysis(graph);
   } else if (opt_name == HLoopOptimization::kLoopOptimizationPassName) {
-    return new (arena) HLoopOptimization(graph, driver, most_recent_induction);
+    return new (arena) HLoopOptimization(graph, driver, most_recent_induction, stats);
+  } else if (opt_name == HRangeSimplification::kRangeSimplificationPassName) {
+    CHECK(most_recent_induction != nullptr);
+    return new (arena) HRangeSimplification(graph, most_recent_induction, stats);
+  } else if (opt_name == HLoopUnrolling::kLoopUnrollingPassName) {
+    CHECK(most_recent_induction != nullptr);
+    return new (arena) HLoopUnrolling(graph, most_recent_induction, stats);
   } else if (opt_name == CHAGuardOptimization::kCHAGuardOptimizationPassName) {
     return new (arena) CHAGuardOptimization(graph);
   } else if (opt_name == CodeSinking::kCodeSinkingPassName) {
@@ -645,11 +680,23 @@ void OptimizingCompiler::RunArchOptimizations(InstructionSet instruction_set,
         fixups
       };
       RunOptimizations(arm_optimizations, arraysize(arm_optimizations), pass_observer);
+      if (!graph->IsCompilingBaseline()) {
+        // Scheduling runs last, so that it also orders the dex cache arrays bases
+        // inserted by the fixups.
+        HInstructionScheduling* scheduling = new (arena) HInstructionScheduling(
+            graph, instruction_set, GetCompilerDriver()->GetInstructionSetFeatures());
+        HOptimization* arm_scheduling[] = { scheduling };
+        RunOptimizations(arm_scheduling, arraysize(arm_scheduling), pass_observer);
+      }
       break;
     }
 #endif
 #ifdef ART_ENABLE_CODEGEN_arm64
     case kArm64: {
+      if (graph->IsCompilingBaseline()) {
+        // None of the ARM64 passes are needed for correctness.
+        break;
+      }
       arm64::InstructionSimplifierArm64* simplifier =
           new (arena) arm64::InstructionSimplifierArm64(graph, stats);
       SideEffectsAnalysis* side_effects = new (arena) SideEffectsAnalysis(graph);
@@ -702,6 +749,12 @@ void OptimizingCompiler::RunArchOptimizations(InstructionSet instruction_set,
           memory_gen
       };
       RunOptimizations(x86_64_optimizations, arraysize(x86_64_optimizations), pass_observer);
+      if (!graph->IsCompilingBaseline()) {
+        HInstructionScheduling* scheduling =
+            new (arena) HInstructionScheduling(graph, instruction_set);
+        HOptimization* x86_64_scheduling[] = { scheduling };
+        RunOptimizations(x86_64_scheduling, arraysize(x86_64_scheduling), pass_observer);
+      }
       break;
     }
 #endif
@@ -710,6 +763,16 @@ void OptimizingCompiler::RunArchOptimizations(InstructionSet instruction_set,
   }
 }
 
+// Returns the number of dex instructions of `code_item`, which is what the method size
+// thresholds of CompilerOptions are expressed in.
+static size_t CountDexInstructions(const DexFile::CodeItem& code_item) {
+  size_t count = 0u;
+  for (CodeItemIterator it(code_item); !it.Done(); it.Advance()) {
+    ++count;
+  }
+  return count;
+}
+
 NO_INLINE  // Avoid increasing caller's frame size by large stack-allocated objects.
 static void AllocateRegisters(HGraph* graph,
                               CodeGenerator* codegen,
@@ -753,6 +816,23 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
     return;
   }
 
+  if (graph->IsCompilingBaseline()) {
+    // Baseline code only lives until the method is recompiled with all optimizations,
+    // so favor compilation speed: no inlining, BCE, LICM, loop optimizations or scheduling.
+    HOptimization* baseline_optimizations[] = {
+      new (arena) IntrinsicsRecognizer(graph, stats),
+      new (arena) HSharpening(graph, codegen, dex_compilation_unit, driver, handles),
+      new (arena) HDeadCodeElimination(graph, stats, "dead_code_elimination$initial"),
+      // The codegen has a few assumptions that only the instruction simplifier
+      // can satisfy.
+      new (arena) InstructionSimplifier(
+          graph, codegen, stats, "instruction_simplifier$before_codegen"),
+    };
+    RunOptimizations(baseline_optimizations, arraysize(baseline_optimizations), pass_observer);
+    RunArchOptimizations(driver->GetInstructionSet(), graph, codegen, pass_observer);
+    return;
+  }
+
   HDeadCodeElimination* dce1 = new (arena) HDeadCodeElimination(
       graph, stats, "dead_code_elimination$initial");
   HDeadCodeElimination* dce2 = new (arena) HDeadCodeElimination(
@@ -771,9 +851,13 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
       graph, "side_effects$before_lse");
   GVNOptimization* gvn = new (arena) GVNOptimization(graph, *side_effects1);
   LICM* licm = new (arena) LICM(graph, *side_effects1, stats);
+  HPartialRedundancyElimination* pre =
+      new (arena) HPartialRedundancyElimination(graph, *side_effects1, stats);
   HInductionVarAnalysis* induction = new (arena) HInductionVarAnalysis(graph);
   BoundsCheckElimination* bce = new (arena) BoundsCheckElimination(graph, *side_effects1, induction);
-  HLoopOptimization* loop = new (arena) HLoopOptimization(graph, driver, induction);
+  HRangeSimplification* range = new (arena) HRangeSimplification(graph, induction, stats);
+  HLoopOptimization* loop = new (arena) HLoopOptimization(graph, driver, induction, stats);
+  HLoopUnrolling* unroll = new (arena) HLoopUnrolling(graph, induction, stats);
   LoadStoreElimination* lse = new (arena) LoadStoreElimination(graph, *side_effects2);
   HSharpening* sharpening = new (arena) HSharpening(
       graph, codegen, dex_compilation_unit, driver, handles);
@@ -808,10 +892,13 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
     side_effects1,
     gvn,
     licm,
+    pre,
     induction,
     bce,
+    range,
     loop,
-    fold3,  // evaluates code generated by dynamic bce
+    unroll,
+    fold3,  // evaluates code generated by dynamic bce and unrolling
     simplify3,
     side_effects2,
     lse,
@@ -888,6 +975,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                                               Handle<mirror::DexCache> dex_cache,
                                               ArtMethod* method,
                                               bool osr,
+                                              bool baseline,
                                               VariableSizedHandleScope* handles) const {
   MaybeRecordStat(MethodCompilationStat::kAttemptCompilation);
   CompilerDriver* compiler_driver = GetCompilerDriver();
@@ -937,7 +1025,8 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
       compiler_driver->GetInstructionSet(),
       kInvalidInvokeType,
       compiler_driver->GetCompilerOptions().GetDebuggable(),
-      osr);
+      osr,
+      baseline);
 
   const uint8_t* interpreter_metadata = nullptr;
   if (method == nullptr) {
@@ -971,6 +1060,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                              codegen.get(),
                              visualizer_output_.get(),
                              compiler_driver,
+                             compilation_stats_.get(),
                              dump_mutex_);
 
   {
@@ -1017,8 +1107,13 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                    &pass_observer,
                    handles);
 
+  // The JIT trades allocation quality for compile time on baseline code and
+  // large methods, where the register allocator dominates compilation.
   RegisterAllocator::Strategy regalloc_strategy =
-    compiler_options.GetRegisterAllocationStrategy();
+    (!Runtime::Current()->IsAotCompiler() &&
+     (baseline || compiler_options.IsLargeMethod(CountDexInstructions(*code_item))))
+        ? compiler_options.GetJitFastRegisterAllocationStrategy()
+        : compiler_options.GetRegisterAllocationStrategy();
   AllocateRegisters(graph, codegen.get(), &pass_observer, regalloc_strategy);
 
   codegen->Compile(code_allocator);
@@ -1064,11 +1159,15 @@ CompiledMethod* OptimizingCompiler::Compile(const DexFile::CodeItem* code_item,
                      dex_cache,
                      nullptr,
                      /* osr */ false,
+                     /* baseline */ false,
                      &handles));
     }
     if (codegen.get() != nullptr) {
       MaybeRecordStat(MethodCompilationStat::kCompiled);
       method = Emit(&arena, &code_allocator, codegen.get(), compiler_driver, code_item);
+      if (compilation_stats_.get() != nullptr) {
+        compilation_stats_->RecordMethodArenaBytes(arena.BytesUsed());
+      }
 
       if (kArenaAllocatorCountAllocations) {
         if (arena.BytesAllocated() > kArenaAllocatorMemoryReportThreshold) {
@@ -1114,19 +1213,37 @@ bool IsCompilingWithCoreImage() {
   return false;
 }
 
-bool EncodeArtMethodInInlineInfo(ArtMethod* method ATTRIBUTE_UNUSED) {
+bool IsCompilingForPersistentJitCodeCache() {
+  Runtime* runtime = Runtime::Current();
+  return runtime != nullptr &&
+      runtime->GetJit() != nullptr &&
+      runtime->GetJit()->GetCodeCache()->IsPersistent();
+}
+
+bool EncodeArtMethodInInlineInfo(ArtMethod* method) {
   // Note: the runtime is null only for unit testing.
-  return Runtime::Current() == nullptr || !Runtime::Current()->IsAotCompiler();
+  if (Runtime::Current() == nullptr) {
+    return true;
+  }
+  if (Runtime::Current()->IsAotCompiler()) {
+    return false;
+  }
+  // Persistent JIT code can only refer to boot image methods by address.
+  return !IsCompilingForPersistentJitCodeCache() || HSharpening::IsInBootImage(method);
 }
 
 bool CanEncodeInlinedMethodInStackMap(const DexFile& caller_dex_file, ArtMethod* callee) {
-  if (!Runtime::Current()->IsAotCompiler()) {
+  if (!Runtime::Current()->IsAotCompiler() && !IsCompilingForPersistentJitCodeCache()) {
     // JIT can always encode methods in stack maps.
     return true;
   }
   if (IsSameDexFile(caller_dex_file, *callee->GetDexFile())) {
     return true;
   }
+  if (EncodeArtMethodInInlineInfo(callee)) {
+    // Boot image methods inlined in persistent JIT code.
+    return true;
+  }
   // TODO(ngeoffray): Support more AOT cases for inlining:
   // - methods in multidex
   // - methods in boot image for on-device non-PIC compilation.
@@ -1136,7 +1253,8 @@ bool CanEncodeInlinedMethodInStackMap(const DexFile& caller_dex_file, ArtMethod*
 bool OptimizingCompiler::JitCompile(Thread* self,
                                     jit::JitCodeCache* code_cache,
                                     ArtMethod* method,
-                                    bool osr) {
+                                    bool osr,
+                                    bool baseline) {
   StackHandleScope<3> hs(self);
   Handle<mirror::ClassLoader> class_loader(hs.NewHandle(
       method->GetDeclaringClass()->GetClassLoader()));
@@ -1171,6 +1289,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                    dex_cache,
                    method,
                    osr,
+                   baseline,
                    &handles));
     if (codegen.get() == nullptr) {
       return false;
@@ -1221,6 +1340,34 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                           *code_item);
   codegen->EmitJitRoots(code_allocator.GetData(), roots, roots_data);
 
+  if (code_cache->IsPersistent() && !osr && !baseline) {
+    // Only store the final code of a method: OSR code is only entered from the interpreter
+    // of a running loop, and baseline code gets replaced.
+    const ArenaVector<jit::JitRootPatch>& root_patches = codegen->GetJitRootPatches();
+    std::vector<jit::JitClassReference> initialized_classes;
+    for (TypeReference type : codegen->GetGraph()->GetAssumedInitializedClasses()) {
+      initialized_classes.push_back(
+          jit::JitClassReference { type.dex_file, type.type_index.index_ });
+    }
+    code_cache->PersistCode(
+        self,
+        method,
+        stack_map_data,
+        stack_map_size,
+        method_info_data,
+        method_info_size,
+        codegen->HasEmptyFrame() ? 0 : codegen->GetFrameSize(),
+        codegen->GetCoreSpillMask(),
+        codegen->GetFpuSpillMask(),
+        code_allocator.GetMemory().data(),
+        code_allocator.GetSize(),
+        codegen->GetJitRootReferences(),
+        std::vector<jit::JitRootPatch>(root_patches.begin(), root_patches.end()),
+        codegen->GetGraph()->HasShouldDeoptimizeFlag(),
+        codegen->GetGraph()->GetCHASingleImplementationList(),
+        initialized_classes);
+  }
+
   const void* code = code_cache->CommitCode(
       self,
       method,
@@ -1234,6 +1381,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
       code_allocator.GetSize(),
       data_size,
       osr,
+      baseline,
       roots,
       codegen->GetGraph()->HasShouldDeoptimizeFlag(),
       codegen->GetGraph()->GetCHASingleImplementationList());
@@ -34,6 +34,10 @@ Compiler* CreateOptimizingCompiler(CompilerDriver* driver);
 // information for checking invariants.
 bool IsCompilingWithCoreImage();
 
+// Returns whether the JIT compiles code for the persistent code cache. Such code may
+// only embed addresses of the boot image, as it gets installed again in later runs.
+bool IsCompilingForPersistentJitCodeCache();
+
 bool EncodeArtMethodInInlineInfo(ArtMethod* method);
 bool CanEncodeInlinedMethodInStackMap(const DexFile& caller_dex_file, ArtMethod* callee)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -17,12 +17,16 @@
 #ifndef ART_COMPILER_OPTIMIZING_OPTIMIZING_COMPILER_STATS_H_
 #define ART_COMPILER_OPTIMIZING_OPTIMIZING_COMPILER_STATS_H_
 
+#include <algorithm>
 #include <atomic>
 #include <iomanip>
+#include <map>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "atomic.h"
+#include "base/mutex.h"
 
 namespace art {
 
@@ -86,12 +90,22 @@ enum MethodCompilationStat {
   kNotInlinedWont,
   kNotInlinedRecursiveBudget,
   kNotInlinedProxy,
+  kLoopVectorized,
+  kLoopVersioned,
+  kVersionedBoundsCheck,
+  kLoopFullyUnrolled,
+  kLoopPeeled,
+  kLoopPartiallyUnrolled,
+  kNotInlinedColdCallSite,
+  kPartialRedundancyEliminated,
+  kGuardedLoopInvariantMoved,
+  kRangeSimplified,
   kLastStat
 };
 
 class OptimizingCompilerStats {
  public:
-  OptimizingCompilerStats() {
+  OptimizingCompilerStats() : pass_arena_bytes_lock_("Pass arena bytes lock") {
     // The std::atomic<> default constructor leaves values uninitialized, so initialize them now.
     Reset();
   }
@@ -100,6 +114,23 @@ class OptimizingCompilerStats {
     compile_stats_[stat] += count;
   }
 
+  // Record the arena memory allocated by a single run of the pass `pass_name`.
+  // Only the largest amount seen for each pass is kept.
+  void RecordPassArenaBytes(Thread* self, const char* pass_name, size_t bytes)
+      REQUIRES(!pass_arena_bytes_lock_) {
+    MutexLock mu(self, pass_arena_bytes_lock_);
+    size_t& peak = pass_arena_bytes_[pass_name];
+    peak = std::max(peak, bytes);
+  }
+
+  // Record the arena memory used for compiling a single method.
+  void RecordMethodArenaBytes(size_t bytes) {
+    size_t peak = method_arena_bytes_.load(std::memory_order_relaxed);
+    while (peak < bytes &&
+           !method_arena_bytes_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+  }
+
   void Log() const {
     if (!kIsDebugBuild && !VLOG_IS_ON(compiler)) {
       // Log only in debug builds or if the compiler is verbose.
@@ -121,6 +152,7 @@ class OptimizingCompilerStats {
               << compile_stats_[i];
         }
       }
+      LogArenaBytes();
     }
   }
 
@@ -137,9 +169,27 @@ class OptimizingCompilerStats {
     for (size_t i = 0; i != kLastStat; ++i) {
       compile_stats_[i] = 0u;
     }
+    method_arena_bytes_ = 0u;
   }
 
  private:
+  void LogArenaBytes() const NO_THREAD_SAFETY_ANALYSIS {
+    // Called once compilation is done, so there are no concurrent updates.
+    if (method_arena_bytes_ != 0u) {
+      LOG(INFO) << "Peak arena bytes for a method: " << method_arena_bytes_;
+    }
+    std::vector<std::pair<std::string, size_t>> passes(pass_arena_bytes_.begin(),
+                                                       pass_arena_bytes_.end());
+    std::sort(passes.begin(),
+              passes.end(),
+              [](const std::pair<std::string, size_t>& a, const std::pair<std::string, size_t>& b) {
+                return a.second > b.second;
+              });
+    for (const std::pair<std::string, size_t>& pass : passes) {
+      LOG(INFO) << "Peak arena bytes for pass " << pass.first << ": " << pass.second;
+    }
+  }
+
   std::string PrintMethodCompilationStat(MethodCompilationStat stat) const {
     std::string name;
     switch (stat) {
@@ -202,6 +252,16 @@ class OptimizingCompilerStats {
       case kNotInlinedWont: name = "NotInlinedWont"; break;
       case kNotInlinedRecursiveBudget: name = "NotInlinedRecursiveBudget"; break;
       case kNotInlinedProxy: name = "NotInlinedProxy"; break;
+      case kLoopVectorized: name = "LoopVectorized"; break;
+      case kLoopVersioned: name = "LoopVersioned"; break;
+      case kVersionedBoundsCheck: name = "VersionedBoundsCheck"; break;
+      case kLoopFullyUnrolled: name = "LoopFullyUnrolled"; break;
+      case kLoopPeeled: name = "LoopPeeled"; break;
+      case kLoopPartiallyUnrolled: name = "LoopPartiallyUnrolled"; break;
+      case kNotInlinedColdCallSite: name = "NotInlinedColdCallSite"; break;
+      case kPartialRedundancyEliminated: name = "PartialRedundancyEliminated"; break;
+      case kGuardedLoopInvariantMoved: name = "GuardedLoopInvariantMoved"; break;
+      case kRangeSimplified: name = "RangeSimplified"; break;
 
       case kLastStat:
         LOG(FATAL) << "invalid stat "
@@ -213,6 +273,13 @@ class OptimizingCompilerStats {
 
   std::atomic<uint32_t> compile_stats_[kLastStat];
 
+  // Largest arena usage of a compiled method.
+  std::atomic<size_t> method_arena_bytes_;
+
+  // Largest arena growth of a single run of each pass.
+  Mutex pass_arena_bytes_lock_;
+  std::map<std::string, size_t> pass_arena_bytes_ GUARDED_BY(pass_arena_bytes_lock_);
+
   DISALLOW_COPY_AND_ASSIGN(OptimizingCompilerStats);
 };
 
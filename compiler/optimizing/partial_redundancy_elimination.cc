@@ -0,0 +1,595 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "partial_redundancy_elimination.h"
+
+#include "side_effects_analysis.h"
+
+namespace art {
+
+// Detect an instruction that can be computed in a predecessor of its block.
+static bool IsCandidate(HInstruction* instruction) {
+  switch (instruction->GetKind()) {
+    case HInstruction::kAdd:
+    case HInstruction::kSub:
+    case HInstruction::kMul:
+    case HInstruction::kDiv:
+    case HInstruction::kRem:
+    case HInstruction::kAnd:
+    case HInstruction::kOr:
+    case HInstruction::kXor:
+    case HInstruction::kShl:
+    case HInstruction::kShr:
+    case HInstruction::kUShr:
+    case HInstruction::kNeg:
+    case HInstruction::kNot:
+    case HInstruction::kBooleanNot:
+    case HInstruction::kTypeConversion:
+    case HInstruction::kArrayLength:
+    case HInstruction::kArrayGet:
+    case HInstruction::kInstanceFieldGet:
+      // Volatile loads cannot be moved.
+      return instruction->CanBeMoved() && !instruction->CanThrow();
+    default:
+      return false;
+  }
+}
+
+// Returns the value of `input` when entering `block` from its predecessor
+// at `predecessor_index`.
+static HInstruction* Translate(HInstruction* input, HBasicBlock* block, size_t predecessor_index) {
+  return (input->IsPhi() && input->GetBlock() == block) ? input->InputAt(predecessor_index) : input;
+}
+
+// Construct a phi(instruction, 0) in the block after a loop-entry guard, for the
+// path that does not enter the loop. These are synthetic phi nodes without a
+// virtual register.
+static HPhi* NewPhi(HBasicBlock* block, HInstruction* instruction) {
+  HGraph* graph = block->GetGraph();
+  Primitive::Type type = instruction->GetType();
+  HInstruction* zero;
+  switch (type) {
+    case Primitive::kPrimNot: zero = graph->GetNullConstant(); break;
+    case Primitive::kPrimFloat: zero = graph->GetFloatConstant(0); break;
+    case Primitive::kPrimDouble: zero = graph->GetDoubleConstant(0); break;
+    default: zero = graph->GetConstant(type, 0); break;
+  }
+  HPhi* phi = new (graph->GetArena())
+      HPhi(graph->GetArena(), kNoRegNumber, /*number_of_inputs*/ 2, HPhi::ToPhiType(type));
+  phi->SetRawInputAt(0, instruction);
+  phi->SetRawInputAt(1, zero);
+  if (type == Primitive::kPrimNot) {
+    phi->SetReferenceTypeInfo(instruction->GetReferenceTypeInfo());
+  }
+  block->AddPhi(phi);
+  return phi;
+}
+
+//
+// Class methods.
+//
+
+HPartialRedundancyElimination::HPartialRedundancyElimination(
+    HGraph* graph,
+    const SideEffectsAnalysis& side_effects,
+    OptimizingCompilerStats* stats)
+    : HOptimization(graph, kPartialRedundancyEliminationPassName, stats),
+      side_effects_(side_effects),
+      global_allocator_(graph->GetArena()),
+      guard_blocks_(std::less<uint32_t>(), graph->GetArena()->Adapter(kArenaAllocGvn)) {
+}
+
+void HPartialRedundancyElimination::Run() {
+  DCHECK(side_effects_.HasRun());
+
+  // Merge points first. This only adds instructions to existing blocks, so the
+  // per-block side effects remain valid.
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    if (block->GetPredecessors().size() > 1 && !block->IsLoopHeader()) {
+      VisitMergeBlock(block);
+    }
+  }
+
+  // We should never deoptimize from an osr method, otherwise we might wrongly
+  // optimize code dominated by the deoptimization.
+  if (graph_->IsCompilingOsr()) {
+    return;
+  }
+
+  // Guarding a loop adds blocks, so collect the loops first. Post order
+  // visits inner loops before outer loops.
+  ArenaVector<HLoopInformation*> loops(global_allocator_->Adapter(kArenaAllocGvn));
+  for (HBasicBlock* block : graph_->GetPostOrder()) {
+    if (block->IsLoopHeader()) {
+      loops.push_back(block->GetLoopInformation());
+    }
+  }
+  for (HLoopInformation* loop : loops) {
+    if (IsGuardableLoop(loop)) {
+      VisitLoop(loop);
+    }
+  }
+}
+
+//
+// Merge points.
+//
+
+void HPartialRedundancyElimination::VisitMergeBlock(HBasicBlock* block) {
+  if (block->IsCatchBlock()) {
+    return;
+  }
+  HLoopInformation* loop_info = block->GetLoopInformation();
+  if (loop_info != nullptr && loop_info->ContainsIrreducibleLoop()) {
+    // As in GVN, do not extend the liveness of instructions in irreducible loops.
+    return;
+  }
+  // Only the normal control flow of a predecessor can be extended.
+  for (HBasicBlock* predecessor : block->GetPredecessors()) {
+    if (!predecessor->GetLastInstruction()->IsGoto()) {
+      return;
+    }
+  }
+
+  // An instruction computed at the end of the predecessors must not depend on
+  // anything written by the instructions preceding it in `block`.
+  SideEffects preceding_effects = SideEffects::None();
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    SideEffects effects = instruction->GetSideEffects();
+    if (IsCandidate(instruction) &&
+        !effects.MayDependOn(preceding_effects) &&
+        TryEliminateAtMerge(instruction)) {
+      MaybeRecordStat(MethodCompilationStat::kPartialRedundancyEliminated);
+    }
+    preceding_effects = preceding_effects.Union(effects);
+  }
+}
+
+bool HPartialRedundancyElimination::TryEliminateAtMerge(HInstruction* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  // Every input must have a value at the end of every predecessor.
+  for (HInstruction* input : instruction->GetInputs()) {
+    bool is_merge_phi = input->IsPhi() && input->GetBlock() == block;
+    if (!is_merge_phi && (input->GetBlock() == block || !input->GetBlock()->Dominates(block))) {
+      return false;
+    }
+  }
+
+  // Find the predecessors where the value is already available.
+  const ArenaVector<HBasicBlock*>& predecessors = block->GetPredecessors();
+  ArenaVector<HInstruction*> values(predecessors.size(),
+                                    nullptr,
+                                    global_allocator_->Adapter(kArenaAllocGvn));
+  bool is_partially_available = false;
+  bool is_same_everywhere = true;
+  for (size_t i = 0; i < predecessors.size(); ++i) {
+    values[i] = FindAvailable(instruction, i);
+    is_partially_available |= (values[i] != nullptr);
+    is_same_everywhere &= (values[i] != nullptr && values[i] == values[0]);
+  }
+  if (!is_partially_available) {
+    return false;
+  }
+
+  HInstruction* replacement = nullptr;
+  if (is_same_everywhere) {
+    replacement = values[0];
+  } else {
+    // Compute the value in the predecessors where it is not available yet,
+    // and merge all values with a phi.
+    HPhi* phi = new (global_allocator_) HPhi(global_allocator_,
+                                             kNoRegNumber,
+                                             predecessors.size(),
+                                             HPhi::ToPhiType(instruction->GetType()));
+    for (size_t i = 0; i < predecessors.size(); ++i) {
+      if (values[i] == nullptr) {
+        HBasicBlock* predecessor = predecessors[i];
+        values[i] = Clone(instruction, i);
+        predecessor->InsertInstructionBefore(values[i], predecessor->GetLastInstruction());
+      }
+      phi->SetRawInputAt(i, values[i]);
+    }
+    if (instruction->GetType() == Primitive::kPrimNot) {
+      phi->SetReferenceTypeInfo(instruction->GetReferenceTypeInfo());
+    }
+    block->AddPhi(phi);
+    replacement = phi;
+  }
+  instruction->ReplaceWith(replacement);
+  block->RemoveInstruction(instruction);
+  return true;
+}
+
+HInstruction* HPartialRedundancyElimination::FindAvailable(HInstruction* instruction,
+                                                           size_t predecessor_index) const {
+  HBasicBlock* block = instruction->GetBlock();
+  HBasicBlock* predecessor = block->GetPredecessors()[predecessor_index];
+  // An equivalent instruction uses the same first input.
+  HInstruction* first_input = Translate(instruction->InputAt(0), block, predecessor_index);
+  for (const HUseListNode<HInstruction*>& use : first_input->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (use.GetIndex() != 0u ||
+        user == instruction ||
+        user->GetKind() != instruction->GetKind() ||
+        user->GetType() != instruction->GetType() ||
+        !user->CanBeMoved() ||
+        !user->InstructionDataEquals(instruction)) {
+      continue;
+    }
+    bool same_inputs = true;
+    for (size_t i = 1, e = instruction->InputCount(); i < e; ++i) {
+      HInstruction* input = Translate(instruction->InputAt(i), block, predecessor_index);
+      same_inputs &= (user->InputAt(i) == input);
+    }
+    if (same_inputs &&
+        user->GetBlock()->Dominates(predecessor) &&
+        !IsKilledBefore(user, predecessor, instruction->GetSideEffects())) {
+      return user;
+    }
+  }
+  return nullptr;
+}
+
+bool HPartialRedundancyElimination::IsKilledBefore(HInstruction* available,
+                                                   HBasicBlock* block,
+                                                   SideEffects effects) const {
+  if (!effects.HasDependencies()) {
+    return false;
+  }
+  // Walk up to the block of `available`, conservatively giving up at merges.
+  while (block != available->GetBlock()) {
+    if (effects.MayDependOn(side_effects_.GetBlockEffects(block)) ||
+        block->GetPredecessors().size() != 1u) {
+      return true;
+    }
+    block = block->GetSinglePredecessor();
+  }
+  for (HInstruction* current = available->GetNext();
+       current != nullptr;
+       current = current->GetNext()) {
+    if (effects.MayDependOn(current->GetSideEffects())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//
+// Loops.
+//
+
+bool HPartialRedundancyElimination::IsGuardableLoop(HLoopInformation* loop) const {
+  // The loop preheader of an irreducible loop does not dominate all the blocks in
+  // the loop, and a try boundary preheader is hard to handle.
+  if (loop->IsIrreducible() ||
+      loop->ContainsIrreducibleLoop() ||
+      !loop->GetPreHeader()->GetLastInstruction()->IsGoto() ||
+      loop->GetHeader()->IsTryBlock()) {
+    return false;
+  }
+  // Deoptimization resumes at the loop header.
+  if (!loop->HasSuspendCheck() || !loop->GetSuspendCheck()->HasEnvironment()) {
+    return false;
+  }
+  // The loop-entry test is the header condition evaluated on the values of the
+  // header phis when entering the loop, so the header must contain nothing else.
+  HBasicBlock* header = loop->GetHeader();
+  HInstruction* control = header->GetLastInstruction();
+  if (!control->IsIf() || !control->InputAt(0)->IsCondition()) {
+    return false;
+  }
+  HCondition* condition = control->InputAt(0)->AsCondition();
+  if (Primitive::IsFloatingPointType(condition->InputAt(0)->GetType())) {
+    return false;
+  }
+  for (HInstruction* input : condition->GetInputs()) {
+    if (!loop->IsDefinedOutOfTheLoop(input) &&
+        !(input->IsPhi() && input->GetBlock() == header)) {
+      return false;
+    }
+  }
+  for (HInstructionIterator it(header->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction != control && instruction != condition && !instruction->IsSuspendCheck()) {
+      return false;
+    }
+  }
+  if (loop->Contains(*control->AsIf()->IfTrueSuccessor()) ==
+      loop->Contains(*control->AsIf()->IfFalseSuccessor())) {
+    return false;
+  }
+  // Early exits may skip the loop-body, so the loop-entry guard would not protect it.
+  for (HBlocksInLoopIterator it_loop(*loop); !it_loop.Done(); it_loop.Advance()) {
+    HBasicBlock* block = it_loop.Current();
+    if (block != header) {
+      for (HBasicBlock* successor : block->GetSuccessors()) {
+        if (!loop->Contains(*successor)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void HPartialRedundancyElimination::VisitLoop(HLoopInformation* loop) {
+  // Collect the null checks executed in every iteration, in dominator order,
+  // so the loads hoisted for one check may make the next check invariant.
+  ArenaVector<HNullCheck*> null_checks(global_allocator_->Adapter(kArenaAllocGvn));
+  for (HBlocksInLoopReversePostOrderIterator it_loop(*loop); !it_loop.Done(); it_loop.Advance()) {
+    HBasicBlock* block = it_loop.Current();
+    if (block->GetLoopInformation() != loop || !loop->DominatesAllBackEdges(block)) {
+      continue;
+    }
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      if (it.Current()->IsNullCheck()) {
+        null_checks.push_back(it.Current()->AsNullCheck());
+      }
+    }
+  }
+  for (HNullCheck* null_check : null_checks) {
+    TryHoistNullCheck(loop, null_check);
+  }
+}
+
+bool HPartialRedundancyElimination::TryHoistNullCheck(HLoopInformation* loop,
+                                                      HNullCheck* null_check) {
+  HInstruction* object = null_check->InputAt(0);
+  if (!loop->IsDefinedOutOfTheLoop(object) || null_check->GetUses().empty()) {
+    return false;
+  }
+  // All users must be loads that are loop invariant once the check is gone.
+  SideEffects loop_effects = side_effects_.GetLoopEffects(loop->GetHeader());
+  ArenaVector<HInstruction*> loads(global_allocator_->Adapter(kArenaAllocGvn));
+  for (const HUseListNode<HInstruction*>& use : null_check->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (!(user->IsInstanceFieldGet() || user->IsArrayLength()) ||
+        !user->CanBeMoved() ||
+        user->GetSideEffects().MayDependOn(loop_effects)) {
+      return false;
+    }
+    DCHECK(loop->Contains(*user->GetBlock()));
+    loads.push_back(user);
+  }
+
+  // Generate: if (object == null) deoptimize; under the loop-entry guard.
+  HBasicBlock* guard = GetGuardBlock(loop);
+  HBasicBlock* preheader = guard->GetSingleSuccessor();
+  // If `object` was hoisted before, use its value within the guard.
+  HInstruction* guarded_object =
+      (object->IsPhi() && object->GetBlock() == preheader) ? object->InputAt(0) : object;
+  HSuspendCheck* suspend = loop->GetSuspendCheck();
+  HInstruction* condition =
+      new (global_allocator_) HEqual(guarded_object, graph_->GetNullConstant());
+  guard->InsertInstructionBefore(condition, guard->GetLastInstruction());
+  HDeoptimize* deoptimize = new (global_allocator_) HDeoptimize(
+      global_allocator_, condition, HDeoptimize::Kind::kBCE, suspend->GetDexPc());
+  guard->InsertInstructionBefore(deoptimize, guard->GetLastInstruction());
+  deoptimize->CopyEnvironmentFromWithLoopPhiAdjustment(suspend->GetEnvironment(),
+                                                       loop->GetHeader());
+
+  // The loop-body now only executes with a non-null `object`.
+  null_check->ReplaceWith(object);
+  null_check->GetBlock()->RemoveInstruction(null_check);
+  MaybeRecordStat(MethodCompilationStat::kGuardedLoopInvariantMoved);
+  for (HInstruction* load : loads) {
+    DCHECK(!load->HasEnvironment());
+    load->MoveBefore(guard->GetLastInstruction());
+    load->ReplaceInput(guarded_object, 0);
+    ReplaceUsesOutsideGuard(load, guard);
+    MaybeRecordStat(MethodCompilationStat::kGuardedLoopInvariantMoved);
+  }
+  return true;
+}
+
+/**
+ * Returns the block that is only executed when the loop is entered, creating
+ * the loop-entry guard on first request:
+ *
+ *          old_preheader
+ *               |
+ *            if_block          <- loop-entry test
+ *            /      \
+ *     true_block  false_block  <- guarded invariants are placed in true_block
+ *            \       /
+ *          new_preheader       <- phi nodes preserve SSA structure
+ *                |
+ *             header
+ */
+HBasicBlock* HPartialRedundancyElimination::GetGuardBlock(HLoopInformation* loop) {
+  HBasicBlock* header = loop->GetHeader();
+  const uint32_t loop_id = header->GetBlockId();
+  auto it = guard_blocks_.find(loop_id);
+  if (it != guard_blocks_.end()) {
+    return it->second;
+  }
+
+  graph_->TransformLoopHeaderForBCE(header);
+  HBasicBlock* new_preheader = loop->GetPreHeader();
+  HBasicBlock* if_block = new_preheader->GetDominator();
+  HBasicBlock* true_block = if_block->GetSuccessors()[0];  // True successor.
+  HBasicBlock* false_block = if_block->GetSuccessors()[1];  // False successor.
+
+  true_block->AddInstruction(new (global_allocator_) HGoto());
+  false_block->AddInstruction(new (global_allocator_) HGoto());
+  new_preheader->AddInstruction(new (global_allocator_) HGoto());
+  HInstruction* test = GenerateLoopEntryTest(loop);
+  if_block->AddInstruction(test);
+  if_block->AddInstruction(new (global_allocator_) HIf(test));
+
+  guard_blocks_.Put(loop_id, true_block);
+  return true_block;
+}
+
+HInstruction* HPartialRedundancyElimination::GenerateLoopEntryTest(HLoopInformation* loop) {
+  HBasicBlock* header = loop->GetHeader();
+  HIf* control = header->GetLastInstruction()->AsIf();
+  HCondition* condition = control->InputAt(0)->AsCondition();
+  // Header phis take their first input when entering the loop.
+  HInstruction* lhs = condition->InputAt(0);
+  HInstruction* rhs = condition->InputAt(1);
+  if (lhs->IsPhi() && lhs->GetBlock() == header) {
+    lhs = lhs->InputAt(0);
+  }
+  if (rhs->IsPhi() && rhs->GetBlock() == header) {
+    rhs = rhs->InputAt(0);
+  }
+  IfCondition cond = loop->Contains(*control->IfTrueSuccessor())
+      ? condition->GetCondition()
+      : condition->GetOppositeCondition();
+  switch (cond) {
+    case kCondEQ: return new (global_allocator_) HEqual(lhs, rhs);
+    case kCondNE: return new (global_allocator_) HNotEqual(lhs, rhs);
+    case kCondLT: return new (global_allocator_) HLessThan(lhs, rhs);
+    case kCondLE: return new (global_allocator_) HLessThanOrEqual(lhs, rhs);
+    case kCondGT: return new (global_allocator_) HGreaterThan(lhs, rhs);
+    case kCondGE: return new (global_allocator_) HGreaterThanOrEqual(lhs, rhs);
+    case kCondB:  return new (global_allocator_) HBelow(lhs, rhs);
+    case kCondBE: return new (global_allocator_) HBelowOrEqual(lhs, rhs);
+    case kCondA:  return new (global_allocator_) HAbove(lhs, rhs);
+    case kCondAE: return new (global_allocator_) HAboveOrEqual(lhs, rhs);
+  }
+  LOG(FATAL) << "Unexpected condition " << static_cast<int>(cond);
+  UNREACHABLE();
+}
+
+void HPartialRedundancyElimination::ReplaceUsesOutsideGuard(HInstruction* instruction,
+                                                            HBasicBlock* guard) {
+  HBasicBlock* preheader = guard->GetSingleSuccessor();
+  HPhi* phi = nullptr;
+  const HUseList<HInstruction*>& uses = instruction->GetUses();
+  for (auto it = uses.begin(), end = uses.end(); it != end; /* ++it below */) {
+    HInstruction* user = it->GetUser();
+    size_t index = it->GetIndex();
+    // Increment `it` now because `*it` may disappear thanks to user->ReplaceInput().
+    ++it;
+    if (user->GetBlock() != guard) {
+      if (phi == nullptr) {
+        phi = NewPhi(preheader, instruction);
+      }
+      user->ReplaceInput(phi, index);  // Removes the use node from the list.
+    }
+  }
+  const HUseList<HEnvironment*>& env_uses = instruction->GetEnvUses();
+  for (auto it = env_uses.begin(), end = env_uses.end(); it != end; /* ++it below */) {
+    HEnvironment* user = it->GetUser();
+    size_t index = it->GetIndex();
+    // Increment `it` now because `*it` may disappear thanks to user->RemoveAsUserOfInput().
+    ++it;
+    if (user->GetHolder()->GetBlock() != guard) {
+      if (phi == nullptr) {
+        phi = NewPhi(preheader, instruction);
+      }
+      user->RemoveAsUserOfInput(index);
+      user->SetRawEnvAt(index, phi);
+      phi->AddEnvUseAt(user, index);
+    }
+  }
+}
+
+//
+// Helpers.
+//
+
+HInstruction* HPartialRedundancyElimination::Clone(HInstruction* instruction,
+                                                   size_t predecessor_index) {
+  HBasicBlock* block = instruction->GetBlock();
+  Primitive::Type type = instruction->GetType();
+  uint32_t dex_pc = instruction->GetDexPc();
+  HInstruction* opa = Translate(instruction->InputAt(0), block, predecessor_index);
+  HInstruction* opb = instruction->InputCount() > 1
+      ? Translate(instruction->InputAt(1), block, predecessor_index)
+      : nullptr;
+  HInstruction* clone = nullptr;
+  switch (instruction->GetKind()) {
+    case HInstruction::kAdd:
+      clone = new (global_allocator_) HAdd(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kSub:
+      clone = new (global_allocator_) HSub(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kMul:
+      clone = new (global_allocator_) HMul(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kDiv:
+      clone = new (global_allocator_) HDiv(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kRem:
+      clone = new (global_allocator_) HRem(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kAnd:
+      clone = new (global_allocator_) HAnd(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kOr:
+      clone = new (global_allocator_) HOr(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kXor:
+      clone = new (global_allocator_) HXor(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kShl:
+      clone = new (global_allocator_) HShl(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kShr:
+      clone = new (global_allocator_) HShr(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kUShr:
+      clone = new (global_allocator_) HUShr(type, opa, opb, dex_pc);
+      break;
+    case HInstruction::kNeg:
+      clone = new (global_allocator_) HNeg(type, opa, dex_pc);
+      break;
+    case HInstruction::kNot:
+      clone = new (global_allocator_) HNot(type, opa, dex_pc);
+      break;
+    case HInstruction::kBooleanNot:
+      clone = new (global_allocator_) HBooleanNot(opa, dex_pc);
+      break;
+    case HInstruction::kTypeConversion:
+      clone = new (global_allocator_) HTypeConversion(type, opa, dex_pc);
+      break;
+    case HInstruction::kArrayLength:
+      clone = new (global_allocator_) HArrayLength(
+          opa, dex_pc, instruction->AsArrayLength()->IsStringLength());
+      break;
+    case HInstruction::kArrayGet:
+      clone = new (global_allocator_) HArrayGet(
+          opa, opb, type, dex_pc, instruction->AsArrayGet()->IsStringCharAt());
+      break;
+    case HInstruction::kInstanceFieldGet: {
+      const FieldInfo& info = instruction->AsInstanceFieldGet()->GetFieldInfo();
+      clone = new (global_allocator_) HInstanceFieldGet(opa,
+                                                        info.GetField(),
+                                                        info.GetFieldType(),
+                                                        info.GetFieldOffset(),
+                                                        info.IsVolatile(),
+                                                        info.GetFieldIndex(),
+                                                        info.GetDeclaringClassDefIndex(),
+                                                        info.GetDexFile(),
+                                                        dex_pc);
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unsupported clone " << instruction->DebugName();
+      UNREACHABLE();
+  }
+  if (type == Primitive::kPrimNot) {
+    clone->SetReferenceTypeInfo(instruction->GetReferenceTypeInfo());
+  }
+  return clone;
+}
+
+}  // namespace art
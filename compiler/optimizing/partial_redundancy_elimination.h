@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_PARTIAL_REDUNDANCY_ELIMINATION_H_
+#define ART_COMPILER_OPTIMIZING_PARTIAL_REDUNDANCY_ELIMINATION_H_
+
+#include "base/arena_containers.h"
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+class SideEffectsAnalysis;
+
+/**
+ * Partial redundancy elimination, which complements GVN and LICM:
+ *  (1) An instruction at a merge point that is already available at the end of
+ *      some of the predecessors is computed at the end of the other predecessors,
+ *      and replaced by a phi of these values. Phis of the merge point are
+ *      translated into the values of each predecessor, so chains of partially
+ *      redundant instructions are handled one after the other.
+ *  (2) A null check of a loop invariant reference in a loop-body, whose users
+ *      are loop invariant loads, is replaced by a deoptimization test under a
+ *      loop-entry guard in front of the loop, where the loads are hoisted to.
+ *      LICM cannot move these, because the check may throw and the loop-body
+ *      is not executed if the loop is not entered.
+ * Both rely on the side effects analysis to know that loads are not killed.
+ */
+class HPartialRedundancyElimination : public HOptimization {
+ public:
+  HPartialRedundancyElimination(HGraph* graph,
+                                const SideEffectsAnalysis& side_effects,
+                                OptimizingCompilerStats* stats);
+
+  void Run() OVERRIDE;
+
+  static constexpr const char* kPartialRedundancyEliminationPassName = "pre";
+
+ private:
+  // Merge points.
+  void VisitMergeBlock(HBasicBlock* block);
+  bool TryEliminateAtMerge(HInstruction* instruction);
+  HInstruction* FindAvailable(HInstruction* instruction, size_t predecessor_index) const;
+  bool IsKilledBefore(HInstruction* available, HBasicBlock* block, SideEffects effects) const;
+
+  // Loops.
+  bool IsGuardableLoop(HLoopInformation* loop) const;
+  void VisitLoop(HLoopInformation* loop);
+  bool TryHoistNullCheck(HLoopInformation* loop, HNullCheck* null_check);
+  HBasicBlock* GetGuardBlock(HLoopInformation* loop);
+  HInstruction* GenerateLoopEntryTest(HLoopInformation* loop);
+  void ReplaceUsesOutsideGuard(HInstruction* instruction, HBasicBlock* guard);
+
+  // Helpers.
+  HInstruction* Clone(HInstruction* instruction, size_t predecessor_index);
+
+  const SideEffectsAnalysis& side_effects_;
+
+  // Global heap memory allocator. Used to build HIR.
+  ArenaAllocator* global_allocator_;
+
+  // Blocks executed only when a loop is entered, where its guarded invariants
+  // are placed, keyed by the id of the loop header.
+  ArenaSafeMap<uint32_t, HBasicBlock*> guard_blocks_;
+
+  DISALLOW_COPY_AND_ASSIGN(HPartialRedundancyElimination);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_PARTIAL_REDUNDANCY_ELIMINATION_H_
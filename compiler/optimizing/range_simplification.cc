@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "range_simplification.h"
+
+#include <algorithm>
+
+#include "base/bit_utils.h"
+
+namespace art {
+
+// Maximum depth of operands followed to find the range of a value.
+static constexpr size_t kMaximumRangeDepth = 4;
+
+// Detect an int, short, char, byte or boolean type.
+static bool IsIntKind(Primitive::Type type) {
+  return Primitive::PrimitiveKind(type) == Primitive::kPrimInt;
+}
+
+// Detect a range that fits the given integral type.
+static bool FitsType(int64_t min, int64_t max, Primitive::Type type) {
+  return Primitive::MinValueOfIntegralType(type) <= min &&
+         max <= Primitive::MaxValueOfIntegralType(type);
+}
+
+// Detect a positive constant mask of consecutive low bits.
+static bool IsLowBitsMask(HInstruction* instruction, /*out*/ int64_t* mask) {
+  if (instruction->IsIntConstant() || instruction->IsLongConstant()) {
+    *mask = Int64FromConstant(instruction->AsConstant());
+    return *mask > 0 && IsPowerOfTwo(*mask + 1);
+  }
+  return false;
+}
+
+// Returns the constant shift distance of a shift operation, masked like the operation itself.
+static bool GetShiftDistance(HBinaryOperation* shift, /*out*/ int64_t* distance) {
+  HInstruction* right = shift->GetRight();
+  if (right->IsIntConstant()) {
+    int64_t mask = shift->GetType() == Primitive::kPrimLong ? kMaxLongShiftDistance
+                                                            : kMaxIntShiftDistance;
+    *distance = right->AsIntConstant()->GetValue() & mask;
+    return true;
+  }
+  return false;
+}
+
+//
+// Class methods.
+//
+
+HRangeSimplification::HRangeSimplification(HGraph* graph,
+                                           HInductionVarAnalysis* induction_analysis,
+                                           OptimizingCompilerStats* stats)
+    : HOptimization(graph, kRangeSimplificationPassName, stats),
+      induction_range_(induction_analysis),
+      global_allocator_(graph->GetArena()),
+      changed_loops_(std::less<HLoopInformation*>(),
+                     graph->GetArena()->Adapter(kArenaAllocOptimization)) {
+}
+
+void HRangeSimplification::Run() {
+  // Operands are simplified before their users, so simplified values are
+  // seen by the range analysis of the users.
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      bool simplified = false;
+      switch (instruction->GetKind()) {
+        case HInstruction::kDivZeroCheck:
+          simplified = TrySimplifyDivZeroCheck(instruction->AsDivZeroCheck());
+          break;
+        case HInstruction::kDiv:
+        case HInstruction::kRem:
+          simplified = TrySimplifyDivOrRem(instruction->AsBinaryOperation());
+          break;
+        case HInstruction::kTypeConversion:
+          simplified = TrySimplifyTypeConversion(instruction->AsTypeConversion());
+          break;
+        case HInstruction::kAnd:
+          simplified = TrySimplifyAnd(instruction->AsAnd());
+          break;
+        case HInstruction::kAdd:
+        case HInstruction::kSub:
+        case HInstruction::kMul:
+          simplified = TryNarrowLongOperation(instruction->AsBinaryOperation());
+          break;
+        default:
+          break;
+      }
+      if (simplified) {
+        MaybeRecordStat(MethodCompilationStat::kRangeSimplified);
+      }
+    }
+  }
+
+  // Recompute the induction information of changed loops, outer loops first
+  // like the induction analysis itself, so that subsequent loop optimizations
+  // see the simplified loop-bodies.
+  if (!changed_loops_.empty()) {
+    for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+      if (block->IsLoopHeader() &&
+          !block->GetLoopInformation()->IsIrreducible() &&
+          changed_loops_.find(block->GetLoopInformation()) != changed_loops_.end()) {
+        induction_range_.ReVisit(block->GetLoopInformation());
+      }
+    }
+  }
+}
+
+//
+// Analysis.
+//
+
+bool HRangeSimplification::GetRange(HInstruction* context,
+                                    HInstruction* instruction,
+                                    /*out*/ int64_t* min,
+                                    /*out*/ int64_t* max,
+                                    size_t depth) {
+  Primitive::Type type = instruction->GetType();
+  if (!Primitive::IsIntegralType(type)) {
+    return false;
+  }
+  if (instruction->IsIntConstant() || instruction->IsLongConstant()) {
+    *min = *max = Int64FromConstant(instruction->AsConstant());
+    return true;
+  }
+  *min = Primitive::MinValueOfIntegralType(type);
+  *max = Primitive::MaxValueOfIntegralType(type);
+  if (depth >= kMaximumRangeDepth) {
+    return true;
+  }
+
+  // Ranges implied by the operation and its operands.
+  int64_t min1 = 0;
+  int64_t max1 = 0;
+  int64_t min2 = 0;
+  int64_t max2 = 0;
+  int64_t distance = 0;
+  switch (instruction->GetKind()) {
+    case HInstruction::kArrayLength:
+      *min = 0;
+      break;
+    case HInstruction::kDivZeroCheck:
+    case HInstruction::kTypeConversion:
+      // A conversion keeps any value that fits the result type.
+      if (GetRange(context, instruction->InputAt(0), &min1, &max1, depth + 1) &&
+          FitsType(min1, max1, type)) {
+        *min = min1;
+        *max = max1;
+      }
+      break;
+    case HInstruction::kAnd:
+      // The result of masking with a non-negative value is bounded by that value.
+      if (GetRange(context, instruction->InputAt(0), &min1, &max1, depth + 1) &&
+          GetRange(context, instruction->InputAt(1), &min2, &max2, depth + 1)) {
+        if (min1 >= 0 && min2 >= 0) {
+          *min = 0;
+          *max = std::min(max1, max2);
+        } else if (min1 >= 0 || min2 >= 0) {
+          *min = 0;
+          *max = min1 >= 0 ? max1 : max2;
+        }
+      }
+      break;
+    case HInstruction::kShr:
+      if (GetShiftDistance(instruction->AsShr(), &distance) &&
+          GetRange(context, instruction->InputAt(0), &min1, &max1, depth + 1)) {
+        *min = min1 >> distance;
+        *max = max1 >> distance;
+      }
+      break;
+    case HInstruction::kUShr:
+      if (GetShiftDistance(instruction->AsUShr(), &distance) && distance != 0) {
+        if (GetRange(context, instruction->InputAt(0), &min1, &max1, depth + 1) && min1 >= 0) {
+          *min = min1 >> distance;
+          *max = max1 >> distance;
+        } else {
+          uint64_t all_bits = type == Primitive::kPrimLong ? std::numeric_limits<uint64_t>::max()
+                                                           : std::numeric_limits<uint32_t>::max();
+          *min = 0;
+          *max = static_cast<int64_t>(all_bits >> distance);
+        }
+      }
+      break;
+    case HInstruction::kRem: {
+      HInstruction* divisor = instruction->InputAt(1);
+      if (divisor->IsDivZeroCheck()) {
+        divisor = divisor->InputAt(0);
+      }
+      if (GetRange(context, divisor, &min2, &max2, depth + 1) && min2 == max2 && min2 != 0) {
+        // The magnitude of the remainder is below the magnitude of the divisor,
+        // and its sign is the sign of the dividend.
+        int64_t bound = (min2 == std::numeric_limits<int64_t>::min())
+            ? std::numeric_limits<int64_t>::max()
+            : std::abs(min2) - 1;
+        bool is_non_negative =
+            GetRange(context, instruction->InputAt(0), &min1, &max1, depth + 1) && min1 >= 0;
+        *min = is_non_negative ? 0 : std::max(*min, -bound);
+        *max = is_non_negative ? std::min(max1, bound) : std::min(*max, bound);
+      }
+      break;
+    }
+    case HInstruction::kAdd:
+    case HInstruction::kSub:
+    case HInstruction::kMul:
+      // Int arithmetic on int bounds cannot overflow a long, so the result
+      // range is exact whenever it fits an int.
+      if (type == Primitive::kPrimInt &&
+          GetRange(context, instruction->InputAt(0), &min1, &max1, depth + 1) &&
+          GetRange(context, instruction->InputAt(1), &min2, &max2, depth + 1)) {
+        int64_t lo = 0;
+        int64_t hi = 0;
+        if (instruction->IsAdd()) {
+          lo = min1 + min2;
+          hi = max1 + max2;
+        } else if (instruction->IsSub()) {
+          lo = min1 - max2;
+          hi = max1 - min2;
+        } else {
+          int64_t products[] = { min1 * min2, min1 * max2, max1 * min2, max1 * max2 };
+          lo = *std::min_element(products, products + arraysize(products));
+          hi = *std::max_element(products, products + arraysize(products));
+        }
+        if (FitsType(lo, hi, type)) {
+          *min = lo;
+          *max = hi;
+        }
+      }
+      break;
+    default:
+      break;
+  }
+
+  // Ranges found by the induction variable analysis of the closest enveloping loop.
+  if (IsIntKind(type)) {
+    InductionVarRange::Value v1;
+    InductionVarRange::Value v2;
+    bool needs_finite_test = false;
+    if (induction_range_.GetInductionRange(context,
+                                           instruction,
+                                           /* chase_hint */ nullptr,
+                                           &v1,
+                                           &v2,
+                                           &needs_finite_test) && !needs_finite_test) {
+      if (v1.is_known && v1.a_constant == 0) {
+        *min = std::max(*min, static_cast<int64_t>(v1.b_constant));
+      }
+      if (v2.is_known && v2.a_constant == 0) {
+        *max = std::min(*max, static_cast<int64_t>(v2.b_constant));
+      }
+    }
+  }
+  return true;
+}
+
+bool HRangeSimplification::IsBelowDivisor(HInstruction* context,
+                                          HInstruction* dividend,
+                                          HInstruction* divisor) {
+  int64_t dividend_min = 0;
+  int64_t dividend_max = 0;
+  if (!GetRange(context, dividend, &dividend_min, &dividend_max) || dividend_min < 0) {
+    return false;
+  }
+  int64_t divisor_min = 0;
+  int64_t divisor_max = 0;
+  if (GetRange(context, divisor, &divisor_min, &divisor_max) && dividend_max < divisor_min) {
+    return true;
+  }
+  // Try to express the upper bound of the dividend in terms of the divisor,
+  // as in the loop-body of for (int i = 0; i < n; i++) { .. i % n .. }.
+  InductionVarRange::Value v1;
+  InductionVarRange::Value v2;
+  bool needs_finite_test = false;
+  return IsIntKind(dividend->GetType()) &&
+         induction_range_.GetInductionRange(context,
+                                            dividend,
+                                            /* chase_hint */ divisor,
+                                            &v1,
+                                            &v2,
+                                            &needs_finite_test) &&
+         !needs_finite_test &&
+         v2.is_known &&
+         v2.instruction == divisor &&
+         v2.a_constant == 1 &&
+         v2.b_constant < 0;
+}
+
+//
+// Simplifications.
+//
+
+bool HRangeSimplification::TrySimplifyDivZeroCheck(HDivZeroCheck* check) {
+  HInstruction* divisor = check->InputAt(0);
+  int64_t min = 0;
+  int64_t max = 0;
+  if (GetRange(check, divisor, &min, &max) && (min > 0 || max < 0)) {
+    Replace(check, divisor);
+    return true;
+  }
+  return false;
+}
+
+bool HRangeSimplification::TrySimplifyDivOrRem(HBinaryOperation* instruction) {
+  Primitive::Type type = instruction->GetType();
+  if (!Primitive::IsIntOrLongType(type)) {
+    return false;
+  }
+  HInstruction* dividend = instruction->GetLeft();
+  HInstruction* divisor = instruction->GetRight();
+  HDivZeroCheck* check = nullptr;
+  if (divisor->IsDivZeroCheck()) {
+    check = divisor->AsDivZeroCheck();
+    divisor = check->InputAt(0);
+  }
+
+  // 0 <= x < y implies x / y == 0 and x % y == x. Since y > 0, a check
+  // right in front of the operation can never throw either.
+  if (IsBelowDivisor(instruction, dividend, divisor)) {
+    bool is_check_in_front = check != nullptr && check->GetBlock() == instruction->GetBlock();
+    Replace(instruction, instruction->IsDiv() ? graph_->GetConstant(type, 0) : dividend);
+    if (is_check_in_front) {
+      Replace(check, divisor);
+    }
+    return true;
+  }
+
+  // A divisor with a single value is a constant, which enables the code
+  // generators to avoid the division instruction.
+  int64_t min = 0;
+  int64_t max = 0;
+  bool simplified = false;
+  if (!divisor->IsConstant() && GetRange(instruction, divisor, &min, &max) &&
+      min == max && min != 0) {
+    instruction->ReplaceInput(graph_->GetConstant(type, min), 1);
+    divisor = instruction->GetRight();
+    simplified = true;
+  }
+
+  // Division and remainder of a non-negative value by a power of two are a
+  // shift and a mask, without the rounding towards zero of negative values.
+  if (divisor->IsConstant()) {
+    int64_t value = Int64FromConstant(divisor->AsConstant());
+    if (value > 1 && IsPowerOfTwo(value) &&
+        GetRange(instruction, dividend, &min, &max) && min >= 0) {
+      HInstruction* replacement = nullptr;
+      if (instruction->IsDiv()) {
+        replacement = new (global_allocator_) HShr(type,
+                                                   dividend,
+                                                   graph_->GetIntConstant(WhichPowerOf2(value)),
+                                                   instruction->GetDexPc());
+      } else {
+        replacement = new (global_allocator_) HAnd(type,
+                                                   dividend,
+                                                   graph_->GetConstant(type, value - 1),
+                                                   instruction->GetDexPc());
+      }
+      Replace(instruction, replacement);
+      simplified = true;
+    }
+  }
+  return simplified;
+}
+
+bool HRangeSimplification::TrySimplifyTypeConversion(HTypeConversion* conversion) {
+  HInstruction* input = conversion->GetInput();
+  Primitive::Type result_type = conversion->GetResultType();
+  if (!IsIntKind(input->GetType()) || !IsIntKind(result_type)) {
+    return false;
+  }
+  int64_t min = 0;
+  int64_t max = 0;
+  if (GetRange(conversion, input, &min, &max) && FitsType(min, max, result_type)) {
+    Replace(conversion, input);
+    return true;
+  }
+  return false;
+}
+
+bool HRangeSimplification::TrySimplifyAnd(HAnd* instruction) {
+  for (size_t i = 0; i < 2; ++i) {
+    int64_t mask = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+    HInstruction* operand = instruction->InputAt(1 - i);
+    if (IsLowBitsMask(instruction->InputAt(i), &mask) &&
+        GetRange(instruction, operand, &min, &max) &&
+        min >= 0 && max <= mask) {
+      Replace(instruction, operand);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HRangeSimplification::TryNarrowLongOperation(HBinaryOperation* instruction) {
+  if (instruction->GetType() != Primitive::kPrimLong) {
+    return false;
+  }
+  int64_t min1 = 0;
+  int64_t max1 = 0;
+  int64_t min2 = 0;
+  int64_t max2 = 0;
+  HInstruction* left = GetNarrowOperand(instruction, instruction->GetLeft(), &min1, &max1);
+  HInstruction* right = GetNarrowOperand(instruction, instruction->GetRight(), &min2, &max2);
+  if (left == nullptr || right == nullptr) {
+    return false;
+  }
+  // Only narrow when this removes a widening, not just moves it.
+  auto is_removable_widening = [](HInstruction* operand) {
+    return operand->IsTypeConversion() && operand->HasOnlyOneNonEnvironmentUse() &&
+        !operand->HasEnvironmentUses();
+  };
+  if (!is_removable_widening(instruction->GetLeft()) &&
+      !is_removable_widening(instruction->GetRight())) {
+    return false;
+  }
+  // Operand ranges fit an int, so the long result range is exact.
+  int64_t min = 0;
+  int64_t max = 0;
+  if (instruction->IsAdd()) {
+    min = min1 + min2;
+    max = max1 + max2;
+  } else if (instruction->IsSub()) {
+    min = min1 - max2;
+    max = max1 - min2;
+  } else {
+    DCHECK(instruction->IsMul());
+    int64_t products[] = { min1 * min2, min1 * max2, max1 * min2, max1 * max2 };
+    min = *std::min_element(products, products + arraysize(products));
+    max = *std::max_element(products, products + arraysize(products));
+  }
+  if (!FitsType(min, max, Primitive::kPrimInt)) {
+    return false;
+  }
+  uint32_t dex_pc = instruction->GetDexPc();
+  HInstruction* operation = nullptr;
+  if (instruction->IsAdd()) {
+    operation = new (global_allocator_) HAdd(Primitive::kPrimInt, left, right, dex_pc);
+  } else if (instruction->IsSub()) {
+    operation = new (global_allocator_) HSub(Primitive::kPrimInt, left, right, dex_pc);
+  } else {
+    operation = new (global_allocator_) HMul(Primitive::kPrimInt, left, right, dex_pc);
+  }
+  instruction->GetBlock()->InsertInstructionBefore(operation, instruction);
+  Replace(instruction,
+          new (global_allocator_) HTypeConversion(Primitive::kPrimLong, operation, dex_pc));
+  return true;
+}
+
+//
+// Helpers.
+//
+
+HInstruction* HRangeSimplification::GetNarrowOperand(HInstruction* context,
+                                                     HInstruction* operand,
+                                                     /*out*/ int64_t* min,
+                                                     /*out*/ int64_t* max) {
+  if (operand->IsLongConstant()) {
+    int64_t value = operand->AsLongConstant()->GetValue();
+    if (IsInt<32>(value)) {
+      *min = *max = value;
+      return graph_->GetIntConstant(static_cast<int32_t>(value));
+    }
+  } else if (operand->IsTypeConversion()) {
+    HInstruction* input = operand->InputAt(0);
+    if (IsIntKind(input->GetType()) && GetRange(context, input, min, max)) {
+      return input;
+    }
+  }
+  return nullptr;
+}
+
+void HRangeSimplification::Replace(HInstruction* instruction, HInstruction* replacement) {
+  HBasicBlock* block = instruction->GetBlock();
+  for (HLoopInformationOutwardIterator it(*block); !it.Done(); it.Advance()) {
+    changed_loops_.insert(it.Current());
+  }
+  // Invariants are fetched from the instructions that define them, also when these
+  // are outside the loop (e.g. a loop bound), so redirect any such fetch.
+  induction_range_.ReplaceAll(instruction, replacement);
+  if (replacement->GetBlock() == nullptr) {
+    block->ReplaceAndRemoveInstructionWith(instruction, replacement);
+  } else {
+    instruction->ReplaceWith(replacement);
+    block->RemoveInstruction(instruction);
+  }
+}
+
+}  // namespace art
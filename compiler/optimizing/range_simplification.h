@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_RANGE_SIMPLIFICATION_H_
+#define ART_COMPILER_OPTIMIZING_RANGE_SIMPLIFICATION_H_
+
+#include "base/arena_containers.h"
+#include "induction_var_range.h"
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+/**
+ * Simplifications of integral arithmetic that rely on value ranges, taken from
+ * the induction variable analysis inside loops and from the types, constants
+ * and masks of the operands elsewhere:
+ *  (1) a division or remainder of a non-negative value by a larger divisor,
+ *      e.g. i % n for 0 <= i < n, is replaced by 0 or by the dividend,
+ *  (2) a division or remainder of a non-negative value by a power of two is
+ *      replaced by a shift or a mask,
+ *  (3) a division by zero check of a divisor that cannot be zero is removed,
+ *  (4) a narrowing type conversion or a mask that does not change its input
+ *      is removed,
+ *  (5) a long addition, subtraction or multiplication of widened int values,
+ *      whose result fits an int, is done in int and widened once.
+ */
+class HRangeSimplification : public HOptimization {
+ public:
+  HRangeSimplification(HGraph* graph,
+                       HInductionVarAnalysis* induction_analysis,
+                       OptimizingCompilerStats* stats);
+
+  void Run() OVERRIDE;
+
+  static constexpr const char* kRangeSimplificationPassName = "range_simplification";
+
+ private:
+  // Analysis.
+  bool GetRange(HInstruction* context,
+                HInstruction* instruction,
+                /*out*/ int64_t* min,
+                /*out*/ int64_t* max,
+                size_t depth = 0);
+  bool IsBelowDivisor(HInstruction* context, HInstruction* dividend, HInstruction* divisor);
+
+  // Simplifications.
+  bool TrySimplifyDivZeroCheck(HDivZeroCheck* check);
+  bool TrySimplifyDivOrRem(HBinaryOperation* instruction);
+  bool TrySimplifyTypeConversion(HTypeConversion* conversion);
+  bool TrySimplifyAnd(HAnd* instruction);
+  bool TryNarrowLongOperation(HBinaryOperation* instruction);
+
+  // Helpers.
+  HInstruction* GetNarrowOperand(HInstruction* context,
+                                 HInstruction* operand,
+                                 /*out*/ int64_t* min,
+                                 /*out*/ int64_t* max);
+  void Replace(HInstruction* instruction, HInstruction* replacement);
+
+  // Range information based on prior induction variable analysis.
+  InductionVarRange induction_range_;
+
+  // Global heap memory allocator. Used to build HIR.
+  ArenaAllocator* global_allocator_;
+
+  // Loops in which instructions were changed, for which the induction
+  // information is recomputed after the pass.
+  ArenaSet<HLoopInformation*> changed_loops_;
+
+  DISALLOW_COPY_AND_ASSIGN(HRangeSimplification);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_RANGE_SIMPLIFICATION_H_
@@ -23,6 +23,7 @@
 #include "code_generator.h"
 #include "register_allocator_graph_color.h"
 #include "register_allocator_linear_scan.h"
+#include "register_allocator_second_chance.h"
 #include "ssa_liveness_analysis.h"
 
 
@@ -44,6 +45,8 @@ RegisterAllocator* RegisterAllocator::Create(ArenaAllocator* allocator,
       return new (allocator) RegisterAllocatorLinearScan(allocator, codegen, analysis);
     case kRegisterAllocatorGraphColor:
       return new (allocator) RegisterAllocatorGraphColor(allocator, codegen, analysis);
+    case kRegisterAllocatorSecondChance:
+      return new (allocator) RegisterAllocatorSecondChance(allocator, codegen, analysis);
     default:
       LOG(FATAL) << "Invalid register allocation strategy: " << strategy;
       UNREACHABLE();
@@ -41,10 +41,13 @@ class RegisterAllocator : public ArenaObject<kArenaAllocRegisterAllocator> {
  public:
   enum Strategy {
     kRegisterAllocatorLinearScan,
-    kRegisterAllocatorGraphColor
+    kRegisterAllocatorGraphColor,
+    kRegisterAllocatorSecondChance
   };
 
   static constexpr Strategy kRegisterAllocatorDefault = kRegisterAllocatorLinearScan;
+  // Default for JIT compilations that favor compile time over code quality.
+  static constexpr Strategy kRegisterAllocatorJitFast = kRegisterAllocatorSecondChance;
 
   static RegisterAllocator* Create(ArenaAllocator* allocator,
                                    CodeGenerator* codegen,
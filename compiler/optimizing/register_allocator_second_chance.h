@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_SECOND_CHANCE_H_
+#define ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_SECOND_CHANCE_H_
+
+#include "arch/instruction_set.h"
+#include "base/arena_containers.h"
+#include "base/macros.h"
+#include "primitive.h"
+#include "register_allocator.h"
+
+namespace art {
+
+class CodeGenerator;
+class HInstruction;
+class HPhi;
+class LiveInterval;
+class LiveRange;
+class Location;
+class SsaLivenessAnalysis;
+
+/**
+ * A second-chance binpacking register allocator on an `HGraph` with SSA form.
+ *
+ * Intervals are allocated in order of their start positions, like in linear scan,
+ * but a register stays busy from the start to the end of the interval holding it:
+ * lifetime holes are not used to share registers. This removes the set of inactive
+ * intervals and its intersection tests, so that each allocation step only looks at
+ * one interval per register. Unhandled intervals are kept in a heap, so splitting
+ * does not shift a sorted list either. An interval that loses its register is
+ * spilled, and gets a second chance at a register at its next register use.
+ *
+ * The resulting code is slightly worse than with linear scan, in exchange for a
+ * compile time that is close to linear in the number of intervals. This makes it
+ * a good fit for JIT compilation of large methods and of baseline code.
+ */
+class RegisterAllocatorSecondChance : public RegisterAllocator {
+ public:
+  RegisterAllocatorSecondChance(ArenaAllocator* allocator,
+                                CodeGenerator* codegen,
+                                const SsaLivenessAnalysis& analysis);
+  ~RegisterAllocatorSecondChance() OVERRIDE {}
+
+  void AllocateRegisters() OVERRIDE;
+
+  bool Validate(bool log_fatal_on_failure) OVERRIDE {
+    processing_core_registers_ = true;
+    if (!ValidateInternal(log_fatal_on_failure)) {
+      return false;
+    }
+    processing_core_registers_ = false;
+    return ValidateInternal(log_fatal_on_failure);
+  }
+
+  size_t GetNumberOfSpillSlots() const {
+    return int_spill_slots_.size()
+        + long_spill_slots_.size()
+        + float_spill_slots_.size()
+        + double_spill_slots_.size()
+        + catch_phi_spill_slots_;
+  }
+
+ private:
+  // Main methods of the allocator.
+  void Scan();
+  bool Allocate(LiveInterval* current);
+  void AllocateGivenReg(LiveInterval* current);
+  bool TryAllocateFreeReg(LiveInterval* current);
+  bool AllocateBlockedReg(LiveInterval* current);
+
+  // Heap of unhandled intervals, ordered by start position. Only the low half
+  // of a register pair is in the heap; the high half is handled right after it.
+  void AddUnhandled(LiveInterval* interval);
+  LiveInterval* TakeUnhandled();
+
+  // Returns the first position at or after `position` where `reg` is blocked by
+  // its fixed interval. Must be called with increasing positions.
+  size_t NextBlockedPosition(int reg, size_t position);
+
+  // Split the intervals holding `reg` at `position`, and add the rest of them
+  // back to the unhandled intervals.
+  void EvictHolders(int reg, size_t position);
+  void RemoveFromActive(LiveInterval* interval);
+
+  // Returns whether `reg` is blocked by the code generator.
+  bool IsBlocked(int reg) const;
+
+  // Update the interval for the register in `location` to cover [start, end).
+  void BlockRegister(Location location, size_t start, size_t end);
+  void BlockRegisters(size_t start, size_t end, bool caller_save_only = false);
+
+  // Allocate a spill slot for the given interval. Should be called in linear
+  // order of interval starting positions.
+  void AllocateSpillSlotFor(LiveInterval* interval);
+
+  // Allocate a spill slot for the given catch phi. Will allocate the same slot
+  // for phis which share the same vreg. Must be called in reverse linear order
+  // of lifetime positions and ascending vreg numbers for correctness.
+  void AllocateSpillSlotForCatchPhi(HPhi* phi);
+
+  // Helper methods.
+  void AllocateRegistersInternal();
+  void ProcessInstruction(HInstruction* instruction);
+  bool ValidateInternal(bool log_fatal_on_failure) const;
+  void DumpInterval(std::ostream& stream, LiveInterval* interval) const;
+  int FindAvailableRegisterPair(size_t* next_use, size_t starting_at) const;
+  int FindAvailableRegister(size_t* next_use, LiveInterval* current) const;
+  bool IsCallerSaveRegister(int reg) const;
+
+  // Try splitting an active non-pair or unaligned pair interval at the given `position`.
+  // Returns whether it was successful at finding such an interval.
+  bool TrySplitNonPairOrUnalignedPairIntervalAt(size_t position,
+                                                size_t first_register_use,
+                                                size_t* next_use);
+
+  // Heaps of intervals for core and floating-point registers that must be processed.
+  ArenaVector<LiveInterval*> unhandled_core_intervals_;
+  ArenaVector<LiveInterval*> unhandled_fp_intervals_;
+
+  // Currently processed heap of unhandled intervals. Either `unhandled_core_intervals_`
+  // or `unhandled_fp_intervals_`.
+  ArenaVector<LiveInterval*>* unhandled_;
+
+  // List of intervals that currently hold a register, until they are dead.
+  ArenaVector<LiveInterval*> active_;
+
+  // Fixed intervals for physical registers. Such intervals cover the positions
+  // where an instruction requires a specific register.
+  ArenaVector<LiveInterval*> physical_core_register_intervals_;
+  ArenaVector<LiveInterval*> physical_fp_register_intervals_;
+
+  // For each register of the kind being processed, the first range of its fixed
+  // interval that does not end before the current position.
+  ArenaVector<LiveRange*> fixed_ranges_;
+
+  // Intervals for temporaries. Such intervals cover the positions
+  // where an instruction requires a temporary.
+  ArenaVector<LiveInterval*> temp_intervals_;
+
+  // The spill slots allocated for live intervals. Typed like in the linear scan
+  // register allocator, for the benefit of the parallel move resolver.
+  ArenaVector<size_t> int_spill_slots_;
+  ArenaVector<size_t> long_spill_slots_;
+  ArenaVector<size_t> float_spill_slots_;
+  ArenaVector<size_t> double_spill_slots_;
+
+  // Spill slots allocated to catch phis.
+  size_t catch_phi_spill_slots_;
+
+  // Instructions that need a safepoint.
+  ArenaVector<HInstruction*> safepoints_;
+
+  // True if processing core registers. False if processing floating
+  // point registers.
+  bool processing_core_registers_;
+
+  // Number of registers for the current register kind (core or floating point).
+  size_t number_of_registers_;
+
+  // Temporary array, allocated ahead of time for simplicity.
+  size_t* registers_array_;
+
+  // Blocked registers, as decided by the code generator.
+  bool* const blocked_core_registers_;
+  bool* const blocked_fp_registers_;
+
+  // Slots reserved for out arguments.
+  size_t reserved_out_slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisterAllocatorSecondChance);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_SECOND_CHANCE_H_
@@ -306,6 +306,34 @@ class SchedulingGraph : public ValueObject {
   ArenaHashMap<const HInstruction*, SchedulingNode*> nodes_map_;
 };
 
+// Instructions that architecture-specific latency visitors give a latency to.
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_COMMON_INSTRUCTION(M) \
+  M(ArrayGet         , unused)                   \
+  M(ArrayLength      , unused)                   \
+  M(ArraySet         , unused)                   \
+  M(BinaryOperation  , unused)                   \
+  M(BoundsCheck      , unused)                   \
+  M(Div              , unused)                   \
+  M(InstanceFieldGet , unused)                   \
+  M(InstanceOf       , unused)                   \
+  M(Invoke           , unused)                   \
+  M(LoadString       , unused)                   \
+  M(Mul              , unused)                   \
+  M(NewArray         , unused)                   \
+  M(NewInstance      , unused)                   \
+  M(Rem              , unused)                   \
+  M(StaticFieldGet   , unused)                   \
+  M(SuspendCheck     , unused)                   \
+  M(TypeConversion   , unused)
+
+#define FOR_EACH_SCHEDULED_SHARED_INSTRUCTION(M) \
+  M(BitwiseNegatedRight, unused)                 \
+  M(MultiplyAccumulate, unused)                  \
+  M(IntermediateAddress, unused)                 \
+  M(DataProcWithShifterOp, unused)
+
 /*
  * The visitors derived from this base class are used by schedulers to evaluate
  * the latencies of `HInstruction`s.
@@ -469,9 +497,14 @@ inline bool SchedulingGraph::IsSchedulingBarrier(const HInstruction* instruction
 
 class HInstructionScheduling : public HOptimization {
  public:
-  HInstructionScheduling(HGraph* graph, InstructionSet instruction_set)
+  // `isa_features` may be null, in which case the scheduler assumes the
+  // features of recent cores.
+  HInstructionScheduling(HGraph* graph,
+                         InstructionSet instruction_set,
+                         const InstructionSetFeatures* isa_features = nullptr)
       : HOptimization(graph, kInstructionScheduling),
-        instruction_set_(instruction_set) {}
+        instruction_set_(instruction_set),
+        isa_features_(isa_features) {}
 
   void Run() {
     Run(/*only_optimize_loop_blocks*/ true, /*schedule_randomly*/ false);
@@ -481,6 +514,7 @@ class HInstructionScheduling : public HOptimization {
   static constexpr const char* kInstructionScheduling = "scheduler";
 
   const InstructionSet instruction_set_;
+  const InstructionSetFeatures* const isa_features_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(HInstructionScheduling);
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_arm.h"
+#include "code_generator_utils.h"
+
+namespace art {
+namespace arm {
+
+void SchedulingLatencyVisitorARM::VisitBinaryOperation(HBinaryOperation* instr) {
+  // Comparisons produce an int but their cost depends on the type of their inputs.
+  Primitive::Type type = (instr->IsCondition() || instr->IsCompare())
+      ? instr->GetLeft()->GetType()
+      : instr->GetResultType();
+  if (Primitive::IsFloatingPointType(type)) {
+    last_visited_latency_ = kArmFloatingPointOpLatency;
+    return;
+  }
+  if (type == Primitive::kPrimLong) {
+    // Operations on register pairs need at least one instruction per half.
+    if ((instr->IsShl() || instr->IsShr() || instr->IsUShr()) && !instr->GetRight()->IsConstant()) {
+      last_visited_internal_latency_ = 8 * kArmIntegerOpLatency;
+    } else {
+      last_visited_internal_latency_ = kArmIntegerOpLatency;
+    }
+  }
+  last_visited_latency_ = kArmIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitBitwiseNegatedRight(HBitwiseNegatedRight* instr) {
+  if (instr->GetResultType() == Primitive::kPrimLong) {
+    last_visited_internal_latency_ = kArmIntegerOpLatency;
+  }
+  last_visited_latency_ = kArmIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitDataProcWithShifterOp(HDataProcWithShifterOp* instr) {
+  if (instr->GetResultType() == Primitive::kPrimLong) {
+    // The shift of a register pair takes several instructions.
+    last_visited_internal_latency_ = 2 * kArmIntegerOpLatency;
+  }
+  last_visited_latency_ = kArmDataProcWithShifterOpLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitIntermediateAddress(HIntermediateAddress* ATTRIBUTE_UNUSED) {
+  // Spacing the `add` from its use in memory accesses hides the address
+  // generation interlock of in-order cores.
+  last_visited_latency_ = kArmIntegerOpLatency + 2;
+}
+
+void SchedulingLatencyVisitorARM::VisitMultiplyAccumulate(HMultiplyAccumulate* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kArmMulIntegerLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitArmDexCacheArraysBase(
+    HArmDexCacheArraysBase* ATTRIBUTE_UNUSED) {
+  // A movw/movt pair followed by an `add` of the PC.
+  last_visited_internal_latency_ = kArmIntegerOpLatency;
+  last_visited_latency_ = kArmIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitArrayGet(HArrayGet* instruction) {
+  if (!instruction->GetArray()->IsIntermediateAddress()) {
+    // Take the intermediate address computation into account.
+    last_visited_internal_latency_ = kArmIntegerOpLatency;
+  }
+  last_visited_latency_ = kArmMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitArrayLength(HArrayLength* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kArmMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitArraySet(HArraySet* instruction) {
+  if (instruction->GetComponentType() == Primitive::kPrimNot) {
+    // Marking the card of the array.
+    last_visited_internal_latency_ = kArmMemoryLoadLatency + kArmIntegerOpLatency;
+  }
+  last_visited_latency_ = kArmMemoryStoreLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitBoundsCheck(HBoundsCheck* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kArmIntegerOpLatency;
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorARM::HandleDivRemConstantIntegral(int64_t imm) {
+  if (imm == 0) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = 0;
+  } else if (imm == 1 || imm == -1) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = kArmIntegerOpLatency;
+  } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+    last_visited_internal_latency_ = 3 * kArmIntegerOpLatency;
+    last_visited_latency_ = kArmIntegerOpLatency;
+  } else {
+    DCHECK(imm <= -2 || imm >= 2);
+    last_visited_internal_latency_ = kArmMulIntegerLatency + 2 * kArmIntegerOpLatency;
+    last_visited_latency_ = kArmIntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorARM::VisitDiv(HDiv* instr) {
+  Primitive::Type type = instr->GetResultType();
+  switch (type) {
+    case Primitive::kPrimFloat:
+      last_visited_latency_ = kArmDivFloatLatency;
+      break;
+    case Primitive::kPrimDouble:
+      last_visited_latency_ = kArmDivDoubleLatency;
+      break;
+    case Primitive::kPrimInt:
+      // Follow the code path used by code generation.
+      if (instr->GetRight()->IsConstant()) {
+        HandleDivRemConstantIntegral(Int64FromConstant(instr->GetRight()->AsConstant()));
+      } else if (has_divide_instruction_) {
+        last_visited_latency_ = kArmDivIntegerLatency;
+      } else {
+        last_visited_internal_latency_ = kArmCallInternalLatency;
+        last_visited_latency_ = kArmCallLatency;
+      }
+      break;
+    default:
+      // Long divisions are runtime calls.
+      last_visited_internal_latency_ = kArmCallInternalLatency;
+      last_visited_latency_ = kArmCallLatency;
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorARM::HandleFieldGetWithVolatility(bool is_volatile,
+                                                                Primitive::Type type) {
+  if (is_volatile) {
+    // Wide volatile loads may need an exclusive load, and all are followed by a barrier.
+    last_visited_internal_latency_ = Primitive::Is64BitType(type)
+        ? kArmMemoryLoadLatency + kArmMemoryBarrierLatency
+        : kArmMemoryBarrierLatency;
+  }
+  last_visited_latency_ = kArmMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGetWithVolatility(instruction->IsVolatile(), instruction->GetType());
+}
+
+void SchedulingLatencyVisitorARM::VisitInstanceOf(HInstanceOf* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kArmCallInternalLatency;
+  last_visited_latency_ = kArmIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitInvoke(HInvoke* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kArmCallInternalLatency;
+  last_visited_latency_ = kArmCallLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitLoadString(HLoadString* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kArmLoadStringInternalLatency;
+  last_visited_latency_ = kArmMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitMul(HMul* instr) {
+  switch (instr->GetResultType()) {
+    case Primitive::kPrimFloat:
+    case Primitive::kPrimDouble:
+      last_visited_latency_ = kArmMulFloatingPointLatency;
+      break;
+    case Primitive::kPrimLong:
+      // A `umull` and two `mla` for the cross products.
+      last_visited_internal_latency_ = 2 * kArmMulIntegerLatency;
+      last_visited_latency_ = kArmMulIntegerLatency;
+      break;
+    default:
+      last_visited_latency_ = kArmMulIntegerLatency;
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorARM::VisitNewArray(HNewArray* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kArmIntegerOpLatency + kArmCallInternalLatency;
+  last_visited_latency_ = kArmCallLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitNewInstance(HNewInstance* instruction) {
+  if (instruction->IsStringAlloc()) {
+    last_visited_internal_latency_ = 2 + kArmMemoryLoadLatency + kArmCallInternalLatency;
+  } else {
+    last_visited_internal_latency_ = kArmCallInternalLatency;
+  }
+  last_visited_latency_ = kArmCallLatency;
+}
+
+void SchedulingLatencyVisitorARM::VisitRem(HRem* instruction) {
+  Primitive::Type type = instruction->GetResultType();
+  if (type == Primitive::kPrimInt) {
+    // Follow the code path used by code generation.
+    if (instruction->GetRight()->IsConstant()) {
+      HandleDivRemConstantIntegral(Int64FromConstant(instruction->GetRight()->AsConstant()));
+      // The remainder needs a multiply-subtract of the quotient.
+      last_visited_internal_latency_ += last_visited_latency_;
+      last_visited_latency_ = (last_visited_latency_ == 0) ? 0 : kArmMulIntegerLatency;
+    } else if (has_divide_instruction_) {
+      last_visited_internal_latency_ = kArmDivIntegerLatency;
+      last_visited_latency_ = kArmMulIntegerLatency;
+    } else {
+      last_visited_internal_latency_ = kArmCallInternalLatency;
+      last_visited_latency_ = kArmCallLatency;
+    }
+  } else {
+    // Long and floating point remainders are runtime calls.
+    last_visited_internal_latency_ = kArmCallInternalLatency;
+    last_visited_latency_ = kArmCallLatency;
+  }
+}
+
+void SchedulingLatencyVisitorARM::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGetWithVolatility(instruction->IsVolatile(), instruction->GetType());
+}
+
+void SchedulingLatencyVisitorARM::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  DCHECK((block->GetLoopInformation() != nullptr) ||
+         (block->IsEntryBlock() && instruction->GetNext()->IsGoto()));
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorARM::VisitTypeConversion(HTypeConversion* instr) {
+  Primitive::Type result_type = instr->GetResultType();
+  Primitive::Type input_type = instr->GetInputType();
+  bool is_floating_point_conversion =
+      Primitive::IsFloatingPointType(result_type) || Primitive::IsFloatingPointType(input_type);
+  if (is_floating_point_conversion &&
+      (result_type == Primitive::kPrimLong || input_type == Primitive::kPrimLong)) {
+    // Conversions between long and floating point values are mostly runtime calls.
+    last_visited_internal_latency_ = kArmCallInternalLatency;
+    last_visited_latency_ = kArmCallLatency;
+  } else if (is_floating_point_conversion) {
+    last_visited_latency_ = kArmTypeConversionFloatingPointIntegerLatency;
+  } else {
+    last_visited_latency_ = kArmIntegerOpLatency;
+  }
+}
+
+}  // namespace arm
+}  // namespace art
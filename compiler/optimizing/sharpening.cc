@@ -30,6 +30,7 @@
 #include "mirror/dex_cache.h"
 #include "mirror/string.h"
 #include "nodes.h"
+#include "optimizing_compiler.h"
 #include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
 
@@ -52,7 +53,7 @@ void HSharpening::Run() {
   }
 }
 
-static bool IsInBootImage(ArtMethod* method) {
+bool HSharpening::IsInBootImage(ArtMethod* method) {
   const std::vector<gc::space::ImageSpace*>& image_spaces =
       Runtime::Current()->GetHeap()->GetBootImageSpaces();
   for (gc::space::ImageSpace* image_space : image_spaces) {
@@ -65,7 +66,13 @@ static bool IsInBootImage(ArtMethod* method) {
 }
 
 static bool AOTCanEmbedMethod(ArtMethod* method, const CompilerOptions& options) {
-  return IsInBootImage(method) && !options.GetCompilePic();
+  return HSharpening::IsInBootImage(method) && !options.GetCompilePic();
+}
+
+static bool JITCanEmbedMethod(ArtMethod* method) {
+  // Code kept in the persistent JIT code cache must not embed addresses of methods
+  // allocated by this process.
+  return !IsCompilingForPersistentJitCodeCache() || HSharpening::IsInBootImage(method);
 }
 
 
@@ -101,13 +108,18 @@ void HSharpening::SharpenInvokeStaticOrDirect(HInvokeStaticOrDirect* invoke,
     // Recursive call.
     method_load_kind = HInvokeStaticOrDirect::MethodLoadKind::kRecursive;
     code_ptr_location = HInvokeStaticOrDirect::CodePtrLocation::kCallSelf;
-  } else if (Runtime::Current()->UseJitCompilation() ||
+  } else if ((Runtime::Current()->UseJitCompilation() && JITCanEmbedMethod(callee)) ||
       AOTCanEmbedMethod(callee, codegen->GetCompilerOptions())) {
     // JIT or on-device AOT compilation referencing a boot image method.
     // Use the method address directly.
     method_load_kind = HInvokeStaticOrDirect::MethodLoadKind::kDirectAddress;
     method_load_data = reinterpret_cast<uintptr_t>(callee);
     code_ptr_location = HInvokeStaticOrDirect::CodePtrLocation::kCallArtMethod;
+  } else if (Runtime::Current()->UseJitCompilation()) {
+    // JIT compilation for the persistent code cache. Load the method from the dex cache
+    // of the caller, where unresolved entries point to the resolution method.
+    method_load_kind = HInvokeStaticOrDirect::MethodLoadKind::kDexCacheViaMethod;
+    code_ptr_location = HInvokeStaticOrDirect::CodePtrLocation::kCallArtMethod;
   } else {
     // Use PC-relative access to the dex cache arrays.
     method_load_kind = HInvokeStaticOrDirect::MethodLoadKind::kDexCachePcRelative;
@@ -57,6 +57,10 @@ class HSharpening : public HOptimization {
   // Used by Sharpening and InstructionSimplifier.
   static void SharpenInvokeStaticOrDirect(HInvokeStaticOrDirect* invoke, CodeGenerator* codegen);
 
+  // Returns whether `method` is in the boot image, and therefore has the same address
+  // in every process using this boot image.
+  static bool IsInBootImage(ArtMethod* method);
+
  private:
   void ProcessLoadString(HLoadString* load_string);
 
@@ -16,6 +16,8 @@
 
 #include "stack_map_stream.h"
 
+#include <numeric>
+
 #include "art_method-inl.h"
 #include "base/stl_util.h"
 #include "optimizing/optimizing_compiler.h"
@@ -24,6 +26,8 @@
 
 namespace art {
 
+constexpr size_t StackMapStream::kNoCatchStackMaps;
+
 void StackMapStream::BeginStackMapEntry(uint32_t dex_pc,
                                         uint32_t native_pc_offset,
                                         uint32_t register_mask,
@@ -149,6 +153,7 @@ size_t StackMapStream::PrepareForFillIn() {
   CodeInfoEncoding encoding;
   encoding.dex_register_map.num_entries = 0;  // TODO: Remove this field.
   encoding.dex_register_map.num_bytes = ComputeDexRegisterMapsSize();
+  SortLocationCatalog();
   encoding.location_catalog.num_entries = location_catalog_entries_.size();
   encoding.location_catalog.num_bytes = ComputeDexRegisterLocationCatalogSize();
   encoding.inline_info.num_entries = inline_infos_.size();
@@ -164,6 +169,14 @@ size_t StackMapStream::PrepareForFillIn() {
   encoding.register_mask.encoding.num_bits = MinimumBitsToStore(register_mask_max_);
   encoding.register_mask.num_entries = PrepareRegisterMasks();
   encoding.stack_map.num_entries = stack_maps_.size();
+  encoding.number_of_catch_stack_maps = GetNumberOfCatchStackMaps();
+  if (kIsDebugBuild) {
+    // The runtime binary searches the other stack maps by native pc.
+    for (size_t i = 1, e = stack_maps_.size() - GetNumberOfCatchStackMaps(); i < e; ++i) {
+      DCHECK_LE(stack_maps_[i - 1].native_pc_code_offset.Uint32Value(instruction_set_),
+                stack_maps_[i].native_pc_code_offset.Uint32Value(instruction_set_));
+    }
+  }
   encoding.stack_map.encoding.SetFromSizes(
       // The stack map contains compressed native PC offsets.
       max_native_pc_offset.CompressedValue(),
@@ -184,12 +197,54 @@ size_t StackMapStream::PrepareForFillIn() {
 
 size_t StackMapStream::ComputeDexRegisterLocationCatalogSize() const {
   size_t size = DexRegisterLocationCatalog::kFixedSize;
+  int32_t previous_large_value = 0;
   for (const DexRegisterLocation& dex_register_location : location_catalog_entries_) {
-    size += DexRegisterLocationCatalog::EntrySize(dex_register_location);
+    size += DexRegisterLocationCatalog::EntrySize(dex_register_location, &previous_large_value);
   }
   return size;
 }
 
+void StackMapStream::SortLocationCatalog() {
+  // Large locations are stored as deltas from the previous large location of the
+  // catalog, so sort them by kind and value to keep the deltas small. Short locations
+  // do not take part in the delta encoding and keep their indices.
+  ArenaVector<size_t> large_indices(allocator_->Adapter(kArenaAllocStackMapStream));
+  for (size_t i = 0; i < location_catalog_entries_.size(); ++i) {
+    if (!DexRegisterLocationCatalog::CanBeEncodedAsShortLocation(location_catalog_entries_[i])) {
+      large_indices.push_back(i);
+    }
+  }
+  if (large_indices.size() < 2u) {
+    return;
+  }
+  ArenaVector<size_t> sorted_indices(large_indices.begin(),
+                                     large_indices.end(),
+                                     allocator_->Adapter(kArenaAllocStackMapStream));
+  std::sort(sorted_indices.begin(), sorted_indices.end(), [this](size_t lhs, size_t rhs) {
+    const DexRegisterLocation& a = location_catalog_entries_[lhs];
+    const DexRegisterLocation& b = location_catalog_entries_[rhs];
+    return std::make_pair(a.GetInternalKind(), a.GetValue()) <
+        std::make_pair(b.GetInternalKind(), b.GetValue());
+  });
+  // The i-th smallest large location moves to the i-th large slot of the catalog.
+  ArenaVector<size_t> new_index(allocator_->Adapter(kArenaAllocStackMapStream));
+  new_index.resize(location_catalog_entries_.size());
+  std::iota(new_index.begin(), new_index.end(), 0u);
+  ArenaVector<DexRegisterLocation> sorted_entries(location_catalog_entries_.begin(),
+                                                  location_catalog_entries_.end(),
+                                                  allocator_->Adapter(kArenaAllocStackMapStream));
+  for (size_t i = 0; i < large_indices.size(); ++i) {
+    new_index[sorted_indices[i]] = large_indices[i];
+    sorted_entries[large_indices[i]] = location_catalog_entries_[sorted_indices[i]];
+  }
+  location_catalog_entries_.swap(sorted_entries);
+  for (size_t& index : dex_register_locations_) {
+    index = new_index[index];
+  }
+  // The catalog indices are final now, no more locations can be added.
+  location_catalog_entries_indices_.Clear();
+}
+
 size_t StackMapStream::DexRegisterMapEntry::ComputeSize(size_t catalog_size) const {
   // For num_dex_registers == 0u live_dex_registers_mask may be null.
   if (num_dex_registers == 0u) {
@@ -337,9 +392,10 @@ void StackMapStream::FillInCodeInfo(MemoryRegion region) {
   // Offset in `dex_register_location_catalog` where to store the next
   // register location.
   size_t location_catalog_offset = DexRegisterLocationCatalog::kFixedSize;
+  int32_t previous_large_value = 0;
   for (DexRegisterLocation dex_register_location : location_catalog_entries_) {
-    dex_register_location_catalog.SetRegisterInfo(location_catalog_offset, dex_register_location);
-    location_catalog_offset += DexRegisterLocationCatalog::EntrySize(dex_register_location);
+    location_catalog_offset += dex_register_location_catalog.SetRegisterInfo(
+        location_catalog_offset, dex_register_location, &previous_large_value);
   }
   // Ensure we reached the end of the Dex registers location_catalog.
   DCHECK_EQ(location_catalog_offset, dex_register_location_catalog_region.size());
@@ -604,6 +660,7 @@ void StackMapStream::CheckCodeInfo(MemoryRegion region) const {
   CodeInfo code_info(region);
   CodeInfoEncoding encoding = code_info.ExtractEncoding();
   DCHECK_EQ(code_info.GetNumberOfStackMaps(encoding), stack_maps_.size());
+  DCHECK_EQ(code_info.GetNumberOfCatchStackMaps(encoding), GetNumberOfCatchStackMaps());
   size_t invoke_info_index = 0;
   for (size_t s = 0; s < stack_maps_.size(); ++s) {
     const StackMap stack_map = code_info.GetStackMapAt(s, encoding);
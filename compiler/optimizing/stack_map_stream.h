@@ -84,7 +84,8 @@ class StackMapStream : public ValueObject {
         code_info_encoding_(allocator->Adapter(kArenaAllocStackMapStream)),
         needed_size_(0),
         current_dex_register_(0),
-        in_inline_frame_(false) {
+        in_inline_frame_(false),
+        first_catch_stack_map_(kNoCatchStackMaps) {
     stack_maps_.reserve(10);
     location_catalog_entries_.reserve(4);
     dex_register_locations_.reserve(10 * 4);
@@ -142,6 +143,13 @@ class StackMapStream : public ValueObject {
                           uint8_t inlining_depth);
   void EndStackMapEntry();
 
+  // The stack map entries added after this call are catch stack maps. They must come
+  // after all other stack maps, which must be added in increasing native pc order.
+  void BeginCatchStackMaps() {
+    DCHECK_EQ(first_catch_stack_map_, kNoCatchStackMaps);
+    first_catch_stack_map_ = stack_maps_.size();
+  }
+
   void AddDexRegisterEntry(DexRegisterLocation::Kind kind, int32_t value);
 
   void AddInvoke(InvokeType type, uint32_t dex_method_index);
@@ -174,7 +182,18 @@ class StackMapStream : public ValueObject {
   size_t ComputeMethodInfoSize() const;
 
  private:
+  static constexpr size_t kNoCatchStackMaps = static_cast<size_t>(-1);
+
+  size_t GetNumberOfCatchStackMaps() const {
+    return (first_catch_stack_map_ == kNoCatchStackMaps)
+        ? 0u
+        : stack_maps_.size() - first_catch_stack_map_;
+  }
+
   size_t ComputeDexRegisterLocationCatalogSize() const;
+  // Sort the large locations of the catalog by kind and value, and update the indices
+  // referring to them.
+  void SortLocationCatalog();
   size_t ComputeDexRegisterMapsSize() const;
   void ComputeInlineInfoEncoding(InlineInfoEncoding* encoding,
                                  size_t dex_register_maps_bytes);
@@ -257,6 +276,8 @@ class StackMapStream : public ValueObject {
   size_t needed_size_;
   uint32_t current_dex_register_;
   bool in_inline_frame_;
+  // Index of the first catch stack map, or kNoCatchStackMaps.
+  size_t first_catch_stack_map_;
 
   static constexpr uint32_t kNoSameDexMapFound = -1;
 
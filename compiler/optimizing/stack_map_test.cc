@@ -71,8 +71,8 @@ TEST(StackMapTest, Test1) {
   DexRegisterLocationCatalog location_catalog = code_info.GetDexRegisterLocationCatalog(encoding);
   // The Dex register location catalog contains:
   // - one 1-byte short Dex register location, and
-  // - one 5-byte large Dex register location.
-  size_t expected_location_catalog_size = 1u + 5u;
+  // - one 2-byte large Dex register location.
+  size_t expected_location_catalog_size = 1u + 2u;
   ASSERT_EQ(expected_location_catalog_size, location_catalog.Size());
 
   StackMap stack_map = code_info.GetStackMapAt(0, encoding);
@@ -184,8 +184,8 @@ TEST(StackMapTest, Test2) {
   DexRegisterLocationCatalog location_catalog = code_info.GetDexRegisterLocationCatalog(encoding);
   // The Dex register location catalog contains:
   // - six 1-byte short Dex register locations, and
-  // - one 5-byte large Dex register location.
-  size_t expected_location_catalog_size = 6u * 1u + 5u;
+  // - one 2-byte large Dex register location.
+  size_t expected_location_catalog_size = 6u * 1u + 2u;
   ASSERT_EQ(expected_location_catalog_size, location_catalog.Size());
 
   // First stack map.
@@ -444,8 +444,8 @@ TEST(StackMapTest, TestDeduplicateInlineInfoDexRegisterMap) {
   DexRegisterLocationCatalog location_catalog = code_info.GetDexRegisterLocationCatalog(encoding);
   // The Dex register location catalog contains:
   // - one 1-byte short Dex register locations, and
-  // - one 5-byte large Dex register location.
-  const size_t expected_location_catalog_size = 1u + 5u;
+  // - one 2-byte large Dex register location.
+  const size_t expected_location_catalog_size = 1u + 2u;
   ASSERT_EQ(expected_location_catalog_size, location_catalog.Size());
 
   // First stack map.
@@ -529,8 +529,8 @@ TEST(StackMapTest, TestNonLiveDexRegisters) {
   ASSERT_EQ(1u, number_of_catalog_entries);
   DexRegisterLocationCatalog location_catalog = code_info.GetDexRegisterLocationCatalog(encoding);
   // The Dex register location catalog contains:
-  // - one 5-byte large Dex register location.
-  size_t expected_location_catalog_size = 5u;
+  // - one 2-byte large Dex register location.
+  size_t expected_location_catalog_size = 2u;
   ASSERT_EQ(expected_location_catalog_size, location_catalog.Size());
 
   StackMap stack_map = code_info.GetStackMapAt(0, encoding);
@@ -583,6 +583,62 @@ TEST(StackMapTest, TestNonLiveDexRegisters) {
 // Generate a stack map whose dex register offset is
 // StackMap::kNoDexRegisterMapSmallEncoding, and ensure we do
 // not treat it as kNoDexRegisterMap.
+TEST(StackMapTest, TestLargeLocationDeltas) {
+  ArenaPool pool;
+  ArenaAllocator arena(&pool);
+  StackMapStream stream(&arena, kRuntimeISA);
+
+  ArenaBitVector sp_mask(&arena, 0, false);
+  uint32_t number_of_dex_registers = 5;
+  stream.BeginStackMapEntry(0, 64, 0x3, &sp_mask, number_of_dex_registers, 0);
+  stream.AddDexRegisterEntry(Kind::kInStack, 512);     // Large location.
+  stream.AddDexRegisterEntry(Kind::kConstant, 1000);   // Large location.
+  stream.AddDexRegisterEntry(Kind::kInRegister, 2);    // Short location.
+  stream.AddDexRegisterEntry(Kind::kInStack, 256);     // Large location.
+  stream.AddDexRegisterEntry(Kind::kConstant, -100);   // Large location.
+  stream.EndStackMapEntry();
+
+  size_t size = stream.PrepareForFillIn();
+  void* memory = arena.Alloc(size, kArenaAllocMisc);
+  MemoryRegion region(memory, size);
+  stream.FillInCodeInfo(region);
+
+  CodeInfo code_info(region);
+  CodeInfoEncoding encoding = code_info.ExtractEncoding();
+  uint32_t number_of_catalog_entries = code_info.GetNumberOfLocationCatalogEntries(encoding);
+  ASSERT_EQ(5u, number_of_catalog_entries);
+  DexRegisterLocationCatalog location_catalog = code_info.GetDexRegisterLocationCatalog(encoding);
+  // The large locations are sorted to the slots (0, 1, 3, 4) of the catalog as stack
+  // slots 64 and 128 and constants -100 and 1000, and stored as the deltas 64, 64,
+  // -228 and 1100, which all fit on a 2-byte signed LEB128.  The catalog contains:
+  // - one 1-byte short Dex register location, and
+  // - four 3-byte large Dex register locations.
+  ASSERT_EQ(1u + 4u * 3u, location_catalog.Size());
+  ASSERT_EQ(1u + 4u * 5u, location_catalog.ComputeSizeWithoutDeltas(number_of_catalog_entries));
+
+  DexRegisterLocation location0 = location_catalog.GetDexRegisterLocation(0);
+  DexRegisterLocation location3 = location_catalog.GetDexRegisterLocation(3);
+  ASSERT_EQ(Kind::kInStackLargeOffset, location0.GetInternalKind());
+  ASSERT_EQ(256, location0.GetValue());
+  ASSERT_EQ(512, location_catalog.GetDexRegisterLocation(1).GetValue());
+  ASSERT_EQ(Kind::kInRegister, location_catalog.GetDexRegisterLocation(2).GetInternalKind());
+  ASSERT_EQ(Kind::kConstantLargeValue, location3.GetInternalKind());
+  ASSERT_EQ(-100, location3.GetValue());
+  ASSERT_EQ(1000, location_catalog.GetDexRegisterLocation(4).GetValue());
+
+  StackMap stack_map = code_info.GetStackMapAt(0, encoding);
+  DexRegisterMap dex_register_map =
+      code_info.GetDexRegisterMapOf(stack_map, encoding, number_of_dex_registers);
+  ASSERT_EQ(512, dex_register_map.GetStackOffsetInBytes(
+                0, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(1000, dex_register_map.GetConstant(1, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(2, dex_register_map.GetMachineRegister(
+                2, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(256, dex_register_map.GetStackOffsetInBytes(
+                3, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(-100, dex_register_map.GetConstant(4, number_of_dex_registers, code_info, encoding));
+}
+
 TEST(StackMapTest, DexRegisterMapOffsetOverflow) {
   ArenaPool pool;
   ArenaAllocator arena(&pool);
@@ -764,7 +820,7 @@ TEST(StackMapTest, InlineTest) {
   sp_mask1.SetBit(4);
 
   // First stack map.
-  stream.BeginStackMapEntry(0, 64, 0x3, &sp_mask1, 2, 2);
+  stream.BeginStackMapEntry(0, 16, 0x3, &sp_mask1, 2, 2);
   stream.AddDexRegisterEntry(Kind::kInStack, 0);
   stream.AddDexRegisterEntry(Kind::kConstant, 4);
 
@@ -1011,4 +1067,54 @@ TEST(StackMapTest, TestInvokeInfo) {
   EXPECT_EQ(invoke3.GetNativePcOffset(encoding.invoke_info.encoding, kRuntimeISA), 16u);
 }
 
+TEST(StackMapTest, TestCatchStackMaps) {
+  ArenaPool pool;
+  ArenaAllocator arena(&pool);
+  StackMapStream stream(&arena, kRuntimeISA);
+
+  ArenaBitVector sp_mask(&arena, 0, true);
+  // Safepoint stack maps, sorted by native pc.
+  for (uint32_t i = 0; i < 16; ++i) {
+    stream.BeginStackMapEntry(i, 8 + 8 * i, 0x3, &sp_mask, 0, 0);
+    stream.EndStackMapEntry();
+  }
+  // Catch stack maps, at native pcs between and equal to the safepoint ones.
+  stream.BeginCatchStackMaps();
+  stream.BeginStackMapEntry(100, 44, 0, &sp_mask, 0, 0);
+  stream.EndStackMapEntry();
+  stream.BeginStackMapEntry(101, 16, 0, &sp_mask, 0, 0);
+  stream.EndStackMapEntry();
+
+  size_t size = stream.PrepareForFillIn();
+  void* memory = arena.Alloc(size, kArenaAllocMisc);
+  MemoryRegion region(memory, size);
+  stream.FillInCodeInfo(region);
+
+  CodeInfo code_info(region);
+  CodeInfoEncoding encoding = code_info.ExtractEncoding();
+  const StackMapEncoding& stack_map_encoding = encoding.stack_map.encoding;
+  ASSERT_EQ(18u, code_info.GetNumberOfStackMaps(encoding));
+  ASSERT_EQ(2u, code_info.GetNumberOfCatchStackMaps(encoding));
+
+  for (uint32_t i = 0; i < 16; ++i) {
+    StackMap stack_map = code_info.GetStackMapForNativePcOffset(8 + 8 * i, encoding);
+    ASSERT_TRUE(stack_map.IsValid());
+    EXPECT_EQ(i, stack_map.GetDexPc(stack_map_encoding));
+  }
+  EXPECT_FALSE(code_info.GetStackMapForNativePcOffset(4, encoding).IsValid());
+  EXPECT_FALSE(code_info.GetStackMapForNativePcOffset(12, encoding).IsValid());
+  EXPECT_FALSE(code_info.GetStackMapForNativePcOffset(200, encoding).IsValid());
+
+  // A catch stack map is found by native pc when no safepoint is there.
+  StackMap catch_by_pc = code_info.GetStackMapForNativePcOffset(44, encoding);
+  ASSERT_TRUE(catch_by_pc.IsValid());
+  EXPECT_EQ(100u, catch_by_pc.GetDexPc(stack_map_encoding));
+
+  StackMap catch_map = code_info.GetCatchStackMapForDexPc(101, encoding);
+  ASSERT_TRUE(catch_map.IsValid());
+  EXPECT_EQ(16u, catch_map.GetNativePcOffset(stack_map_encoding, kRuntimeISA));
+  // Safepoint stack maps are not catch stack maps.
+  EXPECT_FALSE(code_info.GetCatchStackMapForDexPc(3, encoding).IsValid());
+}
+
 }  // namespace art
@@ -932,6 +932,16 @@ void X86_64Assembler::pmullw(XmmRegister dst, XmmRegister src) {
 }
 
 
+void X86_64Assembler::pmaddwd(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0xF5);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
+
 void X86_64Assembler::paddd(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -963,6 +973,28 @@ void X86_64Assembler::pmulld(XmmRegister dst, XmmRegister src) {
 }
 
 
+void X86_64Assembler::pminsd(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x38);
+  EmitUint8(0x39);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
+
+void X86_64Assembler::pmaxsd(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x38);
+  EmitUint8(0x3D);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
+
 void X86_64Assembler::paddq(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -1687,6 +1719,377 @@ void X86_64Assembler::psrlq(XmmRegister reg, const Immediate& shift_count) {
 }
 
 
+// Implied mandatory prefixes (VEX.pp) and opcode maps (VEX.mmmmm) of VEX instructions.
+static constexpr uint8_t kVexPpNone = 0x0;
+static constexpr uint8_t kVexPp66 = 0x1;
+static constexpr uint8_t kVexPpF3 = 0x2;
+static constexpr uint8_t kVexMap0F = 0x1;
+static constexpr uint8_t kVexMap0F38 = 0x2;
+static constexpr uint8_t kVexMap0F3A = 0x3;
+
+
+void X86_64Assembler::vmovaps(XmmRegister dst, XmmRegister src) {
+  if (src.NeedsRex() && !dst.NeedsRex()) {
+    // Use the store form, which allows the shorter two-byte VEX prefix.
+    EmitVex256(kVexPpNone, kVexMap0F, 0x29, src, XmmRegister(0), dst);
+  } else {
+    EmitVex256(kVexPpNone, kVexMap0F, 0x28, dst, XmmRegister(0), src);
+  }
+}
+
+
+void X86_64Assembler::vmovaps(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x28, dst, src);
+}
+
+
+void X86_64Assembler::vmovaps(const Address& dst, XmmRegister src) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x29, src, dst);
+}
+
+
+void X86_64Assembler::vmovups(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x10, dst, src);
+}
+
+
+void X86_64Assembler::vmovups(const Address& dst, XmmRegister src) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x11, src, dst);
+}
+
+
+void X86_64Assembler::vmovapd(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x28, dst, src);
+}
+
+
+void X86_64Assembler::vmovapd(const Address& dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x29, src, dst);
+}
+
+
+void X86_64Assembler::vmovupd(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x10, dst, src);
+}
+
+
+void X86_64Assembler::vmovupd(const Address& dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x11, src, dst);
+}
+
+
+void X86_64Assembler::vmovdqa(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x6F, dst, src);
+}
+
+
+void X86_64Assembler::vmovdqa(const Address& dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x7F, src, dst);
+}
+
+
+void X86_64Assembler::vmovdqu(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPpF3, kVexMap0F, 0x6F, dst, src);
+}
+
+
+void X86_64Assembler::vmovdqu(const Address& dst, XmmRegister src) {
+  EmitVex256(kVexPpF3, kVexMap0F, 0x7F, src, dst);
+}
+
+
+void X86_64Assembler::vaddps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x58, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vsubps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5C, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vmulps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x59, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vdivps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5E, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vaddpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x58, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vsubpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x5C, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vmulpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x59, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vdivpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x5E, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpaddb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xFC, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpsubb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xF8, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpaddw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xFD, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpsubw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xF9, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpmullw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xD5, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpmaddwd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xF5, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpaddd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xFE, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpsubd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xFA, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpmulld(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x40, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpminsd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x39, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpmaxsd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3D, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpaddq(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xD4, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpsubq(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xFB, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vcvtdq2ps(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5B, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vxorps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x57, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vxorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x57, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpxor(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xEF, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vandps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x54, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vandpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x54, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpand(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xDB, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vandnps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x55, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vandnpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x55, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpandn(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xDF, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vorps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPpNone, kVexMap0F, 0x56, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x56, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpor(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xEB, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpavgb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xE0, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpavgw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0xE3, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpcmpeqb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVex256(kVexPp66, kVexMap0F, 0x74, dst, src1, src2);
+}
+
+
+void X86_64Assembler::vpabsb(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x1C, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpabsw(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x1D, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpabsd(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x1E, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpbroadcastb(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x78, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpbroadcastw(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x79, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpbroadcastd(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x58, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpbroadcastq(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x59, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vbroadcastss(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x18, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vbroadcastsd(XmmRegister dst, XmmRegister src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x19, dst, XmmRegister(0), src);
+}
+
+
+void X86_64Assembler::vpmovzxbw(XmmRegister dst, const Address& src) {
+  EmitVex256(kVexPp66, kVexMap0F38, 0x30, dst, src);
+}
+
+
+void X86_64Assembler::vextracti128(XmmRegister dst, XmmRegister src, const Immediate& imm) {
+  DCHECK(imm.is_uint8());
+  // The source is encoded in ModRM.reg and the destination in ModRM.rm.
+  EmitVex256(kVexPp66, kVexMap0F3A, 0x39, src, XmmRegister(0), dst);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(imm.value());
+}
+
+
+void X86_64Assembler::vpsllw(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x71, 6, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpslld(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x72, 6, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpsllq(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x73, 6, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpsraw(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x71, 4, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpsrad(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x72, 4, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpsrlw(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x71, 2, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpsrld(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x72, 2, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vpsrlq(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  EmitVex256Shift(0x73, 2, dst, src, shift_count);
+}
+
+
+void X86_64Assembler::vzeroupper() {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0xC5);
+  EmitUint8(0xF8);
+  EmitUint8(0x77);
+}
+
+
 void X86_64Assembler::fldl(const Address& src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xDD);
@@ -2284,6 +2687,25 @@ void X86_64Assembler::addl(const Address& address, const Immediate& imm) {
 }
 
 
+void X86_64Assembler::addw(const Address& address, const Immediate& imm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  CHECK(imm.is_uint16() || imm.is_int16()) << imm.value();
+  EmitOperandSizeOverride();
+  EmitOptionalRex32(address);
+  if (imm.is_int8()) {
+    // Use sign-extended 8-bit immediate.
+    EmitUint8(0x83);
+    EmitOperand(0, address);
+    EmitUint8(imm.value() & 0xFF);
+  } else {
+    EmitUint8(0x81);
+    EmitOperand(0, address);
+    EmitUint8(imm.value() & 0xFF);
+    EmitUint8(imm.value() >> 8);
+  }
+}
+
+
 void X86_64Assembler::subl(CpuRegister dst, CpuRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitOptionalRex32(dst, src);
@@ -3236,6 +3658,87 @@ void X86_64Assembler::EmitOptionalRex32(XmmRegister dst, const Operand& operand)
   }
 }
 
+void X86_64Assembler::EmitVexPrefix(bool r,
+                                    bool x,
+                                    bool b,
+                                    uint8_t opcode_map,
+                                    bool w,
+                                    uint8_t vvvv,
+                                    bool l,
+                                    uint8_t pp) {
+  // The R, X, B and vvvv fields are stored in inverted form.
+  uint8_t vvvv_l_pp = ((~vvvv & 0xF) << 3) | (l ? 0x04 : 0x00) | pp;
+  if (!x && !b && !w && opcode_map == kVexMap0F) {
+    // Two-byte form: C5 [R vvvv L pp].
+    EmitUint8(0xC5);
+    EmitUint8((r ? 0x00 : 0x80) | vvvv_l_pp);
+  } else {
+    // Three-byte form: C4 [R X B mmmmm] [W vvvv L pp].
+    EmitUint8(0xC4);
+    EmitUint8((r ? 0x00 : 0x80) | (x ? 0x00 : 0x40) | (b ? 0x00 : 0x20) | opcode_map);
+    EmitUint8((w ? 0x80 : 0x00) | vvvv_l_pp);
+  }
+}
+
+void X86_64Assembler::EmitVex256(uint8_t pp,
+                                 uint8_t opcode_map,
+                                 uint8_t opcode,
+                                 XmmRegister reg,
+                                 XmmRegister vvvv,
+                                 XmmRegister rm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(reg.NeedsRex(),
+                /* x */ false,
+                rm.NeedsRex(),
+                opcode_map,
+                /* w */ false,
+                static_cast<uint8_t>(vvvv.AsFloatRegister()),
+                /* l */ true,
+                pp);
+  EmitUint8(opcode);
+  EmitXmmRegisterOperand(reg.LowBits(), rm);
+}
+
+void X86_64Assembler::EmitVex256(uint8_t pp,
+                                 uint8_t opcode_map,
+                                 uint8_t opcode,
+                                 XmmRegister reg,
+                                 const Address& rm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  uint8_t rex = rm.rex();
+  EmitVexPrefix(reg.NeedsRex(),
+                (rex & 0x02) != 0,  // REX.00X0
+                (rex & 0x01) != 0,  // REX.000B
+                opcode_map,
+                /* w */ false,
+                /* vvvv */ 0u,
+                /* l */ true,
+                pp);
+  EmitUint8(opcode);
+  EmitOperand(reg.LowBits(), rm);
+}
+
+void X86_64Assembler::EmitVex256Shift(uint8_t opcode,
+                                      uint8_t reg_opcode,
+                                      XmmRegister dst,
+                                      XmmRegister src,
+                                      const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  // The destination is encoded in VEX.vvvv and the source in ModRM.rm.
+  EmitVexPrefix(/* r */ false,
+                /* x */ false,
+                src.NeedsRex(),
+                kVexMap0F,
+                /* w */ false,
+                static_cast<uint8_t>(dst.AsFloatRegister()),
+                /* l */ true,
+                kVexPp66);
+  EmitUint8(opcode);
+  EmitXmmRegisterOperand(reg_opcode, src);
+  EmitUint8(shift_count.value());
+}
+
 void X86_64Assembler::EmitRex64() {
   EmitOptionalRex(false, true, false, false, false);
 }
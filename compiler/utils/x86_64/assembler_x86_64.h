@@ -458,10 +458,13 @@ class X86_64Assembler FINAL : public Assembler {
   void paddw(XmmRegister dst, XmmRegister src);
   void psubw(XmmRegister dst, XmmRegister src);
   void pmullw(XmmRegister dst, XmmRegister src);
+  void pmaddwd(XmmRegister dst, XmmRegister src);
 
   void paddd(XmmRegister dst, XmmRegister src);
   void psubd(XmmRegister dst, XmmRegister src);
   void pmulld(XmmRegister dst, XmmRegister src);
+  void pminsd(XmmRegister dst, XmmRegister src);  // SSE4.1
+  void pmaxsd(XmmRegister dst, XmmRegister src);  // SSE4.1
 
   void paddq(XmmRegister dst, XmmRegister src);
   void psubq(XmmRegister dst, XmmRegister src);
@@ -557,6 +560,106 @@ class X86_64Assembler FINAL : public Assembler {
   void psrld(XmmRegister reg, const Immediate& shift_count);
   void psrlq(XmmRegister reg, const Immediate& shift_count);
 
+  //
+  // AVX2 instructions on 256-bit vectors (VEX.256 encoding). XmmRegister operands
+  // denote the YMM registers they are the lower half of.
+  //
+
+  void vmovaps(XmmRegister dst, XmmRegister src);     // move
+  void vmovaps(XmmRegister dst, const Address& src);  // load aligned
+  void vmovups(XmmRegister dst, const Address& src);  // load unaligned
+  void vmovaps(const Address& dst, XmmRegister src);  // store aligned
+  void vmovups(const Address& dst, XmmRegister src);  // store unaligned
+
+  void vmovapd(XmmRegister dst, const Address& src);  // load aligned
+  void vmovupd(XmmRegister dst, const Address& src);  // load unaligned
+  void vmovapd(const Address& dst, XmmRegister src);  // store aligned
+  void vmovupd(const Address& dst, XmmRegister src);  // store unaligned
+
+  void vmovdqa(XmmRegister dst, const Address& src);  // load aligned
+  void vmovdqu(XmmRegister dst, const Address& src);  // load unaligned
+  void vmovdqa(const Address& dst, XmmRegister src);  // store aligned
+  void vmovdqu(const Address& dst, XmmRegister src);  // store unaligned
+
+  void vaddps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vsubps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vmulps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vdivps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vaddpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vsubpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vmulpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vdivpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmullw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaddwd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmulld(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpminsd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxsd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddq(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubq(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vcvtdq2ps(XmmRegister dst, XmmRegister src);
+
+  void vxorps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vxorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpxor(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vandps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vandpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpand(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vandnps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vandnpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpandn(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vorps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpor(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpavgb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpavgw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpcmpeqb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpabsb(XmmRegister dst, XmmRegister src);
+  void vpabsw(XmmRegister dst, XmmRegister src);
+  void vpabsd(XmmRegister dst, XmmRegister src);
+
+  void vpbroadcastb(XmmRegister dst, XmmRegister src);
+  void vpbroadcastw(XmmRegister dst, XmmRegister src);
+  void vpbroadcastd(XmmRegister dst, XmmRegister src);
+  void vpbroadcastq(XmmRegister dst, XmmRegister src);
+  void vbroadcastss(XmmRegister dst, XmmRegister src);
+  void vbroadcastsd(XmmRegister dst, XmmRegister src);
+
+  void vpmovzxbw(XmmRegister dst, const Address& src);  // 16 bytes to 16 words
+  void vextracti128(XmmRegister dst, XmmRegister src, const Immediate& imm);  // upper/lower half
+
+  void vpsllw(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpslld(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsllq(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+
+  void vpsraw(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsrad(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  // no vpsraq
+
+  void vpsrlw(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsrld(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsrlq(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+
+  // Zeroes the upper halves of all YMM registers, to avoid AVX-SSE transition penalties.
+  void vzeroupper();
+
   void flds(const Address& src);
   void fstps(const Address& dst);
   void fsts(const Address& dst);
@@ -639,6 +742,7 @@ class X86_64Assembler FINAL : public Assembler {
   void addl(CpuRegister reg, const Address& address);
   void addl(const Address& address, CpuRegister reg);
   void addl(const Address& address, const Immediate& imm);
+  void addw(const Address& address, const Immediate& imm);
 
   void addq(CpuRegister reg, const Immediate& imm);
   void addq(CpuRegister dst, CpuRegister src);
@@ -860,6 +964,33 @@ class X86_64Assembler FINAL : public Assembler {
   void EmitGenericShift(bool wide, int rm, CpuRegister operand, CpuRegister shifter);
 
   // If any input is not false, output the necessary rex prefix.
+  // Emits a VEX prefix, using the two-byte form when the fields allow it.
+  void EmitVexPrefix(bool r,
+                     bool x,
+                     bool b,
+                     uint8_t opcode_map,
+                     bool w,
+                     uint8_t vvvv,
+                     bool l,
+                     uint8_t pp);
+  // Emit 256-bit VEX instructions with a register or memory operand in ModRM.rm.
+  void EmitVex256(uint8_t pp,
+                  uint8_t opcode_map,
+                  uint8_t opcode,
+                  XmmRegister reg,
+                  XmmRegister vvvv,
+                  XmmRegister rm);
+  void EmitVex256(uint8_t pp,
+                  uint8_t opcode_map,
+                  uint8_t opcode,
+                  XmmRegister reg,
+                  const Address& rm);
+  void EmitVex256Shift(uint8_t opcode,
+                       uint8_t reg_opcode,
+                       XmmRegister dst,
+                       XmmRegister src,
+                       const Immediate& shift_count);
+
   void EmitOptionalRex(bool force, bool w, bool r, bool x, bool b);
 
   // Emit a rex prefix byte if necessary for reg. ie if reg is a register in the range R8 to R15.
@@ -787,6 +787,20 @@ TEST_F(AssemblerX86_64Test, Cmpw) {
   DriverStr(expected, "cmpw");
 }
 
+TEST_F(AssemblerX86_64Test, Addw) {
+  GetAssembler()->addw(x86_64::Address(x86_64::CpuRegister(x86_64::RAX), 0),
+                       x86_64::Immediate(1));
+  GetAssembler()->addw(x86_64::Address(x86_64::CpuRegister(x86_64::R9), 8),
+                       x86_64::Immediate(-1));
+  GetAssembler()->addw(x86_64::Address(x86_64::CpuRegister(x86_64::R14), 0),
+                       x86_64::Immediate(0x1234));
+  const char* expected =
+      "addw $1, 0(%RAX)\n"
+      "addw $-1, 8(%R9)\n"
+      "addw $0x1234, 0(%R14)\n";
+  DriverStr(expected, "addw");
+}
+
 TEST_F(AssemblerX86_64Test, MovqAddrImm) {
   GetAssembler()->movq(x86_64::Address(x86_64::CpuRegister(x86_64::RAX), 0),
                        x86_64::Immediate(-5));
@@ -1148,6 +1162,10 @@ TEST_F(AssemblerX86_64Test, Pmullw) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pmullw, "pmullw %{reg2}, %{reg1}"), "pmullw");
 }
 
+TEST_F(AssemblerX86_64Test, Pmaddwd) {
+  DriverStr(RepeatFF(&x86_64::X86_64Assembler::pmaddwd, "pmaddwd %{reg2}, %{reg1}"), "pmaddwd");
+}
+
 TEST_F(AssemblerX86_64Test, Paddd) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::paddd, "paddd %{reg2}, %{reg1}"), "paddd");
 }
@@ -1160,6 +1178,14 @@ TEST_F(AssemblerX86_64Test, Pmulld) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pmulld, "pmulld %{reg2}, %{reg1}"), "pmulld");
 }
 
+TEST_F(AssemblerX86_64Test, Pminsd) {
+  DriverStr(RepeatFF(&x86_64::X86_64Assembler::pminsd, "pminsd %{reg2}, %{reg1}"), "pminsd");
+}
+
+TEST_F(AssemblerX86_64Test, Pmaxsd) {
+  DriverStr(RepeatFF(&x86_64::X86_64Assembler::pmaxsd, "pmaxsd %{reg2}, %{reg1}"), "pmaxsd");
+}
+
 TEST_F(AssemblerX86_64Test, Paddq) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::paddq, "paddq %{reg2}, %{reg1}"), "paddq");
 }
@@ -1417,6 +1443,114 @@ TEST_F(AssemblerX86_64Test, Psrlq) {
             "psrlq $2, %xmm15\n", "pslrqi");
 }
 
+TEST_F(AssemblerX86_64Test, VmovapsRegister) {
+  GetAssembler()->vmovaps(x86_64::XmmRegister(x86_64::XMM0), x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vmovaps(x86_64::XmmRegister(x86_64::XMM8), x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vmovaps(x86_64::XmmRegister(x86_64::XMM1), x86_64::XmmRegister(x86_64::XMM8));
+  GetAssembler()->vmovaps(x86_64::XmmRegister(x86_64::XMM9), x86_64::XmmRegister(x86_64::XMM10));
+  DriverStr("vmovaps %ymm1, %ymm0\n"
+            "vmovaps %ymm1, %ymm8\n"
+            "vmovaps %ymm8, %ymm1\n"
+            "vmovaps %ymm10, %ymm9\n", "vmovaps_ymm");
+}
+
+TEST_F(AssemblerX86_64Test, VmovdquLoadStore) {
+  GetAssembler()->vmovdqu(x86_64::XmmRegister(x86_64::XMM1), x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RSI), x86_64::TIMES_4, 16));
+  GetAssembler()->vmovdqu(x86_64::XmmRegister(x86_64::XMM9), x86_64::Address(
+      x86_64::CpuRegister(x86_64::R8), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_8, 16));
+  GetAssembler()->vmovdqu(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RSI), x86_64::TIMES_4, 16),
+      x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vmovdqu(x86_64::Address(
+      x86_64::CpuRegister(x86_64::R8), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_8, 16),
+      x86_64::XmmRegister(x86_64::XMM9));
+  DriverStr("vmovdqu 16(%rdi,%rsi,4), %ymm1\n"
+            "vmovdqu 16(%r8,%r9,8), %ymm9\n"
+            "vmovdqu %ymm1, 16(%rdi,%rsi,4)\n"
+            "vmovdqu %ymm9, 16(%r8,%r9,8)\n", "vmovdqu_ymm");
+}
+
+TEST_F(AssemblerX86_64Test, Vpaddd) {
+  GetAssembler()->vpaddd(x86_64::XmmRegister(x86_64::XMM0),
+                         x86_64::XmmRegister(x86_64::XMM1),
+                         x86_64::XmmRegister(x86_64::XMM2));
+  GetAssembler()->vpaddd(x86_64::XmmRegister(x86_64::XMM15),
+                         x86_64::XmmRegister(x86_64::XMM14),
+                         x86_64::XmmRegister(x86_64::XMM13));
+  DriverStr("vpaddd %ymm2, %ymm1, %ymm0\n"
+            "vpaddd %ymm13, %ymm14, %ymm15\n", "vpaddd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmulld) {
+  GetAssembler()->vpmulld(x86_64::XmmRegister(x86_64::XMM0),
+                          x86_64::XmmRegister(x86_64::XMM1),
+                          x86_64::XmmRegister(x86_64::XMM2));
+  GetAssembler()->vpmulld(x86_64::XmmRegister(x86_64::XMM8),
+                          x86_64::XmmRegister(x86_64::XMM9),
+                          x86_64::XmmRegister(x86_64::XMM10));
+  DriverStr("vpmulld %ymm2, %ymm1, %ymm0\n"
+            "vpmulld %ymm10, %ymm9, %ymm8\n", "vpmulld");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaddwd) {
+  GetAssembler()->vpmaddwd(x86_64::XmmRegister(x86_64::XMM0),
+                           x86_64::XmmRegister(x86_64::XMM1),
+                           x86_64::XmmRegister(x86_64::XMM2));
+  GetAssembler()->vpmaddwd(x86_64::XmmRegister(x86_64::XMM8),
+                           x86_64::XmmRegister(x86_64::XMM9),
+                           x86_64::XmmRegister(x86_64::XMM10));
+  DriverStr("vpmaddwd %ymm2, %ymm1, %ymm0\n"
+            "vpmaddwd %ymm10, %ymm9, %ymm8\n", "vpmaddwd");
+}
+
+TEST_F(AssemblerX86_64Test, VpminsdVpmaxsd) {
+  GetAssembler()->vpminsd(x86_64::XmmRegister(x86_64::XMM0),
+                          x86_64::XmmRegister(x86_64::XMM1),
+                          x86_64::XmmRegister(x86_64::XMM2));
+  GetAssembler()->vpmaxsd(x86_64::XmmRegister(x86_64::XMM8),
+                          x86_64::XmmRegister(x86_64::XMM9),
+                          x86_64::XmmRegister(x86_64::XMM10));
+  DriverStr("vpminsd %ymm2, %ymm1, %ymm0\n"
+            "vpmaxsd %ymm10, %ymm9, %ymm8\n", "vpminsd_vpmaxsd");
+}
+
+TEST_F(AssemblerX86_64Test, Vextracti128) {
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM0),
+                               x86_64::XmmRegister(x86_64::XMM1),
+                               x86_64::Immediate(1));
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM9),
+                               x86_64::XmmRegister(x86_64::XMM10),
+                               x86_64::Immediate(1));
+  DriverStr("vextracti128 $1, %ymm1, %xmm0\n"
+            "vextracti128 $1, %ymm10, %xmm9\n", "vextracti128");
+}
+
+TEST_F(AssemblerX86_64Test, Vpbroadcastd) {
+  GetAssembler()->vpbroadcastd(x86_64::XmmRegister(x86_64::XMM0),
+                               x86_64::XmmRegister(x86_64::XMM0));
+  GetAssembler()->vpbroadcastd(x86_64::XmmRegister(x86_64::XMM9),
+                               x86_64::XmmRegister(x86_64::XMM2));
+  DriverStr("vpbroadcastd %xmm0, %ymm0\n"
+            "vpbroadcastd %xmm2, %ymm9\n", "vpbroadcastd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpsrld) {
+  GetAssembler()->vpsrld(x86_64::XmmRegister(x86_64::XMM0),
+                         x86_64::XmmRegister(x86_64::XMM0),
+                         x86_64::Immediate(1));
+  GetAssembler()->vpsrld(x86_64::XmmRegister(x86_64::XMM15),
+                         x86_64::XmmRegister(x86_64::XMM15),
+                         x86_64::Immediate(2));
+  DriverStr("vpsrld $1, %ymm0, %ymm0\n"
+            "vpsrld $2, %ymm15, %ymm15\n", "vpsrldi");
+}
+
+TEST_F(AssemblerX86_64Test, Vzeroupper) {
+  GetAssembler()->vzeroupper();
+  DriverStr("vzeroupper\n", "vzeroupper");
+}
+
 TEST_F(AssemblerX86_64Test, UcomissAddress) {
   GetAssembler()->ucomiss(x86_64::XmmRegister(x86_64::XMM0), x86_64::Address(
       x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RBX), x86_64::TIMES_4, 12));
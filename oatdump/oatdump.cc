@@ -622,6 +622,9 @@ class OatDumper {
       kByteKindInlineInfoLast = kByteKindInlineInfoIsLast,
     };
     int64_t bits[kByteKindCount] = {};
+    // Size the location catalogs would take with large locations stored in full rather
+    // than as deltas. Not part of the accounted bytes.
+    int64_t location_catalog_bits_without_deltas = 0;
     // Since code has deduplication, seen tracks already seen pointers to avoid double counting
     // deduplicated code and tables.
     std::unordered_set<const void*> seen;
@@ -648,6 +651,14 @@ class OatDumper {
         Dump(os, "QuickMethodHeader               ", bits[kByteKindQuickMethodHeader], sum);
         Dump(os, "CodeInfoEncoding                ", bits[kByteKindCodeInfoEncoding], sum);
         Dump(os, "CodeInfoLocationCatalog         ", bits[kByteKindCodeInfoLocationCatalog], sum);
+        if (bits[kByteKindCodeInfoLocationCatalog] > 0) {
+          ScopedIndentation indent1(&os);
+          Dump(os,
+               "LocationCatalogWithoutDeltas  ",
+               location_catalog_bits_without_deltas,
+               bits[kByteKindCodeInfoLocationCatalog],
+               "location catalog");
+        }
         Dump(os, "CodeInfoDexRegisterMap          ", bits[kByteKindCodeInfoDexRegisterMap], sum);
         Dump(os, "CodeInfoStackMasks              ", bits[kByteKindCodeInfoStackMasks], sum);
         Dump(os, "CodeInfoRegisterMasks           ", bits[kByteKindCodeInfoRegisterMasks], sum);
@@ -1658,6 +1669,9 @@ class OatDumper {
               helper.GetCodeInfo().GetDexRegisterLocationCatalogSize(encoding);
           stats_.AddBits(Stats::kByteKindCodeInfoLocationCatalog,
                          kBitsPerByte * location_catalog_bytes);
+          stats_.location_catalog_bits_without_deltas += kBitsPerByte *
+              helper.GetCodeInfo().GetDexRegisterLocationCatalog(encoding).ComputeSizeWithoutDeltas(
+                  helper.GetCodeInfo().GetNumberOfLocationCatalogEntries(encoding));
           // Dex register bytes.
           const size_t dex_register_bytes =
               helper.GetCodeInfo().GetDexRegisterMapsSize(encoding, code_item->registers_size_);
@@ -33,6 +33,10 @@ namespace art {
 // Cast entrypoints.
 extern "C" size_t artInstanceOfFromCode(mirror::Object* obj, mirror::Class* ref_class);
 
+// JIT baseline entrypoints.
+extern "C" void art_quick_compile_optimized();
+extern "C" void art_quick_update_inline_cache();
+
 // Read barrier entrypoints.
 // art_quick_read_barrier_mark_regX uses an non-standard calling
 // convention: it expects its input in register X and returns its
@@ -138,6 +142,10 @@ void InitEntryPoints(JniEntryPoints* jpoints, QuickEntryPoints* qpoints) {
   qpoints->pInstanceofNonTrivial = artInstanceOfFromCode;
   qpoints->pCheckInstanceOf = art_quick_check_instance_of;
 
+  // JIT baseline code.
+  qpoints->pCompileOptimized = art_quick_compile_optimized;
+  qpoints->pUpdateInlineCache = art_quick_update_inline_cache;
+
   // Math
   // TODO null entrypoints not needed for ARM64 - generate inline.
   qpoints->pCmpgDouble = nullptr;
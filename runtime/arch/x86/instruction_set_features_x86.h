@@ -64,6 +64,10 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
 
   bool HasSSE4_1() const { return has_SSE4_1_; }
 
+  bool HasAVX() const { return has_AVX_; }
+
+  bool HasAVX2() const { return has_AVX2_; }
+
   bool HasPopCnt() const { return has_POPCNT_; }
 
  protected:
@@ -106,4 +106,24 @@ TEST(X86InstructionSetFeaturesTest, X86FeaturesFromSilvermontVariant) {
   EXPECT_FALSE(x86_features->Equals(x86_default_features.get()));
 }
 
+TEST(X86InstructionSetFeaturesTest, X86_64FeaturesWithAvx2FromString) {
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> base_features(
+      InstructionSetFeatures::FromVariant(kX86_64, "silvermont", &error_msg));
+  ASSERT_TRUE(base_features.get() != nullptr) << error_msg;
+  std::unique_ptr<const InstructionSetFeatures> avx2_features(
+      base_features->AddFeaturesFromString("avx,avx2", &error_msg));
+  ASSERT_TRUE(avx2_features.get() != nullptr) << error_msg;
+  EXPECT_TRUE(avx2_features->AsX86InstructionSetFeatures()->HasAVX());
+  EXPECT_TRUE(avx2_features->AsX86InstructionSetFeatures()->HasAVX2());
+  EXPECT_STREQ("ssse3,sse4.1,sse4.2,avx,avx2,popcnt",
+               avx2_features->GetFeatureString().c_str());
+  EXPECT_EQ(avx2_features->AsBitmap(), 63U);
+
+  // AVX2 survives a round trip through the bitmap stored in oat files.
+  std::unique_ptr<const InstructionSetFeatures> from_bitmap(
+      InstructionSetFeatures::FromBitmap(kX86_64, avx2_features->AsBitmap()));
+  EXPECT_TRUE(from_bitmap->Equals(avx2_features.get()));
+}
+
 }  // namespace art
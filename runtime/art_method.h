@@ -628,6 +628,10 @@ class ArtMethod FINAL {
     return hotness_count_;
   }
 
+  static MemberOffset HotnessCountOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(ArtMethod, hotness_count_));
+  }
+
   const uint8_t* GetQuickenedInfo(PointerSize pointer_size) REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Returns the method header for the compiled code containing 'pc'. Note that runtime
@@ -692,8 +696,9 @@ class ArtMethod FINAL {
   // ifTable.
   uint16_t method_index_;
 
-  // The hotness we measure for this method. Managed by the interpreter. Not atomic, as we allow
-  // missing increments: if the method is hot, we will see it eventually.
+  // The hotness we measure for this method. Managed by the interpreter, and incremented by
+  // JIT baseline code. Not atomic, as we allow missing increments: if the method is hot, we
+  // will see it eventually.
   uint16_t hotness_count_;
 
   // Fake padding field gets inserted here.
@@ -30,6 +30,7 @@ namespace art {
 
 constexpr size_t kMemoryToolRedZoneBytes = 8;
 constexpr size_t Arena::kDefaultSize;
+constexpr size_t ArenaPool::kMaxFreeLargeArenaBytes;
 
 template <bool kCount>
 const char* const ArenaAllocatorStatsImpl<kCount>::kAllocNames[] = {
@@ -271,6 +272,8 @@ ArenaPool::ArenaPool(bool use_malloc, bool low_4gb, const char* name)
     : use_malloc_(use_malloc),
       lock_("Arena pool lock", kArenaPoolLock),
       free_arenas_(nullptr),
+      free_large_arenas_(nullptr),
+      free_large_arena_bytes_(0u),
       low_4gb_(low_4gb),
       name_(name) {
   if (low_4gb) {
@@ -291,6 +294,12 @@ void ArenaPool::ReclaimMemory() {
     free_arenas_ = free_arenas_->next_;
     delete arena;
   }
+  while (free_large_arenas_ != nullptr) {
+    auto* arena = free_large_arenas_;
+    free_large_arenas_ = free_large_arenas_->next_;
+    delete arena;
+  }
+  free_large_arena_bytes_ = 0u;
 }
 
 void ArenaPool::LockReclaimMemory() {
@@ -303,9 +312,23 @@ Arena* ArenaPool::AllocArena(size_t size) {
   Arena* ret = nullptr;
   {
     MutexLock lock(self, lock_);
-    if (free_arenas_ != nullptr && LIKELY(free_arenas_->Size() >= size)) {
-      ret = free_arenas_;
-      free_arenas_ = free_arenas_->next_;
+    if (size <= Arena::kDefaultSize) {
+      if (free_arenas_ != nullptr && LIKELY(free_arenas_->Size() >= size)) {
+        ret = free_arenas_;
+        free_arenas_ = free_arenas_->next_;
+      }
+    } else {
+      // Take the smallest large arena that fits, so that the bigger ones remain
+      // available for the requests that need them.
+      Arena** link = &free_large_arenas_;
+      while (*link != nullptr && (*link)->Size() < size) {
+        link = &(*link)->next_;
+      }
+      if (*link != nullptr) {
+        ret = *link;
+        *link = ret->next_;
+        free_large_arena_bytes_ -= ret->Size();
+      }
     }
   }
   if (ret == nullptr) {
@@ -317,13 +340,30 @@ Arena* ArenaPool::AllocArena(size_t size) {
 }
 
 void ArenaPool::TrimMaps() {
+  ScopedTrace trace(__PRETTY_FUNCTION__);
   if (!use_malloc_) {
-    ScopedTrace trace(__PRETTY_FUNCTION__);
-    // Doesn't work for malloc.
     MutexLock lock(Thread::Current(), lock_);
     for (auto* arena = free_arenas_; arena != nullptr; arena = arena->next_) {
       arena->Release();
     }
+    for (auto* arena = free_large_arenas_; arena != nullptr; arena = arena->next_) {
+      arena->Release();
+    }
+  } else {
+    // Madvising doesn't work for malloc. Free the large arenas instead, they hold the peak
+    // memory of the biggest methods and are the least likely to be needed again.
+    Arena* large_arenas = nullptr;
+    {
+      MutexLock lock(Thread::Current(), lock_);
+      large_arenas = free_large_arenas_;
+      free_large_arenas_ = nullptr;
+      free_large_arena_bytes_ = 0u;
+    }
+    while (large_arenas != nullptr) {
+      Arena* next = large_arenas->next_;
+      delete large_arenas;
+      large_arenas = next;
+    }
   }
 }
 
@@ -333,9 +373,27 @@ size_t ArenaPool::GetBytesAllocated() const {
   for (Arena* arena = free_arenas_; arena != nullptr; arena = arena->next_) {
     total += arena->GetBytesAllocated();
   }
+  for (Arena* arena = free_large_arenas_; arena != nullptr; arena = arena->next_) {
+    total += arena->GetBytesAllocated();
+  }
   return total;
 }
 
+void ArenaPool::FreeArena(Arena* arena) {
+  if (arena->Size() <= Arena::kDefaultSize) {
+    arena->next_ = free_arenas_;
+    free_arenas_ = arena;
+    return;
+  }
+  Arena** link = &free_large_arenas_;
+  while (*link != nullptr && (*link)->Size() < arena->Size()) {
+    link = &(*link)->next_;
+  }
+  arena->next_ = *link;
+  *link = arena;
+  free_large_arena_bytes_ += arena->Size();
+}
+
 void ArenaPool::FreeArenaChain(Arena* first) {
   if (UNLIKELY(RUNNING_ON_MEMORY_TOOL > 0)) {
     for (Arena* arena = first; arena != nullptr; arena = arena->next_) {
@@ -343,14 +401,35 @@ void ArenaPool::FreeArenaChain(Arena* first) {
     }
   }
   if (first != nullptr) {
-    Arena* last = first;
-    while (last->next_ != nullptr) {
-      last = last->next_;
+    Arena* trimmed = nullptr;
+    {
+      Thread* self = Thread::Current();
+      MutexLock lock(self, lock_);
+      while (first != nullptr) {
+        Arena* next = first->next_;
+        FreeArena(first);
+        first = next;
+      }
+      // Drop the largest free arenas above the limit. They are the least likely
+      // to be needed again.
+      while (free_large_arena_bytes_ > kMaxFreeLargeArenaBytes) {
+        Arena** link = &free_large_arenas_;
+        while ((*link)->next_ != nullptr) {
+          link = &(*link)->next_;
+        }
+        Arena* largest = *link;
+        *link = nullptr;
+        free_large_arena_bytes_ -= largest->Size();
+        largest->next_ = trimmed;
+        trimmed = largest;
+      }
+    }
+    // Unmap or free the memory outside of the lock.
+    while (trimmed != nullptr) {
+      Arena* next = trimmed->next_;
+      delete trimmed;
+      trimmed = next;
     }
-    Thread* self = Thread::Current();
-    MutexLock lock(self, lock_);
-    last->next_ = free_arenas_;
-    free_arenas_ = first;
   }
 }
 
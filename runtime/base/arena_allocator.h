@@ -254,14 +254,28 @@ class ArenaPool {
   size_t GetBytesAllocated() const REQUIRES(!lock_);
   void ReclaimMemory() NO_THREAD_SAFETY_ANALYSIS;
   void LockReclaimMemory() REQUIRES(!lock_);
-  // Trim the maps in arenas by madvising, used by JIT to reduce memory usage. This only works
-  // use_malloc is false.
+  // Trim the maps in arenas by madvising, used by JIT to reduce memory usage. Malloc arenas
+  // cannot be madvised, so for them only the free arenas larger than Arena::kDefaultSize are
+  // freed.
   void TrimMaps() REQUIRES(!lock_);
 
+  // Maximum number of bytes kept in free arenas larger than Arena::kDefaultSize. Such arenas
+  // are only requested for single allocations above the default size, typically when compiling
+  // huge methods, so keeping all of them around inflates the footprint of the pool to the sum
+  // of the peaks of all threads.
+  static constexpr size_t kMaxFreeLargeArenaBytes = 32 * Arena::kDefaultSize;
+
  private:
+  void FreeArena(Arena* arena) REQUIRES(lock_);
+
   const bool use_malloc_;
   mutable Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  // Free arenas of at most Arena::kDefaultSize bytes, handed out last in, first out.
   Arena* free_arenas_ GUARDED_BY(lock_);
+  // Free arenas larger than Arena::kDefaultSize, sorted by increasing size, so that a request
+  // takes the smallest arena that fits.
+  Arena* free_large_arenas_ GUARDED_BY(lock_);
+  size_t free_large_arena_bytes_ GUARDED_BY(lock_);
   const bool low_4gb_;
   const char* name_;
   DISALLOW_COPY_AND_ASSIGN(ArenaPool);
@@ -125,6 +125,45 @@ TEST_F(ArenaAllocatorTest, LargeAllocations) {
   }
 }
 
+TEST_F(ArenaAllocatorTest, LargeArenaReuse) {
+  ArenaPool pool;
+  void* small_allocation;
+  void* large_allocation;
+  void* larger_allocation;
+  {
+    ArenaAllocator arena(&pool);
+    small_allocation = arena.Alloc(Arena::kDefaultSize / 2);
+    larger_allocation = arena.Alloc(Arena::kDefaultSize * 4);
+    large_allocation = arena.Alloc(Arena::kDefaultSize * 2);
+  }
+  {
+    // A default size request does not take a large arena.
+    ArenaAllocator arena(&pool);
+    EXPECT_EQ(small_allocation, arena.Alloc(Arena::kDefaultSize / 2));
+  }
+  {
+    // A large request takes the smallest free arena that fits.
+    ArenaAllocator arena(&pool);
+    EXPECT_EQ(large_allocation, arena.Alloc(Arena::kDefaultSize * 3 / 2));
+  }
+  {
+    ArenaAllocator arena(&pool);
+    EXPECT_EQ(larger_allocation, arena.Alloc(Arena::kDefaultSize * 3));
+  }
+}
+
+TEST_F(ArenaAllocatorTest, LargeArenaTrim) {
+  ArenaPool pool;
+  {
+    ArenaAllocator arena(&pool);
+    arena.Alloc(ArenaPool::kMaxFreeLargeArenaBytes / 2);
+    arena.Alloc(ArenaPool::kMaxFreeLargeArenaBytes);
+  }
+  // Only the smaller arena is kept by the pool.
+  EXPECT_GE(pool.GetBytesAllocated(), ArenaPool::kMaxFreeLargeArenaBytes / 2);
+  EXPECT_LT(pool.GetBytesAllocated(), ArenaPool::kMaxFreeLargeArenaBytes);
+}
+
 TEST_F(ArenaAllocatorTest, AllocAlignment) {
   ArenaPool pool;
   ArenaAllocator arena(&pool);
@@ -455,6 +455,8 @@ static bool IsValidImplicitCheck(uintptr_t addr, ArtMethod* method, const Instru
     case Instruction::INVOKE_POLYMORPHIC:
     case Instruction::INVOKE_POLYMORPHIC_RANGE:
     case Instruction::INVOKE_VIRTUAL_QUICK:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
     case Instruction::INVOKE_VIRTUAL_RANGE_QUICK: {
       // Without inlining, we could just check that the offset is the class offset.
       // However, when inlining, the compiler can (validly) merge the null check with a field access
@@ -492,7 +494,11 @@ static bool IsValidImplicitCheck(uintptr_t addr, ArtMethod* method, const Instru
       }
       FALLTHROUGH_INTENDED;
     case Instruction::IGET_QUICK:
+    case Instruction::IGET_QUICK_IF_EQZ:
+    case Instruction::IGET_QUICK_IF_NEZ:
     case Instruction::IGET_BOOLEAN_QUICK:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_EQZ:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_NEZ:
     case Instruction::IGET_BYTE_QUICK:
     case Instruction::IGET_CHAR_QUICK:
     case Instruction::IGET_SHORT_QUICK:
@@ -584,6 +590,8 @@ void ThrowNullPointerExceptionFromDexPC(bool check_address, uintptr_t addr) {
       ThrowNullPointerExceptionForMethodAccess(instr->VRegB_4rcc(), kVirtual);
       break;
     case Instruction::INVOKE_VIRTUAL_QUICK:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
     case Instruction::INVOKE_VIRTUAL_RANGE_QUICK: {
       // Since we replaced the method index, we ask the verifier to tell us which
       // method is invoked at this location.
@@ -611,7 +619,11 @@ void ThrowNullPointerExceptionFromDexPC(bool check_address, uintptr_t addr) {
       break;
     }
     case Instruction::IGET_QUICK:
+    case Instruction::IGET_QUICK_IF_EQZ:
+    case Instruction::IGET_QUICK_IF_NEZ:
     case Instruction::IGET_BOOLEAN_QUICK:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_EQZ:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_NEZ:
     case Instruction::IGET_BYTE_QUICK:
     case Instruction::IGET_CHAR_QUICK:
     case Instruction::IGET_SHORT_QUICK:
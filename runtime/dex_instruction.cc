@@ -273,6 +273,8 @@ std::string Instruction::DumpString(const DexFile* file) const {
           }
           FALLTHROUGH_INTENDED;
         case IGET_QUICK:
+        case IGET_QUICK_IF_EQZ:
+        case IGET_QUICK_IF_NEZ:
         case IGET_OBJECT_QUICK:
           if (file != nullptr) {
             uint32_t field_idx = VRegC_22c();
@@ -394,6 +396,8 @@ std::string Instruction::DumpString(const DexFile* file) const {
           }
           FALLTHROUGH_INTENDED;
         case INVOKE_VIRTUAL_QUICK:
+        case INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+        case INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
           if (file != nullptr) {
             os << opcode << " {";
             uint32_t method_idx = VRegB_35c();
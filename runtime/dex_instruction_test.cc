@@ -28,6 +28,27 @@ TEST(StaticGetters, PropertiesOfNopTest) {
   EXPECT_EQ(Instruction::kVerifyNone, Instruction::VerifyFlagsOf(nop));
 }
 
+// A superinstruction must look like its first instruction to everything but the interpreter.
+static void ExpectSameProperties(Instruction::Code fused, Instruction::Code first) {
+  EXPECT_EQ(Instruction::FormatOf(first), Instruction::FormatOf(fused)) << Instruction::Name(fused);
+  EXPECT_EQ(Instruction::IndexTypeOf(first), Instruction::IndexTypeOf(fused))
+      << Instruction::Name(fused);
+  EXPECT_EQ(Instruction::FlagsOf(first), Instruction::FlagsOf(fused)) << Instruction::Name(fused);
+  EXPECT_EQ(Instruction::VerifyFlagsOf(first), Instruction::VerifyFlagsOf(fused))
+      << Instruction::Name(fused);
+}
+
+TEST(StaticGetters, PropertiesOfSuperinstructions) {
+  ExpectSameProperties(Instruction::IGET_QUICK_IF_EQZ, Instruction::IGET_QUICK);
+  ExpectSameProperties(Instruction::IGET_QUICK_IF_NEZ, Instruction::IGET_QUICK);
+  ExpectSameProperties(Instruction::IGET_BOOLEAN_QUICK_IF_EQZ, Instruction::IGET_BOOLEAN_QUICK);
+  ExpectSameProperties(Instruction::IGET_BOOLEAN_QUICK_IF_NEZ, Instruction::IGET_BOOLEAN_QUICK);
+  ExpectSameProperties(Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT,
+                       Instruction::INVOKE_VIRTUAL_QUICK);
+  ExpectSameProperties(Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT,
+                       Instruction::INVOKE_VIRTUAL_QUICK);
+}
+
 static void Build45cc(uint8_t num_args, uint16_t method_idx, uint16_t proto_idx,
                       uint16_t arg_regs, uint16_t* out) {
   // A = num argument registers
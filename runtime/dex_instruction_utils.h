@@ -70,7 +70,9 @@ constexpr bool IsInstructionInvoke(Instruction::Code opcode) {
 
 constexpr bool IsInstructionQuickInvoke(Instruction::Code opcode) {
   return opcode == Instruction::INVOKE_VIRTUAL_QUICK ||
-      opcode == Instruction::INVOKE_VIRTUAL_RANGE_QUICK;
+      opcode == Instruction::INVOKE_VIRTUAL_RANGE_QUICK ||
+      opcode == Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT ||
+      opcode == Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT;
 }
 
 constexpr bool IsInstructionInvokeStatic(Instruction::Code opcode) {
@@ -119,7 +121,8 @@ constexpr bool IsInstructionIGetOrIPut(Instruction::Code code) {
 
 constexpr bool IsInstructionIGetQuickOrIPutQuick(Instruction::Code code) {
   return (code >= Instruction::IGET_QUICK && code <= Instruction::IPUT_OBJECT_QUICK) ||
-      (code >= Instruction::IPUT_BOOLEAN_QUICK && code <= Instruction::IGET_SHORT_QUICK);
+      (code >= Instruction::IPUT_BOOLEAN_QUICK && code <= Instruction::IGET_SHORT_QUICK) ||
+      (code >= Instruction::IGET_QUICK_IF_EQZ && code <= Instruction::IGET_BOOLEAN_QUICK_IF_NEZ);
 }
 
 constexpr bool IsInstructionSGetOrSPut(Instruction::Code code) {
@@ -185,12 +188,14 @@ inline DexMemAccessType IGetQuickOrIPutQuickMemAccessType(Instruction::Code code
   DCHECK(IsInstructionIGetQuickOrIPutQuick(code));
   switch (code) {
     case Instruction::IGET_QUICK: case Instruction::IPUT_QUICK:
+    case Instruction::IGET_QUICK_IF_EQZ: case Instruction::IGET_QUICK_IF_NEZ:
       return kDexMemAccessWord;
     case Instruction::IGET_WIDE_QUICK: case Instruction::IPUT_WIDE_QUICK:
       return kDexMemAccessWide;
     case Instruction::IGET_OBJECT_QUICK: case Instruction::IPUT_OBJECT_QUICK:
       return kDexMemAccessObject;
     case Instruction::IGET_BOOLEAN_QUICK: case Instruction::IPUT_BOOLEAN_QUICK:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_EQZ: case Instruction::IGET_BOOLEAN_QUICK_IF_NEZ:
       return kDexMemAccessBoolean;
     case Instruction::IGET_BYTE_QUICK: case Instruction::IPUT_BYTE_QUICK:
       return kDexMemAccessByte;
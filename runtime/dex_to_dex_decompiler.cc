@@ -117,7 +117,11 @@ bool DexDecompiler::Decompile() {
         DecompileNop(inst, dex_pc);
         break;
 
+      // Fused superinstructions leave the instruction they are fused with untouched, so
+      // restoring their first instruction is enough.
       case Instruction::IGET_QUICK:
+      case Instruction::IGET_QUICK_IF_EQZ:
+      case Instruction::IGET_QUICK_IF_NEZ:
         DecompileInstanceFieldAccess(inst, dex_pc, Instruction::IGET);
         break;
 
@@ -130,6 +134,8 @@ bool DexDecompiler::Decompile() {
         break;
 
       case Instruction::IGET_BOOLEAN_QUICK:
+      case Instruction::IGET_BOOLEAN_QUICK_IF_EQZ:
+      case Instruction::IGET_BOOLEAN_QUICK_IF_NEZ:
         DecompileInstanceFieldAccess(inst, dex_pc, Instruction::IGET_BOOLEAN);
         break;
 
@@ -174,6 +180,8 @@ bool DexDecompiler::Decompile() {
         break;
 
       case Instruction::INVOKE_VIRTUAL_QUICK:
+      case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+      case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
         DecompileInvokeVirtual(inst, dex_pc, Instruction::INVOKE_VIRTUAL, false);
         break;
 
@@ -66,6 +66,10 @@ bool EntrypointRequiresStackMap(QuickEntrypointEnum trampoline) {
     case kQuickA64Store:
       return false;
 
+    /* Used by JIT baseline code, never suspends. */
+    case kQuickUpdateInlineCache:
+      return false;
+
     default:
       return true;
   }
@@ -117,6 +121,10 @@ bool EntrypointCanTriggerGC(QuickEntrypointEnum entrypoint) {
     case kQuickA64Store:
       return false;
 
+    /* Used by JIT baseline code, never suspends. */
+    case kQuickUpdateInlineCache:
+      return false;
+
     default:
       return true;
   }
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "callee_save_frame.h"
+#include "entrypoints/entrypoint_utils.h"
+#include "jit/jit.h"
+#include "jit/profiling_info.h"
+#include "runtime.h"
+#include "thread-inl.h"
+
+namespace art {
+
+extern "C" void artCompileOptimizedFromCode(Thread* self) REQUIRES_SHARED(Locks::mutator_lock_) {
+  // Called when the hotness counter of JIT baseline code wraps around.
+  ScopedQuickEntrypointChecks sqec(self);
+  jit::Jit* jit = Runtime::Current()->GetJit();
+  if (jit != nullptr) {
+    // Baseline code does not inline, so the caller is the outer method.
+    jit->MaybeCompileOptimized(self, GetCalleeSaveOuterMethod(self, Runtime::kSaveEverything));
+  }
+}
+
+extern "C" void artUpdateInlineCache(mirror::Class* cls, InlineCache* cache, Thread* self)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  // Called from JIT baseline code for a receiver class that is not the first one of the cache.
+  ScopedQuickEntrypointChecks sqec(self);
+  ScopedAssertNoThreadSuspension sants(__FUNCTION__);
+  ProfilingInfo::AddInvokeInfo(cache, cls);
+}
+
+}  // namespace art
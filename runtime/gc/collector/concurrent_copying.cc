@@ -40,6 +40,7 @@
 #include "scoped_thread_state_change-inl.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 #include "well_known_classes.h"
 
 namespace art {
@@ -59,13 +60,24 @@ static constexpr bool kDisallowReadBarrierDuringScan = kIsDebugBuild;
 static constexpr size_t kReadBarrierMarkStackSize = 512 * KB;
 // Verify that there are no missing card marks.
 static constexpr bool kVerifyNoMissingCardMarks = kIsDebugBuild;
+// Parallelism options.
+static constexpr bool kParallelProcessMarkStack = true;
+// Don't bother with the thread pool unless the GC mark stack has at least this many refs.
+static constexpr size_t kMinimumParallelMarkStackSize = 128;
+// Copy objects into thread-local evacuation buffers so that the GC threads and the mutators that
+// copy in the read barrier don't contend on the shared evacuation region.
+static constexpr bool kUseEvacBuffers = true;
+// Larger objects are copied into the shared evacuation region to limit the wasted buffer space.
+static constexpr size_t kMaxEvacBufferObjectSize = space::RegionSpace::kEvacBufferSize / 4;
 
 ConcurrentCopying::ConcurrentCopying(Heap* heap,
+                                     bool young_gen,
                                      const std::string& name_prefix,
                                      bool measure_read_barrier_slow_path)
     : GarbageCollector(heap,
                        name_prefix + (name_prefix.empty() ? "" : " ") +
                        "concurrent copying"),
+      young_gen_(young_gen),
       region_space_(nullptr), gc_barrier_(new Barrier(0)),
       gc_mark_stack_(accounting::ObjectStack::Create("concurrent copying gc mark stack",
                                                      kDefaultGcMarkStackSize,
@@ -76,6 +88,7 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
       rb_mark_bit_stack_full_(false),
       mark_stack_lock_("concurrent copying mark stack lock", kMarkSweepMarkStackLock),
       thread_running_gc_(nullptr),
+      is_parallel_marking_(false),
       is_marking_(false),
       is_active_(false),
       is_asserting_to_space_invariant_(false),
@@ -103,6 +116,8 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
                               kMarkSweepMarkStackLock) {
   static_assert(space::RegionSpace::kRegionSize == accounting::ReadBarrierTable::kRegionSize,
                 "The region space size and the read barrier table region size must match");
+  // The young generation collection relies on graying the old objects on dirty cards.
+  CHECK(!young_gen_ || kUseBakerReadBarrier);
   Thread* self = Thread::Current();
   {
     ReaderMutexLock mu(self, *Locks::heap_bitmap_lock_);
@@ -202,10 +217,15 @@ void ConcurrentCopying::BindBitmaps() {
       CHECK(space->IsZygoteSpace() || space->IsImageSpace());
       immune_spaces_.AddSpace(space);
     } else if (space == region_space_) {
-      // It is OK to clear the bitmap with mutators running since the only place it is read is
-      // VisitObjects which has exclusion with CC.
       region_space_bitmap_ = region_space_->GetMarkBitmap();
-      region_space_bitmap_->Clear();
+      // A young generation collection leaves the old regions alone, and the bitmap is what tells
+      // the live objects from the dead ones in their partially live regions. The young regions
+      // are all evacuated so they never have bits set.
+      if (!young_gen_) {
+        // It is OK to clear the bitmap with mutators running since the only place it is read is
+        // VisitObjects which has exclusion with CC.
+        region_space_bitmap_->Clear();
+      }
     }
   }
 }
@@ -262,8 +282,11 @@ void ConcurrentCopying::InitializePhase() {
     }
     LOG(INFO) << "GC end of InitializePhase";
   }
-  // Mark all of the zygote large objects without graying them.
-  MarkZygoteLargeObjects();
+  // Mark all of the zygote large objects without graying them. The young generation collection
+  // doesn't sweep the large object space.
+  if (!young_gen_) {
+    MarkZygoteLargeObjects();
+  }
 }
 
 // Used to switch the thread roots of a thread from from-space refs to to-space refs.
@@ -354,12 +377,22 @@ class ConcurrentCopying::FlipCallback : public Closure {
     }
     CHECK(thread == self);
     Locks::mutator_lock_->AssertExclusiveHeld(self);
-    cc->region_space_->SetFromSpace(cc->rb_table_, cc->force_evacuate_all_);
+    cc->region_space_->SetFromSpace(cc->rb_table_, cc->force_evacuate_all_, cc->young_gen_);
     cc->SwapStacks();
     if (ConcurrentCopying::kEnableFromSpaceAccountingCheck) {
       cc->RecordLiveStackFreezeSize(self);
-      cc->from_space_num_objects_at_first_pause_ = cc->region_space_->GetObjectsAllocated();
-      cc->from_space_num_bytes_at_first_pause_ = cc->region_space_->GetBytesAllocated();
+      if (cc->young_gen_) {
+        // The old regions stay in the to-space.
+        cc->from_space_num_objects_at_first_pause_ =
+            cc->region_space_->GetObjectsAllocatedInFromSpace() +
+            cc->region_space_->GetObjectsAllocatedInUnevacFromSpace();
+        cc->from_space_num_bytes_at_first_pause_ =
+            cc->region_space_->GetBytesAllocatedInFromSpace() +
+            cc->region_space_->GetBytesAllocatedInUnevacFromSpace();
+      } else {
+        cc->from_space_num_objects_at_first_pause_ = cc->region_space_->GetObjectsAllocated();
+        cc->from_space_num_bytes_at_first_pause_ = cc->region_space_->GetBytesAllocated();
+      }
     }
     cc->is_marking_ = true;
     cc->mark_stack_mode_.StoreRelaxed(ConcurrentCopying::kMarkStackModeThreadLocal);
@@ -378,6 +411,12 @@ class ConcurrentCopying::FlipCallback : public Closure {
         cc->VerifyGrayImmuneObjects();
       }
     }
+    if (cc->young_gen_) {
+      cc->GrayAllDirtyOldObjects();
+    }
+    if (cc->heap_->UseGenerationalConcurrentCopying()) {
+      cc->ClearNonImmuneCards();
+    }
     // May be null during runtime creation, in this case leave java_lang_Object null.
     // This is safe since single threaded behavior should mean FillDummyObject does not
     // happen when java_lang_Object_ is null.
@@ -634,6 +673,88 @@ void ConcurrentCopying::GrayAllDirtyImmuneObjects() {
   updated_all_immune_objects_.StoreRelaxed(true);
 }
 
+class ConcurrentCopying::GrayOldObjectVisitor {
+ public:
+  explicit GrayOldObjectVisitor(ConcurrentCopying* collector) : collector_(collector) {}
+
+  ALWAYS_INLINE void operator()(mirror::Object* obj) const REQUIRES_SHARED(Locks::mutator_lock_) {
+    DCHECK(!collector_->region_space_->IsInNewlyAllocatedRegion(obj));
+    if (obj->AtomicSetReadBarrierState(ReadBarrier::WhiteState(), ReadBarrier::GrayState())) {
+      collector_->PushOntoMarkStack(obj);
+    }
+  }
+
+ private:
+  ConcurrentCopying* const collector_;
+};
+
+void ConcurrentCopying::GrayAllDirtyOldObjects() {
+  TimingLogger::ScopedTiming split(__FUNCTION__, GetTimings());
+  DCHECK(young_gen_);
+  // The old objects are not traced by a young generation collection. The card table invariant
+  // (see VerifyNoMissingCardMarks) means that only the old objects on dirty cards may reference
+  // young objects, so these are the extra roots. Gray them before the mutators resume, otherwise
+  // a mutator could load a from-space reference out of one without taking the read barrier slow
+  // path.
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  GrayOldObjectVisitor visitor(this);
+  region_space_->VisitObjectsOnDirtyCardsInOldRegions(card_table, visitor);
+  WriterMutexLock mu(Thread::Current(), *Locks::heap_bitmap_lock_);
+  for (space::ContinuousSpace* space : heap_->GetContinuousSpaces()) {
+    if (space == region_space_ || immune_spaces_.ContainsSpace(space) ||
+        !space->IsContinuousMemMapAllocSpace()) {
+      continue;
+    }
+    card_table->Scan<false>(space->GetLiveBitmap(), space->Begin(), space->End(), visitor);
+  }
+  // There are few large objects, check them one by one.
+  space::LargeObjectSpace* const los = heap_->GetLargeObjectsSpace();
+  if (los != nullptr) {
+    std::pair<uint8_t*, uint8_t*> range = los->GetBeginEndAtomic();
+    los->GetLiveBitmap()->VisitMarkedRange(reinterpret_cast<uintptr_t>(range.first),
+                                           reinterpret_cast<uintptr_t>(range.second),
+                                           [card_table, &visitor](mirror::Object* obj)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      if (card_table->IsDirty(obj)) {
+        visitor(obj);
+        *card_table->CardFromAddr(obj) = accounting::CardTable::kCardClean;
+      }
+    });
+  }
+  // The objects allocated in the non-moving spaces since the last collection are on the live
+  // stack (after SwapStacks()) rather than in the live bitmaps.
+  accounting::ObjectStack* live_stack = heap_->GetLiveStack();
+  for (StackReference<mirror::Object>* it = live_stack->Begin(); it != live_stack->End(); ++it) {
+    mirror::Object* obj = it->AsMirrorPtr();
+    if (obj != nullptr && !region_space_->HasAddress(obj) && card_table->IsDirty(obj)) {
+      visitor(obj);
+    }
+  }
+}
+
+void ConcurrentCopying::ClearNonImmuneCards() {
+  TimingLogger::ScopedTiming split("(Paused)ClearNonImmuneCards", GetTimings());
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  // The references in the objects on these cards get updated to to-space references by this
+  // collection. A to-space reference is to an old object after this collection completes,
+  // except for the objects the mutators allocate from now on, and the stores of those dirty the
+  // cards again.
+  card_table->ClearCardRange(region_space_->Begin(), region_space_->Limit());
+  if (young_gen_) {
+    // The old objects on the dirty cards of the non-moving spaces were grayed. A full collection
+    // leaves the cards alone, which at worst makes the next young collection gray a few extra
+    // objects.
+    for (space::ContinuousSpace* space : heap_->GetContinuousSpaces()) {
+      if (space == region_space_ || immune_spaces_.ContainsSpace(space) ||
+          !space->IsContinuousMemMapAllocSpace()) {
+        continue;
+      }
+      card_table->ClearCardRange(space->Begin(),
+                                 AlignUp(space->End(), accounting::CardTable::kCardSize));
+    }
+  }
+}
+
 void ConcurrentCopying::SwapStacks() {
   heap_->SwapStacks();
 }
@@ -856,6 +977,8 @@ class ConcurrentCopying::DisableMarkingCheckpoint : public Closure {
     // Note a thread that has just started right before this checkpoint may have already this flag
     // set to false, which is ok.
     thread->SetIsGcMarkingAndUpdateEntrypoints(false);
+    // No more copying after this point, the from-space is about to be cleared.
+    concurrent_copying_->RevokeThreadLocalEvacBuffer(thread);
     // If thread is a running mutator, then act on behalf of the garbage collector.
     // See the code in ThreadList::RunCheckpoint.
     concurrent_copying_->GetBarrier().Pass(self);
@@ -1324,6 +1447,24 @@ void ConcurrentCopying::RevokeThreadLocalMarkStack(Thread* thread) {
   }
 }
 
+void ConcurrentCopying::RevokeThreadLocalEvacBuffer(Thread* thread) {
+  if (!thread->HasEvacBuffer()) {
+    return;
+  }
+  uint8_t* unused_begin;
+  size_t unused_bytes;
+  region_space_->RevokeEvacBuffer(thread, &unused_begin, &unused_bytes);
+  if (unused_bytes != 0U) {
+    // Treat the unused end like a lost copy in Copy(), it may still get reused.
+    FillWithDummyObject(reinterpret_cast<mirror::Object*>(unused_begin), unused_bytes);
+    heap_->num_bytes_allocated_.FetchAndAddSequentiallyConsistent(unused_bytes);
+    to_space_bytes_skipped_.FetchAndAddSequentiallyConsistent(unused_bytes);
+    to_space_objects_skipped_.FetchAndAddSequentiallyConsistent(1);
+    MutexLock mu(Thread::Current(), skipped_blocks_lock_);
+    skipped_blocks_map_.insert(std::make_pair(unused_bytes, unused_begin));
+  }
+}
+
 void ConcurrentCopying::ProcessMarkStack() {
   if (kVerboseMode) {
     LOG(INFO) << "ProcessMarkStack. ";
@@ -1349,10 +1490,17 @@ bool ConcurrentCopying::ProcessMarkStackOnce() {
   if (mark_stack_mode == kMarkStackModeThreadLocal) {
     // Process the thread-local mark stacks and the GC mark stack.
     count += ProcessThreadLocalMarkStacks(false, nullptr);
-    while (!gc_mark_stack_->IsEmpty()) {
-      mirror::Object* to_ref = gc_mark_stack_->PopBack();
-      ProcessMarkStackRef(to_ref);
-      ++count;
+    const size_t thread_count = GetThreadCount();
+    if (kParallelProcessMarkStack && thread_count > 1 &&
+        gc_mark_stack_->Size() >= kMinimumParallelMarkStackSize) {
+      count += ProcessMarkStackParallel(thread_count);
+      DCHECK(gc_mark_stack_->IsEmpty());
+    } else {
+      while (!gc_mark_stack_->IsEmpty()) {
+        mirror::Object* to_ref = gc_mark_stack_->PopBack();
+        ProcessMarkStackRef(to_ref);
+        ++count;
+      }
     }
     gc_mark_stack_->Reset();
   } else if (mark_stack_mode == kMarkStackModeShared) {
@@ -1422,19 +1570,157 @@ size_t ConcurrentCopying::ProcessThreadLocalMarkStacks(bool disable_weak_ref_acc
       ProcessMarkStackRef(to_ref);
       ++count;
     }
+    RecycleMarkStack(Thread::Current(), mark_stack);
+  }
+  return count;
+}
+
+void ConcurrentCopying::RecycleMarkStack(Thread* self, accounting::ObjectStack* mark_stack) {
+  MutexLock mu(self, mark_stack_lock_);
+  if (pooled_mark_stacks_.size() >= kMarkStackPoolSize) {
+    // The pool has enough. Delete it.
+    delete mark_stack;
+  } else {
+    // Otherwise, put it into the pool for later reuse.
+    mark_stack->Reset();
+    pooled_mark_stacks_.push_back(mark_stack);
+  }
+}
+
+size_t ConcurrentCopying::GetThreadCount() const {
+  // Use less threads if we are in a background state (non jank perceptible) since we want to leave
+  // more CPU time for the foreground apps.
+  if (heap_->GetThreadPool() == nullptr || !Runtime::Current()->InJankPerceptibleProcessState()) {
+    return 1;
+  }
+  return heap_->GetConcGCThreadCount() + 1;
+}
+
+// A chunk of the GC mark stack handed to a heap thread pool worker. Refs the worker newly marks go
+// onto its own thread-local mark stack, and full thread-local mark stacks are revoked into
+// revoked_mark_stacks_ where idle workers can steal them.
+class ConcurrentCopying::MarkStackTask : public Task {
+ public:
+  MarkStackTask(ConcurrentCopying* collector,
+                size_t mark_stack_size,
+                StackReference<mirror::Object>* mark_stack)
+      : collector_(collector),
+        mark_stack_(mark_stack, mark_stack + mark_stack_size) {}
+
+  static constexpr size_t kMaxSize = 1 * KB;
+
+  // No thread safety analysis since the GC-running thread holds the mutator lock on behalf of the
+  // workers for the duration of ProcessMarkStackParallel().
+  void Run(Thread* self) OVERRIDE NO_THREAD_SAFETY_ANALYSIS {
+    if (kIsDebugBuild) {
+      collector_->RegisterParallelMarkingThread(self);
+    }
+    while (!mark_stack_.empty()) {
+      mirror::Object* to_ref = mark_stack_.back().AsMirrorPtr();
+      mark_stack_.pop_back();
+      collector_->ProcessMarkStackRef(to_ref);
+    }
+    collector_->ProcessMarkStackParallelWorker(self);
+  }
+
+  void Finalize() OVERRIDE {
+    delete this;
+  }
+
+ private:
+  ConcurrentCopying* const collector_;
+  std::vector<StackReference<mirror::Object>> mark_stack_;
+};
+
+size_t ConcurrentCopying::ProcessMarkStackParallel(size_t thread_count) {
+  TimingLogger::ScopedTiming split("ProcessMarkStackParallel", GetTimings());
+  Thread* self = Thread::Current();
+  DCHECK_EQ(self, thread_running_gc_);
+  DCHECK_EQ(static_cast<uint32_t>(mark_stack_mode_.LoadRelaxed()),
+            static_cast<uint32_t>(kMarkStackModeThreadLocal));
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  const size_t count = gc_mark_stack_->Size();
+  const size_t chunk_size = std::min(count / thread_count + 1, MarkStackTask::kMaxSize);
+  CHECK_GT(chunk_size, 0U);
+  // Split the GC mark stack up into work tasks.
+  for (StackReference<mirror::Object>* it = gc_mark_stack_->Begin(), *end = gc_mark_stack_->End();
+       it < end; ) {
+    const size_t delta = std::min(static_cast<size_t>(end - it), chunk_size);
+    thread_pool->AddTask(self, new MarkStackTask(this, delta, it));
+    it += delta;
+  }
+  // The refs were copied into the tasks. Refs the GC-running thread pushes while running tasks go
+  // back onto the GC mark stack.
+  gc_mark_stack_->Reset();
+  is_parallel_marking_.StoreSequentiallyConsistent(true);
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /* do_work */ true, /* may_hold_locks */ true);
+  thread_pool->StopWorkers(self);
+  is_parallel_marking_.StoreSequentiallyConsistent(false);
+  if (kIsDebugBuild) {
+    MutexLock mu(self, mark_stack_lock_);
+    parallel_marking_threads_.clear();
+  }
+  // The GC-running thread drained the GC mark stack in ProcessMarkStackParallelWorker() and only it
+  // pushes onto the GC mark stack, so the stack is empty now. A mark stack a worker revoked after
+  // the last steal attempt is processed by the caller in the next ProcessMarkStackOnce() round.
+  return count;
+}
+
+void ConcurrentCopying::RegisterParallelMarkingThread(Thread* self) {
+  MutexLock mu(self, mark_stack_lock_);
+  if (!ContainsElement(parallel_marking_threads_, self)) {
+    parallel_marking_threads_.push_back(self);
+  }
+}
+
+bool ConcurrentCopying::IsGcMarkingThread(Thread* self) {
+  if (self == thread_running_gc_) {
+    return true;
+  }
+  if (!is_parallel_marking_.LoadRelaxed()) {
+    return false;
+  }
+  MutexLock mu(self, mark_stack_lock_);
+  return ContainsElement(parallel_marking_threads_, self);
+}
+
+void ConcurrentCopying::ProcessMarkStackParallelWorker(Thread* self) {
+  while (true) {
+    if (self == thread_running_gc_) {
+      // The GC-running thread pushes onto the GC mark stack without a lock.
+      while (!gc_mark_stack_->IsEmpty()) {
+        ProcessMarkStackRef(gc_mark_stack_->PopBack());
+      }
+    } else {
+      // Processing a ref may revoke a full thread-local mark stack and install a new one, so
+      // reload it every iteration.
+      accounting::ObjectStack* tl_mark_stack = self->GetThreadLocalMarkStack();
+      while (tl_mark_stack != nullptr && !tl_mark_stack->IsEmpty()) {
+        ProcessMarkStackRef(tl_mark_stack->PopBack());
+        tl_mark_stack = self->GetThreadLocalMarkStack();
+      }
+      if (tl_mark_stack != nullptr) {
+        self->SetThreadLocalMarkStack(nullptr);
+        RecycleMarkStack(self, tl_mark_stack);
+      }
+    }
+    // Steal a full mark stack revoked by another worker or a mutator.
+    accounting::ObjectStack* stolen_mark_stack = nullptr;
     {
-      MutexLock mu(Thread::Current(), mark_stack_lock_);
-      if (pooled_mark_stacks_.size() >= kMarkStackPoolSize) {
-        // The pool has enough. Delete it.
-        delete mark_stack;
-      } else {
-        // Otherwise, put it into the pool for later reuse.
-        mark_stack->Reset();
-        pooled_mark_stacks_.push_back(mark_stack);
+      MutexLock mu(self, mark_stack_lock_);
+      if (revoked_mark_stacks_.empty()) {
+        break;
       }
+      stolen_mark_stack = revoked_mark_stacks_.back();
+      revoked_mark_stacks_.pop_back();
+    }
+    while (!stolen_mark_stack->IsEmpty()) {
+      ProcessMarkStackRef(stolen_mark_stack->PopBack());
     }
+    RecycleMarkStack(self, stolen_mark_stack);
   }
-  return count;
 }
 
 inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
@@ -1446,8 +1732,15 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
   }
   bool add_to_live_bytes = false;
   if (region_space_->IsInUnevacFromSpace(to_ref)) {
-    // Mark the bitmap only in the GC thread here so that we don't need a CAS.
-    if (!kUseBakerReadBarrier || !region_space_bitmap_->Set(to_ref)) {
+    // Mark the bitmap only in the GC threads here. A CAS is only needed if GC worker threads may be
+    // processing the mark stack in parallel.
+    bool already_marked = false;
+    if (kUseBakerReadBarrier) {
+      already_marked = UNLIKELY(is_parallel_marking_.LoadRelaxed())
+          ? region_space_bitmap_->AtomicTestAndSet(to_ref)
+          : region_space_bitmap_->Set(to_ref);
+    }
+    if (!already_marked) {
       // It may be already marked if we accidentally pushed the same object twice due to the racy
       // bitmap read in MarkUnevacFromSpaceRegion.
       Scan(to_ref);
@@ -1488,7 +1781,7 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
 
   if (add_to_live_bytes) {
     // Add to the live bytes per unevacuated from space. Note this code is always run by the
-    // GC-running thread (no synchronization required).
+    // GC-running thread or a GC worker thread (AddLiveBytes() is atomic).
     DCHECK(region_space_bitmap_->Test(to_ref));
     size_t obj_size = to_ref->SizeOf<kDefaultVerifyFlags>();
     size_t alloc_size = RoundUp(obj_size, space::RegionSpace::kAlignment);
@@ -1715,8 +2008,17 @@ void ConcurrentCopying::ReclaimPhase() {
 
   {
     WriterMutexLock mu(self, *Locks::heap_bitmap_lock_);
-    Sweep(false);
-    SwapBitmaps();
+    if (young_gen_) {
+      // The non-moving spaces and the large object space are only swept by full collections.
+      // Just make the objects allocated since the last collection live.
+      TimingLogger::ScopedTiming t("MarkStackAsLive", GetTimings());
+      accounting::ObjectStack* live_stack = heap_->GetLiveStack();
+      heap_->MarkAllocStackAsLive(live_stack);
+      live_stack->Reset();
+    } else {
+      Sweep(false);
+      SwapBitmaps();
+    }
     heap_->UnBindBitmaps();
 
     // The bitmap was cleared at the start of the GC, there is nothing we need to do here.
@@ -1873,7 +2175,7 @@ void ConcurrentCopying::AssertToSpaceInvariantInNonMovingSpace(mirror::Object* o
   if (immune_spaces_.ContainsObject(ref)) {
     if (kUseBakerReadBarrier) {
       // Immune object may not be gray if called from the GC.
-      if (Thread::Current() == thread_running_gc_ && !gc_grays_immune_objects_) {
+      if (IsGcMarkingThread(Thread::Current()) && !gc_grays_immune_objects_) {
         return;
       }
       bool updated_all_immune_objects = updated_all_immune_objects_.LoadSequentiallyConsistent();
@@ -1883,6 +2185,9 @@ void ConcurrentCopying::AssertToSpaceInvariantInNonMovingSpace(mirror::Object* o
           << " ref=" << ref << " ref rb_state=" << ref->GetReadBarrierState()
           << " updated_all_immune_objects=" << updated_all_immune_objects;
     }
+  } else if (young_gen_) {
+    // The young generation collection doesn't mark the non-moving spaces, everything there is
+    // considered live.
   } else {
     accounting::ContinuousSpaceBitmap* mark_bitmap =
         heap_mark_bitmap_->GetContinuousSpaceBitmap(ref);
@@ -1948,7 +2253,7 @@ inline void ConcurrentCopying::Scan(mirror::Object* to_ref) {
     Thread::Current()->ModifyDebugDisallowReadBarrier(1);
   }
   DCHECK(!region_space_->IsInFromSpace(to_ref));
-  DCHECK_EQ(Thread::Current(), thread_running_gc_);
+  DCHECK(IsGcMarkingThread(Thread::Current()));
   RefFieldsVisitor visitor(this);
   // Disable the read barrier for a performance reason.
   to_ref->VisitReferences</*kVisitNativeRoots*/true, kDefaultVerifyFlags, kWithoutReadBarrier>(
@@ -1960,7 +2265,7 @@ inline void ConcurrentCopying::Scan(mirror::Object* to_ref) {
 
 // Process a field.
 inline void ConcurrentCopying::Process(mirror::Object* obj, MemberOffset offset) {
-  DCHECK_EQ(Thread::Current(), thread_running_gc_);
+  DCHECK(IsGcMarkingThread(Thread::Current()));
   mirror::Object* ref = obj->GetFieldObject<
       mirror::Object, kVerifyNone, kWithoutReadBarrier, false>(offset);
   mirror::Object* to_ref = Mark</*kGrayImmuneObject*/false, /*kFromGCThread*/true>(ref);
@@ -2160,6 +2465,17 @@ mirror::Object* ConcurrentCopying::AllocateInSkippedBlock(size_t alloc_size) {
   return reinterpret_cast<mirror::Object*>(addr);
 }
 
+inline mirror::Object* ConcurrentCopying::AllocateInEvacBuffer(Thread* self, size_t alloc_size) {
+  DCHECK_LE(alloc_size, kMaxEvacBufferObjectSize);
+  if (UNLIKELY(self->EvacBufferSize() < alloc_size)) {
+    RevokeThreadLocalEvacBuffer(self);
+    if (!region_space_->AllocNewEvacBuffer(self, alloc_size)) {
+      return nullptr;
+    }
+  }
+  return self->AllocEvacBuffer(alloc_size);
+}
+
 mirror::Object* ConcurrentCopying::Copy(mirror::Object* from_ref,
                                         mirror::Object* holder,
                                         MemberOffset offset) {
@@ -2179,8 +2495,17 @@ mirror::Object* ConcurrentCopying::Copy(mirror::Object* from_ref,
   size_t non_moving_space_bytes_allocated = 0U;
   size_t bytes_allocated = 0U;
   size_t dummy;
-  mirror::Object* to_ref = region_space_->AllocNonvirtual<true>(
-      region_space_alloc_size, &region_space_bytes_allocated, nullptr, &dummy);
+  mirror::Object* to_ref = nullptr;
+  if (kUseEvacBuffers && region_space_alloc_size <= kMaxEvacBufferObjectSize) {
+    to_ref = AllocateInEvacBuffer(Thread::Current(), region_space_alloc_size);
+    if (to_ref != nullptr) {
+      region_space_bytes_allocated = region_space_alloc_size;
+    }
+  }
+  if (to_ref == nullptr) {
+    to_ref = region_space_->AllocNonvirtual<true>(
+        region_space_alloc_size, &region_space_bytes_allocated, nullptr, &dummy);
+  }
   bytes_allocated = region_space_bytes_allocated;
   if (to_ref != nullptr) {
     DCHECK_EQ(region_space_alloc_size, region_space_bytes_allocated);
@@ -2346,6 +2671,9 @@ mirror::Object* ConcurrentCopying::IsMarked(mirror::Object* from_ref) {
     if (immune_spaces_.ContainsObject(from_ref)) {
       // An immune object is alive.
       to_ref = from_ref;
+    } else if (young_gen_) {
+      // The young generation collection doesn't collect the non-moving spaces.
+      to_ref = from_ref;
     } else {
       // Non-immune non-moving space. Use the mark bitmap.
       accounting::ContinuousSpaceBitmap* mark_bitmap =
@@ -2387,6 +2715,11 @@ mirror::Object* ConcurrentCopying::MarkNonMoving(mirror::Object* ref,
   // ref is in a non-moving space (from_ref == to_ref).
   DCHECK(!region_space_->HasAddress(ref)) << ref;
   DCHECK(!immune_spaces_.ContainsObject(ref));
+  if (young_gen_) {
+    // The non-moving spaces are old. Their objects that may reference young objects were grayed
+    // in GrayAllDirtyOldObjects().
+    return ref;
+  }
   // Use the mark bitmap.
   accounting::ContinuousSpaceBitmap* mark_bitmap =
       heap_mark_bitmap_->GetContinuousSpaceBitmap(ref);
@@ -2472,8 +2805,8 @@ void ConcurrentCopying::FinishPhase() {
     CHECK_EQ(pooled_mark_stacks_.size(), kMarkStackPoolSize);
   }
   // kVerifyNoMissingCardMarks relies on the region space cards not being cleared to avoid false
-  // positives.
-  if (!kVerifyNoMissingCardMarks) {
+  // positives. The generational mode clears them in the pause instead (ClearNonImmuneCards).
+  if (!kVerifyNoMissingCardMarks && !heap_->UseGenerationalConcurrentCopying()) {
     TimingLogger::ScopedTiming split("ClearRegionSpaceCards", GetTimings());
     // We do not currently use the region space cards at all, madvise them away to save ram.
     heap_->GetCardTable()->ClearCardRange(region_space_->Begin(), region_space_->Limit());
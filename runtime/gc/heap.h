@@ -190,6 +190,7 @@ class Heap {
        bool verify_post_gc_rosalloc,
        bool gc_stress_mode,
        bool measure_gc_performance,
+       bool use_generational_cc,
        bool use_homogeneous_space_compaction,
        uint64_t min_interval_homogeneous_space_compaction_by_oom);
 
@@ -718,10 +719,22 @@ class Heap {
     return zygote_space_ != nullptr;
   }
 
+  // Returns the concurrent copying collector that is running, or that ran last.
   collector::ConcurrentCopying* ConcurrentCopyingCollector() {
+    collector::ConcurrentCopying* active_collector =
+        active_concurrent_copying_collector_.LoadAcquire();
+    if (active_collector != nullptr) {
+      return active_collector;
+    }
     return concurrent_copying_collector_;
   }
 
+  // Returns true if the concurrent copying collector alternates between young generation
+  // (sticky) and full collections.
+  bool UseGenerationalConcurrentCopying() const {
+    return use_generational_cc_;
+  }
+
   CollectorType CurrentCollectorType() {
     return collector_type_;
   }
@@ -1354,8 +1367,15 @@ class Heap {
   collector::SemiSpace* semi_space_collector_;
   collector::MarkCompact* mark_compact_collector_;
   collector::ConcurrentCopying* concurrent_copying_collector_;
+  collector::ConcurrentCopying* young_concurrent_copying_collector_;
+  // The one of the two above that is running, or that ran last. Written by the GC-running thread
+  // and read by mutator read barriers, hence atomic.
+  Atomic<collector::ConcurrentCopying*> active_concurrent_copying_collector_;
 
   const bool is_running_on_memory_tool_;
+  // If true, the concurrent copying collector only collects the regions allocated since the last
+  // collection in its sticky collections. The card table tracks the old to young references.
+  const bool use_generational_cc_;
   const bool use_tlab_;
 
   // Pointer to the space which becomes the new main space when we do homogeneous space compaction.
@@ -1439,6 +1459,7 @@ class Heap {
   std::unique_ptr<Verification> verification_;
 
   friend class CollectorTransitionTask;
+  friend class GenerationalConcurrentCopyingTest;
   friend class collector::GarbageCollector;
   friend class collector::MarkCompact;
   friend class collector::ConcurrentCopying;
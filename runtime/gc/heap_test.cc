@@ -89,5 +89,57 @@ TEST_F(ZygoteHeapTest, PreZygoteFork) {
   Runtime::Current()->GetHeap()->PreZygoteFork();
 }
 
+class GenerationalConcurrentCopyingTest : public CommonRuntimeTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options) OVERRIDE {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    if (kUseBakerReadBarrier) {
+      options->push_back(std::make_pair("-Xgc:generational_cc", nullptr));
+    }
+  }
+
+  collector::GcType CollectYoungGeneration(Heap* heap) {
+    return heap->CollectGarbageInternal(collector::kGcTypeSticky,
+                                        kGcCauseExplicit,
+                                        /* clear_soft_references */ false);
+  }
+};
+
+TEST_F(GenerationalConcurrentCopyingTest, OldToYoungReferenceSurvivesYoungCollection) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  if (heap->CurrentCollectorType() != kCollectorTypeCC ||
+      !heap->UseGenerationalConcurrentCopying()) {
+    // The young generation mode requires the concurrent copying collector with the Baker read
+    // barrier.
+    return;
+  }
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  Handle<mirror::Class> c(
+      hs.NewHandle(class_linker_->FindSystemClass(soa.Self(), "[Ljava/lang/Object;")));
+  Handle<mirror::ObjectArray<mirror::Object>> old_array(
+      hs.NewHandle(mirror::ObjectArray<mirror::Object>::Alloc(soa.Self(), c.Get(), 1)));
+  ASSERT_TRUE(old_array != nullptr);
+  {
+    // A full collection moves the array out of the newly allocated regions.
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    heap->CollectGarbage(/* clear_soft_references */ false);
+  }
+  // The young string is only reachable through the old array, so the young collection has to find
+  // it through the dirty card of the array.
+  mirror::String* young = mirror::String::AllocFromModifiedUtf8(soa.Self(), "young");
+  ASSERT_TRUE(young != nullptr);
+  old_array->Set<false>(0, young);
+  young = nullptr;
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ASSERT_EQ(collector::kGcTypeSticky, CollectYoungGeneration(heap));
+  }
+  mirror::Object* survivor = old_array->Get(0);
+  ASSERT_TRUE(survivor != nullptr);
+  ASSERT_TRUE(survivor->IsString());
+  EXPECT_TRUE(survivor->AsString()->Equals("young"));
+}
+
 }  // namespace gc
 }  // namespace art
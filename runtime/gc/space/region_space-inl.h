@@ -18,6 +18,10 @@
 #define ART_RUNTIME_GC_SPACE_REGION_SPACE_INL_H_
 
 #include "region_space.h"
+
+#include <algorithm>
+
+#include "gc/accounting/card_table-inl.h"
 #include "thread-inl.h"
 
 namespace art {
@@ -271,6 +275,61 @@ void RegionSpace::WalkInternal(ObjectCallback* callback, void* arg) {
   }
 }
 
+template <typename Visitor>
+void RegionSpace::VisitObjectsOnDirtyCardsInOldRegions(accounting::CardTable* card_table,
+                                                       const Visitor& visitor) {
+  // Called in a pause, see the comment in WalkInternal about the region_lock_.
+  Locks::mutator_lock_->AssertExclusiveHeld(Thread::Current());
+  const size_t iter_limit = std::min(num_regions_, non_free_region_index_limit_);
+  for (size_t i = 0; i < iter_limit; ++i) {
+    Region* r = &regions_[i];
+    if (r->IsFree() || r->IsNewlyAllocated() || r->IsLargeTail()) {
+      continue;
+    }
+    DCHECK(r->IsInToSpace());
+    if (r->IsLarge()) {
+      mirror::Object* obj = reinterpret_cast<mirror::Object*>(r->Begin());
+      if (card_table->IsDirty(obj)) {
+        visitor(obj);
+      }
+      continue;
+    }
+    uint8_t* pos = r->Begin();
+    uint8_t* top = r->Top();
+    // Skip the region if none of its cards are dirty, which is the common case.
+    const uint8_t* card_begin = card_table->CardFromAddr(pos);
+    const uint8_t* card_end = card_table->CardFromAddr(AlignUp(top, accounting::CardTable::kCardSize));
+    if (std::find(card_begin, card_end, accounting::CardTable::kCardDirty) == card_end) {
+      continue;
+    }
+    // Same as WalkInternal, dead objects in partially live regions may have dangling references.
+    const bool need_bitmap =
+        r->LiveBytes() != static_cast<size_t>(-1) &&
+        r->LiveBytes() != static_cast<size_t>(top - pos);
+    if (need_bitmap) {
+      GetLiveBitmap()->VisitMarkedRange(
+          reinterpret_cast<uintptr_t>(pos),
+          reinterpret_cast<uintptr_t>(top),
+          [card_table, &visitor](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        if (card_table->IsDirty(obj)) {
+          visitor(obj);
+        }
+      });
+    } else {
+      while (pos < top) {
+        mirror::Object* obj = reinterpret_cast<mirror::Object*>(pos);
+        if (obj->GetClass<kDefaultVerifyFlags, kWithoutReadBarrier>() == nullptr) {
+          break;
+        }
+        if (card_table->IsDirty(obj)) {
+          visitor(obj);
+        }
+        pos = reinterpret_cast<uint8_t*>(GetNextObject(obj));
+      }
+    }
+  }
+}
+
 inline mirror::Object* RegionSpace::GetNextObject(mirror::Object* obj) {
   const uintptr_t position = reinterpret_cast<uintptr_t>(obj) + obj->SizeOf();
   return reinterpret_cast<mirror::Object*>(RoundUp(position, kAlignment));
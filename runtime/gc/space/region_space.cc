@@ -16,6 +16,7 @@
 
 #include "bump_pointer_space.h"
 #include "bump_pointer_space-inl.h"
+#include "region_space-inl.h"
 #include "mirror/object-inl.h"
 #include "mirror/class-inl.h"
 #include "thread_list.h"
@@ -158,22 +159,23 @@ inline bool RegionSpace::Region::ShouldBeEvacuated() {
   if (is_newly_allocated_) {
     result = true;
   } else {
-    bool is_live_percent_valid = live_bytes_ != static_cast<size_t>(-1);
+    const size_t live_bytes = LiveBytes();
+    bool is_live_percent_valid = live_bytes != static_cast<size_t>(-1);
     if (is_live_percent_valid) {
       DCHECK(IsInToSpace());
       DCHECK(!IsLargeTail());
-      DCHECK_NE(live_bytes_, static_cast<size_t>(-1));
-      DCHECK_LE(live_bytes_, BytesAllocated());
+      DCHECK_NE(live_bytes, static_cast<size_t>(-1));
+      DCHECK_LE(live_bytes, BytesAllocated());
       const size_t bytes_allocated = RoundUp(BytesAllocated(), kRegionSize);
-      DCHECK_LE(live_bytes_, bytes_allocated);
+      DCHECK_LE(live_bytes, bytes_allocated);
       if (IsAllocated()) {
         // Side node: live_percent == 0 does not necessarily mean
         // there's no live objects due to rounding (there may be a
         // few).
-        result = live_bytes_ * 100U < kEvaculateLivePercentThreshold * bytes_allocated;
+        result = live_bytes * 100U < kEvaculateLivePercentThreshold * bytes_allocated;
       } else {
         DCHECK(IsLarge());
-        result = live_bytes_ == 0U;
+        result = live_bytes == 0U;
       }
     } else {
       result = false;
@@ -184,7 +186,9 @@ inline bool RegionSpace::Region::ShouldBeEvacuated() {
 
 // Determine which regions to evacuate and mark them as
 // from-space. Mark the rest as unevacuated from-space.
-void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table, bool force_evacuate_all) {
+void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
+                               bool force_evacuate_all,
+                               bool young_gen) {
   ++time_;
   if (kUseTableLookupReadBarrier) {
     DCHECK(rb_table->IsAllCleared());
@@ -193,6 +197,7 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table, bool forc
   MutexLock mu(Thread::Current(), region_lock_);
   size_t num_expected_large_tails = 0;
   bool prev_large_evacuated = false;
+  bool prev_large_is_old = false;
   VerifyNonFreeRegionLimit();
   const size_t iter_limit = kUseTableLookupReadBarrier
       ? num_regions_
@@ -207,8 +212,13 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table, bool forc
         DCHECK((state == RegionState::kRegionStateAllocated ||
                 state == RegionState::kRegionStateLarge) &&
                type == RegionType::kRegionTypeToSpace);
-        bool should_evacuate = force_evacuate_all || r->ShouldBeEvacuated();
-        if (should_evacuate) {
+        // A young generation collection does not collect the old regions. Leaving them in the
+        // to-space makes the collector treat their objects as marked.
+        const bool is_old = young_gen && !r->IsNewlyAllocated();
+        const bool should_evacuate = !is_old && (force_evacuate_all || r->ShouldBeEvacuated());
+        if (is_old) {
+          DCHECK(r->IsInToSpace());
+        } else if (should_evacuate) {
           r->SetAsFromSpace();
           DCHECK(r->IsInFromSpace());
         } else {
@@ -218,13 +228,16 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table, bool forc
         if (UNLIKELY(state == RegionState::kRegionStateLarge &&
                      type == RegionType::kRegionTypeToSpace)) {
           prev_large_evacuated = should_evacuate;
+          prev_large_is_old = is_old;
           num_expected_large_tails = RoundUp(r->BytesAllocated(), kRegionSize) / kRegionSize - 1;
           DCHECK_GT(num_expected_large_tails, 0U);
         }
       } else {
         DCHECK(state == RegionState::kRegionStateLargeTail &&
                type == RegionType::kRegionTypeToSpace);
-        if (prev_large_evacuated) {
+        if (prev_large_is_old) {
+          DCHECK(r->IsInToSpace());
+        } else if (prev_large_evacuated) {
           r->SetAsFromSpace();
           DCHECK(r->IsInFromSpace());
         } else {
@@ -450,6 +463,47 @@ bool RegionSpace::AllocNewTlab(Thread* self, size_t min_bytes) {
   return false;
 }
 
+bool RegionSpace::AllocNewEvacBuffer(Thread* self, size_t min_bytes) {
+  DCHECK(!self->HasEvacBuffer());
+  DCHECK_ALIGNED(min_bytes, kAlignment);
+  DCHECK_LE(min_bytes, kEvacBufferSize);
+  size_t bytes_allocated;
+  size_t bytes_tl_bulk_allocated;
+  mirror::Object* buffer = AllocNonvirtual<true>(kEvacBufferSize,
+                                                 &bytes_allocated,
+                                                 nullptr,
+                                                 &bytes_tl_bulk_allocated);
+  if (buffer == nullptr) {
+    return false;
+  }
+  DCHECK_EQ(bytes_allocated, kEvacBufferSize);
+  uint8_t* start = reinterpret_cast<uint8_t*>(buffer);
+  self->SetEvacBuffer(start, start + kEvacBufferSize);
+  return true;
+}
+
+void RegionSpace::RevokeEvacBuffer(Thread* thread, uint8_t** unused_begin, size_t* unused_bytes) {
+  *unused_begin = nullptr;
+  *unused_bytes = 0U;
+  if (!thread->HasEvacBuffer()) {
+    return;
+  }
+  uint8_t* pos = thread->GetEvacBufferPos();
+  uint8_t* end = thread->GetEvacBufferEnd();
+  // The end may be the end of the region, that is the beginning of the next one.
+  Region* r = RefToRegionUnlocked(reinterpret_cast<mirror::Object*>(end - kAlignment));
+  DCHECK(r->Contains(reinterpret_cast<mirror::Object*>(pos)) || pos == r->End());
+  size_t num_objects = thread->GetEvacBufferObjectsAllocated();
+  if (pos != end) {
+    *unused_begin = pos;
+    *unused_bytes = end - pos;
+    // The dummy object that fills the unused end.
+    ++num_objects;
+  }
+  r->RecordEvacBufferAllocations(num_objects);
+  thread->SetEvacBuffer(nullptr, nullptr);
+}
+
 size_t RegionSpace::RevokeThreadLocalBuffers(Thread* thread) {
   MutexLock mu(Thread::Current(), region_lock_);
   RevokeThreadLocalBuffersLocked(thread);
@@ -507,7 +561,7 @@ void RegionSpace::Region::Dump(std::ostream& os) const {
      << "-" << reinterpret_cast<void*>(end_)
      << " state=" << static_cast<uint>(state_) << " type=" << static_cast<uint>(type_)
      << " objects_allocated=" << objects_allocated_
-     << " alloc_time=" << alloc_time_ << " live_bytes=" << live_bytes_
+     << " alloc_time=" << alloc_time_ << " live_bytes=" << LiveBytes()
      << " is_newly_allocated=" << is_newly_allocated_ << " is_a_tlab=" << is_a_tlab_ << " thread=" << thread_ << "\n";
 }
 
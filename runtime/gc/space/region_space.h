@@ -24,6 +24,11 @@
 
 namespace art {
 namespace gc {
+
+namespace accounting {
+class CardTable;
+}  // namespace accounting
+
 namespace space {
 
 // A space that consists of equal-sized regions.
@@ -158,6 +163,14 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
     WalkInternal<true>(callback, arg);
   }
 
+  // Visit the objects on dirty cards in the regions that were not allocated since the last
+  // collection, i.e. the old generation. Used by the young generation collection to find the
+  // old-to-young references.
+  template <typename Visitor>
+  void VisitObjectsOnDirtyCardsInOldRegions(accounting::CardTable* card_table,
+                                            const Visitor& visitor)
+      REQUIRES(Locks::mutator_lock_);
+
   accounting::ContinuousSpaceBitmap::SweepCallback* GetSweepCallback() OVERRIDE {
     return nullptr;
   }
@@ -168,6 +181,8 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
   static constexpr size_t kAlignment = kObjectAlignment;
   // The region size.
   static constexpr size_t kRegionSize = 256 * KB;
+  // The size of a thread-local evacuation buffer.
+  static constexpr size_t kEvacBufferSize = 16 * KB;
 
   bool IsInFromSpace(mirror::Object* ref) {
     if (HasAddress(ref)) {
@@ -209,7 +224,9 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
     return RegionType::kRegionTypeNone;
   }
 
-  void SetFromSpace(accounting::ReadBarrierTable* rb_table, bool force_evacuate_all)
+  // If young_gen is true, only the newly allocated regions are evacuated and the others are left
+  // in the to-space.
+  void SetFromSpace(accounting::ReadBarrierTable* rb_table, bool force_evacuate_all, bool young_gen)
       REQUIRES(!region_lock_);
 
   size_t FromSpaceSize() REQUIRES(!region_lock_);
@@ -227,6 +244,10 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
       MutexLock mu(Thread::Current(), region_lock_);
       for (size_t i = 0; i < num_regions_; ++i) {
         Region* r = &regions_[i];
+        if (r->IsInToSpace()) {
+          // Regions left in the to-space by a young generation collection keep their live bytes.
+          continue;
+        }
         size_t live_bytes = r->LiveBytes();
         CHECK(live_bytes == 0U || live_bytes == static_cast<size_t>(-1)) << live_bytes;
       }
@@ -236,6 +257,15 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
   void RecordAlloc(mirror::Object* ref) REQUIRES(!region_lock_);
   bool AllocNewTlab(Thread* self, size_t min_bytes) REQUIRES(!region_lock_);
 
+  // Reserve a thread-local evacuation buffer in the current evacuation region so that the thread
+  // can copy objects into the to-space without synchronizing with the other copying threads.
+  // The objects are counted when the buffer is revoked.
+  bool AllocNewEvacBuffer(Thread* self, size_t min_bytes) REQUIRES(!region_lock_);
+  // Record the objects copied into the evacuation buffer of thread and reset it. The unused end
+  // of the buffer is returned in unused_begin and unused_bytes, the caller must fill it with a
+  // dummy object to keep the region walkable.
+  void RevokeEvacBuffer(Thread* thread, uint8_t** unused_begin, size_t* unused_bytes);
+
   uint32_t Time() {
     return time_;
   }
@@ -264,7 +294,7 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
       type_ = RegionType::kRegionTypeNone;
       objects_allocated_.StoreRelaxed(0);
       alloc_time_ = 0;
-      live_bytes_ = static_cast<size_t>(-1);
+      live_bytes_.StoreRelaxed(static_cast<size_t>(-1));
       is_newly_allocated_ = false;
       is_a_tlab_ = false;
       thread_ = nullptr;
@@ -286,7 +316,7 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
       type_ = RegionType::kRegionTypeNone;
       objects_allocated_.StoreRelaxed(0);
       alloc_time_ = 0;
-      live_bytes_ = static_cast<size_t>(-1);
+      live_bytes_.StoreRelaxed(static_cast<size_t>(-1));
       ZeroAndReleasePages(begin_, end_ - begin_);
       is_newly_allocated_ = false;
       is_a_tlab_ = false;
@@ -389,13 +419,13 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
     void SetAsFromSpace() {
       DCHECK(!IsFree() && IsInToSpace());
       type_ = RegionType::kRegionTypeFromSpace;
-      live_bytes_ = static_cast<size_t>(-1);
+      live_bytes_.StoreRelaxed(static_cast<size_t>(-1));
     }
 
     void SetAsUnevacFromSpace() {
       DCHECK(!IsFree() && IsInToSpace());
       type_ = RegionType::kRegionTypeUnevacFromSpace;
-      live_bytes_ = 0U;
+      live_bytes_.StoreRelaxed(0U);
     }
 
     void SetUnevacFromSpaceAsToSpace() {
@@ -405,16 +435,17 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
 
     ALWAYS_INLINE bool ShouldBeEvacuated();
 
+    // May be called concurrently by the GC worker threads during parallel marking.
     void AddLiveBytes(size_t live_bytes) {
       DCHECK(IsInUnevacFromSpace());
       DCHECK(!IsLargeTail());
-      DCHECK_NE(live_bytes_, static_cast<size_t>(-1));
-      live_bytes_ += live_bytes;
-      DCHECK_LE(live_bytes_, BytesAllocated());
+      DCHECK_NE(LiveBytes(), static_cast<size_t>(-1));
+      size_t old_live_bytes = live_bytes_.FetchAndAddRelaxed(live_bytes);
+      DCHECK_LE(old_live_bytes + live_bytes, BytesAllocated());
     }
 
     size_t LiveBytes() const {
-      return live_bytes_;
+      return live_bytes_.LoadRelaxed();
     }
 
     size_t BytesAllocated() const;
@@ -465,6 +496,13 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
       DCHECK_LE(Top(), end_);
     }
 
+    // The reservation of the evacuation buffer was already counted as one object by Alloc().
+    void RecordEvacBufferAllocations(size_t num_objects) {
+      DCHECK(IsAllocated() && IsInToSpace());
+      DCHECK_GE(num_objects, 1U);
+      objects_allocated_.FetchAndAddSequentiallyConsistent(num_objects - 1);
+    }
+
    private:
     size_t idx_;                        // The region's index in the region space.
     uint8_t* begin_;                    // The begin address of the region.
@@ -474,7 +512,7 @@ class RegionSpace FINAL : public ContinuousMemMapAllocSpace {
     RegionType type_;                   // The region type (see RegionType).
     Atomic<size_t> objects_allocated_;  // The number of objects allocated.
     uint32_t alloc_time_;               // The allocation time of the region.
-    size_t live_bytes_;                 // The live bytes. Used to compute the live percent.
+    Atomic<size_t> live_bytes_;         // The live bytes. Used to compute the live percent.
     bool is_newly_allocated_;           // True if it's allocated after the last collection.
     bool is_a_tlab_;                    // True if it's a tlab.
     Thread* thread_;                    // The owning thread if it's a tlab.
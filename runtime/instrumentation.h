@@ -304,11 +304,11 @@ class Instrumentation {
         have_branch_listeners_ || have_invoke_virtual_or_interface_listeners_;
   }
 
-  // Any instrumentation *other* than what is needed for Jit profiling active?
-  bool NonJitProfilingActive() const REQUIRES_SHARED(Locks::mutator_lock_) {
-    return have_dex_pc_listeners_ || have_method_exit_listeners_ ||
-        have_field_read_listeners_ || have_field_write_listeners_ ||
-        have_exception_caught_listeners_ || have_method_unwind_listeners_ ||
+  // Any instrumentation that must observe individual instructions active? Method entry, exit and
+  // unwind events as well as exception caught events are reported around the fast interpreter,
+  // so only these listeners force execution in the C++ interpreter.
+  bool InstructionListenersActive() const REQUIRES_SHARED(Locks::mutator_lock_) {
+    return have_dex_pc_listeners_ || have_field_read_listeners_ || have_field_write_listeners_ ||
         have_branch_listeners_;
   }
 
@@ -412,6 +412,7 @@ TEST_F(InstrumentationTest, NoInstrumentation) {
   EXPECT_FALSE(instr->HasMethodEntryListeners());
   EXPECT_FALSE(instr->HasMethodExitListeners());
   EXPECT_FALSE(instr->IsActive());
+  EXPECT_FALSE(instr->InstructionListenersActive());
 }
 
 // Test instrumentation listeners for each event.
@@ -451,6 +452,42 @@ TEST_F(InstrumentationTest, InvokeVirtualOrInterfaceEvent) {
   TestEvent(instrumentation::Instrumentation::kInvokeVirtualOrInterface);
 }
 
+// Method tracing events do not need to observe individual instructions, and so must not force
+// execution out of mterp.
+TEST_F(InstrumentationTest, InstructionListenersActive) {
+  ScopedObjectAccess soa(Thread::Current());
+  instrumentation::Instrumentation* instr = Runtime::Current()->GetInstrumentation();
+  const uint32_t tracing_events = instrumentation::Instrumentation::kMethodEntered |
+      instrumentation::Instrumentation::kMethodExited |
+      instrumentation::Instrumentation::kMethodUnwind |
+      instrumentation::Instrumentation::kExceptionCaught;
+  TestInstrumentationListener listener;
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ScopedSuspendAll ssa("Add instrumentation listener");
+    instr->AddListener(&listener, tracing_events);
+  }
+  EXPECT_TRUE(instr->IsActive());
+  EXPECT_FALSE(instr->InstructionListenersActive());
+
+  TestInstrumentationListener dex_pc_listener;
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ScopedSuspendAll ssa("Add instrumentation listener");
+    instr->AddListener(&dex_pc_listener, instrumentation::Instrumentation::kDexPcMoved);
+  }
+  EXPECT_TRUE(instr->InstructionListenersActive());
+
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ScopedSuspendAll ssa("Remove instrumentation listeners");
+    instr->RemoveListener(&dex_pc_listener, instrumentation::Instrumentation::kDexPcMoved);
+    instr->RemoveListener(&listener, tracing_events);
+  }
+  EXPECT_FALSE(instr->IsActive());
+  EXPECT_FALSE(instr->InstructionListenersActive());
+}
+
 TEST_F(InstrumentationTest, DeoptimizeDirectMethod) {
   ScopedObjectAccess soa(Thread::Current());
   jobject class_loader = LoadDex("Instrumentation");
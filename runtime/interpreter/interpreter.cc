@@ -230,11 +230,35 @@ static void InterpreterJni(Thread* self,
 
 enum InterpreterImplKind {
   kSwitchImplKind,        // Switch-based interpreter implementation.
+  kComputedGotoImplKind,  // Threaded interpreter implementation, using computed gotos.
   kMterpImplKind          // Assembly interpreter
 };
 
 static constexpr InterpreterImplKind kInterpreterImplKind = kMterpImplKind;
 
+// The C++ interpreter used where Mterp is not: with access checks, in transactions, before
+// the runtime is started, and when debugging, instrumenting or tracing.
+static constexpr InterpreterImplKind kFallbackInterpreterImplKind = kComputedGotoImplKind;
+
+template<bool do_access_check, bool transaction_active>
+static inline JValue ExecuteCppImpl(Thread* self,
+                                    const DexFile::CodeItem* code_item,
+                                    ShadowFrame& shadow_frame,
+                                    JValue result_register)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  constexpr InterpreterImplKind kind = (kInterpreterImplKind == kMterpImplKind)
+      ? kFallbackInterpreterImplKind
+      : kInterpreterImplKind;
+  if (kind == kComputedGotoImplKind) {
+    return ExecuteGotoImpl<do_access_check, transaction_active>(self, code_item, shadow_frame,
+                                                                result_register, false);
+  } else {
+    DCHECK_EQ(kind, kSwitchImplKind);
+    return ExecuteSwitchImpl<do_access_check, transaction_active>(self, code_item, shadow_frame,
+                                                                  result_register, false);
+  }
+}
+
 static inline JValue Execute(
     Thread* self,
     const DexFile::CodeItem* code_item,
@@ -286,21 +310,30 @@ static inline JValue Execute(
     // Enter the "without access check" interpreter.
     if (kInterpreterImplKind == kMterpImplKind) {
       if (transaction_active) {
-        // No Mterp variant - just use the switch interpreter.
-        return ExecuteSwitchImpl<false, true>(self, code_item, shadow_frame, result_register,
-                                              false);
+        // No Mterp variant - just use the C++ interpreter.
+        return ExecuteCppImpl<false, true>(self, code_item, shadow_frame, result_register);
       } else if (UNLIKELY(!Runtime::Current()->IsStarted())) {
-        return ExecuteSwitchImpl<false, false>(self, code_item, shadow_frame, result_register,
-                                               false);
+        return ExecuteCppImpl<false, false>(self, code_item, shadow_frame, result_register);
       } else {
         while (true) {
           // Mterp does not support all instrumentation/debugging.
           if (MterpShouldSwitchInterpreters() != 0) {
-            return ExecuteSwitchImpl<false, false>(self, code_item, shadow_frame, result_register,
-                                                   false);
+            return ExecuteCppImpl<false, false>(self, code_item, shadow_frame, result_register);
           }
           bool returned = ExecuteMterpImpl(self, code_item, &shadow_frame, &result_register);
           if (returned) {
+            // Mterp does not report method exits itself. Unwinds through a pending exception
+            // have already been reported when looking for a catch block.
+            instrumentation::Instrumentation* instrumentation =
+                Runtime::Current()->GetInstrumentation();
+            if (UNLIKELY(instrumentation->HasMethodExitListeners()) &&
+                !self->IsExceptionPending()) {
+              instrumentation->MethodExitEvent(self,
+                                               shadow_frame.GetThisObject(code_item->ins_size_),
+                                               method,
+                                               shadow_frame.GetDexPC(),
+                                               result_register);
+            }
             return result_register;
           } else {
             // Mterp didn't like that instruction.  Single-step it with the reference interpreter.
@@ -314,35 +347,19 @@ static inline JValue Execute(
         }
       }
     } else {
-      DCHECK_EQ(kInterpreterImplKind, kSwitchImplKind);
       if (transaction_active) {
-        return ExecuteSwitchImpl<false, true>(self, code_item, shadow_frame, result_register,
-                                              false);
+        return ExecuteCppImpl<false, true>(self, code_item, shadow_frame, result_register);
       } else {
-        return ExecuteSwitchImpl<false, false>(self, code_item, shadow_frame, result_register,
-                                               false);
+        return ExecuteCppImpl<false, false>(self, code_item, shadow_frame, result_register);
       }
     }
   } else {
-    // Enter the "with access check" interpreter.
-    if (kInterpreterImplKind == kMterpImplKind) {
-      // No access check variants for Mterp.  Just use the switch version.
-      if (transaction_active) {
-        return ExecuteSwitchImpl<true, true>(self, code_item, shadow_frame, result_register,
-                                             false);
-      } else {
-        return ExecuteSwitchImpl<true, false>(self, code_item, shadow_frame, result_register,
-                                              false);
-      }
+    // Enter the "with access check" interpreter.  There are no access check variants for
+    // Mterp, so this always uses the C++ interpreter.
+    if (transaction_active) {
+      return ExecuteCppImpl<true, true>(self, code_item, shadow_frame, result_register);
     } else {
-      DCHECK_EQ(kInterpreterImplKind, kSwitchImplKind);
-      if (transaction_active) {
-        return ExecuteSwitchImpl<true, true>(self, code_item, shadow_frame, result_register,
-                                             false);
-      } else {
-        return ExecuteSwitchImpl<true, false>(self, code_item, shadow_frame, result_register,
-                                              false);
-      }
+      return ExecuteCppImpl<true, false>(self, code_item, shadow_frame, result_register);
     }
   }
 }
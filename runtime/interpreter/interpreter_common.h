@@ -150,6 +150,8 @@ static inline bool DoFastInvoke(Thread* self,
     if (jit != nullptr) {
       if (type == kVirtual) {
         jit->InvokeVirtualOrInterface(receiver, sf_method, shadow_frame.GetDexPC(), called_method);
+      } else {
+        jit->InvokeStaticOrDirect(sf_method, shadow_frame.GetDexPC());
       }
       jit->AddSamples(self, sf_method, 1, /*with_backedges*/false);
     }
@@ -185,6 +187,8 @@ static inline bool DoInvoke(Thread* self,
     if (jit != nullptr) {
       if (type == kVirtual || type == kInterface) {
         jit->InvokeVirtualOrInterface(receiver, sf_method, shadow_frame.GetDexPC(), called_method);
+      } else {
+        jit->InvokeStaticOrDirect(sf_method, shadow_frame.GetDexPC());
       }
       jit->AddSamples(self, sf_method, 1, /*with_backedges*/false);
     }
@@ -102,10 +102,37 @@ namespace interpreter {
     }                                                                                          \
   } while (false)
 
-template<bool do_access_check, bool transaction_active>
-JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
-                         ShadowFrame& shadow_frame, JValue result_register,
-                         bool interpret_one_instruction) {
+// Fetch the instruction at `inst` and record its dex pc.
+#define FETCH_INSTRUCTION()                                                                    \
+  do {                                                                                         \
+    dex_pc = inst->GetDexPc(insns);                                                            \
+    shadow_frame.SetDexPC(dex_pc);                                                             \
+    TraceExecution(shadow_frame, inst, dex_pc);                                                \
+    inst_data = inst->Fetch16(0);                                                              \
+  } while (false)
+
+// Start of the handler of `opcode`: a case of the switch, and the target of the handler
+// table of the computed goto interpreter.
+#define HANDLE_INSTRUCTION(opcode) case Instruction::opcode: op_##opcode:  // NOLINT
+
+// End of an instruction handler, with `inst` pointing to the next instruction. The switch
+// interpreter leaves the switch for the next iteration of the loop. The computed goto
+// interpreter jumps straight to the handler of the next instruction, giving each handler
+// its own indirect branch, which is easier to predict than the single one of the switch.
+#define NEXT_INSTRUCTION()                                                                     \
+  if (threaded && !interpret_one_instruction) {                                                \
+    FETCH_INSTRUCTION();                                                                       \
+    goto *handlers[inst->Opcode(inst_data)];                                                   \
+  }                                                                                            \
+  break
+
+// Never inlined: the handler table holds the addresses of its labels, which must be those of
+// the copy that uses the table.
+template<bool do_access_check, bool transaction_active, bool threaded>
+NO_INLINE static JValue ExecuteImpl(Thread* self, const DexFile::CodeItem* code_item,
+                                    ShadowFrame& shadow_frame, JValue result_register,
+                                    bool interpret_one_instruction)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
   constexpr bool do_assignability_check = do_access_check;
   if (UNLIKELY(!shadow_frame.HasReferenceArray())) {
     LOG(FATAL) << "Invalid shadow frame for interpreter use";
@@ -121,95 +148,107 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
   ArtMethod* method = shadow_frame.GetMethod();
   jit::Jit* jit = Runtime::Current()->GetJit();
 
+  // Instruction handlers of the computed goto interpreter, indexed by opcode. The table is only
+  // emitted for the threaded copy: in the switch interpreter the branch is constant folded away,
+  // so its labels are not address-taken and do not get in the way of optimizing the switch.
+  const void* const* handlers = nullptr;
+  if (threaded) {
+    static const void* const kHandlers[kNumPackedOpcodes] = {
+#define INSTRUCTION_HANDLER(o, code, n, f, i, a, v) &&op_##code,
+#include "dex_instruction_list.h"
+      DEX_INSTRUCTION_LIST(INSTRUCTION_HANDLER)
+#undef DEX_INSTRUCTION_LIST
+#undef INSTRUCTION_HANDLER
+    };
+    handlers = kHandlers;
+  }
+
   do {
-    dex_pc = inst->GetDexPc(insns);
-    shadow_frame.SetDexPC(dex_pc);
-    TraceExecution(shadow_frame, inst, dex_pc);
-    inst_data = inst->Fetch16(0);
+    FETCH_INSTRUCTION();
     switch (inst->Opcode(inst_data)) {
-      case Instruction::NOP:
+      HANDLE_INSTRUCTION(NOP)
         PREAMBLE();
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE_FROM16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_FROM16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MOVE_16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_32x(),
                              shadow_frame.GetVReg(inst->VRegB_32x()));
         inst = inst->Next_3xx();
-        break;
-      case Instruction::MOVE_WIDE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_WIDE)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_12x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE_WIDE_FROM16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_WIDE_FROM16)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_22x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_22x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MOVE_WIDE_16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_WIDE_16)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_32x(),
                                  shadow_frame.GetVRegLong(inst->VRegB_32x()));
         inst = inst->Next_3xx();
-        break;
-      case Instruction::MOVE_OBJECT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_OBJECT)
         PREAMBLE();
         shadow_frame.SetVRegReference(inst->VRegA_12x(inst_data),
                                       shadow_frame.GetVRegReference(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE_OBJECT_FROM16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_OBJECT_FROM16)
         PREAMBLE();
         shadow_frame.SetVRegReference(inst->VRegA_22x(inst_data),
                                       shadow_frame.GetVRegReference(inst->VRegB_22x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MOVE_OBJECT_16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_OBJECT_16)
         PREAMBLE();
         shadow_frame.SetVRegReference(inst->VRegA_32x(),
                                       shadow_frame.GetVRegReference(inst->VRegB_32x()));
         inst = inst->Next_3xx();
-        break;
-      case Instruction::MOVE_RESULT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_RESULT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_11x(inst_data), result_register.GetI());
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE_RESULT_WIDE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_RESULT_WIDE)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_11x(inst_data), result_register.GetJ());
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE_RESULT_OBJECT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_RESULT_OBJECT)
         PREAMBLE();
         shadow_frame.SetVRegReference(inst->VRegA_11x(inst_data), result_register.GetL());
         inst = inst->Next_1xx();
-        break;
-      case Instruction::MOVE_EXCEPTION: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MOVE_EXCEPTION) {
         PREAMBLE();
         ObjPtr<mirror::Throwable> exception = self->GetException();
         DCHECK(exception != nullptr) << "No pending exception on MOVE_EXCEPTION instruction";
         shadow_frame.SetVRegReference(inst->VRegA_11x(inst_data), exception.Ptr());
         self->ClearException();
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::RETURN_VOID_NO_BARRIER: {
+      HANDLE_INSTRUCTION(RETURN_VOID_NO_BARRIER) {
         PREAMBLE();
         JValue result;
         self->AllowThreadSuspension();
@@ -225,7 +264,7 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         return result;
       }
-      case Instruction::RETURN_VOID: {
+      HANDLE_INSTRUCTION(RETURN_VOID) {
         PREAMBLE();
         QuasiAtomic::ThreadFenceForConstructor();
         JValue result;
@@ -242,7 +281,7 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         return result;
       }
-      case Instruction::RETURN: {
+      HANDLE_INSTRUCTION(RETURN) {
         PREAMBLE();
         JValue result;
         result.SetJ(0);
@@ -260,7 +299,7 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         return result;
       }
-      case Instruction::RETURN_WIDE: {
+      HANDLE_INSTRUCTION(RETURN_WIDE) {
         PREAMBLE();
         JValue result;
         result.SetJ(shadow_frame.GetVRegLong(inst->VRegA_11x(inst_data)));
@@ -277,7 +316,7 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         return result;
       }
-      case Instruction::RETURN_OBJECT: {
+      HANDLE_INSTRUCTION(RETURN_OBJECT) {
         PREAMBLE();
         JValue result;
         self->AllowThreadSuspension();
@@ -314,7 +353,7 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         return result;
       }
-      case Instruction::CONST_4: {
+      HANDLE_INSTRUCTION(CONST_4) {
         PREAMBLE();
         uint4_t dst = inst->VRegA_11n(inst_data);
         int4_t val = inst->VRegB_11n(inst_data);
@@ -323,9 +362,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(dst, nullptr);
         }
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CONST_16: {
+      HANDLE_INSTRUCTION(CONST_16) {
         PREAMBLE();
         uint8_t dst = inst->VRegA_21s(inst_data);
         int16_t val = inst->VRegB_21s();
@@ -334,9 +373,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(dst, nullptr);
         }
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CONST: {
+      HANDLE_INSTRUCTION(CONST) {
         PREAMBLE();
         uint8_t dst = inst->VRegA_31i(inst_data);
         int32_t val = inst->VRegB_31i();
@@ -345,9 +384,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(dst, nullptr);
         }
         inst = inst->Next_3xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CONST_HIGH16: {
+      HANDLE_INSTRUCTION(CONST_HIGH16) {
         PREAMBLE();
         uint8_t dst = inst->VRegA_21h(inst_data);
         int32_t val = static_cast<int32_t>(inst->VRegB_21h() << 16);
@@ -356,30 +395,30 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(dst, nullptr);
         }
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CONST_WIDE_16:
+      HANDLE_INSTRUCTION(CONST_WIDE_16)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_21s(inst_data), inst->VRegB_21s());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::CONST_WIDE_32:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(CONST_WIDE_32)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_31i(inst_data), inst->VRegB_31i());
         inst = inst->Next_3xx();
-        break;
-      case Instruction::CONST_WIDE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(CONST_WIDE)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_51l(inst_data), inst->VRegB_51l());
         inst = inst->Next_51l();
-        break;
-      case Instruction::CONST_WIDE_HIGH16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(CONST_WIDE_HIGH16)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_21h(inst_data),
                                  static_cast<uint64_t>(inst->VRegB_21h()) << 48);
         inst = inst->Next_2xx();
-        break;
-      case Instruction::CONST_STRING: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(CONST_STRING) {
         PREAMBLE();
         ObjPtr<mirror::String> s = ResolveString(self,
                                                  shadow_frame,
@@ -390,9 +429,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(inst->VRegA_21c(inst_data), s.Ptr());
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CONST_STRING_JUMBO: {
+      HANDLE_INSTRUCTION(CONST_STRING_JUMBO) {
         PREAMBLE();
         ObjPtr<mirror::String> s = ResolveString(self,
                                                  shadow_frame,
@@ -403,9 +442,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(inst->VRegA_31c(inst_data), s.Ptr());
           inst = inst->Next_3xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CONST_CLASS: {
+      HANDLE_INSTRUCTION(CONST_CLASS) {
         PREAMBLE();
         ObjPtr<mirror::Class> c = ResolveVerifyAndClinit(dex::TypeIndex(inst->VRegB_21c()),
                                                          shadow_frame.GetMethod(),
@@ -418,9 +457,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(inst->VRegA_21c(inst_data), c.Ptr());
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::MONITOR_ENTER: {
+      HANDLE_INSTRUCTION(MONITOR_ENTER) {
         PREAMBLE();
         ObjPtr<mirror::Object> obj = shadow_frame.GetVRegReference(inst->VRegA_11x(inst_data));
         if (UNLIKELY(obj == nullptr)) {
@@ -430,9 +469,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           DoMonitorEnter<do_assignability_check>(self, &shadow_frame, obj);
           POSSIBLY_HANDLE_PENDING_EXCEPTION(self->IsExceptionPending(), Next_1xx);
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::MONITOR_EXIT: {
+      HANDLE_INSTRUCTION(MONITOR_EXIT) {
         PREAMBLE();
         ObjPtr<mirror::Object> obj = shadow_frame.GetVRegReference(inst->VRegA_11x(inst_data));
         if (UNLIKELY(obj == nullptr)) {
@@ -442,9 +481,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           DoMonitorExit<do_assignability_check>(self, &shadow_frame, obj);
           POSSIBLY_HANDLE_PENDING_EXCEPTION(self->IsExceptionPending(), Next_1xx);
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CHECK_CAST: {
+      HANDLE_INSTRUCTION(CHECK_CAST) {
         PREAMBLE();
         ObjPtr<mirror::Class> c = ResolveVerifyAndClinit(dex::TypeIndex(inst->VRegB_21c()),
                                                          shadow_frame.GetMethod(),
@@ -462,9 +501,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
             inst = inst->Next_2xx();
           }
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INSTANCE_OF: {
+      HANDLE_INSTRUCTION(INSTANCE_OF) {
         PREAMBLE();
         ObjPtr<mirror::Class> c = ResolveVerifyAndClinit(dex::TypeIndex(inst->VRegC_22c()),
                                                          shadow_frame.GetMethod(),
@@ -479,9 +518,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
                                (obj != nullptr && obj->InstanceOf(c)) ? 1 : 0);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::ARRAY_LENGTH:  {
+      HANDLE_INSTRUCTION(ARRAY_LENGTH) {
         PREAMBLE();
         ObjPtr<mirror::Object> array = shadow_frame.GetVRegReference(inst->VRegB_12x(inst_data));
         if (UNLIKELY(array == nullptr)) {
@@ -491,9 +530,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVReg(inst->VRegA_12x(inst_data), array->AsArray()->GetLength());
           inst = inst->Next_1xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::NEW_INSTANCE: {
+      HANDLE_INSTRUCTION(NEW_INSTANCE) {
         PREAMBLE();
         ObjPtr<mirror::Object> obj = nullptr;
         ObjPtr<mirror::Class> c = ResolveVerifyAndClinit(dex::TypeIndex(inst->VRegB_21c()),
@@ -522,14 +561,14 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
             AbortTransactionF(self, "Allocating finalizable object in transaction: %s",
                               obj->PrettyTypeOf().c_str());
             HANDLE_PENDING_EXCEPTION();
-            break;
+            NEXT_INSTRUCTION();
           }
           shadow_frame.SetVRegReference(inst->VRegA_21c(inst_data), obj.Ptr());
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::NEW_ARRAY: {
+      HANDLE_INSTRUCTION(NEW_ARRAY) {
         PREAMBLE();
         int32_t length = shadow_frame.GetVReg(inst->VRegB_22c(inst_data));
         ObjPtr<mirror::Object> obj = AllocArrayFromCode<do_access_check, true>(
@@ -544,25 +583,25 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           shadow_frame.SetVRegReference(inst->VRegA_22c(inst_data), obj.Ptr());
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::FILLED_NEW_ARRAY: {
+      HANDLE_INSTRUCTION(FILLED_NEW_ARRAY) {
         PREAMBLE();
         bool success =
             DoFilledNewArray<false, do_access_check, transaction_active>(inst, shadow_frame, self,
                                                                          &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::FILLED_NEW_ARRAY_RANGE: {
+      HANDLE_INSTRUCTION(FILLED_NEW_ARRAY_RANGE) {
         PREAMBLE();
         bool success =
             DoFilledNewArray<true, do_access_check, transaction_active>(inst, shadow_frame,
                                                                         self, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::FILL_ARRAY_DATA: {
+      HANDLE_INSTRUCTION(FILL_ARRAY_DATA) {
         PREAMBLE();
         const uint16_t* payload_addr = reinterpret_cast<const uint16_t*>(inst) + inst->VRegB_31t();
         const Instruction::ArrayDataPayload* payload =
@@ -571,15 +610,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         bool success = FillArrayData(obj, payload);
         if (!success) {
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         if (transaction_active) {
           RecordArrayElementsInTransaction(obj->AsArray(), payload->element_count);
         }
         inst = inst->Next_3xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::THROW: {
+      HANDLE_INSTRUCTION(THROW) {
         PREAMBLE();
         ObjPtr<mirror::Object> exception =
             shadow_frame.GetVRegReference(inst->VRegA_11x(inst_data));
@@ -595,53 +634,53 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           self->SetException(exception->AsThrowable());
         }
         HANDLE_PENDING_EXCEPTION();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::GOTO: {
+      HANDLE_INSTRUCTION(GOTO) {
         PREAMBLE();
         int8_t offset = inst->VRegA_10t(inst_data);
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::GOTO_16: {
+      HANDLE_INSTRUCTION(GOTO_16) {
         PREAMBLE();
         int16_t offset = inst->VRegA_20t();
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::GOTO_32: {
+      HANDLE_INSTRUCTION(GOTO_32) {
         PREAMBLE();
         int32_t offset = inst->VRegA_30t();
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::PACKED_SWITCH: {
+      HANDLE_INSTRUCTION(PACKED_SWITCH) {
         PREAMBLE();
         int32_t offset = DoPackedSwitch(inst, shadow_frame, inst_data);
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPARSE_SWITCH: {
+      HANDLE_INSTRUCTION(SPARSE_SWITCH) {
         PREAMBLE();
         int32_t offset = DoSparseSwitch(inst, shadow_frame, inst_data);
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
-        break;
+        NEXT_INSTRUCTION();
       }
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wfloat-equal"
 
-      case Instruction::CMPL_FLOAT: {
+      HANDLE_INSTRUCTION(CMPL_FLOAT) {
         PREAMBLE();
         float val1 = shadow_frame.GetVRegFloat(inst->VRegB_23x());
         float val2 = shadow_frame.GetVRegFloat(inst->VRegC_23x());
@@ -655,9 +694,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data), result);
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CMPG_FLOAT: {
+      HANDLE_INSTRUCTION(CMPG_FLOAT) {
         PREAMBLE();
         float val1 = shadow_frame.GetVRegFloat(inst->VRegB_23x());
         float val2 = shadow_frame.GetVRegFloat(inst->VRegC_23x());
@@ -671,9 +710,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data), result);
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::CMPL_DOUBLE: {
+      HANDLE_INSTRUCTION(CMPL_DOUBLE) {
         PREAMBLE();
         double val1 = shadow_frame.GetVRegDouble(inst->VRegB_23x());
         double val2 = shadow_frame.GetVRegDouble(inst->VRegC_23x());
@@ -687,10 +726,10 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data), result);
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
 
-      case Instruction::CMPG_DOUBLE: {
+      HANDLE_INSTRUCTION(CMPG_DOUBLE) {
         PREAMBLE();
         double val1 = shadow_frame.GetVRegDouble(inst->VRegB_23x());
         double val2 = shadow_frame.GetVRegDouble(inst->VRegC_23x());
@@ -704,12 +743,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data), result);
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
 
 #pragma clang diagnostic pop
 
-      case Instruction::CMP_LONG: {
+      HANDLE_INSTRUCTION(CMP_LONG) {
         PREAMBLE();
         int64_t val1 = shadow_frame.GetVRegLong(inst->VRegB_23x());
         int64_t val2 = shadow_frame.GetVRegLong(inst->VRegC_23x());
@@ -723,9 +762,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         }
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data), result);
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_EQ: {
+      HANDLE_INSTRUCTION(IF_EQ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) ==
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
@@ -737,9 +776,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_NE: {
+      HANDLE_INSTRUCTION(IF_NE) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) !=
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
@@ -751,9 +790,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_LT: {
+      HANDLE_INSTRUCTION(IF_LT) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) <
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
@@ -765,9 +804,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_GE: {
+      HANDLE_INSTRUCTION(IF_GE) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) >=
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
@@ -779,9 +818,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_GT: {
+      HANDLE_INSTRUCTION(IF_GT) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) >
         shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
@@ -793,9 +832,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_LE: {
+      HANDLE_INSTRUCTION(IF_LE) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) <=
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
@@ -807,9 +846,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_EQZ: {
+      HANDLE_INSTRUCTION(IF_EQZ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) == 0) {
           int16_t offset = inst->VRegB_21t();
@@ -820,9 +859,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_NEZ: {
+      HANDLE_INSTRUCTION(IF_NEZ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) != 0) {
           int16_t offset = inst->VRegB_21t();
@@ -833,9 +872,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_LTZ: {
+      HANDLE_INSTRUCTION(IF_LTZ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) < 0) {
           int16_t offset = inst->VRegB_21t();
@@ -846,9 +885,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_GEZ: {
+      HANDLE_INSTRUCTION(IF_GEZ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) >= 0) {
           int16_t offset = inst->VRegB_21t();
@@ -859,9 +898,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_GTZ: {
+      HANDLE_INSTRUCTION(IF_GTZ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) > 0) {
           int16_t offset = inst->VRegB_21t();
@@ -872,9 +911,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IF_LEZ:  {
+      HANDLE_INSTRUCTION(IF_LEZ) {
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) <= 0) {
           int16_t offset = inst->VRegB_21t();
@@ -885,15 +924,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET_BOOLEAN: {
+      HANDLE_INSTRUCTION(AGET_BOOLEAN) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         ObjPtr<mirror::BooleanArray> array = a->AsBooleanArray();
@@ -903,15 +942,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET_BYTE: {
+      HANDLE_INSTRUCTION(AGET_BYTE) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         ObjPtr<mirror::ByteArray> array = a->AsByteArray();
@@ -921,15 +960,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET_CHAR: {
+      HANDLE_INSTRUCTION(AGET_CHAR) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         ObjPtr<mirror::CharArray> array = a->AsCharArray();
@@ -939,15 +978,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET_SHORT: {
+      HANDLE_INSTRUCTION(AGET_SHORT) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         ObjPtr<mirror::ShortArray> array = a->AsShortArray();
@@ -957,15 +996,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET: {
+      HANDLE_INSTRUCTION(AGET) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         DCHECK(a->IsIntArray() || a->IsFloatArray()) << a->PrettyTypeOf();
@@ -976,15 +1015,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET_WIDE:  {
+      HANDLE_INSTRUCTION(AGET_WIDE) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         DCHECK(a->IsLongArray() || a->IsDoubleArray()) << a->PrettyTypeOf();
@@ -995,15 +1034,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AGET_OBJECT: {
+      HANDLE_INSTRUCTION(AGET_OBJECT) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         ObjPtr<mirror::ObjectArray<mirror::Object>> array = a->AsObjectArray<mirror::Object>();
@@ -1013,15 +1052,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT_BOOLEAN: {
+      HANDLE_INSTRUCTION(APUT_BOOLEAN) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         uint8_t val = shadow_frame.GetVReg(inst->VRegA_23x(inst_data));
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
@@ -1032,15 +1071,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT_BYTE: {
+      HANDLE_INSTRUCTION(APUT_BYTE) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int8_t val = shadow_frame.GetVReg(inst->VRegA_23x(inst_data));
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
@@ -1051,15 +1090,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT_CHAR: {
+      HANDLE_INSTRUCTION(APUT_CHAR) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         uint16_t val = shadow_frame.GetVReg(inst->VRegA_23x(inst_data));
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
@@ -1070,15 +1109,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT_SHORT: {
+      HANDLE_INSTRUCTION(APUT_SHORT) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int16_t val = shadow_frame.GetVReg(inst->VRegA_23x(inst_data));
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
@@ -1089,15 +1128,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT: {
+      HANDLE_INSTRUCTION(APUT) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t val = shadow_frame.GetVReg(inst->VRegA_23x(inst_data));
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
@@ -1109,15 +1148,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT_WIDE: {
+      HANDLE_INSTRUCTION(APUT_WIDE) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int64_t val = shadow_frame.GetVRegLong(inst->VRegA_23x(inst_data));
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
@@ -1129,15 +1168,15 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::APUT_OBJECT: {
+      HANDLE_INSTRUCTION(APUT_OBJECT) {
         PREAMBLE();
         ObjPtr<mirror::Object> a = shadow_frame.GetVRegReference(inst->VRegB_23x());
         if (UNLIKELY(a == nullptr)) {
           ThrowNullPointerExceptionFromInterpreter();
           HANDLE_PENDING_EXCEPTION();
-          break;
+          NEXT_INSTRUCTION();
         }
         int32_t index = shadow_frame.GetVReg(inst->VRegC_23x());
         ObjPtr<mirror::Object> val = shadow_frame.GetVRegReference(inst->VRegA_23x(inst_data));
@@ -1148,1192 +1187,1207 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         } else {
           HANDLE_PENDING_EXCEPTION();
         }
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_BOOLEAN: {
+      HANDLE_INSTRUCTION(IGET_BOOLEAN) {
         PREAMBLE();
         bool success = DoFieldGet<InstancePrimitiveRead, Primitive::kPrimBoolean, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_BYTE: {
+      HANDLE_INSTRUCTION(IGET_BYTE) {
         PREAMBLE();
         bool success = DoFieldGet<InstancePrimitiveRead, Primitive::kPrimByte, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_CHAR: {
+      HANDLE_INSTRUCTION(IGET_CHAR) {
         PREAMBLE();
         bool success = DoFieldGet<InstancePrimitiveRead, Primitive::kPrimChar, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_SHORT: {
+      HANDLE_INSTRUCTION(IGET_SHORT) {
         PREAMBLE();
         bool success = DoFieldGet<InstancePrimitiveRead, Primitive::kPrimShort, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET: {
+      HANDLE_INSTRUCTION(IGET) {
         PREAMBLE();
         bool success = DoFieldGet<InstancePrimitiveRead, Primitive::kPrimInt, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_WIDE: {
+      HANDLE_INSTRUCTION(IGET_WIDE) {
         PREAMBLE();
         bool success = DoFieldGet<InstancePrimitiveRead, Primitive::kPrimLong, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_OBJECT: {
+      HANDLE_INSTRUCTION(IGET_OBJECT) {
         PREAMBLE();
         bool success = DoFieldGet<InstanceObjectRead, Primitive::kPrimNot, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_QUICK: {
+      // The C++ interpreter executes the fused superinstructions as their first instruction,
+      // leaving the second one to be dispatched on its own, so that instrumentation still
+      // sees every dex pc.
+      HANDLE_INSTRUCTION(IGET_QUICK)
+      HANDLE_INSTRUCTION(IGET_QUICK_IF_EQZ)
+      HANDLE_INSTRUCTION(IGET_QUICK_IF_NEZ) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimInt>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_WIDE_QUICK: {
+      HANDLE_INSTRUCTION(IGET_WIDE_QUICK) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimLong>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_OBJECT_QUICK: {
+      HANDLE_INSTRUCTION(IGET_OBJECT_QUICK) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimNot>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_BOOLEAN_QUICK: {
+      HANDLE_INSTRUCTION(IGET_BOOLEAN_QUICK)
+      HANDLE_INSTRUCTION(IGET_BOOLEAN_QUICK_IF_EQZ)
+      HANDLE_INSTRUCTION(IGET_BOOLEAN_QUICK_IF_NEZ) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimBoolean>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_BYTE_QUICK: {
+      HANDLE_INSTRUCTION(IGET_BYTE_QUICK) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimByte>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_CHAR_QUICK: {
+      HANDLE_INSTRUCTION(IGET_CHAR_QUICK) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimChar>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IGET_SHORT_QUICK: {
+      HANDLE_INSTRUCTION(IGET_SHORT_QUICK) {
         PREAMBLE();
         bool success = DoIGetQuick<Primitive::kPrimShort>(shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET_BOOLEAN: {
+      HANDLE_INSTRUCTION(SGET_BOOLEAN) {
         PREAMBLE();
         bool success = DoFieldGet<StaticPrimitiveRead, Primitive::kPrimBoolean, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET_BYTE: {
+      HANDLE_INSTRUCTION(SGET_BYTE) {
         PREAMBLE();
         bool success = DoFieldGet<StaticPrimitiveRead, Primitive::kPrimByte, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET_CHAR: {
+      HANDLE_INSTRUCTION(SGET_CHAR) {
         PREAMBLE();
         bool success = DoFieldGet<StaticPrimitiveRead, Primitive::kPrimChar, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET_SHORT: {
+      HANDLE_INSTRUCTION(SGET_SHORT) {
         PREAMBLE();
         bool success = DoFieldGet<StaticPrimitiveRead, Primitive::kPrimShort, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET: {
+      HANDLE_INSTRUCTION(SGET) {
         PREAMBLE();
         bool success = DoFieldGet<StaticPrimitiveRead, Primitive::kPrimInt, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET_WIDE: {
+      HANDLE_INSTRUCTION(SGET_WIDE) {
         PREAMBLE();
         bool success = DoFieldGet<StaticPrimitiveRead, Primitive::kPrimLong, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SGET_OBJECT: {
+      HANDLE_INSTRUCTION(SGET_OBJECT) {
         PREAMBLE();
         bool success = DoFieldGet<StaticObjectRead, Primitive::kPrimNot, do_access_check>(
             self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_BOOLEAN: {
+      HANDLE_INSTRUCTION(IPUT_BOOLEAN) {
         PREAMBLE();
         bool success = DoFieldPut<InstancePrimitiveWrite, Primitive::kPrimBoolean, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_BYTE: {
+      HANDLE_INSTRUCTION(IPUT_BYTE) {
         PREAMBLE();
         bool success = DoFieldPut<InstancePrimitiveWrite, Primitive::kPrimByte, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_CHAR: {
+      HANDLE_INSTRUCTION(IPUT_CHAR) {
         PREAMBLE();
         bool success = DoFieldPut<InstancePrimitiveWrite, Primitive::kPrimChar, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_SHORT: {
+      HANDLE_INSTRUCTION(IPUT_SHORT) {
         PREAMBLE();
         bool success = DoFieldPut<InstancePrimitiveWrite, Primitive::kPrimShort, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT: {
+      HANDLE_INSTRUCTION(IPUT) {
         PREAMBLE();
         bool success = DoFieldPut<InstancePrimitiveWrite, Primitive::kPrimInt, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_WIDE: {
+      HANDLE_INSTRUCTION(IPUT_WIDE) {
         PREAMBLE();
         bool success = DoFieldPut<InstancePrimitiveWrite, Primitive::kPrimLong, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_OBJECT: {
+      HANDLE_INSTRUCTION(IPUT_OBJECT) {
         PREAMBLE();
         bool success = DoFieldPut<InstanceObjectWrite, Primitive::kPrimNot, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimInt, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_BOOLEAN_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_BOOLEAN_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimBoolean, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_BYTE_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_BYTE_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimByte, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_CHAR_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_CHAR_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimChar, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_SHORT_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_SHORT_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimShort, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_WIDE_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_WIDE_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimLong, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::IPUT_OBJECT_QUICK: {
+      HANDLE_INSTRUCTION(IPUT_OBJECT_QUICK) {
         PREAMBLE();
         bool success = DoIPutQuick<Primitive::kPrimNot, transaction_active>(
             shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT_BOOLEAN: {
+      HANDLE_INSTRUCTION(SPUT_BOOLEAN) {
         PREAMBLE();
         bool success = DoFieldPut<StaticPrimitiveWrite, Primitive::kPrimBoolean, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT_BYTE: {
+      HANDLE_INSTRUCTION(SPUT_BYTE) {
         PREAMBLE();
         bool success = DoFieldPut<StaticPrimitiveWrite, Primitive::kPrimByte, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT_CHAR: {
+      HANDLE_INSTRUCTION(SPUT_CHAR) {
         PREAMBLE();
         bool success = DoFieldPut<StaticPrimitiveWrite, Primitive::kPrimChar, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT_SHORT: {
+      HANDLE_INSTRUCTION(SPUT_SHORT) {
         PREAMBLE();
         bool success = DoFieldPut<StaticPrimitiveWrite, Primitive::kPrimShort, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT: {
+      HANDLE_INSTRUCTION(SPUT) {
         PREAMBLE();
         bool success = DoFieldPut<StaticPrimitiveWrite, Primitive::kPrimInt, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT_WIDE: {
+      HANDLE_INSTRUCTION(SPUT_WIDE) {
         PREAMBLE();
         bool success = DoFieldPut<StaticPrimitiveWrite, Primitive::kPrimLong, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SPUT_OBJECT: {
+      HANDLE_INSTRUCTION(SPUT_OBJECT) {
         PREAMBLE();
         bool success = DoFieldPut<StaticObjectWrite, Primitive::kPrimNot, do_access_check,
             transaction_active>(self, shadow_frame, inst, inst_data);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_VIRTUAL: {
+      HANDLE_INSTRUCTION(INVOKE_VIRTUAL) {
         PREAMBLE();
         bool success = DoInvoke<kVirtual, false, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_VIRTUAL_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_VIRTUAL_RANGE) {
         PREAMBLE();
         bool success = DoInvoke<kVirtual, true, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_SUPER: {
+      HANDLE_INSTRUCTION(INVOKE_SUPER) {
         PREAMBLE();
         bool success = DoInvoke<kSuper, false, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_SUPER_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_SUPER_RANGE) {
         PREAMBLE();
         bool success = DoInvoke<kSuper, true, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_DIRECT: {
+      HANDLE_INSTRUCTION(INVOKE_DIRECT) {
         PREAMBLE();
         bool success = DoInvoke<kDirect, false, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_DIRECT_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_DIRECT_RANGE) {
         PREAMBLE();
         bool success = DoInvoke<kDirect, true, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_INTERFACE: {
+      HANDLE_INSTRUCTION(INVOKE_INTERFACE) {
         PREAMBLE();
         bool success = DoInvoke<kInterface, false, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_INTERFACE_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_INTERFACE_RANGE) {
         PREAMBLE();
         bool success = DoInvoke<kInterface, true, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_STATIC: {
+      HANDLE_INSTRUCTION(INVOKE_STATIC) {
         PREAMBLE();
         bool success = DoInvoke<kStatic, false, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_STATIC_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_STATIC_RANGE) {
         PREAMBLE();
         bool success = DoInvoke<kStatic, true, do_access_check>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_VIRTUAL_QUICK: {
+      HANDLE_INSTRUCTION(INVOKE_VIRTUAL_QUICK)
+      HANDLE_INSTRUCTION(INVOKE_VIRTUAL_QUICK_MOVE_RESULT)
+      HANDLE_INSTRUCTION(INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT) {
         PREAMBLE();
         bool success = DoInvokeVirtualQuick<false>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_VIRTUAL_RANGE_QUICK: {
+      HANDLE_INSTRUCTION(INVOKE_VIRTUAL_RANGE_QUICK) {
         PREAMBLE();
         bool success = DoInvokeVirtualQuick<true>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_POLYMORPHIC: {
+      HANDLE_INSTRUCTION(INVOKE_POLYMORPHIC) {
         PREAMBLE();
         DCHECK(Runtime::Current()->IsMethodHandlesEnabled());
         bool success = DoInvokePolymorphic<false /* is_range */>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_4xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_POLYMORPHIC_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_POLYMORPHIC_RANGE) {
         PREAMBLE();
         DCHECK(Runtime::Current()->IsMethodHandlesEnabled());
         bool success = DoInvokePolymorphic<true /* is_range */>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_4xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_CUSTOM: {
+      HANDLE_INSTRUCTION(INVOKE_CUSTOM) {
         PREAMBLE();
         DCHECK(Runtime::Current()->IsMethodHandlesEnabled());
         bool success = DoInvokeCustom<false /* is_range */>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::INVOKE_CUSTOM_RANGE: {
+      HANDLE_INSTRUCTION(INVOKE_CUSTOM_RANGE) {
         PREAMBLE();
         DCHECK(Runtime::Current()->IsMethodHandlesEnabled());
         bool success = DoInvokeCustom<true /* is_range */>(
             self, shadow_frame, inst, inst_data, &result_register);
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_3xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::NEG_INT:
+      HANDLE_INSTRUCTION(NEG_INT)
         PREAMBLE();
         shadow_frame.SetVReg(
             inst->VRegA_12x(inst_data), -shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::NOT_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(NOT_INT)
         PREAMBLE();
         shadow_frame.SetVReg(
             inst->VRegA_12x(inst_data), ~shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::NEG_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(NEG_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(
             inst->VRegA_12x(inst_data), -shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::NOT_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(NOT_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(
             inst->VRegA_12x(inst_data), ~shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::NEG_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(NEG_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(
             inst->VRegA_12x(inst_data), -shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::NEG_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(NEG_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(
             inst->VRegA_12x(inst_data), -shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::INT_TO_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(INT_TO_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_12x(inst_data),
                                  shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::INT_TO_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(INT_TO_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_12x(inst_data),
                                   shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::INT_TO_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(INT_TO_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_12x(inst_data),
                                    shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::LONG_TO_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(LONG_TO_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data),
                              shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::LONG_TO_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(LONG_TO_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_12x(inst_data),
                                   shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::LONG_TO_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(LONG_TO_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_12x(inst_data),
                                    shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::FLOAT_TO_INT: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(FLOAT_TO_INT) {
         PREAMBLE();
         float val = shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data));
         int32_t result = art_float_to_integral<int32_t, float>(val);
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data), result);
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::FLOAT_TO_LONG: {
+      HANDLE_INSTRUCTION(FLOAT_TO_LONG) {
         PREAMBLE();
         float val = shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data));
         int64_t result = art_float_to_integral<int64_t, float>(val);
         shadow_frame.SetVRegLong(inst->VRegA_12x(inst_data), result);
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::FLOAT_TO_DOUBLE:
+      HANDLE_INSTRUCTION(FLOAT_TO_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_12x(inst_data),
                                    shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::DOUBLE_TO_INT: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DOUBLE_TO_INT) {
         PREAMBLE();
         double val = shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data));
         int32_t result = art_float_to_integral<int32_t, double>(val);
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data), result);
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::DOUBLE_TO_LONG: {
+      HANDLE_INSTRUCTION(DOUBLE_TO_LONG) {
         PREAMBLE();
         double val = shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data));
         int64_t result = art_float_to_integral<int64_t, double>(val);
         shadow_frame.SetVRegLong(inst->VRegA_12x(inst_data), result);
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::DOUBLE_TO_FLOAT:
+      HANDLE_INSTRUCTION(DOUBLE_TO_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_12x(inst_data),
                                   shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::INT_TO_BYTE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(INT_TO_BYTE)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data), static_cast<int8_t>(
             shadow_frame.GetVReg(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::INT_TO_CHAR:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(INT_TO_CHAR)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data), static_cast<uint16_t>(
             shadow_frame.GetVReg(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::INT_TO_SHORT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(INT_TO_SHORT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_12x(inst_data), static_cast<int16_t>(
             shadow_frame.GetVReg(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
-      case Instruction::ADD_INT: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(ADD_INT) {
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              SafeAdd(shadow_frame.GetVReg(inst->VRegB_23x()),
                                      shadow_frame.GetVReg(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SUB_INT:
+      HANDLE_INSTRUCTION(SUB_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              SafeSub(shadow_frame.GetVReg(inst->VRegB_23x()),
                                      shadow_frame.GetVReg(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MUL_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MUL_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              SafeMul(shadow_frame.GetVReg(inst->VRegB_23x()),
                                      shadow_frame.GetVReg(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::DIV_INT: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DIV_INT) {
         PREAMBLE();
         bool success = DoIntDivide(shadow_frame, inst->VRegA_23x(inst_data),
                                    shadow_frame.GetVReg(inst->VRegB_23x()),
                                    shadow_frame.GetVReg(inst->VRegC_23x()));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_INT: {
+      HANDLE_INSTRUCTION(REM_INT) {
         PREAMBLE();
         bool success = DoIntRemainder(shadow_frame, inst->VRegA_23x(inst_data),
                                       shadow_frame.GetVReg(inst->VRegB_23x()),
                                       shadow_frame.GetVReg(inst->VRegC_23x()));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SHL_INT:
+      HANDLE_INSTRUCTION(SHL_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_23x()) <<
                              (shadow_frame.GetVReg(inst->VRegC_23x()) & 0x1f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SHR_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SHR_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_23x()) >>
                              (shadow_frame.GetVReg(inst->VRegC_23x()) & 0x1f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::USHR_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(USHR_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              static_cast<uint32_t>(shadow_frame.GetVReg(inst->VRegB_23x())) >>
                              (shadow_frame.GetVReg(inst->VRegC_23x()) & 0x1f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::AND_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(AND_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_23x()) &
                              shadow_frame.GetVReg(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::OR_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(OR_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_23x()) |
                              shadow_frame.GetVReg(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::XOR_INT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(XOR_INT)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_23x(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_23x()) ^
                              shadow_frame.GetVReg(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::ADD_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(ADD_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  SafeAdd(shadow_frame.GetVRegLong(inst->VRegB_23x()),
                                          shadow_frame.GetVRegLong(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SUB_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SUB_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  SafeSub(shadow_frame.GetVRegLong(inst->VRegB_23x()),
                                          shadow_frame.GetVRegLong(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MUL_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MUL_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  SafeMul(shadow_frame.GetVRegLong(inst->VRegB_23x()),
                                          shadow_frame.GetVRegLong(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::DIV_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DIV_LONG)
         PREAMBLE();
         DoLongDivide(shadow_frame, inst->VRegA_23x(inst_data),
                      shadow_frame.GetVRegLong(inst->VRegB_23x()),
                      shadow_frame.GetVRegLong(inst->VRegC_23x()));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(self->IsExceptionPending(), Next_2xx);
-        break;
-      case Instruction::REM_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(REM_LONG)
         PREAMBLE();
         DoLongRemainder(shadow_frame, inst->VRegA_23x(inst_data),
                         shadow_frame.GetVRegLong(inst->VRegB_23x()),
                         shadow_frame.GetVRegLong(inst->VRegC_23x()));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(self->IsExceptionPending(), Next_2xx);
-        break;
-      case Instruction::AND_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(AND_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_23x()) &
                                  shadow_frame.GetVRegLong(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::OR_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(OR_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_23x()) |
                                  shadow_frame.GetVRegLong(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::XOR_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(XOR_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_23x()) ^
                                  shadow_frame.GetVRegLong(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SHL_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SHL_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_23x()) <<
                                  (shadow_frame.GetVReg(inst->VRegC_23x()) & 0x3f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SHR_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SHR_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  shadow_frame.GetVRegLong(inst->VRegB_23x()) >>
                                  (shadow_frame.GetVReg(inst->VRegC_23x()) & 0x3f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::USHR_LONG:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(USHR_LONG)
         PREAMBLE();
         shadow_frame.SetVRegLong(inst->VRegA_23x(inst_data),
                                  static_cast<uint64_t>(shadow_frame.GetVRegLong(inst->VRegB_23x())) >>
                                  (shadow_frame.GetVReg(inst->VRegC_23x()) & 0x3f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::ADD_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(ADD_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_23x(inst_data),
                                   shadow_frame.GetVRegFloat(inst->VRegB_23x()) +
                                   shadow_frame.GetVRegFloat(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SUB_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SUB_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_23x(inst_data),
                                   shadow_frame.GetVRegFloat(inst->VRegB_23x()) -
                                   shadow_frame.GetVRegFloat(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MUL_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MUL_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_23x(inst_data),
                                   shadow_frame.GetVRegFloat(inst->VRegB_23x()) *
                                   shadow_frame.GetVRegFloat(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::DIV_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DIV_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_23x(inst_data),
                                   shadow_frame.GetVRegFloat(inst->VRegB_23x()) /
                                   shadow_frame.GetVRegFloat(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::REM_FLOAT:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(REM_FLOAT)
         PREAMBLE();
         shadow_frame.SetVRegFloat(inst->VRegA_23x(inst_data),
                                   fmodf(shadow_frame.GetVRegFloat(inst->VRegB_23x()),
                                         shadow_frame.GetVRegFloat(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::ADD_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(ADD_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_23x(inst_data),
                                    shadow_frame.GetVRegDouble(inst->VRegB_23x()) +
                                    shadow_frame.GetVRegDouble(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SUB_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SUB_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_23x(inst_data),
                                    shadow_frame.GetVRegDouble(inst->VRegB_23x()) -
                                    shadow_frame.GetVRegDouble(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MUL_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MUL_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_23x(inst_data),
                                    shadow_frame.GetVRegDouble(inst->VRegB_23x()) *
                                    shadow_frame.GetVRegDouble(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::DIV_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DIV_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_23x(inst_data),
                                    shadow_frame.GetVRegDouble(inst->VRegB_23x()) /
                                    shadow_frame.GetVRegDouble(inst->VRegC_23x()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::REM_DOUBLE:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(REM_DOUBLE)
         PREAMBLE();
         shadow_frame.SetVRegDouble(inst->VRegA_23x(inst_data),
                                    fmod(shadow_frame.GetVRegDouble(inst->VRegB_23x()),
                                         shadow_frame.GetVRegDouble(inst->VRegC_23x())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::ADD_INT_2ADDR: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(ADD_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA, SafeAdd(shadow_frame.GetVReg(vregA),
                                             shadow_frame.GetVReg(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SUB_INT_2ADDR: {
+      HANDLE_INSTRUCTION(SUB_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              SafeSub(shadow_frame.GetVReg(vregA),
                                      shadow_frame.GetVReg(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::MUL_INT_2ADDR: {
+      HANDLE_INSTRUCTION(MUL_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              SafeMul(shadow_frame.GetVReg(vregA),
                                      shadow_frame.GetVReg(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::DIV_INT_2ADDR: {
+      HANDLE_INSTRUCTION(DIV_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         bool success = DoIntDivide(shadow_frame, vregA, shadow_frame.GetVReg(vregA),
                                    shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_1xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_INT_2ADDR: {
+      HANDLE_INSTRUCTION(REM_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         bool success = DoIntRemainder(shadow_frame, vregA, shadow_frame.GetVReg(vregA),
                                       shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_1xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SHL_INT_2ADDR: {
+      HANDLE_INSTRUCTION(SHL_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              shadow_frame.GetVReg(vregA) <<
                              (shadow_frame.GetVReg(inst->VRegB_12x(inst_data)) & 0x1f));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SHR_INT_2ADDR: {
+      HANDLE_INSTRUCTION(SHR_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              shadow_frame.GetVReg(vregA) >>
                              (shadow_frame.GetVReg(inst->VRegB_12x(inst_data)) & 0x1f));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::USHR_INT_2ADDR: {
+      HANDLE_INSTRUCTION(USHR_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              static_cast<uint32_t>(shadow_frame.GetVReg(vregA)) >>
                              (shadow_frame.GetVReg(inst->VRegB_12x(inst_data)) & 0x1f));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AND_INT_2ADDR: {
+      HANDLE_INSTRUCTION(AND_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              shadow_frame.GetVReg(vregA) &
                              shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::OR_INT_2ADDR: {
+      HANDLE_INSTRUCTION(OR_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              shadow_frame.GetVReg(vregA) |
                              shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::XOR_INT_2ADDR: {
+      HANDLE_INSTRUCTION(XOR_INT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVReg(vregA,
                              shadow_frame.GetVReg(vregA) ^
                              shadow_frame.GetVReg(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::ADD_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(ADD_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  SafeAdd(shadow_frame.GetVRegLong(vregA),
                                          shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SUB_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(SUB_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  SafeSub(shadow_frame.GetVRegLong(vregA),
                                          shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::MUL_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(MUL_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  SafeMul(shadow_frame.GetVRegLong(vregA),
                                          shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::DIV_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(DIV_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         DoLongDivide(shadow_frame, vregA, shadow_frame.GetVRegLong(vregA),
                     shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(self->IsExceptionPending(), Next_1xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(REM_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         DoLongRemainder(shadow_frame, vregA, shadow_frame.GetVRegLong(vregA),
                         shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         POSSIBLY_HANDLE_PENDING_EXCEPTION(self->IsExceptionPending(), Next_1xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AND_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(AND_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  shadow_frame.GetVRegLong(vregA) &
                                  shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::OR_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(OR_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  shadow_frame.GetVRegLong(vregA) |
                                  shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::XOR_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(XOR_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  shadow_frame.GetVRegLong(vregA) ^
                                  shadow_frame.GetVRegLong(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SHL_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(SHL_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  shadow_frame.GetVRegLong(vregA) <<
                                  (shadow_frame.GetVReg(inst->VRegB_12x(inst_data)) & 0x3f));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SHR_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(SHR_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  shadow_frame.GetVRegLong(vregA) >>
                                  (shadow_frame.GetVReg(inst->VRegB_12x(inst_data)) & 0x3f));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::USHR_LONG_2ADDR: {
+      HANDLE_INSTRUCTION(USHR_LONG_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegLong(vregA,
                                  static_cast<uint64_t>(shadow_frame.GetVRegLong(vregA)) >>
                                  (shadow_frame.GetVReg(inst->VRegB_12x(inst_data)) & 0x3f));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::ADD_FLOAT_2ADDR: {
+      HANDLE_INSTRUCTION(ADD_FLOAT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegFloat(vregA,
                                   shadow_frame.GetVRegFloat(vregA) +
                                   shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SUB_FLOAT_2ADDR: {
+      HANDLE_INSTRUCTION(SUB_FLOAT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegFloat(vregA,
                                   shadow_frame.GetVRegFloat(vregA) -
                                   shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::MUL_FLOAT_2ADDR: {
+      HANDLE_INSTRUCTION(MUL_FLOAT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegFloat(vregA,
                                   shadow_frame.GetVRegFloat(vregA) *
                                   shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::DIV_FLOAT_2ADDR: {
+      HANDLE_INSTRUCTION(DIV_FLOAT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegFloat(vregA,
                                   shadow_frame.GetVRegFloat(vregA) /
                                   shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_FLOAT_2ADDR: {
+      HANDLE_INSTRUCTION(REM_FLOAT_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegFloat(vregA,
                                   fmodf(shadow_frame.GetVRegFloat(vregA),
                                         shadow_frame.GetVRegFloat(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::ADD_DOUBLE_2ADDR: {
+      HANDLE_INSTRUCTION(ADD_DOUBLE_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegDouble(vregA,
                                    shadow_frame.GetVRegDouble(vregA) +
                                    shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::SUB_DOUBLE_2ADDR: {
+      HANDLE_INSTRUCTION(SUB_DOUBLE_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegDouble(vregA,
                                    shadow_frame.GetVRegDouble(vregA) -
                                    shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::MUL_DOUBLE_2ADDR: {
+      HANDLE_INSTRUCTION(MUL_DOUBLE_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegDouble(vregA,
                                    shadow_frame.GetVRegDouble(vregA) *
                                    shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::DIV_DOUBLE_2ADDR: {
+      HANDLE_INSTRUCTION(DIV_DOUBLE_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegDouble(vregA,
                                    shadow_frame.GetVRegDouble(vregA) /
                                    shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data)));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_DOUBLE_2ADDR: {
+      HANDLE_INSTRUCTION(REM_DOUBLE_2ADDR) {
         PREAMBLE();
         uint4_t vregA = inst->VRegA_12x(inst_data);
         shadow_frame.SetVRegDouble(vregA,
                                    fmod(shadow_frame.GetVRegDouble(vregA),
                                         shadow_frame.GetVRegDouble(inst->VRegB_12x(inst_data))));
         inst = inst->Next_1xx();
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::ADD_INT_LIT16:
+      HANDLE_INSTRUCTION(ADD_INT_LIT16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22s(inst_data),
                              SafeAdd(shadow_frame.GetVReg(inst->VRegB_22s(inst_data)),
                                      inst->VRegC_22s()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::RSUB_INT_LIT16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(RSUB_INT_LIT16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22s(inst_data),
                              SafeSub(inst->VRegC_22s(),
                                      shadow_frame.GetVReg(inst->VRegB_22s(inst_data))));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MUL_INT_LIT16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MUL_INT_LIT16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22s(inst_data),
                              SafeMul(shadow_frame.GetVReg(inst->VRegB_22s(inst_data)),
                                      inst->VRegC_22s()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::DIV_INT_LIT16: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DIV_INT_LIT16) {
         PREAMBLE();
         bool success = DoIntDivide(shadow_frame, inst->VRegA_22s(inst_data),
                                    shadow_frame.GetVReg(inst->VRegB_22s(inst_data)),
                                    inst->VRegC_22s());
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_INT_LIT16: {
+      HANDLE_INSTRUCTION(REM_INT_LIT16) {
         PREAMBLE();
         bool success = DoIntRemainder(shadow_frame, inst->VRegA_22s(inst_data),
                                       shadow_frame.GetVReg(inst->VRegB_22s(inst_data)),
                                       inst->VRegC_22s());
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AND_INT_LIT16:
+      HANDLE_INSTRUCTION(AND_INT_LIT16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22s(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22s(inst_data)) &
                              inst->VRegC_22s());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::OR_INT_LIT16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(OR_INT_LIT16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22s(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22s(inst_data)) |
                              inst->VRegC_22s());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::XOR_INT_LIT16:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(XOR_INT_LIT16)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22s(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22s(inst_data)) ^
                              inst->VRegC_22s());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::ADD_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(ADD_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              SafeAdd(shadow_frame.GetVReg(inst->VRegB_22b()), inst->VRegC_22b()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::RSUB_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(RSUB_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              SafeSub(inst->VRegC_22b(), shadow_frame.GetVReg(inst->VRegB_22b())));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::MUL_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(MUL_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              SafeMul(shadow_frame.GetVReg(inst->VRegB_22b()), inst->VRegC_22b()));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::DIV_INT_LIT8: {
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(DIV_INT_LIT8) {
         PREAMBLE();
         bool success = DoIntDivide(shadow_frame, inst->VRegA_22b(inst_data),
                                    shadow_frame.GetVReg(inst->VRegB_22b()), inst->VRegC_22b());
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::REM_INT_LIT8: {
+      HANDLE_INSTRUCTION(REM_INT_LIT8) {
         PREAMBLE();
         bool success = DoIntRemainder(shadow_frame, inst->VRegA_22b(inst_data),
                                       shadow_frame.GetVReg(inst->VRegB_22b()), inst->VRegC_22b());
         POSSIBLY_HANDLE_PENDING_EXCEPTION(!success, Next_2xx);
-        break;
+        NEXT_INSTRUCTION();
       }
-      case Instruction::AND_INT_LIT8:
+      HANDLE_INSTRUCTION(AND_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22b()) &
                              inst->VRegC_22b());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::OR_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(OR_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22b()) |
                              inst->VRegC_22b());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::XOR_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(XOR_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22b()) ^
                              inst->VRegC_22b());
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SHL_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SHL_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22b()) <<
                              (inst->VRegC_22b() & 0x1f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::SHR_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(SHR_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              shadow_frame.GetVReg(inst->VRegB_22b()) >>
                              (inst->VRegC_22b() & 0x1f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::USHR_INT_LIT8:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(USHR_INT_LIT8)
         PREAMBLE();
         shadow_frame.SetVReg(inst->VRegA_22b(inst_data),
                              static_cast<uint32_t>(shadow_frame.GetVReg(inst->VRegB_22b())) >>
                              (inst->VRegC_22b() & 0x1f));
         inst = inst->Next_2xx();
-        break;
-      case Instruction::UNUSED_3E ... Instruction::UNUSED_43:
-      case Instruction::UNUSED_F3 ... Instruction::UNUSED_F9:
-      case Instruction::UNUSED_FE ... Instruction::UNUSED_FF:
-      case Instruction::UNUSED_79:
-      case Instruction::UNUSED_7A:
+        NEXT_INSTRUCTION();
+      HANDLE_INSTRUCTION(UNUSED_3E)
+      HANDLE_INSTRUCTION(UNUSED_3F)
+      HANDLE_INSTRUCTION(UNUSED_40)
+      HANDLE_INSTRUCTION(UNUSED_41)
+      HANDLE_INSTRUCTION(UNUSED_42)
+      HANDLE_INSTRUCTION(UNUSED_43)
+      HANDLE_INSTRUCTION(UNUSED_79)
+      HANDLE_INSTRUCTION(UNUSED_7A)
+      HANDLE_INSTRUCTION(UNUSED_F9)
+      HANDLE_INSTRUCTION(UNUSED_FE)
+      HANDLE_INSTRUCTION(UNUSED_FF)
         UnexpectedOpcode(inst, shadow_frame);
     }
   } while (!interpret_one_instruction);
@@ -2342,6 +2396,26 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
   return result_register;
 }  // NOLINT(readability/fn_size)
 
+#undef NEXT_INSTRUCTION
+#undef HANDLE_INSTRUCTION
+#undef FETCH_INSTRUCTION
+
+template<bool do_access_check, bool transaction_active>
+JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
+                         ShadowFrame& shadow_frame, JValue result_register,
+                         bool interpret_one_instruction) {
+  return ExecuteImpl<do_access_check, transaction_active, /* threaded */ false>(
+      self, code_item, shadow_frame, result_register, interpret_one_instruction);
+}
+
+template<bool do_access_check, bool transaction_active>
+JValue ExecuteGotoImpl(Thread* self, const DexFile::CodeItem* code_item,
+                       ShadowFrame& shadow_frame, JValue result_register,
+                       bool interpret_one_instruction) {
+  return ExecuteImpl<do_access_check, transaction_active, /* threaded */ true>(
+      self, code_item, shadow_frame, result_register, interpret_one_instruction);
+}
+
 // Explicit definitions of ExecuteSwitchImpl.
 template HOT_ATTR
 JValue ExecuteSwitchImpl<true, false>(Thread* self, const DexFile::CodeItem* code_item,
@@ -2360,5 +2434,23 @@ JValue ExecuteSwitchImpl<false, true>(Thread* self, const DexFile::CodeItem* cod
                                       ShadowFrame& shadow_frame, JValue result_register,
                                       bool interpret_one_instruction);
 
+// Explicit definitions of ExecuteGotoImpl.
+template HOT_ATTR
+JValue ExecuteGotoImpl<true, false>(Thread* self, const DexFile::CodeItem* code_item,
+                                    ShadowFrame& shadow_frame, JValue result_register,
+                                    bool interpret_one_instruction);
+template HOT_ATTR
+JValue ExecuteGotoImpl<false, false>(Thread* self, const DexFile::CodeItem* code_item,
+                                     ShadowFrame& shadow_frame, JValue result_register,
+                                     bool interpret_one_instruction);
+template
+JValue ExecuteGotoImpl<true, true>(Thread* self, const DexFile::CodeItem* code_item,
+                                   ShadowFrame& shadow_frame, JValue result_register,
+                                   bool interpret_one_instruction);
+template
+JValue ExecuteGotoImpl<false, true>(Thread* self, const DexFile::CodeItem* code_item,
+                                    ShadowFrame& shadow_frame, JValue result_register,
+                                    bool interpret_one_instruction);
+
 }  // namespace interpreter
 }  // namespace art
@@ -37,6 +37,15 @@ JValue ExecuteSwitchImpl(Thread* self,
                          JValue result_register,
                          bool interpret_one_instruction) REQUIRES_SHARED(Locks::mutator_lock_);
 
+// Threaded variant of ExecuteSwitchImpl, sharing its instruction handlers, which dispatches
+// with computed gotos (labels as values) instead of a switch.
+template<bool do_access_check, bool transaction_active>
+JValue ExecuteGotoImpl(Thread* self,
+                       const DexFile::CodeItem* code_item,
+                       ShadowFrame& shadow_frame,
+                       JValue result_register,
+                       bool interpret_one_instruction) REQUIRES_SHARED(Locks::mutator_lock_);
+
 }  // namespace interpreter
 }  // namespace art
 
@@ -147,7 +147,8 @@ extern "C" size_t MterpShouldSwitchInterpreters()
     REQUIRES_SHARED(Locks::mutator_lock_) {
   const instrumentation::Instrumentation* const instrumentation =
       Runtime::Current()->GetInstrumentation();
-  return instrumentation->NonJitProfilingActive() || Dbg::IsDebuggerActive();
+  // Method tracing only needs entry, exit and unwind events, which do not require leaving mterp.
+  return instrumentation->InstructionListenersActive() || Dbg::IsDebuggerActive();
 }
 
 
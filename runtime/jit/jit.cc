@@ -20,6 +20,7 @@
 
 #include "art_method-inl.h"
 #include "base/enums.h"
+#include "base/time_utils.h"
 #include "debugger.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
 #include "interpreter/interpreter.h"
@@ -27,6 +28,7 @@
 #include "jit_code_cache.h"
 #include "oat_file_manager.h"
 #include "oat_quick_method_header.h"
+#include "persistent_code_cache.h"
 #include "profile_compilation_info.h"
 #include "profile_saver.h"
 #include "runtime.h"
@@ -47,10 +49,20 @@ void* Jit::jit_library_handle_= nullptr;
 void* Jit::jit_compiler_handle_ = nullptr;
 void* (*Jit::jit_load_)(bool*) = nullptr;
 void (*Jit::jit_unload_)(void*) = nullptr;
-bool (*Jit::jit_compile_method_)(void*, ArtMethod*, Thread*, bool) = nullptr;
+bool (*Jit::jit_compile_method_)(void*, ArtMethod*, Thread*, bool, bool) = nullptr;
 void (*Jit::jit_types_loaded_)(void*, mirror::Class**, size_t count) = nullptr;
 bool Jit::generate_debug_info_ = false;
 
+// Baseline code counts its hotness in the method's 16-bit hotness counter, which the
+// runtime primes so that it wraps around to zero after `OptimizeMethodThreshold()`
+// method entries and loop back edges.
+static constexpr uint32_t kHotnessCounterWrapAround = std::numeric_limits<uint16_t>::max() + 1u;
+
+// Only these code generators count hotness in baseline code.
+static constexpr bool SupportsBaselineCompilation(InstructionSet isa) {
+  return isa == kArm64 || isa == kX86_64;
+}
+
 JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& options) {
   auto* jit_options = new JitOptions;
   jit_options->use_jit_compilation_ = options.GetOrDefault(RuntimeArgumentMap::UseJitCompilation);
@@ -118,6 +130,28 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
         static_cast<size_t>(1));
   }
 
+  jit_options->thread_pool_size_ = options.GetOrDefault(RuntimeArgumentMap::JITPoolThreads);
+  if (jit_options->thread_pool_size_ == 0) {
+    LOG(FATAL) << "JIT thread pool size cannot be 0.";
+  }
+
+  // Tiered compilation is off unless an optimization threshold is given.
+  if (options.Exists(RuntimeArgumentMap::JITOptimizeThreshold)) {
+    jit_options->optimize_threshold_ = *options.Get(RuntimeArgumentMap::JITOptimizeThreshold);
+    if (jit_options->optimize_threshold_ > std::numeric_limits<uint16_t>::max()) {
+      LOG(FATAL) << "Method optimization threshold is above its internal limit.";
+    }
+    if (jit_options->optimize_threshold_ != 0 && !SupportsBaselineCompilation(kRuntimeISA)) {
+      LOG(WARNING) << "JIT baseline compilation is not supported on " << kRuntimeISA;
+      jit_options->optimize_threshold_ = 0;
+    }
+  }
+
+  // Compiled code is only saved across runs when given a file to store it.
+  if (options.Exists(RuntimeArgumentMap::JITPersistentCache)) {
+    jit_options->persistent_cache_file_ = *options.Get(RuntimeArgumentMap::JITPersistentCache);
+  }
+
   return jit_options;
 }
 
@@ -131,6 +165,24 @@ void Jit::DumpInfo(std::ostream& os) {
   cumulative_timings_.Dump(os);
   MutexLock mu(Thread::Current(), lock_);
   memory_use_.PrintMemoryUse(os);
+  os << queue_depth_.Name();
+  if (queue_depth_.SampleSize() != 0u) {
+    // The depth is a count, PrintConfidenceIntervals() would format it as a duration.
+    Histogram<uint64_t>::CumulativeData data;
+    queue_depth_.CreateHistogram(&data);
+    os << ": 99% C.I. " << queue_depth_.Percentile(0.005, data)
+       << "-" << queue_depth_.Percentile(0.995, data)
+       << " Avg: " << queue_depth_.Mean() << " Max: " << queue_depth_.Max() << "\n";
+  } else {
+    os << ": <no data>\n";
+  }
+  if (queue_wait_time_.SampleSize() != 0u) {
+    Histogram<uint64_t>::CumulativeData data;
+    queue_wait_time_.CreateHistogram(&data);
+    queue_wait_time_.PrintConfidenceIntervals(os, 0.99, data);
+  } else {
+    os << queue_wait_time_.Name() << ": <no data>\n";
+  }
 }
 
 void Jit::DumpForSigQuit(std::ostream& os) {
@@ -145,13 +197,17 @@ void Jit::AddTimingLogger(const TimingLogger& logger) {
 Jit::Jit() : dump_info_on_shutdown_(false),
              cumulative_timings_("JIT timings"),
              memory_use_("Memory used for compilation", 16),
+             queue_depth_("JIT compile queue depth", 1),
+             queue_wait_time_("JIT compile queue wait time", 16),
              lock_("JIT memory use lock"),
              use_jit_compilation_(true),
              hot_method_threshold_(0),
              warm_method_threshold_(0),
              osr_method_threshold_(0),
+             optimize_method_threshold_(0),
              priority_thread_weight_(0),
-             invoke_transition_weight_(0) {}
+             invoke_transition_weight_(0),
+             thread_pool_size_(0) {}
 
 Jit* Jit::Create(JitOptions* options, std::string* error_msg) {
   DCHECK(options->UseJitCompilation() || options->GetProfileSaverOptions().IsEnabled());
@@ -168,20 +224,37 @@ Jit* Jit::Create(JitOptions* options, std::string* error_msg) {
   if (jit->GetCodeCache() == nullptr) {
     return nullptr;
   }
+  const std::string& persistent_cache_file = options->GetPersistentCacheFile();
+  if (!persistent_cache_file.empty() && options->UseJitCompilation()) {
+    std::string persistent_error_msg;
+    PersistentCodeCache* persistent_code_cache = PersistentCodeCache::IsSupported(kRuntimeISA)
+        ? PersistentCodeCache::Create(persistent_cache_file, &persistent_error_msg)
+        : nullptr;
+    if (persistent_code_cache != nullptr) {
+      jit->code_cache_->SetPersistentCodeCache(persistent_code_cache);
+    } else {
+      LOG(WARNING) << "Not using persistent JIT code cache " << persistent_cache_file << ": "
+                   << (persistent_error_msg.empty() ? "unsupported instruction set"
+                                                    : persistent_error_msg);
+    }
+  }
   jit->use_jit_compilation_ = options->UseJitCompilation();
   jit->profile_saver_options_ = options->GetProfileSaverOptions();
   VLOG(jit) << "JIT created with initial_capacity="
       << PrettySize(options->GetCodeCacheInitialCapacity())
       << ", max_capacity=" << PrettySize(options->GetCodeCacheMaxCapacity())
       << ", compile_threshold=" << options->GetCompileThreshold()
+      << ", optimize_threshold=" << options->GetOptimizeThreshold()
       << ", profile_saver_options=" << options->GetProfileSaverOptions();
 
 
   jit->hot_method_threshold_ = options->GetCompileThreshold();
   jit->warm_method_threshold_ = options->GetWarmupThreshold();
   jit->osr_method_threshold_ = options->GetOsrThreshold();
+  jit->optimize_method_threshold_ = options->GetOptimizeThreshold();
   jit->priority_thread_weight_ = options->GetPriorityThreadWeight();
   jit->invoke_transition_weight_ = options->GetInvokeTransitionWeight();
+  jit->thread_pool_size_ = options->GetThreadPoolSize();
 
   jit->CreateThreadPool();
 
@@ -212,7 +285,7 @@ bool Jit::LoadCompilerLibrary(std::string* error_msg) {
     *error_msg = "JIT couldn't find jit_unload entry point";
     return false;
   }
-  jit_compile_method_ = reinterpret_cast<bool (*)(void*, ArtMethod*, Thread*, bool)>(
+  jit_compile_method_ = reinterpret_cast<bool (*)(void*, ArtMethod*, Thread*, bool, bool)>(
       dlsym(jit_library_handle_, "jit_compile_method"));
   if (jit_compile_method_ == nullptr) {
     dlclose(jit_library_handle_);
@@ -246,7 +319,7 @@ bool Jit::LoadCompiler(std::string* error_msg) {
   return true;
 }
 
-bool Jit::CompileMethod(ArtMethod* method, Thread* self, bool osr) {
+bool Jit::CompileMethod(ArtMethod* method, Thread* self, bool osr, bool baseline) {
   DCHECK(Runtime::Current()->UseJitCompilation());
   DCHECK(!method->IsRuntimeMethod());
 
@@ -266,19 +339,32 @@ bool Jit::CompileMethod(ArtMethod* method, Thread* self, bool osr) {
   // If we get a request to compile a proxy method, we pass the actual Java method
   // of that proxy method, as the compiler does not expect a proxy method.
   ArtMethod* method_to_compile = method->GetInterfaceMethodIfProxy(kRuntimePointerSize);
-  if (!code_cache_->NotifyCompilationOf(method_to_compile, self, osr)) {
+  if (!code_cache_->NotifyCompilationOf(method_to_compile, self, osr, baseline)) {
     return false;
   }
 
+  // Code compiled by an earlier run is the final optimized code, which supersedes a
+  // baseline compilation.
+  if (!osr && code_cache_->InstallPersistedCode(self, method_to_compile)) {
+    code_cache_->DoneCompiling(method_to_compile, self, osr);
+    return true;
+  }
+
   VLOG(jit) << "Compiling method "
             << ArtMethod::PrettyMethod(method_to_compile)
-            << " osr=" << std::boolalpha << osr;
-  bool success = jit_compile_method_(jit_compiler_handle_, method_to_compile, self, osr);
+            << " osr=" << std::boolalpha << osr
+            << " baseline=" << baseline;
+  bool success = jit_compile_method_(jit_compiler_handle_, method_to_compile, self, osr, baseline);
   code_cache_->DoneCompiling(method_to_compile, self, osr);
   if (!success) {
     VLOG(jit) << "Failed to compile method "
               << ArtMethod::PrettyMethod(method_to_compile)
-              << " osr=" << std::boolalpha << osr;
+              << " osr=" << std::boolalpha << osr
+              << " baseline=" << baseline;
+  } else if (baseline) {
+    // Start counting towards the optimized compilation. Increments made by the baseline
+    // code since it got installed are lost, which is fine as hotness is not precise.
+    method_to_compile->SetCounter(kHotnessCounterWrapAround - optimize_method_threshold_);
   }
   if (kIsDebugBuild) {
     if (self->IsExceptionPending()) {
@@ -298,7 +384,7 @@ void Jit::CreateThreadPool() {
 
   // We need peers as we may report the JIT thread, e.g., in the debugger.
   constexpr bool kJitPoolNeedsPeers = true;
-  thread_pool_.reset(new ThreadPool("Jit thread pool", 1, kJitPoolNeedsPeers));
+  thread_pool_.reset(new ThreadPool("Jit thread pool", thread_pool_size_, kJitPoolNeedsPeers));
 
   thread_pool_->SetPthreadPriority(kJitPoolThreadPthreadPriority);
   Start();
@@ -560,15 +646,45 @@ void Jit::AddMemoryUsage(ArtMethod* method, size_t bytes) {
   memory_use_.AddValue(bytes);
 }
 
+bool Jit::RegisterCompileTask(Thread* self, ArtMethod* method, bool osr) {
+  MutexLock mu(self, lock_);
+  std::unordered_set<ArtMethod*>& queued = osr ? queued_osr_methods_ : queued_methods_;
+  if (!queued.insert(method).second) {
+    return false;
+  }
+  queue_depth_.AddValue(queued_methods_.size() + queued_osr_methods_.size());
+  return true;
+}
+
+void Jit::UnregisterCompileTask(Thread* self, ArtMethod* method, bool osr, uint64_t wait_time_ns) {
+  MutexLock mu(self, lock_);
+  std::unordered_set<ArtMethod*>& queued = osr ? queued_osr_methods_ : queued_methods_;
+  queued.erase(method);
+  queue_wait_time_.AdjustAndAddValue(wait_time_ns);
+}
+
 class JitCompileTask FINAL : public Task {
  public:
   enum TaskKind {
     kAllocateProfile,
     kCompile,
+    kCompileBaseline,
     kCompileOsr
   };
 
-  JitCompileTask(ArtMethod* method, TaskKind kind) : method_(method), kind_(kind) {
+  // A method waiting for OSR keeps a thread in the interpreter, so OSR compilations go before the
+  // regular ones, which are ordered by the hotness counter. Allocating a ProfilingInfo is cheap.
+  // Optimized recompilations of baseline code are queued without hotness: the method already
+  // runs compiled code, so they go last.
+  static constexpr uint32_t kCompilePriority = 0u;
+  static constexpr uint32_t kCompileOsrPriority = 1u << 16;
+  static constexpr uint32_t kAllocateProfilePriority = 1u << 17;
+
+  JitCompileTask(ArtMethod* method, TaskKind kind, uint16_t hotness = 0u)
+      : method_(method),
+        kind_(kind),
+        priority_(ComputePriority(kind, hotness)),
+        start_ns_(NanoTime()) {
     ScopedObjectAccess soa(Thread::Current());
     // Add a global ref to the class to prevent class unloading until compilation is done.
     klass_ = soa.Vm()->AddGlobalRef(soa.Self(), method_->GetDeclaringClass());
@@ -582,10 +698,14 @@ class JitCompileTask FINAL : public Task {
 
   void Run(Thread* self) OVERRIDE {
     ScopedObjectAccess soa(self);
-    if (kind_ == kCompile) {
-      Runtime::Current()->GetJit()->CompileMethod(method_, self, /* osr */ false);
-    } else if (kind_ == kCompileOsr) {
-      Runtime::Current()->GetJit()->CompileMethod(method_, self, /* osr */ true);
+    if (kind_ == kCompile || kind_ == kCompileBaseline || kind_ == kCompileOsr) {
+      const bool osr = (kind_ == kCompileOsr);
+      const bool baseline = (kind_ == kCompileBaseline);
+      Jit* jit = Runtime::Current()->GetJit();
+      const uint64_t wait_time_ns = NanoTime() - start_ns_;
+      jit->CompileMethod(method_, self, osr, baseline);
+      // Only unregister after compiling, requests made in the meantime are duplicates.
+      jit->UnregisterCompileTask(self, method_, osr, wait_time_ns);
     } else {
       DCHECK(kind_ == kAllocateProfile);
       if (ProfilingInfo::Create(self, method_, /* retry_allocation */ true)) {
@@ -599,9 +719,29 @@ class JitCompileTask FINAL : public Task {
     delete this;
   }
 
+  uint32_t GetPriority() const OVERRIDE {
+    return priority_;
+  }
+
  private:
+  static uint32_t ComputePriority(TaskKind kind, uint16_t hotness) {
+    switch (kind) {
+      case kAllocateProfile:
+        return kAllocateProfilePriority;
+      case kCompileOsr:
+        return kCompileOsrPriority + hotness;
+      case kCompile:
+      case kCompileBaseline:
+        return kCompilePriority + hotness;
+    }
+    LOG(FATAL) << "Unreachable";
+    UNREACHABLE();
+  }
+
   ArtMethod* const method_;
   const TaskKind kind_;
+  const uint32_t priority_;
+  const uint64_t start_ns_;
   jobject klass_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(JitCompileTask);
@@ -656,9 +796,13 @@ void Jit::AddSamples(Thread* self, ArtMethod* method, uint16_t count, bool with_
   } else if (use_jit_compilation_) {
     if (starting_count < hot_method_threshold_) {
       if ((new_count >= hot_method_threshold_) &&
-          !code_cache_->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
+          !code_cache_->ContainsPc(method->GetEntryPointFromQuickCompiledCode()) &&
+          RegisterCompileTask(self, method, /* osr */ false)) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(self, new JitCompileTask(method, JitCompileTask::kCompile));
+        JitCompileTask::TaskKind kind = UseTieredCompilation()
+            ? JitCompileTask::kCompileBaseline
+            : JitCompileTask::kCompile;
+        thread_pool_->AddTask(self, new JitCompileTask(method, kind, std::min(new_count, 0xffff)));
       }
       // Avoid jumping more than one state at a time.
       new_count = std::min(new_count, osr_method_threshold_ - 1);
@@ -667,9 +811,13 @@ void Jit::AddSamples(Thread* self, ArtMethod* method, uint16_t count, bool with_
         // If the samples don't contain any back edge, we don't increment the hotness.
         return;
       }
-      if ((new_count >= osr_method_threshold_) &&  !code_cache_->IsOsrCompiled(method)) {
+      if ((new_count >= osr_method_threshold_) &&
+          !code_cache_->IsOsrCompiled(method) &&
+          RegisterCompileTask(self, method, /* osr */ true)) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(self, new JitCompileTask(method, JitCompileTask::kCompileOsr));
+        thread_pool_->AddTask(
+            self,
+            new JitCompileTask(method, JitCompileTask::kCompileOsr, std::min(new_count, 0xffff)));
       }
     }
   }
@@ -677,13 +825,28 @@ void Jit::AddSamples(Thread* self, ArtMethod* method, uint16_t count, bool with_
   method->SetCounter(new_count);
 }
 
+void Jit::MaybeCompileOptimized(Thread* self, ArtMethod* method) {
+  if (thread_pool_ == nullptr || !use_jit_compilation_) {
+    return;
+  }
+  DCHECK(UseTieredCompilation());
+  if (code_cache_->IsBaselineCompiled(method->GetEntryPointFromQuickCompiledCode()) &&
+      RegisterCompileTask(self, method, /* osr */ false)) {
+    VLOG(jit) << "Optimizing baseline compiled method " << method->PrettyMethod();
+    thread_pool_->AddTask(self, new JitCompileTask(method, JitCompileTask::kCompile));
+  }
+}
+
 void Jit::MethodEntered(Thread* thread, ArtMethod* method) {
   Runtime* runtime = Runtime::Current();
   if (UNLIKELY(runtime->UseJitCompilation() && runtime->GetJit()->JitAtFirstUse())) {
     // The compiler requires a ProfilingInfo object.
     ProfilingInfo::Create(thread, method, /* retry_allocation */ true);
-    JitCompileTask compile_task(method, JitCompileTask::kCompile);
-    compile_task.Run(thread);
+    // Register the synchronous task like a queued one, JitCompileTask::Run() unregisters it.
+    if (RegisterCompileTask(thread, method, /* osr */ false)) {
+      JitCompileTask compile_task(method, JitCompileTask::kCompile);
+      compile_task.Run(thread);
+    }
     return;
   }
 
@@ -710,6 +873,14 @@ void Jit::InvokeVirtualOrInterface(ObjPtr<mirror::Object> this_object,
   }
 }
 
+void Jit::InvokeStaticOrDirect(ArtMethod* caller, uint32_t dex_pc) {
+  ScopedAssertNoThreadSuspension ants(__FUNCTION__);
+  ProfilingInfo* info = caller->GetProfilingInfo(kRuntimePointerSize);
+  if (info != nullptr) {
+    info->AddInvokeCount(dex_pc);
+  }
+}
+
 void Jit::WaitForCompilationToFinish(Thread* self) {
   if (thread_pool_ != nullptr) {
     thread_pool_->Wait(self, false, false);
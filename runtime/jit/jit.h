@@ -17,6 +17,8 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include <unordered_set>
+
 #include "base/arena_allocator.h"
 #include "base/histogram-inl.h"
 #include "base/macros.h"
@@ -54,12 +56,13 @@ class Jit {
   static constexpr size_t kDefaultCompileThreshold = kStressMode ? 2 : 10000;
   static constexpr size_t kDefaultPriorityThreadWeightRatio = 1000;
   static constexpr size_t kDefaultInvokeTransitionWeightRatio = 500;
+  static constexpr size_t kDefaultPoolThreads = 1;
   // How frequently should the interpreter check to see if OSR compilation is ready.
   static constexpr int16_t kJitRecheckOSRThreshold = 100;
 
   virtual ~Jit();
   static Jit* Create(JitOptions* options, std::string* error_msg);
-  bool CompileMethod(ArtMethod* method, Thread* self, bool osr)
+  bool CompileMethod(ArtMethod* method, Thread* self, bool osr, bool baseline = false)
       REQUIRES_SHARED(Locks::mutator_lock_);
   void CreateThreadPool();
 
@@ -94,6 +97,18 @@ class Jit {
     return warm_method_threshold_;
   }
 
+  // Number of method entries and loop back edges executed by baseline code before
+  // the method gets recompiled with all optimizations.
+  size_t OptimizeMethodThreshold() const {
+    return optimize_method_threshold_;
+  }
+
+  // Whether hot methods first get a quick baseline compilation, and are only optimized
+  // once they stay hot.
+  bool UseTieredCompilation() const {
+    return optimize_method_threshold_ != 0;
+  }
+
   uint16_t PriorityThreadWeight() const {
     return priority_thread_weight_;
   }
@@ -112,17 +127,26 @@ class Jit {
 
   // Profiling methods.
   void MethodEntered(Thread* thread, ArtMethod* method)
-      REQUIRES_SHARED(Locks::mutator_lock_);
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!lock_);
 
   void AddSamples(Thread* self, ArtMethod* method, uint16_t samples, bool with_backedges)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Called by baseline code of `method` when its hotness counter wraps around, that is when it
+  // reached the optimization threshold. Queue the optimized compilation of `method`.
+  void MaybeCompileOptimized(Thread* self, ArtMethod* method)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void InvokeVirtualOrInterface(ObjPtr<mirror::Object> this_object,
                                 ArtMethod* caller,
                                 uint32_t dex_pc,
                                 ArtMethod* callee)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record the execution of a static, direct or super invoke.
+  void InvokeStaticOrDirect(ArtMethod* caller, uint32_t dex_pc)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void NotifyInterpreterToCompiledCodeTransition(Thread* self, ArtMethod* caller)
       REQUIRES_SHARED(Locks::mutator_lock_) {
     AddSamples(self, caller, invoke_transition_weight_, false);
@@ -182,8 +206,16 @@ class Jit {
   void Start();
 
  private:
+  friend class JitCompileTask;
+
   Jit();
 
+  // Returns false if a task of the same kind is already queued for the method. Otherwise records
+  // it as queued and the queue depth.
+  bool RegisterCompileTask(Thread* self, ArtMethod* method, bool osr) REQUIRES(!lock_);
+  void UnregisterCompileTask(Thread* self, ArtMethod* method, bool osr, uint64_t wait_time_ns)
+      REQUIRES(!lock_);
+
   static bool LoadCompiler(std::string* error_msg);
 
   // JIT compiler
@@ -191,13 +223,20 @@ class Jit {
   static void* jit_compiler_handle_;
   static void* (*jit_load_)(bool*);
   static void (*jit_unload_)(void*);
-  static bool (*jit_compile_method_)(void*, ArtMethod*, Thread*, bool);
+  static bool (*jit_compile_method_)(void*, ArtMethod*, Thread*, bool, bool);
   static void (*jit_types_loaded_)(void*, mirror::Class**, size_t count);
 
   // Performance monitoring.
   bool dump_info_on_shutdown_;
   CumulativeLogger cumulative_timings_;
   Histogram<uint64_t> memory_use_ GUARDED_BY(lock_);
+  // Number of compile tasks queued or running when a new one is added.
+  Histogram<uint64_t> queue_depth_ GUARDED_BY(lock_);
+  // Time between adding a compile task and starting it.
+  Histogram<uint64_t> queue_wait_time_ GUARDED_BY(lock_);
+  // The methods with a queued or running compile task, to avoid queuing them again.
+  std::unordered_set<ArtMethod*> queued_methods_ GUARDED_BY(lock_);
+  std::unordered_set<ArtMethod*> queued_osr_methods_ GUARDED_BY(lock_);
   Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
   std::unique_ptr<jit::JitCodeCache> code_cache_;
@@ -208,8 +247,10 @@ class Jit {
   uint16_t hot_method_threshold_;
   uint16_t warm_method_threshold_;
   uint16_t osr_method_threshold_;
+  uint16_t optimize_method_threshold_;
   uint16_t priority_thread_weight_;
   uint16_t invoke_transition_weight_;
+  size_t thread_pool_size_;
   std::unique_ptr<ThreadPool> thread_pool_;
 
   DISALLOW_COPY_AND_ASSIGN(Jit);
@@ -227,6 +268,9 @@ class JitOptions {
   size_t GetOsrThreshold() const {
     return osr_threshold_;
   }
+  size_t GetOptimizeThreshold() const {
+    return optimize_threshold_;
+  }
   uint16_t GetPriorityThreadWeight() const {
     return priority_thread_weight_;
   }
@@ -236,12 +280,20 @@ class JitOptions {
   size_t GetCodeCacheInitialCapacity() const {
     return code_cache_initial_capacity_;
   }
+  size_t GetThreadPoolSize() const {
+    return thread_pool_size_;
+  }
   size_t GetCodeCacheMaxCapacity() const {
     return code_cache_max_capacity_;
   }
   bool DumpJitInfoOnShutdown() const {
     return dump_info_on_shutdown_;
   }
+  // File where compiled code is saved for, and loaded from, other runs. Empty if compiled
+  // code is not persisted.
+  const std::string& GetPersistentCacheFile() const {
+    return persistent_cache_file_;
+  }
   const ProfileSaverOptions& GetProfileSaverOptions() const {
     return profile_saver_options_;
   }
@@ -269,9 +321,12 @@ class JitOptions {
   size_t compile_threshold_;
   size_t warmup_threshold_;
   size_t osr_threshold_;
+  size_t optimize_threshold_;
   uint16_t priority_thread_weight_;
   size_t invoke_transition_weight_;
+  size_t thread_pool_size_;
   bool dump_info_on_shutdown_;
+  std::string persistent_cache_file_;
   ProfileSaverOptions profile_saver_options_;
 
   JitOptions()
@@ -281,8 +336,10 @@ class JitOptions {
         compile_threshold_(0),
         warmup_threshold_(0),
         osr_threshold_(0),
+        optimize_threshold_(0),
         priority_thread_weight_(0),
         invoke_transition_weight_(0),
+        thread_pool_size_(0),
         dump_info_on_shutdown_(false) {}
 
   DISALLOW_COPY_AND_ASSIGN(JitOptions);
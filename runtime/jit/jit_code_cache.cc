@@ -19,19 +19,24 @@
 #include <sstream>
 
 #include "art_method-inl.h"
+#include "base/arena_allocator.h"
 #include "base/enums.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
 #include "base/time_utils.h"
 #include "cha.h"
+#include "class_linker.h"
 #include "debugger_interface.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
 #include "gc/accounting/bitmap-inl.h"
+#include "gc/allocator/dlmalloc.h"
 #include "gc/scoped_gc_critical_section.h"
+#include "handle_scope-inl.h"
 #include "jit/jit.h"
 #include "jit/profiling_info.h"
 #include "linear_alloc.h"
 #include "mem_map.h"
+#include "mirror/object_array-inl.h"
 #include "oat_file-inl.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread_list.h"
@@ -149,8 +154,14 @@ JitCodeCache::JitCodeCache(MemMap* code_map,
       used_memory_for_code_(0),
       number_of_compilations_(0),
       number_of_osr_compilations_(0),
+      number_of_baseline_compilations_(0),
       number_of_deoptimizations_(0),
       number_of_collections_(0),
+      number_of_full_collections_(0),
+      hot_generation_methods_(0),
+      hot_generation_code_size_(0),
+      released_memory_(0),
+      number_of_persisted_installs_(0),
       histogram_stack_map_memory_use_("Memory used for stack maps", 16),
       histogram_code_memory_use_("Memory used for compiled code", 16),
       histogram_profiling_info_memory_use_("Memory used for profiling info", 16),
@@ -220,6 +231,7 @@ uint8_t* JitCodeCache::CommitCode(Thread* self,
                                   size_t code_size,
                                   size_t data_size,
                                   bool osr,
+                                  bool baseline,
                                   Handle<mirror::ObjectArray<mirror::Object>> roots,
                                   bool has_should_deoptimize_flag,
                                   const ArenaSet<ArtMethod*>& cha_single_implementation_list) {
@@ -235,6 +247,7 @@ uint8_t* JitCodeCache::CommitCode(Thread* self,
                                        code_size,
                                        data_size,
                                        osr,
+                                       baseline,
                                        roots,
                                        has_should_deoptimize_flag,
                                        cha_single_implementation_list);
@@ -253,6 +266,7 @@ uint8_t* JitCodeCache::CommitCode(Thread* self,
                                 code_size,
                                 data_size,
                                 osr,
+                                baseline,
                                 roots,
                                 has_should_deoptimize_flag,
                                 cha_single_implementation_list);
@@ -260,6 +274,136 @@ uint8_t* JitCodeCache::CommitCode(Thread* self,
   return result;
 }
 
+void JitCodeCache::PersistCode(Thread* self,
+                               ArtMethod* method,
+                               const uint8_t* stack_map,
+                               size_t stack_map_size,
+                               const uint8_t* method_info,
+                               size_t method_info_size,
+                               size_t frame_size_in_bytes,
+                               size_t core_spill_mask,
+                               size_t fp_spill_mask,
+                               const uint8_t* code,
+                               size_t code_size,
+                               const std::vector<JitRootReference>& roots,
+                               const std::vector<JitRootPatch>& root_patches,
+                               bool has_should_deoptimize_flag,
+                               const ArenaSet<ArtMethod*>& cha_single_implementation_list,
+                               const std::vector<JitClassReference>& initialized_classes) {
+  DCHECK(IsPersistent());
+  if (!persistent_code_cache_->AddMethod(self,
+                                         method,
+                                         stack_map,
+                                         stack_map_size,
+                                         method_info,
+                                         method_info_size,
+                                         frame_size_in_bytes,
+                                         core_spill_mask,
+                                         fp_spill_mask,
+                                         code,
+                                         code_size,
+                                         roots,
+                                         root_patches,
+                                         has_should_deoptimize_flag,
+                                         cha_single_implementation_list,
+                                         initialized_classes)) {
+    VLOG(jit) << "Could not persist the compiled code of " << method->PrettyMethod();
+  }
+}
+
+bool JitCodeCache::InstallPersistedCode(Thread* self, ArtMethod* method) {
+  if (persistent_code_cache_ == nullptr) {
+    return false;
+  }
+  PersistedMethod persisted;
+  if (!persistent_code_cache_->FindMethod(method, &persisted)) {
+    return false;
+  }
+  // The code may have been compiled without class initialization checks for the
+  // declaring class and its superclasses.
+  if (!method->GetDeclaringClass()->IsInitialized()) {
+    return false;
+  }
+  // It may also have been compiled without class initialization checks for boot class path
+  // classes that were initialized in the run that compiled it.
+  if (!PersistentCodeCache::AreClassesInitialized(method, persisted)) {
+    VLOG(jit) << "Cannot install persisted code of " << method->PrettyMethod()
+              << ": uninitialized classes";
+    return false;
+  }
+
+  StackHandleScope<1> hs(self);
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  size_t number_of_roots = persisted.roots.size();
+  Handle<mirror::ObjectArray<mirror::Object>> roots(
+      hs.NewHandle(mirror::ObjectArray<mirror::Object>::Alloc(
+          self, class_linker->GetClassRoot(ClassLinker::kObjectArrayClass), number_of_roots)));
+  if (roots == nullptr) {
+    // Out of memory, just clear the exception to avoid any Java exception uncaught problems.
+    DCHECK(self->IsExceptionPending());
+    self->ClearException();
+    return false;
+  }
+  if (!PersistentCodeCache::ResolveRoots(method, persisted, roots)) {
+    VLOG(jit) << "Cannot install persisted code of " << method->PrettyMethod()
+              << ": unresolved roots";
+    return false;
+  }
+  ArenaAllocator arena(Runtime::Current()->GetArenaPool());
+  ArenaSet<ArtMethod*> cha_single_implementation_list(std::less<ArtMethod*>(),
+                                                      arena.Adapter(kArenaAllocCHA));
+  if (!PersistentCodeCache::ResolveChaAssumptions(
+          method, persisted, &cha_single_implementation_list)) {
+    VLOG(jit) << "Cannot install persisted code of " << method->PrettyMethod()
+              << ": invalid class hierarchy assumptions";
+    return false;
+  }
+
+  uint8_t* stack_map_data = nullptr;
+  uint8_t* method_info_data = nullptr;
+  uint8_t* roots_data = nullptr;
+  size_t data_size = ReserveData(self,
+                                 persisted.stack_map.size(),
+                                 persisted.method_info.size(),
+                                 number_of_roots,
+                                 method,
+                                 &stack_map_data,
+                                 &method_info_data,
+                                 &roots_data);
+  if (stack_map_data == nullptr || roots_data == nullptr) {
+    return false;
+  }
+  memcpy(stack_map_data, persisted.stack_map.data(), persisted.stack_map.size());
+  memcpy(method_info_data, persisted.method_info.data(), persisted.method_info.size());
+  std::vector<uint8_t> code(persisted.code.begin(), persisted.code.end());
+  PersistentCodeCache::PatchRoots(persisted, code.data(), roots_data);
+
+  uint8_t* result = CommitCode(self,
+                               method,
+                               stack_map_data,
+                               method_info_data,
+                               roots_data,
+                               persisted.frame_size_in_bytes,
+                               persisted.core_spill_mask,
+                               persisted.fp_spill_mask,
+                               code.data(),
+                               code.size(),
+                               data_size,
+                               /* osr */ false,
+                               /* baseline */ false,
+                               roots,
+                               persisted.has_should_deoptimize_flag,
+                               cha_single_implementation_list);
+  if (result == nullptr) {
+    ClearData(self, stack_map_data, roots_data);
+    return false;
+  }
+  VLOG(jit) << "Installed persisted code of " << method->PrettyMethod();
+  MutexLock mu(self, lock_);
+  number_of_persisted_installs_++;
+  return true;
+}
+
 bool JitCodeCache::WaitForPotentialCollectionToComplete(Thread* self) {
   bool in_collection = false;
   while (collection_in_progress_) {
@@ -394,6 +538,7 @@ void JitCodeCache::FreeCode(const void* code_ptr) {
   DeleteJITCodeEntryForAddress(reinterpret_cast<uintptr_t>(code_ptr));
   FreeData(GetRootTable(code_ptr));
   FreeCode(reinterpret_cast<uint8_t*>(allocation));
+  baseline_code_.erase(code_ptr);
 }
 
 void JitCodeCache::FreeAllMethodHeaders(
@@ -496,7 +641,8 @@ void JitCodeCache::DisallowInlineCacheAccess() {
 }
 
 void JitCodeCache::CopyInlineCacheInto(const InlineCache& ic,
-                                       Handle<mirror::ObjectArray<mirror::Class>> array) {
+                                       Handle<mirror::ObjectArray<mirror::Class>> array,
+                                       /*out*/ uint32_t* class_counts) {
   WaitUntilInlineCacheAccessible(Thread::Current());
   // Note that we don't need to lock `lock_` here, the compiler calling
   // this method has already ensured the inline cache will not be deleted.
@@ -505,6 +651,9 @@ void JitCodeCache::CopyInlineCacheInto(const InlineCache& ic,
        ++in_cache) {
     mirror::Class* object = ic.classes_[in_cache].Read();
     if (object != nullptr) {
+      if (class_counts != nullptr) {
+        class_counts[in_array] = ic.class_counts_[in_cache];
+      }
       array->Set(in_array++, object);
     }
   }
@@ -522,11 +671,13 @@ uint8_t* JitCodeCache::CommitCodeInternal(Thread* self,
                                           size_t code_size,
                                           size_t data_size,
                                           bool osr,
+                                          bool baseline,
                                           Handle<mirror::ObjectArray<mirror::Object>> roots,
                                           bool has_should_deoptimize_flag,
                                           const ArenaSet<ArtMethod*>&
                                               cha_single_implementation_list) {
   DCHECK(stack_map != nullptr);
+  DCHECK(!osr || !baseline);
   size_t alignment = GetInstructionSetAlignment(kRuntimeISA);
   // Ensure the header ends up at expected instruction alignment.
   size_t header_size = RoundUp(sizeof(OatQuickMethodHeader), alignment);
@@ -616,6 +767,10 @@ uint8_t* JitCodeCache::CommitCodeInternal(Thread* self,
     // Fill the root table before updating the entry point.
     DCHECK_EQ(FromStackMapToRoots(stack_map), roots_data);
     FillRootTable(roots_data, roots);
+    if (baseline) {
+      number_of_baseline_compilations_++;
+      baseline_code_.insert(code_ptr);
+    }
     if (osr) {
       number_of_osr_compilations_++;
       osr_code_map_.Put(method, code_ptr);
@@ -630,7 +785,8 @@ uint8_t* JitCodeCache::CommitCodeInternal(Thread* self,
     }
     last_update_time_ns_.StoreRelease(NanoTime());
     VLOG(jit)
-        << "JIT added (osr=" << std::boolalpha << osr << std::noboolalpha << ") "
+        << "JIT added (osr=" << std::boolalpha << osr << ", baseline=" << baseline
+        << std::noboolalpha << ") "
         << ArtMethod::PrettyMethod(method) << "@" << method
         << " ccache_size=" << PrettySize(CodeCacheSizeLocked()) << ": "
         << " dcache_size=" << PrettySize(DataCacheSizeLocked()) << ": "
@@ -967,6 +1123,11 @@ void JitCodeCache::GarbageCollectCache(Thread* self) {
 
     DoCollection(self, /* collect_profiling_info */ do_full_collection);
 
+    {
+      MutexLock mu(self, lock_);
+      ReleaseFreePages();
+    }
+
     if (!kIsDebugBuild || VLOG_IS_ON(jit)) {
       LOG(INFO) << "After code cache collection, code="
                 << PrettySize(CodeCacheSize())
@@ -989,22 +1150,7 @@ void JitCodeCache::GarbageCollectCache(Thread* self) {
 
       // Start polling the liveness of compiled code to prepare for the next full collection.
       if (next_collection_will_be_full) {
-        // Save the entry point of methods we have compiled, and update the entry
-        // point of those methods to the interpreter. If the method is invoked, the
-        // interpreter will update its entry point to the compiled code and call it.
-        for (ProfilingInfo* info : profiling_infos_) {
-          const void* entry_point = info->GetMethod()->GetEntryPointFromQuickCompiledCode();
-          if (ContainsPc(entry_point)) {
-            info->SetSavedEntryPoint(entry_point);
-            // Don't call Instrumentation::UpdateMethods, as it can check the declaring
-            // class of the method. We may be concurrently running a GC which makes accessing
-            // the class unsafe. We know it is OK to bypass the instrumentation as we've just
-            // checked that the current entry point is JIT compiled code.
-            info->GetMethod()->SetEntryPointFromQuickCompiledCode(GetQuickToInterpreterBridge());
-          }
-        }
-
-        DCHECK(CheckLiveCompiledCodeHasProfilingInfo());
+        PrepareFullCollection();
       }
       live_bitmap_.reset(nullptr);
       NotifyCollectionDone(self);
@@ -1013,6 +1159,55 @@ void JitCodeCache::GarbageCollectCache(Thread* self) {
   Runtime::Current()->GetJit()->AddTimingLogger(logger);
 }
 
+void JitCodeCache::PrepareFullCollection() {
+  // Methods whose compiled code kept being used across the last full collections form the
+  // hot generation. We do not poll them, as doing so sends them through the interpreter
+  // bridge once more for code that is very likely to be kept anyway. Every few full
+  // collections the hot generation is polled too, so that code that became cold
+  // eventually gets collected.
+  size_t hot_generation_budget =
+      ((number_of_full_collections_ + 1) % kHotGenerationCollectionInterval == 0)
+          ? 0u
+          : (current_capacity_ / 2) / kHotGenerationCapacityRatio;
+  hot_generation_methods_ = 0;
+  hot_generation_code_size_ = 0;
+  // Save the entry point of methods we have compiled, and update the entry
+  // point of those methods to the interpreter. If the method is invoked, the
+  // interpreter will update its entry point to the compiled code and call it.
+  for (ProfilingInfo* info : profiling_infos_) {
+    const void* entry_point = info->GetMethod()->GetEntryPointFromQuickCompiledCode();
+    if (ContainsPc(entry_point)) {
+      if (info->GetSurvivedCollections() >= kHotGenerationThreshold) {
+        size_t code_size = OatQuickMethodHeader::FromEntryPoint(entry_point)->GetCodeSize();
+        if (hot_generation_code_size_ + code_size <= hot_generation_budget) {
+          hot_generation_code_size_ += code_size;
+          ++hot_generation_methods_;
+          continue;
+        }
+      }
+      info->SetSavedEntryPoint(entry_point);
+      // Don't call Instrumentation::UpdateMethods, as it can check the declaring
+      // class of the method. We may be concurrently running a GC which makes accessing
+      // the class unsafe. We know it is OK to bypass the instrumentation as we've just
+      // checked that the current entry point is JIT compiled code.
+      info->GetMethod()->SetEntryPointFromQuickCompiledCode(GetQuickToInterpreterBridge());
+    }
+  }
+
+  DCHECK(CheckLiveCompiledCodeHasProfilingInfo());
+}
+
+void JitCodeCache::ReleaseFreePages() {
+  // Compiled code cannot be moved to compact the cache: thread stacks hold return
+  // addresses into it, and it reaches its roots with PC-relative loads. Instead, give
+  // back the pages that collections left free in the middle of the mspaces.
+  ScopedTrace trace(__FUNCTION__);
+  size_t reclaimed = 0;
+  mspace_inspect_all(data_mspace_, DlmallocMadviseCallback, &reclaimed);
+  mspace_inspect_all(code_mspace_, DlmallocMadviseCallback, &reclaimed);
+  released_memory_ += reclaimed;
+}
+
 void JitCodeCache::RemoveUnmarkedCode(Thread* self) {
   ScopedTrace trace(__FUNCTION__);
   std::unordered_set<OatQuickMethodHeader*> method_headers;
@@ -1039,12 +1234,19 @@ void JitCodeCache::DoCollection(Thread* self, bool collect_profiling_info) {
   {
     MutexLock mu(self, lock_);
     if (collect_profiling_info) {
+      number_of_full_collections_++;
       // Clear the profiling info of methods that do not have compiled code as entrypoint.
       // Also remove the saved entry point from the ProfilingInfo objects.
       for (ProfilingInfo* info : profiling_infos_) {
         const void* ptr = info->GetMethod()->GetEntryPointFromQuickCompiledCode();
-        if (!ContainsPc(ptr) && !info->IsInUseByCompiler()) {
-          info->GetMethod()->SetProfilingInfo(nullptr);
+        if (ContainsPc(ptr)) {
+          // The compiled code was either revived or not polled, and survives this collection.
+          info->IncrementSurvivedCollections();
+        } else {
+          info->ResetSurvivedCollections();
+          if (!info->IsInUseByCompiler()) {
+            info->GetMethod()->SetProfilingInfo(nullptr);
+          }
         }
 
         if (info->GetSavedEntryPoint() != nullptr) {
@@ -1090,9 +1292,18 @@ void JitCodeCache::DoCollection(Thread* self, bool collect_profiling_info) {
   if (collect_profiling_info) {
     ScopedThreadSuspension sts(self, kSuspended);
     MutexLock mu(self, lock_);
+    // Baseline code updates the inline caches of the ProfilingInfo it was compiled with, so
+    // keep the profiling infos of methods that still have baseline code in the cache.
+    std::unordered_set<ArtMethod*> methods_with_baseline_code;
+    for (const void* code_ptr : baseline_code_) {
+      auto it = method_code_map_.find(code_ptr);
+      if (it != method_code_map_.end()) {
+        methods_with_baseline_code.insert(it->second);
+      }
+    }
     // Free all profiling infos of methods not compiled nor being compiled.
     auto profiling_kept_end = std::remove_if(profiling_infos_.begin(), profiling_infos_.end(),
-      [this] (ProfilingInfo* info) NO_THREAD_SAFETY_ANALYSIS {
+      [this, &methods_with_baseline_code] (ProfilingInfo* info) NO_THREAD_SAFETY_ANALYSIS {
         const void* ptr = info->GetMethod()->GetEntryPointFromQuickCompiledCode();
         // We have previously cleared the ProfilingInfo pointer in the ArtMethod in the hope
         // that the compiled code would not get revived. As mutator threads run concurrently,
@@ -1104,6 +1315,11 @@ void JitCodeCache::DoCollection(Thread* self, bool collect_profiling_info) {
             info->GetMethod()->GetProfilingInfo(kRuntimePointerSize) == nullptr) {
           info->GetMethod()->SetProfilingInfo(info);
         } else if (info->GetMethod()->GetProfilingInfo(kRuntimePointerSize) != info) {
+          if (methods_with_baseline_code.find(info->GetMethod()) !=
+              methods_with_baseline_code.end()) {
+            // Baseline code of the method may still write to this ProfilingInfo.
+            return false;
+          }
           // No need for this ProfilingInfo object anymore.
           FreeData(reinterpret_cast<uint8_t*>(info));
           return true;
@@ -1186,6 +1402,7 @@ OatQuickMethodHeader* JitCodeCache::LookupOsrMethodHeader(ArtMethod* method) {
 ProfilingInfo* JitCodeCache::AddProfilingInfo(Thread* self,
                                               ArtMethod* method,
                                               const std::vector<uint32_t>& entries,
+                                              const std::vector<uint32_t>& invoke_count_entries,
                                               bool retry_allocation)
     // No thread safety analysis as we are using TryLock/Unlock explicitly.
     NO_THREAD_SAFETY_ANALYSIS {
@@ -1194,29 +1411,31 @@ ProfilingInfo* JitCodeCache::AddProfilingInfo(Thread* self,
     // If we are allocating for the interpreter, just try to lock, to avoid
     // lock contention with the JIT.
     if (lock_.ExclusiveTryLock(self)) {
-      info = AddProfilingInfoInternal(self, method, entries);
+      info = AddProfilingInfoInternal(self, method, entries, invoke_count_entries);
       lock_.ExclusiveUnlock(self);
     }
   } else {
     {
       MutexLock mu(self, lock_);
-      info = AddProfilingInfoInternal(self, method, entries);
+      info = AddProfilingInfoInternal(self, method, entries, invoke_count_entries);
     }
 
     if (info == nullptr) {
       GarbageCollectCache(self);
       MutexLock mu(self, lock_);
-      info = AddProfilingInfoInternal(self, method, entries);
+      info = AddProfilingInfoInternal(self, method, entries, invoke_count_entries);
     }
   }
   return info;
 }
 
-ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNUSED,
-                                                      ArtMethod* method,
-                                                      const std::vector<uint32_t>& entries) {
+ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(
+    Thread* self ATTRIBUTE_UNUSED,
+    ArtMethod* method,
+    const std::vector<uint32_t>& entries,
+    const std::vector<uint32_t>& invoke_count_entries) {
   size_t profile_info_size = RoundUp(
-      sizeof(ProfilingInfo) + sizeof(InlineCache) * entries.size(),
+      ProfilingInfo::ComputeSize(entries.size(), invoke_count_entries.size()),
       sizeof(void*));
 
   // Check whether some other thread has concurrently created it.
@@ -1229,7 +1448,7 @@ ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNU
   if (data == nullptr) {
     return nullptr;
   }
-  info = new (data) ProfilingInfo(method, entries);
+  info = new (data) ProfilingInfo(method, entries, invoke_count_entries);
 
   // Make sure other threads see the data in the profiling info object before the
   // store in the ArtMethod's ProfilingInfo pointer.
@@ -1268,8 +1487,15 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
       continue;
     }
     std::vector<ProfileMethodInfo::ProfileInlineCache> inline_caches;
+    std::vector<ProfileMethodInfo::ProfileInvokeCount> invoke_counts;
+    info->VisitInvokeCounts([&invoke_counts](uint32_t dex_pc, uint32_t count) {
+      if (count != 0) {
+        invoke_counts.emplace_back(/*ProfileMethodInfo::ProfileInvokeCount*/ dex_pc, count);
+      }
+    });
     for (size_t i = 0; i < info->number_of_inline_caches_; ++i) {
       std::vector<ProfileMethodInfo::ProfileClassReference> profile_classes;
+      std::vector<uint32_t> receiver_counts;
       const InlineCache& cache = info->cache_[i];
       ArtMethod* caller = info->GetMethod();
       bool is_missing_types = false;
@@ -1311,17 +1537,18 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
           // Only consider classes from the same apk (including multidex).
           profile_classes.emplace_back(/*ProfileMethodInfo::ProfileClassReference*/
               class_dex_file, type_index);
+          receiver_counts.push_back(cache.class_counts_[k]);
         } else {
           is_missing_types = true;
         }
       }
       if (!profile_classes.empty()) {
         inline_caches.emplace_back(/*ProfileMethodInfo::ProfileInlineCache*/
-            cache.dex_pc_, is_missing_types, profile_classes);
+            cache.dex_pc_, is_missing_types, profile_classes, receiver_counts);
       }
     }
     methods.emplace_back(/*ProfileMethodInfo*/
-        dex_file, method->GetDexMethodIndex(), inline_caches);
+        dex_file, method->GetDexMethodIndex(), inline_caches, invoke_counts);
   }
 }
 
@@ -1334,8 +1561,17 @@ bool JitCodeCache::IsOsrCompiled(ArtMethod* method) {
   return osr_code_map_.find(method) != osr_code_map_.end();
 }
 
-bool JitCodeCache::NotifyCompilationOf(ArtMethod* method, Thread* self, bool osr) {
-  if (!osr && ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
+bool JitCodeCache::IsBaselineCompiled(const void* entry_point) {
+  if (!ContainsPc(entry_point)) {
+    return false;
+  }
+  MutexLock mu(Thread::Current(), lock_);
+  return baseline_code_.find(EntryPointToCodePointer(entry_point)) != baseline_code_.end();
+}
+
+bool JitCodeCache::NotifyCompilationOf(ArtMethod* method, Thread* self, bool osr, bool baseline) {
+  const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
+  if (!osr && ContainsPc(entry_point) && (baseline || !IsBaselineCompiled(entry_point))) {
     return false;
   }
 
@@ -1448,6 +1684,9 @@ void JitCodeCache::FreeData(uint8_t* data) {
 }
 
 void JitCodeCache::Dump(std::ostream& os) {
+  // Read outside of `lock_`, as the persistent code cache has its own lock.
+  size_t persisted_methods_added =
+      (persistent_code_cache_ != nullptr) ? persistent_code_cache_->GetNumberOfAddedMethods() : 0u;
   MutexLock mu(Thread::Current(), lock_);
   os << "Current JIT code cache size: " << PrettySize(used_memory_for_code_) << "\n"
      << "Current JIT data cache size: " << PrettySize(used_memory_for_data_) << "\n"
@@ -1456,8 +1695,21 @@ void JitCodeCache::Dump(std::ostream& os) {
      << "Total number of JIT compilations: " << number_of_compilations_ << "\n"
      << "Total number of JIT compilations for on stack replacement: "
         << number_of_osr_compilations_ << "\n"
+     << "Total number of JIT baseline compilations: "
+        << number_of_baseline_compilations_ << "\n"
      << "Total number of deoptimizations: " << number_of_deoptimizations_ << "\n"
-     << "Total number of JIT code cache collections: " << number_of_collections_ << std::endl;
+     << "Total number of JIT code cache collections: " << number_of_collections_ << "\n"
+     << "Total number of full JIT code cache collections: "
+        << number_of_full_collections_ << "\n"
+     << "JIT hot generation: " << hot_generation_methods_ << " methods, "
+        << PrettySize(hot_generation_code_size_) << "\n"
+     << "Total JIT code cache memory released: " << PrettySize(released_memory_) << "\n";
+  if (persistent_code_cache_ != nullptr) {
+    os << "Persistent JIT code cache: " << persistent_code_cache_->GetNumberOfLoadedMethods()
+       << " methods loaded, " << number_of_persisted_installs_ << " installed, "
+       << persisted_methods_added << " added\n";
+  }
+  os << std::flush;
   histogram_stack_map_memory_use_.PrintMemoryUse(os);
   histogram_code_memory_use_.PrintMemoryUse(os);
   histogram_profiling_info_memory_use_.PrintMemoryUse(os);
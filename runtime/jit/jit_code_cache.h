@@ -26,6 +26,7 @@
 #include "base/mutex.h"
 #include "gc/accounting/bitmap.h"
 #include "gc_root.h"
+#include "jit/persistent_code_cache.h"
 #include "jni.h"
 #include "method_reference.h"
 #include "oat_file.h"
@@ -59,6 +60,16 @@ class JitCodeCache {
   // By default, do not GC until reaching 256KB.
   static constexpr size_t kReservedCapacity = kInitialCapacity * 4;
 
+  // Compiled code that survived this many consecutive full collections by being used is
+  // promoted to the hot generation, whose liveness is not polled before a full collection.
+  static constexpr uint8_t kHotGenerationThreshold = 2;
+
+  // Every that many full collections, the hot generation is polled and collected as well.
+  static constexpr size_t kHotGenerationCollectionInterval = 4;
+
+  // The hot generation may use at most half of the code capacity.
+  static constexpr size_t kHotGenerationCapacityRatio = 2;
+
   // Create the code cache with a code + data capacity equal to "capacity", error message is passed
   // in the out arg error_msg.
   static JitCodeCache* Create(size_t initial_capacity,
@@ -72,7 +83,9 @@ class JitCodeCache {
   // Number of bytes allocated in the data cache.
   size_t DataCacheSize() REQUIRES(!lock_);
 
-  bool NotifyCompilationOf(ArtMethod* method, Thread* self, bool osr)
+  // Return whether `method` should be compiled. An optimized compilation is
+  // allowed for a method whose entry point is JIT baseline code.
+  bool NotifyCompilationOf(ArtMethod* method, Thread* self, bool osr, bool baseline)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!lock_);
 
@@ -114,12 +127,53 @@ class JitCodeCache {
                       size_t code_size,
                       size_t data_size,
                       bool osr,
+                      bool baseline,
                       Handle<mirror::ObjectArray<mirror::Object>> roots,
                       bool has_should_deoptimize_flag,
                       const ArenaSet<ArtMethod*>& cha_single_implementation_list)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!lock_);
 
+  // Whether compiled code is also stored in a persistent code cache. The compiler then
+  // restricts itself to code that can be installed in later runs.
+  bool IsPersistent() const {
+    return persistent_code_cache_ != nullptr;
+  }
+
+  // Take ownership of `persistent_code_cache`. Must be called before the JIT compiles.
+  void SetPersistentCodeCache(PersistentCodeCache* persistent_code_cache) {
+    persistent_code_cache_.reset(persistent_code_cache);
+  }
+
+  // Store the compiled code of `method` in the persistent code cache. `code` has its root
+  // table uses at `root_patches`, and `roots` are the references of its root table.
+  // `initialized_classes` are the classes `code` assumes to be initialized.
+  void PersistCode(Thread* self,
+                   ArtMethod* method,
+                   const uint8_t* stack_map,
+                   size_t stack_map_size,
+                   const uint8_t* method_info,
+                   size_t method_info_size,
+                   size_t frame_size_in_bytes,
+                   size_t core_spill_mask,
+                   size_t fp_spill_mask,
+                   const uint8_t* code,
+                   size_t code_size,
+                   const std::vector<JitRootReference>& roots,
+                   const std::vector<JitRootPatch>& root_patches,
+                   bool has_should_deoptimize_flag,
+                   const ArenaSet<ArtMethod*>& cha_single_implementation_list,
+                   const std::vector<JitClassReference>& initialized_classes)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Install the code of `method` found in the persistent code cache, if any. Returns
+  // false if there is none, or if it cannot be used in this run, in which case the
+  // method needs to be compiled.
+  bool InstallPersistedCode(Thread* self, ArtMethod* method)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
   // Return true if the code cache contains this pc.
   bool ContainsPc(const void* pc) const;
 
@@ -175,7 +229,11 @@ class JitCodeCache {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  void CopyInlineCacheInto(const InlineCache& ic, Handle<mirror::ObjectArray<mirror::Class>> array)
+  // Copy the classes of `ic` into `array`, and if `class_counts` is not null, how often
+  // each of them was seen as receiver into `class_counts`, in the same order.
+  void CopyInlineCacheInto(const InlineCache& ic,
+                           Handle<mirror::ObjectArray<mirror::Class>> array,
+                           /*out*/ uint32_t* class_counts = nullptr)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -184,6 +242,7 @@ class JitCodeCache {
   ProfilingInfo* AddProfilingInfo(Thread* self,
                                   ArtMethod* method,
                                   const std::vector<uint32_t>& entries,
+                                  const std::vector<uint32_t>& invoke_count_entries,
                                   bool retry_allocation)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -217,6 +276,9 @@ class JitCodeCache {
 
   bool IsOsrCompiled(ArtMethod* method) REQUIRES(!lock_);
 
+  // Return whether `entry_point` is the entry point of JIT baseline code.
+  bool IsBaselineCompiled(const void* entry_point) REQUIRES(!lock_);
+
   void SweepRootTables(IsMarkedVisitor* visitor)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -261,6 +323,7 @@ class JitCodeCache {
                               size_t code_size,
                               size_t data_size,
                               bool osr,
+                              bool baseline,
                               Handle<mirror::ObjectArray<mirror::Object>> roots,
                               bool has_should_deoptimize_flag,
                               const ArenaSet<ArtMethod*>& cha_single_implementation_list)
@@ -269,7 +332,8 @@ class JitCodeCache {
 
   ProfilingInfo* AddProfilingInfoInternal(Thread* self,
                                           ArtMethod* method,
-                                          const std::vector<uint32_t>& entries)
+                                          const std::vector<uint32_t>& entries,
+                                          const std::vector<uint32_t>& invoke_count_entries)
       REQUIRES(lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -286,6 +350,14 @@ class JitCodeCache {
   // Free in the mspace allocations for `code_ptr`.
   void FreeCode(const void* code_ptr) REQUIRES(lock_);
 
+  // Give back the pages of free chunks in the code and data mspaces to the kernel, so
+  // that the resident cache stays dense after collections.
+  void ReleaseFreePages() REQUIRES(lock_);
+
+  // Before a full collection, set the entry point of compiled methods outside the hot
+  // generation to the interpreter to poll whether they are still used.
+  void PrepareFullCollection() REQUIRES(lock_);
+
   // Number of bytes allocated in the code cache.
   size_t CodeCacheSizeLocked() REQUIRES(lock_);
 
@@ -347,6 +419,9 @@ class JitCodeCache {
   SafeMap<const void*, ArtMethod*> method_code_map_ GUARDED_BY(lock_);
   // Holds osr compiled code associated to the ArtMethod.
   SafeMap<ArtMethod*, const void*> osr_code_map_ GUARDED_BY(lock_);
+  // Holds the code pointers of baseline compiled code, which gets replaced by an
+  // optimized compilation once the method stays hot.
+  std::unordered_set<const void*> baseline_code_ GUARDED_BY(lock_);
   // ProfilingInfo objects we have allocated.
   std::vector<ProfilingInfo*> profiling_infos_ GUARDED_BY(lock_);
 
@@ -384,12 +459,32 @@ class JitCodeCache {
   // Number of compilations for on-stack-replacement done throughout the lifetime of the JIT.
   size_t number_of_osr_compilations_ GUARDED_BY(lock_);
 
+  // Number of baseline compilations done throughout the lifetime of the JIT.
+  size_t number_of_baseline_compilations_ GUARDED_BY(lock_);
+
   // Number of deoptimizations done throughout the lifetime of the JIT.
   size_t number_of_deoptimizations_ GUARDED_BY(lock_);
 
   // Number of code cache collections done throughout the lifetime of the JIT.
   size_t number_of_collections_ GUARDED_BY(lock_);
 
+  // Number of full code cache collections done throughout the lifetime of the JIT.
+  size_t number_of_full_collections_ GUARDED_BY(lock_);
+
+  // Number of methods and bytes of code kept in the hot generation when polling
+  // for the last full collection.
+  size_t hot_generation_methods_ GUARDED_BY(lock_);
+  size_t hot_generation_code_size_ GUARDED_BY(lock_);
+
+  // Bytes of free code and data cache pages given back to the kernel after collections.
+  size_t released_memory_ GUARDED_BY(lock_);
+
+  // Number of methods installed from the persistent code cache.
+  size_t number_of_persisted_installs_ GUARDED_BY(lock_);
+
+  // Compiled code from earlier runs, and where to store the code compiled in this one.
+  std::unique_ptr<PersistentCodeCache> persistent_code_cache_;
+
   // Histograms for keeping track of stack map size statistics.
   Histogram<uint64_t> histogram_stack_map_memory_use_ GUARDED_BY(lock_);
 
@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "persistent_code_cache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <zlib.h>
+
+#include "arch/instruction_set_features.h"
+#include "art_method-inl.h"
+#include "base/casts.h"
+#include "base/logging.h"
+#include "class_linker.h"
+#include "dex_file-inl.h"
+#include "gc/heap.h"
+#include "gc/space/image_space.h"
+#include "gc_root.h"
+#include "intern_table.h"
+#include "method_info.h"
+#include "mirror/class-inl.h"
+#include "mirror/dex_cache.h"
+#include "mirror/object_array-inl.h"
+#include "oat_file.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "stack_map.h"
+#include "thread-current-inl.h"
+
+namespace art {
+namespace jit {
+
+static constexpr uint8_t kMagic[] = { 'j', 'p', 'c', '\n' };
+static constexpr uint8_t kVersion[] = { '0', '0', '2', '\0' };
+
+// Size of the header of a method entry: the size of the payload, and its adler32 checksum.
+static constexpr size_t kEntryHeaderSize = 2 * sizeof(uint32_t);
+
+static void AddUint32(std::vector<uint8_t>* buffer, uint32_t value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer->insert(buffer->end(), bytes, bytes + sizeof(value));
+}
+
+static void AddUint64(std::vector<uint8_t>* buffer, uint64_t value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer->insert(buffer->end(), bytes, bytes + sizeof(value));
+}
+
+static void AddBytes(std::vector<uint8_t>* buffer, const uint8_t* data, size_t size) {
+  buffer->insert(buffer->end(), data, data + size);
+}
+
+static uint32_t ComputeAdler32(const uint8_t* data, size_t size) {
+  return adler32(adler32(0L, Z_NULL, 0), data, size);
+}
+
+static uint64_t MethodKey(uint32_t dex_checksum, uint32_t method_index) {
+  return (static_cast<uint64_t>(dex_checksum) << 32) | method_index;
+}
+
+// Bounds checked reader of the data of the file.
+class PersistedDataReader {
+ public:
+  explicit PersistedDataReader(ArrayRef<const uint8_t> data)
+      : ptr_(data.data()), end_(data.data() + data.size()) {}
+
+  bool ReadUint32(uint32_t* value) {
+    if (static_cast<size_t>(end_ - ptr_) < sizeof(uint32_t)) {
+      return false;
+    }
+    memcpy(value, ptr_, sizeof(uint32_t));
+    ptr_ += sizeof(uint32_t);
+    return true;
+  }
+
+  bool ReadDexReference(PersistedDexReference* reference) {
+    return ReadUint32(&reference->dex_file) && ReadUint32(&reference->index);
+  }
+
+  bool ReadBytes(size_t size, ArrayRef<const uint8_t>* bytes) {
+    if (static_cast<size_t>(end_ - ptr_) < size) {
+      return false;
+    }
+    *bytes = ArrayRef<const uint8_t>(ptr_, size);
+    ptr_ += size;
+    return true;
+  }
+
+  bool IsAtEnd() const {
+    return ptr_ == end_;
+  }
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* const end_;
+};
+
+// Decode the method in `payload`. Returns false if it is malformed.
+static bool DecodeMethod(ArrayRef<const uint8_t> payload,
+                         uint32_t* dex_checksum,
+                         uint32_t* method_index,
+                         PersistedMethod* persisted) {
+  PersistedDataReader reader(payload);
+  uint32_t flags = 0;
+  uint32_t number_of_roots = 0;
+  uint32_t number_of_root_patches = 0;
+  uint32_t number_of_cha_assumptions = 0;
+  uint32_t number_of_initialized_classes = 0;
+  uint32_t code_size = 0;
+  uint32_t stack_map_size = 0;
+  uint32_t method_info_size = 0;
+  if (!reader.ReadUint32(dex_checksum) ||
+      !reader.ReadUint32(method_index) ||
+      !reader.ReadUint32(&persisted->frame_size_in_bytes) ||
+      !reader.ReadUint32(&persisted->core_spill_mask) ||
+      !reader.ReadUint32(&persisted->fp_spill_mask) ||
+      !reader.ReadUint32(&flags) ||
+      !reader.ReadUint32(&number_of_roots) ||
+      !reader.ReadUint32(&number_of_root_patches) ||
+      !reader.ReadUint32(&number_of_cha_assumptions) ||
+      !reader.ReadUint32(&number_of_initialized_classes) ||
+      !reader.ReadUint32(&code_size) ||
+      !reader.ReadUint32(&stack_map_size) ||
+      !reader.ReadUint32(&method_info_size)) {
+    return false;
+  }
+  // Do not trust the counts to size the vectors before reading the entries they count.
+  if (number_of_roots > payload.size() ||
+      number_of_root_patches > payload.size() ||
+      number_of_cha_assumptions > payload.size() ||
+      number_of_initialized_classes > payload.size()) {
+    return false;
+  }
+  persisted->has_should_deoptimize_flag = (flags & 1u) != 0;
+
+  persisted->roots.resize(number_of_roots);
+  for (PersistedRoot& root : persisted->roots) {
+    uint32_t is_class = 0;
+    if (!reader.ReadUint32(&is_class) || !reader.ReadDexReference(&root.reference)) {
+      return false;
+    }
+    root.is_class = (is_class != 0);
+  }
+  persisted->root_patches.resize(number_of_root_patches);
+  for (JitRootPatch& patch : persisted->root_patches) {
+    if (!reader.ReadUint32(&patch.code_offset) ||
+        !reader.ReadUint32(&patch.index_in_table) ||
+        patch.index_in_table >= number_of_roots ||
+        patch.code_offset > code_size - std::min<uint32_t>(code_size, sizeof(uint32_t)) ||
+        code_size < sizeof(uint32_t)) {
+      return false;
+    }
+  }
+  persisted->cha_assumptions.resize(number_of_cha_assumptions);
+  for (PersistedChaAssumption& assumption : persisted->cha_assumptions) {
+    if (!reader.ReadDexReference(&assumption.method) ||
+        !reader.ReadDexReference(&assumption.implementation)) {
+      return false;
+    }
+  }
+  persisted->initialized_classes.resize(number_of_initialized_classes);
+  for (PersistedDexReference& klass : persisted->initialized_classes) {
+    if (!reader.ReadDexReference(&klass)) {
+      return false;
+    }
+  }
+  return reader.ReadBytes(code_size, &persisted->code) &&
+      reader.ReadBytes(stack_map_size, &persisted->stack_map) &&
+      reader.ReadBytes(method_info_size, &persisted->method_info) &&
+      reader.IsAtEnd();
+}
+
+// Encode `dex_file` relative to `outer_dex_file` and the boot class path.
+static bool EncodeDexFile(const DexFile* dex_file,
+                          const DexFile* outer_dex_file,
+                          uint32_t* encoded) {
+  if (dex_file == outer_dex_file) {
+    *encoded = PersistedDexReference::kOuterDexFile;
+    return true;
+  }
+  const std::vector<const DexFile*>& boot_class_path =
+      Runtime::Current()->GetClassLinker()->GetBootClassPath();
+  auto it = std::find(boot_class_path.begin(), boot_class_path.end(), dex_file);
+  if (it == boot_class_path.end()) {
+    return false;
+  }
+  *encoded = 1u + dchecked_integral_cast<uint32_t>(it - boot_class_path.begin());
+  return true;
+}
+
+static const DexFile* DecodeDexFile(uint32_t encoded, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (encoded == PersistedDexReference::kOuterDexFile) {
+    return method->GetDexFile();
+  }
+  const std::vector<const DexFile*>& boot_class_path =
+      Runtime::Current()->GetClassLinker()->GetBootClassPath();
+  return (encoded - 1u < boot_class_path.size()) ? boot_class_path[encoded - 1u] : nullptr;
+}
+
+static ObjPtr<mirror::DexCache> GetDexCache(uint32_t encoded,
+                                            const DexFile& dex_file,
+                                            ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (encoded == PersistedDexReference::kOuterDexFile) {
+    return method->GetDexCache();
+  }
+  return Runtime::Current()->GetClassLinker()->FindDexCache(Thread::Current(), dex_file);
+}
+
+static ObjPtr<mirror::ClassLoader> GetClassLoader(uint32_t encoded, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  // Dex files of the boot class path are loaded by the boot class loader.
+  return (encoded == PersistedDexReference::kOuterDexFile)
+      ? method->GetDeclaringClass()->GetClassLoader()
+      : nullptr;
+}
+
+// Returns the virtual method `reference`, or null if its class is not loaded.
+static ArtMethod* LookupVirtualMethod(const PersistedDexReference& reference, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  const DexFile* dex_file = DecodeDexFile(reference.dex_file, method);
+  if (dex_file == nullptr || reference.index >= dex_file->NumMethodIds()) {
+    return nullptr;
+  }
+  ObjPtr<mirror::DexCache> dex_cache = GetDexCache(reference.dex_file, *dex_file, method);
+  const DexFile::MethodId& method_id = dex_file->GetMethodId(reference.index);
+  ObjPtr<mirror::Class> klass = Runtime::Current()->GetClassLinker()->LookupResolvedType(
+      *dex_file, method_id.class_idx_, dex_cache, GetClassLoader(reference.dex_file, method));
+  if (klass == nullptr) {
+    return nullptr;
+  }
+  return klass->FindDeclaredVirtualMethod(dex_cache, reference.index, kRuntimePointerSize);
+}
+
+// Methods inlined in persisted code are either boot image methods, encoded by address in the
+// stack maps, or encoded by index in the dex file of their caller. The latter must be loaded
+// for the runtime to walk the inlined frames, see GetResolvedMethod.
+static bool AreInlinedMethodsLoaded(ArtMethod* method, const PersistedMethod& persisted)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  CodeInfo code_info(persisted.stack_map.data());
+  CodeInfoEncoding encoding = code_info.ExtractEncoding();
+  if (!code_info.HasInlineInfo(encoding)) {
+    return true;
+  }
+  MethodInfo method_info(persisted.method_info.data());
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  Thread* self = Thread::Current();
+  const InlineInfoEncoding& inline_encoding = encoding.inline_info.encoding;
+  for (size_t i = 0, e = code_info.GetNumberOfStackMaps(encoding); i < e; ++i) {
+    StackMap stack_map = code_info.GetStackMapAt(i, encoding);
+    if (!stack_map.HasInlineInfo(encoding.stack_map.encoding)) {
+      continue;
+    }
+    InlineInfo inline_info = code_info.GetInlineInfoOf(stack_map, encoding);
+    ArtMethod* caller = method;
+    for (uint32_t depth = 0, end = inline_info.GetDepth(inline_encoding); depth < end; ++depth) {
+      if (inline_info.EncodesArtMethodAtDepth(inline_encoding, depth)) {
+        caller = inline_info.GetArtMethodAtDepth(inline_encoding, depth);
+        continue;
+      }
+      if (inline_info.GetDexPcAtDepth(inline_encoding, depth) == static_cast<uint32_t>(-1)) {
+        // The String.charAt special case, always a leaf.
+        continue;
+      }
+      uint32_t method_index =
+          inline_info.GetMethodIndexAtDepth(inline_encoding, method_info, depth);
+      const DexFile* dex_file = caller->GetDexFile();
+      if (method_index >= dex_file->NumMethodIds()) {
+        return false;
+      }
+      const DexFile::MethodId& method_id = dex_file->GetMethodId(method_index);
+      ObjPtr<mirror::Class> klass = class_linker->LookupClass(
+          self,
+          dex_file->StringByTypeIdx(method_id.class_idx_),
+          caller->GetDeclaringClass()->GetClassLoader());
+      if (klass == nullptr) {
+        return false;
+      }
+      const char* name = dex_file->GetMethodName(method_id);
+      const Signature signature = dex_file->GetMethodSignature(method_id);
+      ArtMethod* inlined_method =
+          klass->FindDeclaredDirectMethod(name, signature, kRuntimePointerSize);
+      if (inlined_method == nullptr) {
+        inlined_method = klass->FindDeclaredVirtualMethod(name, signature, kRuntimePointerSize);
+      }
+      if (inlined_method == nullptr) {
+        return false;
+      }
+      caller = inlined_method;
+    }
+  }
+  return true;
+}
+
+PersistentCodeCache* PersistentCodeCache::Create(const std::string& filename,
+                                                 std::string* error_msg) {
+  std::unique_ptr<PersistentCodeCache> cache(new PersistentCodeCache());
+  if (!cache->flock_.Init(filename.c_str(), O_CREAT | O_RDWR, /* block */ false, error_msg)) {
+    return nullptr;
+  }
+  File* file = cache->flock_.GetFile();
+  std::vector<uint8_t> header = ComputeHeader();
+  size_t valid_size = cache->LoadMethods(header, error_msg);
+  if (valid_size == 0) {
+    // Start over with a file for this runtime.
+    cache->methods_.clear();
+    cache->map_.reset();
+    if (file->SetLength(0) != 0 || !file->PwriteFully(header.data(), header.size(), 0)) {
+      *error_msg = "Could not write the header of " + filename;
+      return nullptr;
+    }
+    valid_size = header.size();
+  } else if (static_cast<int64_t>(valid_size) != file->GetLength()) {
+    // Drop a method that was only partially written.
+    if (file->SetLength(valid_size) != 0) {
+      *error_msg = "Could not truncate " + filename;
+      return nullptr;
+    }
+  }
+  MutexLock mu(Thread::Current(), cache->lock_);
+  cache->file_size_ = valid_size;
+  return cache.release();
+}
+
+size_t PersistentCodeCache::LoadMethods(const std::vector<uint8_t>& header,
+                                        std::string* error_msg) {
+  File* file = flock_.GetFile();
+  int64_t length = file->GetLength();
+  if (length < static_cast<int64_t>(header.size())) {
+    return 0;
+  }
+  map_.reset(MemMap::MapFile(length,
+                             PROT_READ,
+                             MAP_PRIVATE,
+                             file->Fd(),
+                             /* start */ 0,
+                             /* low_4gb */ false,
+                             file->GetPath().c_str(),
+                             error_msg));
+  if (map_ == nullptr) {
+    LOG(WARNING) << "Could not map the persistent JIT code cache: " << *error_msg;
+    return 0;
+  }
+  if (memcmp(map_->Begin(), header.data(), header.size()) != 0) {
+    VLOG(jit) << "Persistent JIT code cache " << file->GetPath() << " is for another runtime";
+    return 0;
+  }
+  const uint8_t* ptr = map_->Begin() + header.size();
+  const uint8_t* end = map_->Begin() + length;
+  while (static_cast<size_t>(end - ptr) >= kEntryHeaderSize) {
+    uint32_t size;
+    uint32_t checksum;
+    memcpy(&size, ptr, sizeof(size));
+    memcpy(&checksum, ptr + sizeof(size), sizeof(checksum));
+    const uint8_t* payload = ptr + kEntryHeaderSize;
+    if (static_cast<size_t>(end - payload) < size || ComputeAdler32(payload, size) != checksum) {
+      break;
+    }
+    ArrayRef<const uint8_t> data(payload, size);
+    uint32_t dex_checksum;
+    uint32_t method_index;
+    PersistedMethod persisted;
+    if (!DecodeMethod(data, &dex_checksum, &method_index, &persisted)) {
+      break;
+    }
+    // A method compiled again in a later run replaces the earlier code.
+    methods_[MethodKey(dex_checksum, method_index)] = data;
+    ptr = payload + size;
+  }
+  VLOG(jit) << "Loaded " << methods_.size() << " methods from persistent JIT code cache "
+            << file->GetPath();
+  return ptr - map_->Begin();
+}
+
+bool PersistentCodeCache::IsSupported(InstructionSet isa) {
+  // Code generators for these instruction sets store the address of a root table entry
+  // as a 32-bit value in the code, which is all that `PatchRoots` knows to relocate.
+  switch (isa) {
+    case kArm:
+    case kThumb2:
+    case kArm64:
+    case kX86:
+    case kX86_64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::vector<uint8_t> PersistentCodeCache::ComputeHeader() {
+  Runtime* runtime = Runtime::Current();
+  std::vector<uint8_t> body;
+  AddUint32(&body, static_cast<uint32_t>(kRuntimeISA));
+  AddUint32(&body, runtime->IsJavaDebuggable() ? 1u : 0u);
+  // The JIT compiles for the instruction set features of the build, unless its compiler
+  // options say otherwise.
+  std::string features = InstructionSetFeatures::FromCppDefines()->GetFeatureString();
+  for (const std::string& option : runtime->GetCompilerOptions()) {
+    features += ' ';
+    features += option;
+  }
+  AddUint32(&body, dchecked_integral_cast<uint32_t>(features.size()));
+  AddBytes(&body, reinterpret_cast<const uint8_t*>(features.data()), features.size());
+  // Compiled code embeds addresses of boot image methods and objects.
+  for (gc::space::ImageSpace* space : runtime->GetHeap()->GetBootImageSpaces()) {
+    AddUint32(&body, space->GetImageHeader().GetOatChecksum());
+    AddUint64(&body, reinterpret_cast<uintptr_t>(space->Begin()));
+  }
+
+  std::vector<uint8_t> header;
+  AddBytes(&header, kMagic, sizeof(kMagic));
+  AddBytes(&header, kVersion, sizeof(kVersion));
+  AddUint32(&header, dchecked_integral_cast<uint32_t>(body.size()));
+  AddBytes(&header, body.data(), body.size());
+  return header;
+}
+
+uint32_t PersistentCodeCache::ComputeDexChecksum(const DexFile& dex_file) {
+  uint32_t location_checksum = dex_file.GetLocationChecksum();
+  uint32_t checksum = ComputeAdler32(reinterpret_cast<const uint8_t*>(&location_checksum),
+                                     sizeof(location_checksum));
+  const OatFile::OatDexFile* oat_dex_file = dex_file.GetOatDexFile();
+  if (oat_dex_file == nullptr || oat_dex_file->GetOatFile() == nullptr) {
+    return checksum;
+  }
+  for (const OatFile::OatDexFile* other : oat_dex_file->GetOatFile()->GetOatDexFiles()) {
+    uint32_t other_checksum = other->GetDexFileLocationChecksum();
+    checksum = adler32(checksum,
+                       reinterpret_cast<const uint8_t*>(&other_checksum),
+                       sizeof(other_checksum));
+  }
+  return checksum;
+}
+
+bool PersistentCodeCache::AddMethod(Thread* self,
+                                    ArtMethod* method,
+                                    const uint8_t* stack_map,
+                                    size_t stack_map_size,
+                                    const uint8_t* method_info,
+                                    size_t method_info_size,
+                                    size_t frame_size_in_bytes,
+                                    size_t core_spill_mask,
+                                    size_t fp_spill_mask,
+                                    const uint8_t* code,
+                                    size_t code_size,
+                                    const std::vector<JitRootReference>& roots,
+                                    const std::vector<JitRootPatch>& root_patches,
+                                    bool has_should_deoptimize_flag,
+                                    const ArenaSet<ArtMethod*>& cha_single_implementation_list,
+                                    const std::vector<JitClassReference>& initialized_classes) {
+  const DexFile* dex_file = method->GetDexFile();
+  std::vector<uint8_t> payload;
+  AddUint32(&payload, ComputeDexChecksum(*dex_file));
+  AddUint32(&payload, method->GetDexMethodIndex());
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(frame_size_in_bytes));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(core_spill_mask));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(fp_spill_mask));
+  AddUint32(&payload, has_should_deoptimize_flag ? 1u : 0u);
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(roots.size()));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(root_patches.size()));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(cha_single_implementation_list.size()));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(initialized_classes.size()));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(code_size));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(stack_map_size));
+  AddUint32(&payload, dchecked_integral_cast<uint32_t>(method_info_size));
+  for (const JitRootReference& root : roots) {
+    uint32_t encoded_dex_file;
+    if (!EncodeDexFile(root.dex_file, dex_file, &encoded_dex_file)) {
+      return false;
+    }
+    AddUint32(&payload, root.is_class ? 1u : 0u);
+    AddUint32(&payload, encoded_dex_file);
+    AddUint32(&payload, root.index);
+  }
+  for (const JitRootPatch& patch : root_patches) {
+    AddUint32(&payload, patch.code_offset);
+    AddUint32(&payload, patch.index_in_table);
+  }
+  for (ArtMethod* single_impl : cha_single_implementation_list) {
+    ArtMethod* implementation = single_impl->GetSingleImplementation(kRuntimePointerSize);
+    uint32_t encoded_method_dex_file;
+    uint32_t encoded_implementation_dex_file;
+    if (implementation == nullptr ||
+        !EncodeDexFile(single_impl->GetDexFile(), dex_file, &encoded_method_dex_file) ||
+        !EncodeDexFile(implementation->GetDexFile(), dex_file, &encoded_implementation_dex_file)) {
+      return false;
+    }
+    AddUint32(&payload, encoded_method_dex_file);
+    AddUint32(&payload, single_impl->GetDexMethodIndex());
+    AddUint32(&payload, encoded_implementation_dex_file);
+    AddUint32(&payload, implementation->GetDexMethodIndex());
+  }
+  for (const JitClassReference& klass : initialized_classes) {
+    uint32_t encoded_dex_file;
+    if (!EncodeDexFile(klass.dex_file, dex_file, &encoded_dex_file)) {
+      return false;
+    }
+    AddUint32(&payload, encoded_dex_file);
+    AddUint32(&payload, klass.type_index);
+  }
+  AddBytes(&payload, code, code_size);
+  AddBytes(&payload, stack_map, stack_map_size);
+  AddBytes(&payload, method_info, method_info_size);
+
+  std::vector<uint8_t> entry;
+  AddUint32(&entry, dchecked_integral_cast<uint32_t>(payload.size()));
+  AddUint32(&entry, ComputeAdler32(payload.data(), payload.size()));
+  AddBytes(&entry, payload.data(), payload.size());
+
+  // Do not block the GC while writing the file.
+  ScopedThreadSuspension sts(self, kNative);
+  MutexLock mu(self, lock_);
+  if (file_size_ + entry.size() > kMaxFileSize) {
+    return false;
+  }
+  File* file = flock_.GetFile();
+  if (!file->PwriteFully(entry.data(), entry.size(), file_size_)) {
+    PLOG(WARNING) << "Could not write to persistent JIT code cache " << file->GetPath();
+    return false;
+  }
+  file_size_ += entry.size();
+  ++number_of_added_methods_;
+  return true;
+}
+
+bool PersistentCodeCache::FindMethod(ArtMethod* method, PersistedMethod* persisted) const {
+  auto it = methods_.find(
+      MethodKey(ComputeDexChecksum(*method->GetDexFile()), method->GetDexMethodIndex()));
+  if (it == methods_.end()) {
+    return false;
+  }
+  uint32_t dex_checksum;
+  uint32_t method_index;
+  return DecodeMethod(it->second, &dex_checksum, &method_index, persisted);
+}
+
+bool PersistentCodeCache::ResolveRoots(ArtMethod* method,
+                                       const PersistedMethod& persisted,
+                                       Handle<mirror::ObjectArray<mirror::Object>> roots) {
+  DCHECK_EQ(static_cast<size_t>(roots->GetLength()), persisted.roots.size());
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  for (size_t i = 0; i < persisted.roots.size(); ++i) {
+    const PersistedRoot& root = persisted.roots[i];
+    const DexFile* dex_file = DecodeDexFile(root.reference.dex_file, method);
+    if (dex_file == nullptr) {
+      return false;
+    }
+    ObjPtr<mirror::DexCache> dex_cache = GetDexCache(root.reference.dex_file, *dex_file, method);
+    if (root.is_class) {
+      if (root.reference.index >= dex_file->NumTypeIds()) {
+        return false;
+      }
+      ObjPtr<mirror::Class> klass = class_linker->LookupResolvedType(
+          *dex_file,
+          dex::TypeIndex(root.reference.index),
+          dex_cache,
+          GetClassLoader(root.reference.dex_file, method));
+      if (klass == nullptr) {
+        return false;
+      }
+      roots->Set(i, klass.Ptr());
+    } else {
+      if (root.reference.index >= dex_file->NumStringIds()) {
+        return false;
+      }
+      ObjPtr<mirror::String> string = class_linker->LookupString(
+          *dex_file, dex::StringIndex(root.reference.index), dex_cache);
+      if (string == nullptr) {
+        return false;
+      }
+      // Like for freshly compiled code, the JIT requires strings of the root table to be
+      // strongly interned.
+      roots->Set(i, class_linker->GetInternTable()->InternStrong(string).Ptr());
+    }
+  }
+  return AreInlinedMethodsLoaded(method, persisted);
+}
+
+bool PersistentCodeCache::ResolveChaAssumptions(
+    ArtMethod* method,
+    const PersistedMethod& persisted,
+    ArenaSet<ArtMethod*>* cha_single_implementation_list) {
+  for (const PersistedChaAssumption& assumption : persisted.cha_assumptions) {
+    ArtMethod* single_impl = LookupVirtualMethod(assumption.method, method);
+    ArtMethod* implementation = LookupVirtualMethod(assumption.implementation, method);
+    if (single_impl == nullptr ||
+        implementation == nullptr ||
+        !single_impl->HasSingleImplementation() ||
+        single_impl->GetSingleImplementation(kRuntimePointerSize) != implementation) {
+      return false;
+    }
+    cha_single_implementation_list->insert(single_impl);
+  }
+  return true;
+}
+
+bool PersistentCodeCache::AreClassesInitialized(ArtMethod* method,
+                                                const PersistedMethod& persisted) {
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  for (const PersistedDexReference& reference : persisted.initialized_classes) {
+    const DexFile* dex_file = DecodeDexFile(reference.dex_file, method);
+    if (dex_file == nullptr || reference.index >= dex_file->NumTypeIds()) {
+      return false;
+    }
+    // A class that is not resolved yet in this run is not initialized either.
+    ObjPtr<mirror::Class> klass = class_linker->LookupResolvedType(
+        *dex_file,
+        dex::TypeIndex(reference.index),
+        GetDexCache(reference.dex_file, *dex_file, method),
+        GetClassLoader(reference.dex_file, method));
+    if (klass == nullptr || !klass->IsInitialized()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PersistentCodeCache::PatchRoots(const PersistedMethod& persisted,
+                                     uint8_t* code,
+                                     const uint8_t* roots_data) {
+  for (const JitRootPatch& patch : persisted.root_patches) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(roots_data) +
+        patch.index_in_table * sizeof(GcRoot<mirror::Object>);
+    typedef __attribute__((__aligned__(1))) uint32_t unaligned_uint32_t;
+    reinterpret_cast<unaligned_uint32_t*>(code + patch.code_offset)[0] =
+        dchecked_integral_cast<uint32_t>(address);
+  }
+}
+
+size_t PersistentCodeCache::GetNumberOfAddedMethods() {
+  MutexLock mu(Thread::Current(), lock_);
+  return number_of_added_methods_;
+}
+
+}  // namespace jit
+}  // namespace art
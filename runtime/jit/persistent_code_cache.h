@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_PERSISTENT_CODE_CACHE_H_
+#define ART_RUNTIME_JIT_PERSISTENT_CODE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/instruction_set.h"
+#include "base/array_ref.h"
+#include "base/arena_containers.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "base/scoped_flock.h"
+#include "globals.h"
+#include "handle.h"
+#include "mem_map.h"
+
+namespace art {
+
+class ArtMethod;
+class DexFile;
+class Thread;
+
+namespace mirror {
+class Object;
+template<class T> class ObjectArray;
+}  // namespace mirror
+
+namespace jit {
+
+// Location in compiled code of the 32-bit address of an entry of its root table.
+struct JitRootPatch {
+  uint32_t code_offset;
+  uint32_t index_in_table;
+};
+
+// The string or class of an entry of the root table of compiled code.
+struct JitRootReference {
+  bool is_class;
+  const DexFile* dex_file;
+  uint32_t index;
+};
+
+// A class that compiled code assumes to be initialized.
+struct JitClassReference {
+  const DexFile* dex_file;
+  uint32_t type_index;
+};
+
+// A root table entry or a method, described by an index in the dex file of the compiled
+// method (kOuterDexFile), or in a dex file of the boot class path.
+struct PersistedDexReference {
+  static constexpr uint32_t kOuterDexFile = 0u;
+
+  uint32_t dex_file;  // kOuterDexFile, or 1 + the index in the boot class path.
+  uint32_t index;
+};
+
+// An entry of the root table of compiled code.
+struct PersistedRoot {
+  bool is_class;
+  PersistedDexReference reference;
+};
+
+// A class hierarchy analysis assumption of compiled code: `method` has the single
+// implementation `implementation`.
+struct PersistedChaAssumption {
+  PersistedDexReference method;
+  PersistedDexReference implementation;
+};
+
+// The compiled code of a method, as read from the persistent code cache. Arrays point
+// into the mapped file.
+struct PersistedMethod {
+  uint32_t frame_size_in_bytes;
+  uint32_t core_spill_mask;
+  uint32_t fp_spill_mask;
+  bool has_should_deoptimize_flag;
+  // In the order of the root table.
+  std::vector<PersistedRoot> roots;
+  std::vector<JitRootPatch> root_patches;
+  std::vector<PersistedChaAssumption> cha_assumptions;
+  // Classes of the boot class path the code does not check initialization of.
+  std::vector<PersistedDexReference> initialized_classes;
+  ArrayRef<const uint8_t> code;
+  ArrayRef<const uint8_t> stack_map;
+  ArrayRef<const uint8_t> method_info;
+};
+
+// File holding JIT compiled code of an application, for installation in later runs.
+//
+// The file starts with a header identifying the instruction set features and the boot
+// image that the code was compiled for, as compiled code embeds addresses of boot image
+// methods and objects. Compiled methods are appended to it as they get compiled, each with
+// its stack maps and method info, the references of its root table and the code locations
+// to patch with the address of the root table, and the class hierarchy analysis and
+// class initialization assumptions the code relies on. Methods are keyed by the checksum
+// of their dex file and their method index.
+//
+// Only code that does not embed addresses allocated by the compiling process can be
+// persisted, see IsCompilingForPersistentJitCodeCache in the compiler.
+class PersistentCodeCache {
+ public:
+  // The file stops growing past this size.
+  static constexpr size_t kMaxFileSize = 32 * MB;
+
+  // Open or create the file at `filename`, and map the compiled code it holds if it was
+  // written for this runtime. Returns null if the file cannot be locked for exclusive use.
+  static PersistentCodeCache* Create(const std::string& filename, std::string* error_msg);
+
+  // Whether JIT compiled code for `isa` can be persisted.
+  static bool IsSupported(InstructionSet isa);
+
+  // Append the compiled code of `method` to the file. `roots` are in the order of the root
+  // table. `initialized_classes` are the classes the code assumes to be initialized. Returns
+  // false if the code refers to a dex file other than the one of `method` and the boot class
+  // path, or if the file is full.
+  bool AddMethod(Thread* self,
+                 ArtMethod* method,
+                 const uint8_t* stack_map,
+                 size_t stack_map_size,
+                 const uint8_t* method_info,
+                 size_t method_info_size,
+                 size_t frame_size_in_bytes,
+                 size_t core_spill_mask,
+                 size_t fp_spill_mask,
+                 const uint8_t* code,
+                 size_t code_size,
+                 const std::vector<JitRootReference>& roots,
+                 const std::vector<JitRootPatch>& root_patches,
+                 bool has_should_deoptimize_flag,
+                 const ArenaSet<ArtMethod*>& cha_single_implementation_list,
+                 const std::vector<JitClassReference>& initialized_classes)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Return whether the file holds compiled code for `method`, and decode it in `persisted`.
+  bool FindMethod(ArtMethod* method, PersistedMethod* persisted) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Resolve the root table of `persisted` in `roots`. Returns false if a class or string
+  // is not loaded yet in this run, or if a method inlined in the code is not loaded.
+  static bool ResolveRoots(ArtMethod* method,
+                           const PersistedMethod& persisted,
+                           Handle<mirror::ObjectArray<mirror::Object>> roots)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Check the class hierarchy analysis assumptions of `persisted`, and add the methods they
+  // are about to `cha_single_implementation_list`. Returns false if an assumption does not
+  // hold in this run.
+  static bool ResolveChaAssumptions(ArtMethod* method,
+                                    const PersistedMethod& persisted,
+                                    ArenaSet<ArtMethod*>* cha_single_implementation_list)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns whether the classes that `persisted` assumes to be initialized are initialized
+  // in this run.
+  static bool AreClassesInitialized(ArtMethod* method, const PersistedMethod& persisted)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Patch `code`, a copy of the code of `persisted`, with the address of its root table.
+  static void PatchRoots(const PersistedMethod& persisted,
+                         uint8_t* code,
+                         const uint8_t* roots_data);
+
+  size_t GetNumberOfLoadedMethods() const {
+    return methods_.size();
+  }
+
+  size_t GetNumberOfAddedMethods() REQUIRES(!lock_);
+
+  // Returns the header identifying the runtime the code of the file is compiled for.
+  static std::vector<uint8_t> ComputeHeader();
+
+  // Returns the checksum identifying `dex_file` together with the other dex files of its apk,
+  // which the layout of its classes may depend on.
+  static uint32_t ComputeDexChecksum(const DexFile& dex_file);
+
+ private:
+  PersistentCodeCache()
+      : lock_("persistent JIT code cache lock"),
+        file_size_(0),
+        number_of_added_methods_(0) {}
+
+  // Map the file and index its methods. Returns the size of the valid part of the file, or
+  // 0 if its header does not match this runtime.
+  size_t LoadMethods(const std::vector<uint8_t>& header, std::string* error_msg);
+
+  // The locked file.
+  ScopedFlock flock_;
+
+  // The file as it was when opened.
+  std::unique_ptr<MemMap> map_;
+
+  // Methods found in `map_`, keyed by dex checksum and method index.
+  std::unordered_map<uint64_t, ArrayRef<const uint8_t>> methods_;
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  size_t file_size_ GUARDED_BY(lock_);
+  size_t number_of_added_methods_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(PersistentCodeCache);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_PERSISTENT_CODE_CACHE_H_
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "art_method-inl.h"
+#include "base/arena_allocator.h"
+#include "base/unix_file/fd_file.h"
+#include "class_linker-inl.h"
+#include "common_runtime_test.h"
+#include "jit/persistent_code_cache.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+namespace jit {
+
+class PersistentCodeCacheTest : public CommonRuntimeTest {
+ protected:
+  ArtMethod* GetObjectHashCode() REQUIRES_SHARED(Locks::mutator_lock_) {
+    ObjPtr<mirror::Class> klass = Runtime::Current()->GetClassLinker()->FindSystemClass(
+        Thread::Current(), "Ljava/lang/Object;");
+    return klass->FindDeclaredVirtualMethod("hashCode", "()I", kRuntimePointerSize);
+  }
+
+  std::unique_ptr<PersistentCodeCache> Create(const ScratchFile& file) {
+    std::string error_msg;
+    std::unique_ptr<PersistentCodeCache> cache(
+        PersistentCodeCache::Create(file.GetFilename(), &error_msg));
+    EXPECT_TRUE(cache != nullptr) << error_msg;
+    return cache;
+  }
+
+  bool AddMethod(PersistentCodeCache* cache, ArtMethod* method)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    ArenaAllocator arena(Runtime::Current()->GetArenaPool());
+    ArenaSet<ArtMethod*> cha_single_implementation_list(std::less<ArtMethod*>(),
+                                                        arena.Adapter(kArenaAllocCHA));
+    std::vector<JitRootReference> roots = {
+        JitRootReference { /* is_class */ false, method->GetDexFile(), 0u },
+        JitRootReference { /* is_class */ true, method->GetDexFile(), 1u },
+    };
+    std::vector<JitRootPatch> root_patches = {
+        JitRootPatch { 4u, 1u },
+        JitRootPatch { 12u, 0u },
+    };
+    std::vector<JitClassReference> initialized_classes = {
+        JitClassReference { method->GetDexFile(),
+                            method->GetDeclaringClass()->GetDexTypeIndex().index_ },
+    };
+    return cache->AddMethod(Thread::Current(),
+                            method,
+                            stack_map_,
+                            sizeof(stack_map_),
+                            method_info_,
+                            sizeof(method_info_),
+                            /* frame_size_in_bytes */ 32u,
+                            /* core_spill_mask */ 0x3u,
+                            /* fp_spill_mask */ 0u,
+                            code_,
+                            sizeof(code_),
+                            roots,
+                            root_patches,
+                            /* has_should_deoptimize_flag */ true,
+                            cha_single_implementation_list,
+                            initialized_classes);
+  }
+
+  const uint8_t code_[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+  const uint8_t stack_map_[6] = { 1, 2, 3, 4, 5, 6 };
+  const uint8_t method_info_[2] = { 7, 8 };
+};
+
+TEST_F(PersistentCodeCacheTest, CreateWritesHeader) {
+  ScratchFile file;
+  std::unique_ptr<PersistentCodeCache> cache = Create(file);
+  ASSERT_TRUE(cache != nullptr);
+  EXPECT_EQ(0u, cache->GetNumberOfLoadedMethods());
+  EXPECT_EQ(static_cast<int64_t>(PersistentCodeCache::ComputeHeader().size()),
+            file.GetFile()->GetLength());
+}
+
+TEST_F(PersistentCodeCacheTest, RewriteForAnotherRuntime) {
+  ScratchFile file;
+  const char garbage[] = "not a persistent code cache";
+  ASSERT_TRUE(file.GetFile()->WriteFully(garbage, sizeof(garbage)));
+  std::unique_ptr<PersistentCodeCache> cache = Create(file);
+  ASSERT_TRUE(cache != nullptr);
+  EXPECT_EQ(0u, cache->GetNumberOfLoadedMethods());
+  EXPECT_EQ(static_cast<int64_t>(PersistentCodeCache::ComputeHeader().size()),
+            file.GetFile()->GetLength());
+}
+
+TEST_F(PersistentCodeCacheTest, AddAndFindMethod) {
+  ScratchFile file;
+  ScopedObjectAccess soa(Thread::Current());
+  ArtMethod* method = GetObjectHashCode();
+  ASSERT_TRUE(method != nullptr);
+  {
+    std::unique_ptr<PersistentCodeCache> cache = Create(file);
+    ASSERT_TRUE(cache != nullptr);
+    ASSERT_TRUE(AddMethod(cache.get(), method));
+    EXPECT_EQ(1u, cache->GetNumberOfAddedMethods());
+    // Only methods of earlier runs are installed.
+    PersistedMethod persisted;
+    EXPECT_FALSE(cache->FindMethod(method, &persisted));
+  }
+
+  std::unique_ptr<PersistentCodeCache> cache = Create(file);
+  ASSERT_TRUE(cache != nullptr);
+  EXPECT_EQ(1u, cache->GetNumberOfLoadedMethods());
+  PersistedMethod persisted;
+  ASSERT_TRUE(cache->FindMethod(method, &persisted));
+  EXPECT_EQ(32u, persisted.frame_size_in_bytes);
+  EXPECT_EQ(0x3u, persisted.core_spill_mask);
+  EXPECT_EQ(0u, persisted.fp_spill_mask);
+  EXPECT_TRUE(persisted.has_should_deoptimize_flag);
+  ASSERT_EQ(2u, persisted.roots.size());
+  EXPECT_FALSE(persisted.roots[0].is_class);
+  EXPECT_EQ(PersistedDexReference::kOuterDexFile, persisted.roots[0].reference.dex_file);
+  EXPECT_EQ(0u, persisted.roots[0].reference.index);
+  EXPECT_TRUE(persisted.roots[1].is_class);
+  EXPECT_EQ(1u, persisted.roots[1].reference.index);
+  ASSERT_EQ(2u, persisted.root_patches.size());
+  EXPECT_EQ(4u, persisted.root_patches[0].code_offset);
+  EXPECT_EQ(1u, persisted.root_patches[0].index_in_table);
+  EXPECT_TRUE(persisted.cha_assumptions.empty());
+  ASSERT_EQ(1u, persisted.initialized_classes.size());
+  EXPECT_EQ(PersistedDexReference::kOuterDexFile, persisted.initialized_classes[0].dex_file);
+  EXPECT_EQ(method->GetDeclaringClass()->GetDexTypeIndex().index_,
+            persisted.initialized_classes[0].index);
+  EXPECT_TRUE(PersistentCodeCache::AreClassesInitialized(method, persisted));
+  ASSERT_EQ(sizeof(code_), persisted.code.size());
+  EXPECT_EQ(0, memcmp(code_, persisted.code.data(), sizeof(code_)));
+  ASSERT_EQ(sizeof(stack_map_), persisted.stack_map.size());
+  EXPECT_EQ(0, memcmp(stack_map_, persisted.stack_map.data(), sizeof(stack_map_)));
+  ASSERT_EQ(sizeof(method_info_), persisted.method_info.size());
+  EXPECT_EQ(0, memcmp(method_info_, persisted.method_info.data(), sizeof(method_info_)));
+
+  // Patching writes the address of the root table entries.
+  std::vector<uint8_t> code(persisted.code.begin(), persisted.code.end());
+  const uint8_t* roots_data = reinterpret_cast<const uint8_t*>(0x1000);
+  PersistentCodeCache::PatchRoots(persisted, code.data(), roots_data);
+  uint32_t patched;
+  memcpy(&patched, code.data() + 4, sizeof(patched));
+  EXPECT_EQ(0x1000u + sizeof(GcRoot<mirror::Object>), patched);
+  memcpy(&patched, code.data() + 12, sizeof(patched));
+  EXPECT_EQ(0x1000u, patched);
+}
+
+TEST_F(PersistentCodeCacheTest, TruncatePartialMethod) {
+  ScratchFile file;
+  ScopedObjectAccess soa(Thread::Current());
+  ArtMethod* method = GetObjectHashCode();
+  ASSERT_TRUE(method != nullptr);
+  int64_t valid_length;
+  {
+    std::unique_ptr<PersistentCodeCache> cache = Create(file);
+    ASSERT_TRUE(cache != nullptr);
+    ASSERT_TRUE(AddMethod(cache.get(), method));
+    valid_length = file.GetFile()->GetLength();
+  }
+  // Simulate a method only partially written when the process died.
+  const uint8_t partial[] = { 0xff, 0x00, 0x00, 0x00, 0x12, 0x34 };
+  ASSERT_TRUE(file.GetFile()->PwriteFully(partial, sizeof(partial), valid_length));
+
+  std::unique_ptr<PersistentCodeCache> cache = Create(file);
+  ASSERT_TRUE(cache != nullptr);
+  EXPECT_EQ(1u, cache->GetNumberOfLoadedMethods());
+  EXPECT_EQ(valid_length, file.GetFile()->GetLength());
+}
+
+}  // namespace jit
+}  // namespace art
@@ -37,9 +37,8 @@
 namespace art {
 
 const uint8_t ProfileCompilationInfo::kProfileMagic[] = { 'p', 'r', 'o', '\0' };
-// Last profile version: fix profman merges. Update profile version to force
-// regeneration of possibly faulty profiles.
-const uint8_t ProfileCompilationInfo::kProfileVersion[] = { '0', '0', '5', '\0' };
+// Last profile version: add receiver counts to inline caches.
+const uint8_t ProfileCompilationInfo::kProfileVersion[] = { '0', '0', '7', '\0' };
 
 static constexpr uint16_t kMaxDexFileKeyLength = PATH_MAX;
 
@@ -48,8 +47,8 @@ static constexpr uint16_t kMaxDexFileKeyLength = PATH_MAX;
 // using the same test profile.
 static constexpr bool kDebugIgnoreChecksum = false;
 
-static constexpr uint8_t kIsMissingTypesEncoding = 6;
-static constexpr uint8_t kIsMegamorphicEncoding = 7;
+static constexpr uint8_t kIsMissingTypesEncoding = 0xfe;
+static constexpr uint8_t kIsMegamorphicEncoding = 0xff;
 
 static_assert(sizeof(InlineCache::kIndividualCacheSize) == sizeof(uint8_t),
               "InlineCache::kIndividualCacheSize does not have the expect type size");
@@ -67,17 +66,28 @@ ProfileCompilationInfo::~ProfileCompilationInfo() {
 }
 
 void ProfileCompilationInfo::DexPcData::AddClass(uint16_t dex_profile_idx,
-                                                 const dex::TypeIndex& type_idx) {
+                                                 const dex::TypeIndex& type_idx,
+                                                 uint32_t count) {
   if (is_megamorphic || is_missing_types) {
     return;
   }
-  classes.emplace(dex_profile_idx, type_idx);
+  ClassReference class_ref(dex_profile_idx, type_idx);
+  classes.insert(class_ref);
   if (classes.size() >= InlineCache::kIndividualCacheSize) {
-    is_megamorphic = true;
-    classes.clear();
+    SetIsMegamorphic();
+    return;
+  }
+  if (count != 0u) {
+    uint32_t& current = class_counts.FindOrAdd(class_ref, 0u)->second;
+    current = std::max(current, count);
   }
 }
 
+uint32_t ProfileCompilationInfo::DexPcData::GetClassCount(const ClassReference& class_ref) const {
+  auto it = class_counts.find(class_ref);
+  return (it == class_counts.end()) ? 0u : it->second;
+}
+
 // Transform the actual dex location into relative paths.
 // Note: this is OK because we don't store profiles of different apps into the same file.
 // Apps with split apks don't cause trouble because each split has a different name and will not
@@ -212,16 +222,22 @@ static constexpr size_t kLineHeaderSize =
  *        method_encoding_21,method_encoding_22...,,class_id1,class_id2...
  *    .....
  * The method_encoding is:
- *    method_id,number_of_inline_caches,inline_cache1,inline_cache2...
+ *    method_id,number_of_inline_caches,inline_cache1,inline_cache2..., \
+ *        number_of_invoke_counts,invoke_count1,invoke_count2...
  * The inline_cache is:
- *    dex_pc,[M|dex_map_size], dex_profile_index,class_id1,class_id2...,dex_profile_index2,...
+ *    dex_pc,[M|dex_map_size], dex_profile_index,class_id1,class_count1,class_id2, \
+ *        class_count2...,dex_profile_index2,...
  *    dex_map_size is the number of dex_indeces that follows.
  *       Classes are grouped per their dex files and the line
- *       `dex_profile_index,class_id1,class_id2...,dex_profile_index2,...` encodes the
- *       mapping from `dex_profile_index` to the set of classes `class_id1,class_id2...`
+ *       `dex_profile_index,class_id1,class_count1,class_id2,class_count2...,dex_profile_index2,...`
+ *       encodes the mapping from `dex_profile_index` to the set of classes
+ *       `class_id1,class_id2...`, along with the number of times each class was seen
+ *       as receiver (0 if unknown).
  *    M stands for megamorphic or missing types and it's encoded as either
  *    the byte kIsMegamorphicEncoding or kIsMissingTypesEncoding.
  *    When present, there will be no class ids following.
+ * The invoke_count is:
+ *    dex_pc,count
  **/
 bool ProfileCompilationInfo::Save(int fd) {
   ScopedTrace trace(__PRETTY_FUNCTION__);
@@ -277,6 +293,11 @@ bool ProfileCompilationInfo::Save(int fd) {
     for (const auto& method_it : dex_data.method_map) {
       AddUintToBuffer(&buffer, method_it.first);
       AddInlineCacheToBuffer(&buffer, method_it.second);
+      auto counts_it = dex_data.invoke_count_map.find(method_it.first);
+      AddInvokeCountsToBuffer(&buffer,
+                              counts_it == dex_data.invoke_count_map.end()
+                                  ? nullptr
+                                  : &counts_it->second);
     }
     for (const auto& class_id : dex_data.class_set) {
       AddUintToBuffer(&buffer, class_id.index_);
@@ -340,14 +361,43 @@ void ProfileCompilationInfo::AddInlineCacheToBuffer(std::vector<uint8_t>* buffer
       for (size_t i = 0; i < dex_classes.size(); i++) {
         // Add the type index of the classes.
         AddUintToBuffer(buffer, dex_classes[i].index_);
+        // Add the receiver count of the classes.
+        ClassReference class_ref(dex_profile_index, dex_classes[i]);
+        AddUintToBuffer(buffer, dex_pc_data.GetClassCount(class_ref));
       }
     }
   }
 }
 
+void ProfileCompilationInfo::AddInvokeCountsToBuffer(std::vector<uint8_t>* buffer,
+                                                     const InvokeCountMap* invoke_counts) {
+  // Add invoke count map size.
+  if (invoke_counts == nullptr) {
+    AddUintToBuffer(buffer, static_cast<uint16_t>(0));
+    return;
+  }
+  AddUintToBuffer(buffer, static_cast<uint16_t>(invoke_counts->size()));
+  for (const auto& invoke_count_it : *invoke_counts) {
+    AddUintToBuffer(buffer, invoke_count_it.first);  // uint16_t
+    AddUintToBuffer(buffer, invoke_count_it.second);  // uint32_t
+  }
+}
+
+void ProfileCompilationInfo::MergeInvokeCount(InvokeCountMap* invoke_counts,
+                                              uint16_t dex_pc,
+                                              uint32_t count) {
+  uint32_t& current = invoke_counts->FindOrAdd(dex_pc, 0u)->second;
+  current = std::max(current, count);
+}
+
 uint32_t ProfileCompilationInfo::GetMethodsRegionSize(const DexFileData& dex_data) {
-  // ((uint16_t)method index + (uint16_t)inline cache size) * number of methods
-  uint32_t size = 2 * sizeof(uint16_t) * dex_data.method_map.size();
+  // ((uint16_t)method index + (uint16_t)inline cache size + (uint16_t)invoke count size)
+  //     * number of methods
+  uint32_t size = 3 * sizeof(uint16_t) * dex_data.method_map.size();
+  for (const auto& counts_it : dex_data.invoke_count_map) {
+    // (uint16_t)dex_pc + (uint32_t)count
+    size += (sizeof(uint16_t) + sizeof(uint32_t)) * counts_it.second.size();
+  }
   for (const auto& method_it : dex_data.method_map) {
     const InlineCacheMap& inline_cache = method_it.second;
     size += sizeof(uint16_t) * inline_cache.size();  // dex_pc
@@ -361,6 +411,7 @@ uint32_t ProfileCompilationInfo::GetMethodsRegionSize(const DexFileData& dex_dat
         size += sizeof(uint8_t);  // number of classes
         const std::vector<dex::TypeIndex>& dex_classes = dex_it.second;
         size += sizeof(uint16_t) * dex_classes.size();  // the actual classes
+        size += sizeof(uint32_t) * dex_classes.size();  // the receiver counts
       }
     }
   }
@@ -477,7 +528,15 @@ bool ProfileCompilationInfo::AddMethod(const std::string& dex_location,
       if (class_dex_data == nullptr) {  // checksum mismatch
         return false;
       }
-      dex_pc_data.AddClass(class_dex_data->profile_index, class_ref.type_index);
+      dex_pc_data.AddClass(class_dex_data->profile_index,
+                           class_ref.type_index,
+                           pmi_ic_dex_pc_data.GetClassCount(class_ref));
+    }
+  }
+  if (!pmi.invoke_counts.empty()) {
+    InvokeCountMap* invoke_counts = &data->invoke_count_map.FindOrAdd(method_index)->second;
+    for (const auto& pmi_invoke_count_it : pmi.invoke_counts) {
+      MergeInvokeCount(invoke_counts, pmi_invoke_count_it.first, pmi_invoke_count_it.second);
     }
   }
   return true;
@@ -498,7 +557,8 @@ bool ProfileCompilationInfo::AddMethod(const ProfileMethodInfo& pmi) {
       dex_pc_data_it->second.SetIsMissingTypes();
       continue;
     }
-    for (const ProfileMethodInfo::ProfileClassReference& class_ref : cache.classes) {
+    for (size_t i = 0; i < cache.classes.size(); i++) {
+      const ProfileMethodInfo::ProfileClassReference& class_ref = cache.classes[i];
       DexFileData* class_dex_data = GetOrAddDexFileData(
           GetProfileDexFileKey(class_ref.dex_file->GetLocation()),
           class_ref.dex_file->GetLocationChecksum());
@@ -510,7 +570,16 @@ bool ProfileCompilationInfo::AddMethod(const ProfileMethodInfo& pmi) {
         // Don't bother adding classes if we are missing types.
         break;
       }
-      dex_pc_data_it->second.AddClass(class_dex_data->profile_index, class_ref.type_index);
+      uint32_t count = cache.receiver_counts.empty() ? 0u : cache.receiver_counts[i];
+      dex_pc_data_it->second.AddClass(class_dex_data->profile_index, class_ref.type_index, count);
+    }
+  }
+
+  if (!pmi.invoke_counts.empty()) {
+    InvokeCountMap* invoke_counts =
+        &data->invoke_count_map.FindOrAdd(pmi.dex_method_index)->second;
+    for (const ProfileMethodInfo::ProfileInvokeCount& invoke_count : pmi.invoke_counts) {
+      MergeInvokeCount(invoke_counts, invoke_count.dex_pc, invoke_count.count);
     }
   }
   return true;
@@ -568,14 +637,31 @@ bool ProfileCompilationInfo::ReadInlineCache(SafeBuffer& buffer,
       }
       for (; dex_classes_size > 0; dex_classes_size--) {
         uint16_t type_index;
+        uint32_t count;
         READ_UINT(uint16_t, buffer, type_index, error);
-        dex_pc_data_it->second.AddClass(dex_profile_index, dex::TypeIndex(type_index));
+        READ_UINT(uint32_t, buffer, count, error);
+        dex_pc_data_it->second.AddClass(dex_profile_index, dex::TypeIndex(type_index), count);
       }
     }
   }
   return true;
 }
 
+bool ProfileCompilationInfo::ReadInvokeCounts(SafeBuffer& buffer,
+                                              /*out*/ InvokeCountMap* invoke_counts,
+                                              /*out*/ std::string* error) {
+  uint16_t invoke_counts_size;
+  READ_UINT(uint16_t, buffer, invoke_counts_size, error);
+  for (; invoke_counts_size > 0; invoke_counts_size--) {
+    uint16_t dex_pc;
+    uint32_t count;
+    READ_UINT(uint16_t, buffer, dex_pc, error);
+    READ_UINT(uint32_t, buffer, count, error);
+    MergeInvokeCount(invoke_counts, dex_pc, count);
+  }
+  return true;
+}
+
 bool ProfileCompilationInfo::ReadMethods(SafeBuffer& buffer,
                                          uint8_t number_of_dex_files,
                                          const ProfileLineHeader& line_header,
@@ -589,6 +675,16 @@ bool ProfileCompilationInfo::ReadMethods(SafeBuffer& buffer,
     if (!ReadInlineCache(buffer, number_of_dex_files, &(it->second), error)) {
       return false;
     }
+    InvokeCountMap invoke_counts;
+    if (!ReadInvokeCounts(buffer, &invoke_counts, error)) {
+      return false;
+    }
+    if (!invoke_counts.empty()) {
+      InvokeCountMap* method_counts = &data->invoke_count_map.FindOrAdd(method_index)->second;
+      for (const auto& invoke_count_it : invoke_counts) {
+        MergeInvokeCount(method_counts, invoke_count_it.first, invoke_count_it.second);
+      }
+    }
   }
 
   return true;
@@ -908,12 +1004,22 @@ bool ProfileCompilationInfo::MergeWith(const ProfileCompilationInfo& other) {
           class_set->second.SetIsMegamorphic();
         } else {
           for (const auto& class_it : other_class_set) {
-            class_set->second.AddClass(dex_profile_index_remap.Get(
-                class_it.dex_profile_index), class_it.type_index);
+            class_set->second.AddClass(dex_profile_index_remap.Get(class_it.dex_profile_index),
+                                       class_it.type_index,
+                                       other_ic_it.second.GetClassCount(class_it));
           }
         }
       }
     }
+
+    // Merge the invoke counts.
+    for (const auto& other_counts_it : other_dex_data->invoke_count_map) {
+      InvokeCountMap* invoke_counts =
+          &dex_data->invoke_count_map.FindOrAdd(other_counts_it.first)->second;
+      for (const auto& other_invoke_count_it : other_counts_it.second) {
+        MergeInvokeCount(invoke_counts, other_invoke_count_it.first, other_invoke_count_it.second);
+      }
+    }
   }
   return true;
 }
@@ -965,6 +1071,13 @@ bool ProfileCompilationInfo::GetMethod(const std::string& dex_location,
 
   // TODO(calin): maybe expose a direct pointer to avoid copying
   pmi->inline_caches = *inline_caches;
+
+  const DexFileData* dex_data = FindDexData(GetProfileDexFileKey(dex_location));
+  DCHECK(dex_data != nullptr);
+  const auto counts_it = dex_data->invoke_count_map.find(dex_method_index);
+  if (counts_it != dex_data->invoke_count_map.end()) {
+    pmi->invoke_counts = counts_it->second;
+  }
   return true;
 }
 
@@ -1062,11 +1175,23 @@ std::string ProfileCompilationInfo::DumpInfo(const std::vector<const DexFile*>*
         } else {
           for (const ClassReference& class_ref : inline_cache_it.second.classes) {
             os << "(" << static_cast<uint32_t>(class_ref.dex_profile_index)
-               << "," << class_ref.type_index.index_ << ")";
+               << "," << class_ref.type_index.index_;
+            uint32_t count = inline_cache_it.second.GetClassCount(class_ref);
+            if (count != 0u) {
+              os << ",#" << count;
+            }
+            os << ")";
           }
         }
         os << "}";
       }
+      const auto counts_it = dex_data->invoke_count_map.find(method_it.first);
+      if (counts_it != dex_data->invoke_count_map.end()) {
+        for (const auto& invoke_count_it : counts_it->second) {
+          os << "{" << std::hex << invoke_count_it.first << std::dec
+             << ":#" << invoke_count_it.second << "}";
+        }
+      }
       os << "], ";
     }
     os << "\n\tclasses: ";
@@ -1207,7 +1332,8 @@ bool ProfileCompilationInfo::GenerateTestProfile(
 
 bool ProfileCompilationInfo::OfflineProfileMethodInfo::operator==(
       const OfflineProfileMethodInfo& other) const {
-  if (inline_caches.size() != other.inline_caches.size()) {
+  if (inline_caches.size() != other.inline_caches.size() ||
+      invoke_counts != other.invoke_counts) {
     return false;
   }
 
@@ -1233,7 +1359,9 @@ bool ProfileCompilationInfo::OfflineProfileMethodInfo::operator==(
         const DexReference& dex_ref = dex_references[class_ref.dex_profile_index];
         const DexReference& other_dex_ref = other.dex_references[other_class_ref.dex_profile_index];
         if (class_ref.type_index == other_class_ref.type_index &&
-            dex_ref == other_dex_ref) {
+            dex_ref == other_dex_ref &&
+            dex_pc_data.GetClassCount(class_ref) ==
+                other_dex_pc_data.GetClassCount(other_class_ref)) {
           found = true;
           break;
         }
@@ -50,9 +50,30 @@ struct ProfileMethodInfo {
                        const std::vector<ProfileClassReference>& profile_classes)
         : dex_pc(pc), is_missing_types(missing_types), classes(profile_classes) {}
 
+    ProfileInlineCache(uint32_t pc,
+                       bool missing_types,
+                       const std::vector<ProfileClassReference>& profile_classes,
+                       const std::vector<uint32_t>& profile_receiver_counts)
+        : dex_pc(pc),
+          is_missing_types(missing_types),
+          classes(profile_classes),
+          receiver_counts(profile_receiver_counts) {
+      DCHECK(receiver_counts.empty() || receiver_counts.size() == classes.size());
+    }
+
     const uint32_t dex_pc;
     const bool is_missing_types;
     const std::vector<ProfileClassReference> classes;
+    // Number of times each class of `classes` was seen as receiver, in the
+    // same order. Empty if unknown.
+    const std::vector<uint32_t> receiver_counts;
+  };
+
+  struct ProfileInvokeCount {
+    ProfileInvokeCount(uint32_t pc, uint32_t invoke_count) : dex_pc(pc), count(invoke_count) {}
+
+    const uint32_t dex_pc;
+    const uint32_t count;
   };
 
   ProfileMethodInfo(const DexFile* dex, uint32_t method_index)
@@ -63,9 +84,19 @@ struct ProfileMethodInfo {
                     const std::vector<ProfileInlineCache>& caches)
       : dex_file(dex), dex_method_index(method_index), inline_caches(caches) {}
 
+  ProfileMethodInfo(const DexFile* dex,
+                    uint32_t method_index,
+                    const std::vector<ProfileInlineCache>& caches,
+                    const std::vector<ProfileInvokeCount>& counts)
+      : dex_file(dex),
+        dex_method_index(method_index),
+        inline_caches(caches),
+        invoke_counts(counts) {}
+
   const DexFile* dex_file;
   const uint32_t dex_method_index;
   const std::vector<ProfileInlineCache> inline_caches;
+  const std::vector<ProfileInvokeCount> invoke_counts;
 };
 
 /**
@@ -135,26 +166,36 @@ class ProfileCompilationInfo {
   // The set of classes that can be found at a given dex pc.
   using ClassSet = std::set<ClassReference>;
 
+  // The number of times each class of a ClassSet was seen as receiver.
+  using ClassCountMap = SafeMap<ClassReference, uint32_t>;
+
   // Encodes the actual inline cache for a given dex pc (whether or not the receiver is
-  // megamorphic and its possible types).
+  // megamorphic and its possible types, and how often each type was seen).
   // If the receiver is megamorphic or is missing types the set of classes will be empty.
   struct DexPcData {
     DexPcData() : is_missing_types(false), is_megamorphic(false) {}
-    void AddClass(uint16_t dex_profile_idx, const dex::TypeIndex& type_idx);
+    // Add a class seen `count` times as receiver. Counts of the same class are merged by
+    // keeping the largest one, as the runtime saves snapshots of cumulative counts.
+    void AddClass(uint16_t dex_profile_idx, const dex::TypeIndex& type_idx, uint32_t count = 0u);
+    // Return the number of times the given class was seen as receiver, 0 if unknown.
+    uint32_t GetClassCount(const ClassReference& class_ref) const;
     void SetIsMegamorphic() {
       if (is_missing_types) return;
       is_megamorphic = true;
       classes.clear();
+      class_counts.clear();
     }
     void SetIsMissingTypes() {
       is_megamorphic = false;
       is_missing_types = true;
       classes.clear();
+      class_counts.clear();
     }
     bool operator==(const DexPcData& other) const {
       return is_megamorphic == other.is_megamorphic &&
           is_missing_types == other.is_missing_types &&
-          classes == other.classes;
+          classes == other.classes &&
+          class_counts == other.class_counts;
     }
 
     // Not all runtime types can be encoded in the profile. For example if the receiver
@@ -163,6 +204,8 @@ class ProfileCompilationInfo {
     bool is_missing_types;
     bool is_megamorphic;
     ClassSet classes;
+    // Only classes of `classes` with a known, non-zero count are present.
+    ClassCountMap class_counts;
   };
 
   // The inline cache map: DexPc -> DexPcData.
@@ -171,6 +214,13 @@ class ProfileCompilationInfo {
   // Maps a method dex index to its inline cache.
   using MethodMap = SafeMap<uint16_t, InlineCacheMap>;
 
+  // The invoke count map: DexPc -> number of times the invoke at DexPc was executed.
+  // Contrary to inline caches, counts are recorded for all kinds of invokes.
+  using InvokeCountMap = SafeMap<uint16_t, uint32_t>;
+
+  // Maps a method dex index to its invoke counts.
+  using InvokeCountMethodMap = SafeMap<uint16_t, InvokeCountMap>;
+
   // Encodes the full set of inline caches for a given method.
   // The dex_references vector is indexed according to the ClassReference::dex_profile_index.
   // i.e. the dex file of any ClassReference present in the inline caches can be found at
@@ -180,6 +230,7 @@ class ProfileCompilationInfo {
 
     std::vector<DexReference> dex_references;
     InlineCacheMap inline_caches;
+    InvokeCountMap invoke_counts;
   };
 
   // Public methods to create, extend or query the profile.
@@ -222,7 +273,7 @@ class ProfileCompilationInfo {
   bool ContainsClass(const DexFile& dex_file, dex::TypeIndex type_idx) const;
 
   // Return true if the method is present in the profiling info.
-  // If the method is found, `pmi` is populated with its inline caches.
+  // If the method is found, `pmi` is populated with its inline caches and invoke counts.
   bool GetMethod(const std::string& dex_location,
                  uint32_t dex_checksum,
                  uint16_t dex_method_index,
@@ -304,9 +355,13 @@ class ProfileCompilationInfo {
     // The classes which have been profiled. Note that these don't necessarily include
     // all the classes that can be found in the inline caches reference.
     std::set<dex::TypeIndex> class_set;
+    // The methods' invoke counts. Only methods present in method_map have counts.
+    InvokeCountMethodMap invoke_count_map;
 
     bool operator==(const DexFileData& other) const {
-      return checksum == other.checksum && method_map == other.method_map;
+      return checksum == other.checksum &&
+          method_map == other.method_map &&
+          invoke_count_map == other.invoke_count_map;
     }
   };
 
@@ -440,10 +495,23 @@ class ProfileCompilationInfo {
                        /*out*/InlineCacheMap* inline_cache,
                        /*out*/std::string* error);
 
+  // Read the invoke count encoding from the buffer into invoke_counts.
+  bool ReadInvokeCounts(SafeBuffer& buffer,
+                        /*out*/InvokeCountMap* invoke_counts,
+                        /*out*/std::string* error);
+
   // Encode the inline cache into the given buffer.
   void AddInlineCacheToBuffer(std::vector<uint8_t>* buffer,
                               const InlineCacheMap& inline_cache);
 
+  // Encode the invoke counts into the given buffer.
+  void AddInvokeCountsToBuffer(std::vector<uint8_t>* buffer,
+                               const InvokeCountMap* invoke_counts);
+
+  // Merge `count` into the invoke count of `dex_pc` in `invoke_counts`. The largest
+  // count is kept, as the runtime saves snapshots of the same cumulative counts.
+  static void MergeInvokeCount(InvokeCountMap* invoke_counts, uint16_t dex_pc, uint32_t count);
+
   // Return the number of bytes needed to encode the profile information
   // for the methods in dex_data.
   uint32_t GetMethodsRegionSize(const DexFileData& dex_data);
@@ -787,6 +787,123 @@ TEST_F(ProfileCompilationInfoTest, MissingTypesInlineCachesMerge) {
   ASSERT_TRUE(info_no_inline_cache.Save(GetFd(profile)));
 }
 
+TEST_F(ProfileCompilationInfoTest, SaveInvokeCounts) {
+  ScratchFile profile;
+
+  ProfileCompilationInfo saved_info;
+  ProfileCompilationInfo::OfflineProfileMethodInfo pmi = GetOfflineProfileMethodInfo();
+  // Count the invokes with inline caches, as well as invokes without.
+  for (uint16_t dex_pc = 0; dex_pc < 66; dex_pc += 3) {
+    pmi.invoke_counts.Put(dex_pc, 1000u * dex_pc);
+  }
+  pmi.invoke_counts.Put(/* dex_pc */ 100, std::numeric_limits<uint32_t>::max());
+
+  for (uint16_t method_idx = 0; method_idx < 10; method_idx++) {
+    ASSERT_TRUE(AddMethod("dex_location1", /* checksum */ 1, method_idx, pmi, &saved_info));
+  }
+  // Add a method without invoke counts.
+  ASSERT_TRUE(AddMethod("dex_location1", /* checksum */ 1, /* method_idx */ 10, &saved_info));
+
+  ASSERT_TRUE(saved_info.Save(GetFd(profile)));
+  ASSERT_EQ(0, profile.GetFile()->Flush());
+
+  // Check that we get back what we saved.
+  ProfileCompilationInfo loaded_info;
+  ASSERT_TRUE(profile.GetFile()->ResetOffset());
+  ASSERT_TRUE(loaded_info.Load(GetFd(profile)));
+  ASSERT_TRUE(loaded_info.Equals(saved_info));
+
+  ProfileCompilationInfo::OfflineProfileMethodInfo loaded_pmi;
+  ASSERT_TRUE(loaded_info.GetMethod("dex_location1",
+                                    /* checksum */ 1,
+                                    /* method_idx */ 3,
+                                    &loaded_pmi));
+  ASSERT_TRUE(loaded_pmi == pmi);
+  ASSERT_EQ(std::numeric_limits<uint32_t>::max(), loaded_pmi.invoke_counts.Get(100));
+
+  ProfileCompilationInfo::OfflineProfileMethodInfo loaded_pmi_no_counts;
+  ASSERT_TRUE(loaded_info.GetMethod("dex_location1",
+                                    /* checksum */ 1,
+                                    /* method_idx */ 10,
+                                    &loaded_pmi_no_counts));
+  ASSERT_TRUE(loaded_pmi_no_counts.invoke_counts.empty());
+}
+
+TEST_F(ProfileCompilationInfoTest, MergeInvokeCounts) {
+  ProfileCompilationInfo::OfflineProfileMethodInfo pmi1;
+  pmi1.invoke_counts.Put(/* dex_pc */ 0, 10u);
+  pmi1.invoke_counts.Put(/* dex_pc */ 5, 500u);
+  ProfileCompilationInfo info1;
+  ASSERT_TRUE(AddMethod("dex_location1", /* checksum */ 1, /* method_idx */ 0, pmi1, &info1));
+
+  ProfileCompilationInfo::OfflineProfileMethodInfo pmi2;
+  pmi2.invoke_counts.Put(/* dex_pc */ 0, 20u);
+  pmi2.invoke_counts.Put(/* dex_pc */ 5, 50u);
+  pmi2.invoke_counts.Put(/* dex_pc */ 9, 1u);
+  ProfileCompilationInfo info2;
+  ASSERT_TRUE(AddMethod("dex_location1", /* checksum */ 1, /* method_idx */ 0, pmi2, &info2));
+
+  // Merging keeps the largest count of each invoke.
+  ASSERT_TRUE(info1.MergeWith(info2));
+  ProfileCompilationInfo::OfflineProfileMethodInfo merged_pmi;
+  ASSERT_TRUE(info1.GetMethod("dex_location1",
+                              /* checksum */ 1,
+                              /* method_idx */ 0,
+                              &merged_pmi));
+  ASSERT_EQ(3u, merged_pmi.invoke_counts.size());
+  ASSERT_EQ(20u, merged_pmi.invoke_counts.Get(0));
+  ASSERT_EQ(500u, merged_pmi.invoke_counts.Get(5));
+  ASSERT_EQ(1u, merged_pmi.invoke_counts.Get(9));
+}
+
+TEST_F(ProfileCompilationInfoTest, SaveAndMergeReceiverCounts) {
+  ScratchFile profile;
+
+  ProfileCompilationInfo::OfflineProfileMethodInfo pmi1;
+  pmi1.dex_references.emplace_back("dex_location1", /* checksum */ 1);
+  ProfileCompilationInfo::DexPcData dex_pc_data1;
+  dex_pc_data1.AddClass(0, dex::TypeIndex(0), /* count */ 900u);
+  dex_pc_data1.AddClass(0, dex::TypeIndex(1), /* count */ 90u);
+  dex_pc_data1.AddClass(0, dex::TypeIndex(2), std::numeric_limits<uint32_t>::max());
+  pmi1.inline_caches.Put(/* dex_pc */ 0, dex_pc_data1);
+  ProfileCompilationInfo info1;
+  ASSERT_TRUE(AddMethod("dex_location1", /* checksum */ 1, /* method_idx */ 0, pmi1, &info1));
+
+  ASSERT_TRUE(info1.Save(GetFd(profile)));
+  ASSERT_EQ(0, profile.GetFile()->Flush());
+
+  ProfileCompilationInfo loaded_info;
+  ASSERT_TRUE(profile.GetFile()->ResetOffset());
+  ASSERT_TRUE(loaded_info.Load(GetFd(profile)));
+  ASSERT_TRUE(loaded_info.Equals(info1));
+
+  ProfileCompilationInfo::OfflineProfileMethodInfo pmi2;
+  pmi2.dex_references.emplace_back("dex_location1", /* checksum */ 1);
+  ProfileCompilationInfo::DexPcData dex_pc_data2;
+  dex_pc_data2.AddClass(0, dex::TypeIndex(0), /* count */ 100u);
+  dex_pc_data2.AddClass(0, dex::TypeIndex(1), /* count */ 200u);
+  dex_pc_data2.AddClass(0, dex::TypeIndex(3), /* count */ 5u);
+  pmi2.inline_caches.Put(/* dex_pc */ 0, dex_pc_data2);
+  ProfileCompilationInfo info2;
+  ASSERT_TRUE(AddMethod("dex_location1", /* checksum */ 1, /* method_idx */ 0, pmi2, &info2));
+
+  // Merging keeps the largest count of each receiver.
+  ASSERT_TRUE(loaded_info.MergeWith(info2));
+  ProfileCompilationInfo::OfflineProfileMethodInfo merged_pmi;
+  ASSERT_TRUE(loaded_info.GetMethod("dex_location1",
+                                    /* checksum */ 1,
+                                    /* method_idx */ 0,
+                                    &merged_pmi));
+  const ProfileCompilationInfo::DexPcData& merged_data = merged_pmi.inline_caches.Get(0);
+  ASSERT_EQ(4u, merged_data.classes.size());
+  using ClassReference = ProfileCompilationInfo::ClassReference;
+  ASSERT_EQ(900u, merged_data.GetClassCount(ClassReference(0, dex::TypeIndex(0))));
+  ASSERT_EQ(200u, merged_data.GetClassCount(ClassReference(0, dex::TypeIndex(1))));
+  ASSERT_EQ(std::numeric_limits<uint32_t>::max(),
+            merged_data.GetClassCount(ClassReference(0, dex::TypeIndex(2))));
+  ASSERT_EQ(5u, merged_data.GetClassCount(ClassReference(0, dex::TypeIndex(3))));
+}
+
 TEST_F(ProfileCompilationInfoTest, LoadShouldClearExistingDataFromProfiles) {
   ScratchFile profile;
 
@@ -25,17 +25,26 @@
 
 namespace art {
 
-ProfilingInfo::ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries)
+ProfilingInfo::ProfilingInfo(ArtMethod* method,
+                             const std::vector<uint32_t>& entries,
+                             const std::vector<uint32_t>& invoke_count_entries)
       : number_of_inline_caches_(entries.size()),
+        number_of_invoke_counts_(invoke_count_entries.size()),
         method_(method),
         is_method_being_compiled_(false),
         is_osr_method_being_compiled_(false),
         current_inline_uses_(0),
+        survived_collections_(0),
         saved_entry_point_(nullptr) {
   memset(&cache_, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
     cache_[i].dex_pc_ = entries[i];
   }
+  InvokeCount* invoke_counts = GetInvokeCounts();
+  for (size_t i = 0; i < number_of_invoke_counts_; ++i) {
+    invoke_counts[i].dex_pc = invoke_count_entries[i];
+    invoke_counts[i].count = 0u;
+  }
 }
 
 bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocation) {
@@ -49,18 +58,31 @@ bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocatio
 
   uint32_t dex_pc = 0;
   std::vector<uint32_t> entries;
+  std::vector<uint32_t> invoke_count_entries;
   while (code_ptr < code_end) {
     const Instruction& instruction = *Instruction::At(code_ptr);
     switch (instruction.Opcode()) {
       case Instruction::INVOKE_VIRTUAL:
       case Instruction::INVOKE_VIRTUAL_RANGE:
       case Instruction::INVOKE_VIRTUAL_QUICK:
+      case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+      case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
       case Instruction::INVOKE_VIRTUAL_RANGE_QUICK:
       case Instruction::INVOKE_INTERFACE:
       case Instruction::INVOKE_INTERFACE_RANGE:
         entries.push_back(dex_pc);
         break;
 
+      case Instruction::INVOKE_SUPER:
+      case Instruction::INVOKE_SUPER_RANGE:
+      case Instruction::INVOKE_DIRECT:
+      case Instruction::INVOKE_DIRECT_RANGE:
+      case Instruction::INVOKE_STATIC:
+      case Instruction::INVOKE_STATIC_RANGE:
+        // No receiver type to record, only count the executions.
+        invoke_count_entries.push_back(dex_pc);
+        break;
+
       default:
         break;
     }
@@ -73,7 +95,8 @@ bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocatio
 
   // Allocate the `ProfilingInfo` object int the JIT's data space.
   jit::JitCodeCache* code_cache = Runtime::Current()->GetJit()->GetCodeCache();
-  return code_cache->AddProfilingInfo(self, method, entries, retry_allocation) != nullptr;
+  return code_cache->AddProfilingInfo(
+      self, method, entries, invoke_count_entries, retry_allocation) != nullptr;
 }
 
 InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
@@ -87,12 +110,44 @@ InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
   UNREACHABLE();
 }
 
+uint32_t ProfilingInfo::GetInvokeCount(uint32_t dex_pc) const {
+  for (size_t i = 0; i < number_of_inline_caches_; ++i) {
+    if (cache_[i].dex_pc_ == dex_pc) {
+      return cache_[i].count_;
+    }
+  }
+  const InvokeCount* invoke_counts = GetInvokeCounts();
+  for (size_t i = 0; i < number_of_invoke_counts_; ++i) {
+    if (invoke_counts[i].dex_pc == dex_pc) {
+      return invoke_counts[i].count;
+    }
+  }
+  return 0u;
+}
+
+void ProfilingInfo::AddInvokeCount(uint32_t dex_pc) {
+  InvokeCount* invoke_counts = GetInvokeCounts();
+  for (size_t i = 0; i < number_of_invoke_counts_; ++i) {
+    if (invoke_counts[i].dex_pc == dex_pc) {
+      InlineCache::IncrementCount(&invoke_counts[i].count);
+      return;
+    }
+  }
+  LOG(FATAL) << "No invoke count found for "  << ArtMethod::PrettyMethod(method_) << "@" << dex_pc;
+  UNREACHABLE();
+}
+
 void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
-  InlineCache* cache = GetInlineCache(dex_pc);
+  AddInvokeInfo(GetInlineCache(dex_pc), cls);
+}
+
+void ProfilingInfo::AddInvokeInfo(InlineCache* cache, mirror::Class* cls) {
+  cache->IncrementCount();
   for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
     mirror::Class* existing = cache->classes_[i].Read();
     if (existing == cls) {
-      // Receiver type is already in the cache, nothing else to do.
+      // Receiver type is already in the cache, only count it.
+      InlineCache::IncrementCount(&cache->class_counts_[i]);
       return;
     } else if (existing == nullptr) {
       // Cache entry is empty, try to put `cls` in it.
@@ -104,7 +159,9 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
         // entry in case the entry contains `cls`.
         --i;
       } else {
-        // We successfully set `cls`, just return.
+        // We successfully set `cls`, count it and return. The entry may have been
+        // used by a class that got unloaded, so the count starts over.
+        cache->class_counts_[i] = 1u;
         return;
       }
     }
@@ -17,10 +17,12 @@
 #ifndef ART_RUNTIME_JIT_PROFILING_INFO_H_
 #define ART_RUNTIME_JIT_PROFILING_INFO_H_
 
+#include <limits>
 #include <vector>
 
 #include "base/macros.h"
 #include "gc_root.h"
+#include "offsets.h"
 
 namespace art {
 
@@ -37,13 +39,46 @@ class Class;
 
 // Structure to store the classes seen at runtime for a specific instruction.
 // Once the classes_ array is full, we consider the INVOKE to be megamorphic.
+// Only used for virtual and interface invokes, together with how often the INVOKE
+// was executed and how often each of the classes was seen as receiver.
 class InlineCache {
  public:
-  static constexpr uint8_t kIndividualCacheSize = 5;
+  static constexpr uint8_t kIndividualCacheSize = 8;
+
+  // Offsets used by JIT baseline code, which counts invokes of the first receiver class
+  // without calling the runtime.
+  static MemberOffset CountOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(InlineCache, count_));
+  }
+
+  static MemberOffset ClassesOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(InlineCache, classes_));
+  }
+
+  static MemberOffset ClassCountsOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(InlineCache, class_counts_));
+  }
 
  private:
   uint32_t dex_pc_;
+  // Number of times the INVOKE was executed, saturating at the maximum value.
+  // Updates are racy, so the count is only an approximation.
+  uint32_t count_;
   GcRoot<mirror::Class> classes_[kIndividualCacheSize];
+  // Number of times the class at the same index in classes_ was seen as receiver,
+  // saturating at the maximum value. Updates are racy, like for `count_`.
+  uint32_t class_counts_[kIndividualCacheSize];
+
+  static void IncrementCount(uint32_t* count) {
+    // The increment is racy, as profiling is best effort and not worth an atomic operation.
+    if (*count != std::numeric_limits<uint32_t>::max()) {
+      (*count)++;
+    }
+  }
+
+  void IncrementCount() {
+    IncrementCount(&count_);
+  }
 
   friend class jit::JitCodeCache;
   friend class ProfilingInfo;
@@ -57,8 +92,7 @@ class InlineCache {
  */
 class ProfilingInfo {
  public:
-  // Create a ProfilingInfo for 'method'. Return whether it succeeded, or if it is
-  // not needed in case the method does not have virtual/interface invocations.
+  // Create a ProfilingInfo for 'method'. Return whether it succeeded.
   static bool Create(Thread* self, ArtMethod* method, bool retry_allocation)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -69,6 +103,33 @@ class ProfilingInfo {
       REQUIRES(Roles::uninterruptible_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Same as above, for JIT baseline code which knows the inline cache of the INVOKE.
+  static void AddInvokeInfo(InlineCache* cache, mirror::Class* cls)
+      REQUIRES(Roles::uninterruptible_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Add information from an executed INVOKE instruction without a receiver type
+  // to the profile, that is a static, direct or super invoke.
+  void AddInvokeCount(uint32_t dex_pc)
+      REQUIRES(Roles::uninterruptible_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Return the number of times the INVOKE at `dex_pc` has been executed,
+  // or 0 if there is no INVOKE at `dex_pc`.
+  uint32_t GetInvokeCount(uint32_t dex_pc) const;
+
+  // Call `visitor` with the dex pc and execution count of each INVOKE.
+  template <typename Visitor>
+  void VisitInvokeCounts(const Visitor& visitor) const {
+    for (size_t i = 0; i < number_of_inline_caches_; ++i) {
+      visitor(cache_[i].dex_pc_, cache_[i].count_);
+    }
+    const InvokeCount* invoke_counts = GetInvokeCounts();
+    for (size_t i = 0; i < number_of_invoke_counts_; ++i) {
+      visitor(invoke_counts[i].dex_pc, invoke_counts[i].count);
+    }
+  }
+
   ArtMethod* GetMethod() const {
     return method_;
   }
@@ -105,6 +166,7 @@ class ProfilingInfo {
       memset(&cache->classes_[0],
              0,
              InlineCache::kIndividualCacheSize * sizeof(GcRoot<mirror::Class>));
+      memset(&cache->class_counts_[0], 0, InlineCache::kIndividualCacheSize * sizeof(uint32_t));
     }
   }
 
@@ -124,17 +186,63 @@ class ProfilingInfo {
     current_inline_uses_--;
   }
 
+  // Number of consecutive full code cache collections the compiled code of the method
+  // survived by being used. The code cache keeps the code of methods that survived a few
+  // of them in its hot generation.
+  uint8_t GetSurvivedCollections() const {
+    return survived_collections_;
+  }
+
+  void IncrementSurvivedCollections() {
+    if (survived_collections_ != std::numeric_limits<uint8_t>::max()) {
+      survived_collections_++;
+    }
+  }
+
+  void ResetSurvivedCollections() {
+    survived_collections_ = 0;
+  }
+
   bool IsInUseByCompiler() const {
     return IsMethodBeingCompiled(/*osr*/ true) || IsMethodBeingCompiled(/*osr*/ false) ||
         (current_inline_uses_ > 0);
   }
 
  private:
-  ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries);
+  // Execution count of a static, direct or super INVOKE, which needs no InlineCache.
+  struct InvokeCount {
+    uint32_t dex_pc;
+    // Saturating and racy, like InlineCache::count_.
+    uint32_t count;
+  };
+
+  ProfilingInfo(ArtMethod* method,
+                const std::vector<uint32_t>& entries,
+                const std::vector<uint32_t>& invoke_count_entries);
+
+  // Size of a ProfilingInfo with `number_of_inline_caches` inline caches and
+  // `number_of_invoke_counts` invoke counts.
+  static size_t ComputeSize(size_t number_of_inline_caches, size_t number_of_invoke_counts) {
+    return sizeof(ProfilingInfo) +
+        number_of_inline_caches * sizeof(InlineCache) +
+        number_of_invoke_counts * sizeof(InvokeCount);
+  }
+
+  // The invoke counts follow the inline caches.
+  InvokeCount* GetInvokeCounts() {
+    return reinterpret_cast<InvokeCount*>(&cache_[number_of_inline_caches_]);
+  }
 
-  // Number of instructions we are profiling in the ArtMethod.
+  const InvokeCount* GetInvokeCounts() const {
+    return reinterpret_cast<const InvokeCount*>(&cache_[number_of_inline_caches_]);
+  }
+
+  // Number of virtual and interface instructions we are profiling in the ArtMethod.
   const uint32_t number_of_inline_caches_;
 
+  // Number of static, direct and super instructions we are counting in the ArtMethod.
+  const uint32_t number_of_invoke_counts_;
+
   // Method this profiling info is for.
   // Not 'const' as JVMTI introduces obsolete methods that we implement by creating new ArtMethods.
   // See JitCodeCache::MoveObsoleteMethod.
@@ -150,11 +258,15 @@ class ProfilingInfo {
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
+  // Implicitly guarded by the JIT code cache lock, like `is_method_being_compiled_`.
+  uint8_t survived_collections_;
+
   // Entry point of the corresponding ArtMethod, while the JIT code cache
   // is poking for the liveness of compiled code.
   const void* saved_entry_point_;
 
-  // Dynamically allocated array of size `number_of_inline_caches_`.
+  // Dynamically allocated array of size `number_of_inline_caches_`, followed by
+  // the array of `number_of_invoke_counts_` InvokeCount.
   InlineCache cache_[0];
 
   friend class jit::JitCodeCache;
@@ -125,6 +125,7 @@ void CodeInfo::Dump(VariableIndentationOutputStream* vios,
   vios->Stream()
       << "Optimized CodeInfo (number_of_dex_registers=" << number_of_dex_registers
       << ", number_of_stack_maps=" << number_of_stack_maps
+      << ", number_of_catch_stack_maps=" << GetNumberOfCatchStackMaps(encoding)
       << ")\n";
   ScopedIndentation indent1(vios);
   encoding.stack_map.encoding.Dump(vios);
@@ -83,8 +83,9 @@ class DexRegisterLocation {
     kInFpuRegisterHigh = 4,   // 0b100
     kConstant = 5,            // 0b101
 
-    // Large location kinds, requiring a 5-byte encoding (1 byte for the
-    // kind, 4 bytes for the value).
+    // Large location kinds, requiring a multi-byte encoding (1 byte for the
+    // kind, followed by the value as a signed LEB128 delta, see
+    // DexRegisterLocationCatalog).
 
     // Stack location at a large offset, meaning that the offset value
     // divided by the stack frame slot size (4 bytes) cannot fit on a
@@ -195,7 +196,9 @@ std::ostream& operator<<(std::ostream& stream, const DexRegisterLocation::Kind&
  *
  *   [DexRegisterLocation+].
  *
- * DexRegisterLocations are either 1- or 5-byte wide (see art::DexRegisterLocation::Kind).
+ * DexRegisterLocations are either 1-byte wide, or 1 byte followed by a signed LEB128
+ * holding the difference between the value and the value of the previous large
+ * location of the catalog (see art::DexRegisterLocation::Kind).
  */
 class DexRegisterLocationCatalog {
  public:
@@ -204,66 +207,40 @@ class DexRegisterLocationCatalog {
   // Short (compressed) location, fitting on one byte.
   typedef uint8_t ShortLocation;
 
-  void SetRegisterInfo(size_t offset, const DexRegisterLocation& dex_register_location) {
+  // Store `dex_register_location` at `offset` and return the size of its entry.
+  // `previous_large_value` holds the encoded value of the last large location stored
+  // in the catalog (0 if there is none) and is updated if the location is large.
+  size_t SetRegisterInfo(size_t offset,
+                         const DexRegisterLocation& dex_register_location,
+                         int32_t* previous_large_value) {
     DexRegisterLocation::Kind kind = ComputeCompressedKind(dex_register_location);
-    int32_t value = dex_register_location.GetValue();
+    int32_t value = EncodeValue(kind, dex_register_location.GetValue());
     if (DexRegisterLocation::IsShortLocationKind(kind)) {
       // Short location.  Compress the kind and the value as a single byte.
-      if (kind == DexRegisterLocation::Kind::kInStack) {
-        // Instead of storing stack offsets expressed in bytes for
-        // short stack locations, store slot offsets.  A stack offset
-        // is a multiple of 4 (kFrameSlotSize).  This means that by
-        // dividing it by 4, we can fit values from the [0, 128)
-        // interval in a short stack location, and not just values
-        // from the [0, 32) interval.
-        DCHECK_EQ(value % kFrameSlotSize, 0);
-        value /= kFrameSlotSize;
-      }
       DCHECK(IsShortValue(value)) << value;
       region_.StoreUnaligned<ShortLocation>(offset, MakeShortLocation(kind, value));
+      return SingleShortEntrySize();
     } else {
-      // Large location.  Write the location on one byte and the value
-      // on 4 bytes.
+      // Large location.  Write the location on one byte and the difference with
+      // the previous large value as a signed LEB128.  The stream sorts the large
+      // locations by kind and value, so the difference usually fits on one or two bytes.
       DCHECK(!IsShortValue(value)) << value;
-      if (kind == DexRegisterLocation::Kind::kInStackLargeOffset) {
-        // Also divide large stack offsets by 4 for the sake of consistency.
-        DCHECK_EQ(value % kFrameSlotSize, 0);
-        value /= kFrameSlotSize;
-      }
-      // Data can be unaligned as the written Dex register locations can
-      // either be 1-byte or 5-byte wide.  Use
-      // art::MemoryRegion::StoreUnaligned instead of
-      // art::MemoryRegion::Store to prevent unligned word accesses on ARM.
+      int32_t delta = LargeValueDelta(value, *previous_large_value);
+      *previous_large_value = value;
       region_.StoreUnaligned<DexRegisterLocation::Kind>(offset, kind);
-      region_.StoreUnaligned<int32_t>(offset + sizeof(DexRegisterLocation::Kind), value);
+      uint8_t* delta_begin = region_.PointerTo<uint8_t>(offset + sizeof(DexRegisterLocation::Kind));
+      uint8_t* delta_end = EncodeSignedLeb128(delta_begin, delta);
+      DCHECK_LE(offset + sizeof(DexRegisterLocation::Kind) + (delta_end - delta_begin), Size());
+      return sizeof(DexRegisterLocation::Kind) + (delta_end - delta_begin);
     }
   }
 
-  // Find the offset of the location catalog entry number `location_catalog_entry_index`.
-  size_t FindLocationOffset(size_t location_catalog_entry_index) const {
-    size_t offset = kFixedSize;
-    // Skip the first `location_catalog_entry_index - 1` entries.
-    for (uint16_t i = 0; i < location_catalog_entry_index; ++i) {
-      // Read the first next byte and inspect its first 3 bits to decide
-      // whether it is a short or a large location.
-      DexRegisterLocation::Kind kind = ExtractKindAtOffset(offset);
-      if (DexRegisterLocation::IsShortLocationKind(kind)) {
-        // Short location.  Skip the current byte.
-        offset += SingleShortEntrySize();
-      } else {
-        // Large location.  Skip the 5 next bytes.
-        offset += SingleLargeEntrySize();
-      }
-    }
-    return offset;
-  }
-
   // Get the internal kind of entry at `location_catalog_entry_index`.
   DexRegisterLocation::Kind GetLocationInternalKind(size_t location_catalog_entry_index) const {
     if (location_catalog_entry_index == kNoLocationEntryIndex) {
       return DexRegisterLocation::Kind::kNone;
     }
-    return ExtractKindAtOffset(FindLocationOffset(location_catalog_entry_index));
+    return GetDexRegisterLocation(location_catalog_entry_index).GetInternalKind();
   }
 
   // Get the (surface) kind and value of entry at `location_catalog_entry_index`.
@@ -271,27 +248,39 @@ class DexRegisterLocationCatalog {
     if (location_catalog_entry_index == kNoLocationEntryIndex) {
       return DexRegisterLocation::None();
     }
-    size_t offset = FindLocationOffset(location_catalog_entry_index);
-    // Read the first byte and inspect its first 3 bits to get the location.
-    ShortLocation first_byte = region_.LoadUnaligned<ShortLocation>(offset);
-    DexRegisterLocation::Kind kind = ExtractKindFromShortLocation(first_byte);
-    if (DexRegisterLocation::IsShortLocationKind(kind)) {
-      // Short location.  Extract the value from the remaining 5 bits.
-      int32_t value = ExtractValueFromShortLocation(first_byte);
-      if (kind == DexRegisterLocation::Kind::kInStack) {
-        // Convert the stack slot (short) offset to a byte offset value.
-        value *= kFrameSlotSize;
-      }
-      return DexRegisterLocation(kind, value);
-    } else {
-      // Large location.  Read the four next bytes to get the value.
-      int32_t value = region_.LoadUnaligned<int32_t>(offset + sizeof(DexRegisterLocation::Kind));
-      if (kind == DexRegisterLocation::Kind::kInStackLargeOffset) {
-        // Convert the stack slot (large) offset to a byte offset value.
-        value *= kFrameSlotSize;
-      }
-      return DexRegisterLocation(kind, value);
+    // Entries are variable-sized and large values are stored as deltas, so decode
+    // all the entries up to the requested one.  Catalogs are small.
+    size_t offset = kFixedSize;
+    int32_t previous_large_value = 0;
+    for (size_t i = 0; i < location_catalog_entry_index; ++i) {
+      ReadEntry(&offset, &previous_large_value);
+    }
+    return ReadEntry(&offset, &previous_large_value);
+  }
+
+  // Compute the size of the first `number_of_entries` entries of the catalog.
+  size_t ComputeSize(size_t number_of_entries) const {
+    size_t offset = kFixedSize;
+    int32_t previous_large_value = 0;
+    for (size_t i = 0; i < number_of_entries; ++i) {
+      ReadEntry(&offset, &previous_large_value);
+    }
+    return offset;
+  }
+
+  // Compute the size the first `number_of_entries` entries of the catalog would
+  // take if large values were stored in full, on four bytes.  Used for statistics.
+  size_t ComputeSizeWithoutDeltas(size_t number_of_entries) const {
+    size_t size = kFixedSize;
+    size_t offset = kFixedSize;
+    int32_t previous_large_value = 0;
+    for (size_t i = 0; i < number_of_entries; ++i) {
+      DexRegisterLocation location = ReadEntry(&offset, &previous_large_value);
+      size += DexRegisterLocation::IsShortLocationKind(location.GetInternalKind())
+          ? SingleShortEntrySize()
+          : sizeof(DexRegisterLocation::Kind) + sizeof(int32_t);
     }
+    return size;
   }
 
   // Compute the compressed kind of `location`.
@@ -352,18 +341,22 @@ class DexRegisterLocationCatalog {
     UNREACHABLE();
   }
 
-  static size_t EntrySize(const DexRegisterLocation& location) {
-    return CanBeEncodedAsShortLocation(location) ? SingleShortEntrySize() : SingleLargeEntrySize();
+  // Return the size of the entry of `location`, given the encoded value of the
+  // previous large location, and update the latter if `location` is large.
+  static size_t EntrySize(const DexRegisterLocation& location, int32_t* previous_large_value) {
+    if (CanBeEncodedAsShortLocation(location)) {
+      return SingleShortEntrySize();
+    }
+    int32_t value = EncodeValue(ComputeCompressedKind(location), location.GetValue());
+    int32_t delta = LargeValueDelta(value, *previous_large_value);
+    *previous_large_value = value;
+    return sizeof(DexRegisterLocation::Kind) + SignedLeb128Size(delta);
   }
 
   static size_t SingleShortEntrySize() {
     return sizeof(ShortLocation);
   }
 
-  static size_t SingleLargeEntrySize() {
-    return sizeof(DexRegisterLocation::Kind) + sizeof(int32_t);
-  }
-
   size_t Size() const {
     return region_.size();
   }
@@ -422,10 +415,55 @@ class DexRegisterLocationCatalog {
     return (location >> kValueOffset) & kValueMask;
   }
 
-  // Extract a location kind from the byte at position `offset`.
-  DexRegisterLocation::Kind ExtractKindAtOffset(size_t offset) const {
-    ShortLocation first_byte = region_.LoadUnaligned<ShortLocation>(offset);
-    return ExtractKindFromShortLocation(first_byte);
+  // Instead of storing stack offsets expressed in bytes, store slot offsets.
+  // A stack offset is a multiple of 4 (kFrameSlotSize).  This means that by
+  // dividing it by 4, we can fit values from the [0, 128) interval in a short
+  // stack location, and not just values from the [0, 32) interval.
+  static int32_t EncodeValue(DexRegisterLocation::Kind kind, int32_t value) {
+    if (kind == DexRegisterLocation::Kind::kInStack ||
+        kind == DexRegisterLocation::Kind::kInStackLargeOffset) {
+      DCHECK_EQ(value % kFrameSlotSize, 0);
+      return value / kFrameSlotSize;
+    }
+    return value;
+  }
+
+  static int32_t DecodeValue(DexRegisterLocation::Kind kind, int32_t value) {
+    if (kind == DexRegisterLocation::Kind::kInStack ||
+        kind == DexRegisterLocation::Kind::kInStackLargeOffset) {
+      return value * kFrameSlotSize;
+    }
+    return value;
+  }
+
+  // Difference between two large values, with wrap-around so that any pair of
+  // 32-bit values can be encoded.
+  static int32_t LargeValueDelta(int32_t value, int32_t previous_large_value) {
+    return static_cast<int32_t>(
+        static_cast<uint32_t>(value) - static_cast<uint32_t>(previous_large_value));
+  }
+
+  // Decode the entry at `*offset` and advance `*offset` past it.
+  DexRegisterLocation ReadEntry(size_t* offset, int32_t* previous_large_value) const {
+    // Read the first byte and inspect its first 3 bits to get the location.
+    ShortLocation first_byte = region_.LoadUnaligned<ShortLocation>(*offset);
+    DexRegisterLocation::Kind kind = ExtractKindFromShortLocation(first_byte);
+    if (DexRegisterLocation::IsShortLocationKind(kind)) {
+      // Short location.  Extract the value from the remaining 5 bits.
+      *offset += SingleShortEntrySize();
+      int32_t value = ExtractValueFromShortLocation(first_byte);
+      return DexRegisterLocation(kind, DecodeValue(kind, value));
+    } else {
+      // Large location.  Read the delta with the previous large value.
+      const uint8_t* data = region_.PointerTo<uint8_t>(*offset + sizeof(DexRegisterLocation::Kind));
+      const uint8_t* data_begin = data;
+      int32_t delta = DecodeSignedLeb128(&data);
+      *offset += sizeof(DexRegisterLocation::Kind) + (data - data_begin);
+      int32_t value = static_cast<int32_t>(
+          static_cast<uint32_t>(*previous_large_value) + static_cast<uint32_t>(delta));
+      *previous_large_value = value;
+      return DexRegisterLocation(kind, DecodeValue(kind, value));
+    }
   }
 
   MemoryRegion region_;
@@ -1268,6 +1306,9 @@ struct CodeInfoEncoding {
   BitEncodingTable<BitRegionEncoding> stack_mask;
   BitEncodingTable<InvokeInfoEncoding> invoke_info;
   BitEncodingTable<InlineInfoEncoding> inline_info;
+  // Number of catch stack maps. They are stored after the other stack maps, which
+  // are sorted by native pc offset.
+  uint32_t number_of_catch_stack_maps = 0;
 
   CodeInfoEncoding() {}
 
@@ -1276,6 +1317,7 @@ struct CodeInfoEncoding {
     dex_register_map.Decode(&ptr);
     location_catalog.Decode(&ptr);
     stack_map.Decode(&ptr);
+    number_of_catch_stack_maps = DecodeUnsignedLeb128(&ptr);
     register_mask.Decode(&ptr);
     stack_mask.Decode(&ptr);
     invoke_info.Decode(&ptr);
@@ -1295,6 +1337,7 @@ struct CodeInfoEncoding {
     dex_register_map.Encode(dest);
     location_catalog.Encode(dest);
     stack_map.Encode(dest);
+    EncodeUnsignedLeb128(dest, number_of_catch_stack_maps);
     register_mask.Encode(dest);
     stack_mask.Encode(dest);
     invoke_info.Encode(dest);
@@ -1347,8 +1390,9 @@ struct CodeInfoEncoding {
  * where CodeInfoEncoding is of the form:
  *
  *   [ByteSizedTable(dex_register_map), ByteSizedTable(location_catalog),
- *    BitEncodingTable<StackMapEncoding>, BitEncodingTable<BitRegionEncoding>,
- *    BitEncodingTable<BitRegionEncoding>, BitEncodingTable<InlineInfoEncoding>]
+ *    BitEncodingTable<StackMapEncoding>, number_of_catch_stack_maps,
+ *    BitEncodingTable<BitRegionEncoding>, BitEncodingTable<BitRegionEncoding>,
+ *    BitEncodingTable<InvokeInfoEncoding>, BitEncodingTable<InlineInfoEncoding>]
  */
 class CodeInfo {
  public:
@@ -1414,6 +1458,11 @@ class CodeInfo {
     return encoding.stack_map.num_entries;
   }
 
+  // Catch stack maps are the last `GetNumberOfCatchStackMaps()` stack maps.
+  uint32_t GetNumberOfCatchStackMaps(const CodeInfoEncoding& encoding) const {
+    return encoding.number_of_catch_stack_maps;
+  }
+
   // Get the size of all the stack maps of this CodeInfo object, in bits. Not byte aligned.
   ALWAYS_INLINE size_t GetStackMapsSizeInBits(const CodeInfoEncoding& encoding) const {
     return encoding.stack_map.encoding.BitSize() * GetNumberOfStackMaps(encoding);
@@ -1487,10 +1536,10 @@ class CodeInfo {
     return StackMap();
   }
 
-  // Searches the stack map list backwards because catch stack maps are stored
-  // at the end.
+  // Only searches the catch stack maps, which are stored at the end.
   StackMap GetCatchStackMapForDexPc(uint32_t dex_pc, const CodeInfoEncoding& encoding) const {
-    for (size_t i = GetNumberOfStackMaps(encoding); i > 0; --i) {
+    size_t first_catch = GetNumberOfStackMaps(encoding) - GetNumberOfCatchStackMaps(encoding);
+    for (size_t i = GetNumberOfStackMaps(encoding); i > first_catch; --i) {
       StackMap stack_map = GetStackMapAt(i - 1, encoding);
       if (stack_map.GetDexPc(encoding.stack_map.encoding) == dex_pc) {
         return stack_map;
@@ -1533,13 +1582,32 @@ class CodeInfo {
 
   StackMap GetStackMapForNativePcOffset(uint32_t native_pc_offset,
                                         const CodeInfoEncoding& encoding) const {
-    // TODO: Safepoint stack maps are sorted by native_pc_offset but catch stack
-    //       maps are not. If we knew that the method does not have try/catch,
-    //       we could do binary search.
-    for (size_t i = 0, e = GetNumberOfStackMaps(encoding); i < e; ++i) {
-      StackMap stack_map = GetStackMapAt(i, encoding);
-      if (stack_map.GetNativePcOffset(encoding.stack_map.encoding, kRuntimeISA) ==
+    const StackMapEncoding& stack_map_encoding = encoding.stack_map.encoding;
+    size_t end = GetNumberOfStackMaps(encoding);
+    size_t first_catch = end - GetNumberOfCatchStackMaps(encoding);
+    // Safepoint stack maps are sorted by native_pc_offset, so binary search for
+    // the first one at `native_pc_offset`.
+    size_t low = 0;
+    size_t high = first_catch;
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (GetStackMapAt(mid, encoding).GetNativePcOffset(stack_map_encoding, kRuntimeISA) <
           native_pc_offset) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    if (low < first_catch) {
+      StackMap stack_map = GetStackMapAt(low, encoding);
+      if (stack_map.GetNativePcOffset(stack_map_encoding, kRuntimeISA) == native_pc_offset) {
+        return stack_map;
+      }
+    }
+    // Catch stack maps are not sorted, but there are few of them.
+    for (size_t i = first_catch; i < end; ++i) {
+      StackMap stack_map = GetStackMapAt(i, encoding);
+      if (stack_map.GetNativePcOffset(stack_map_encoding, kRuntimeISA) == native_pc_offset) {
         return stack_map;
       }
     }
@@ -1548,8 +1616,21 @@ class CodeInfo {
 
   InvokeInfo GetInvokeInfoForNativePcOffset(uint32_t native_pc_offset,
                                             const CodeInfoEncoding& encoding) {
-    for (size_t index = 0; index < encoding.invoke_info.num_entries; index++) {
-      InvokeInfo item = GetInvokeInfo(encoding, index);
+    // Invoke infos follow the order of the safepoint stack maps, so they are
+    // sorted by native_pc_offset too.
+    size_t low = 0;
+    size_t high = encoding.invoke_info.num_entries;
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (GetInvokeInfo(encoding, mid).GetNativePcOffset(encoding.invoke_info.encoding,
+                                                         kRuntimeISA) < native_pc_offset) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    if (low < encoding.invoke_info.num_entries) {
+      InvokeInfo item = GetInvokeInfo(encoding, low);
       if (item.GetNativePcOffset(encoding.invoke_info.encoding, kRuntimeISA) == native_pc_offset) {
         return item;
       }
@@ -1611,29 +1692,8 @@ class CodeInfo {
   // in `region_` and containing `number_of_dex_locations` entries.
   size_t ComputeDexRegisterLocationCatalogSize(uint32_t origin,
                                                uint32_t number_of_dex_locations) const {
-    // TODO: Ideally, we would like to use art::DexRegisterLocationCatalog::Size or
-    // art::DexRegisterLocationCatalog::FindLocationOffset, but the
-    // DexRegisterLocationCatalog is not yet built.  Try to factor common code.
-    size_t offset = origin + DexRegisterLocationCatalog::kFixedSize;
-
-    // Skip the first `number_of_dex_locations - 1` entries.
-    for (uint16_t i = 0; i < number_of_dex_locations; ++i) {
-      // Read the first next byte and inspect its first 3 bits to decide
-      // whether it is a short or a large location.
-      DexRegisterLocationCatalog::ShortLocation first_byte =
-          region_.LoadUnaligned<DexRegisterLocationCatalog::ShortLocation>(offset);
-      DexRegisterLocation::Kind kind =
-          DexRegisterLocationCatalog::ExtractKindFromShortLocation(first_byte);
-      if (DexRegisterLocation::IsShortLocationKind(kind)) {
-        // Short location.  Skip the current byte.
-        offset += DexRegisterLocationCatalog::SingleShortEntrySize();
-      } else {
-        // Large location.  Skip the 5 next bytes.
-        offset += DexRegisterLocationCatalog::SingleLargeEntrySize();
-      }
-    }
-    size_t size = offset - origin;
-    return size;
+    DexRegisterLocationCatalog catalog(region_.Subregion(origin, region_.size() - origin));
+    return catalog.ComputeSize(number_of_dex_locations);
   }
 
   MemoryRegion region_;
@@ -311,6 +311,14 @@ inline mirror::Object* Thread::AllocTlab(size_t bytes) {
   return ret;
 }
 
+inline mirror::Object* Thread::AllocEvacBuffer(size_t bytes) {
+  DCHECK_GE(EvacBufferSize(), bytes);
+  ++tlsPtr_.thread_local_evac_objects;
+  mirror::Object* ret = reinterpret_cast<mirror::Object*>(tlsPtr_.thread_local_evac_pos);
+  tlsPtr_.thread_local_evac_pos += bytes;
+  return ret;
+}
+
 inline bool Thread::PushOnThreadLocalAllocationStack(mirror::Object* obj) {
   DCHECK_LE(tlsPtr_.thread_local_alloc_stack_top, tlsPtr_.thread_local_alloc_stack_end);
   if (tlsPtr_.thread_local_alloc_stack_top < tlsPtr_.thread_local_alloc_stack_end) {
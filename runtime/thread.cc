@@ -1986,6 +1986,9 @@ Thread::Thread(bool daemon)
   }
   tlsPtr_.flip_function = nullptr;
   tlsPtr_.thread_local_mark_stack = nullptr;
+  tlsPtr_.thread_local_evac_pos = nullptr;
+  tlsPtr_.thread_local_evac_end = nullptr;
+  tlsPtr_.thread_local_evac_objects = 0;
   tls32_.is_transitioning_to_runnable = false;
 }
 
@@ -2108,6 +2111,7 @@ void Thread::Destroy() {
     Runtime::Current()->GetHeap()->RevokeThreadLocalBuffers(this);
     if (kUseReadBarrier) {
       Runtime::Current()->GetHeap()->ConcurrentCopyingCollector()->RevokeThreadLocalMarkStack(this);
+      Runtime::Current()->GetHeap()->ConcurrentCopyingCollector()->RevokeThreadLocalEvacBuffer(this);
     }
   }
 }
@@ -2918,6 +2922,8 @@ void Thread::DumpThreadOffset(std::ostream& os, uint32_t offset) {
   QUICK_ENTRY_POINT_INFO(pInvokeVirtualTrampolineWithAccessCheck)
   QUICK_ENTRY_POINT_INFO(pInvokePolymorphic)
   QUICK_ENTRY_POINT_INFO(pTestSuspend)
+  QUICK_ENTRY_POINT_INFO(pCompileOptimized)
+  QUICK_ENTRY_POINT_INFO(pUpdateInlineCache)
   QUICK_ENTRY_POINT_INFO(pDeliverException)
   QUICK_ENTRY_POINT_INFO(pThrowArrayBounds)
   QUICK_ENTRY_POINT_INFO(pThrowDivZero)
@@ -3479,6 +3485,13 @@ void Thread::SetTlab(uint8_t* start, uint8_t* end, uint8_t* limit) {
   tlsPtr_.thread_local_objects = 0;
 }
 
+void Thread::SetEvacBuffer(uint8_t* start, uint8_t* end) {
+  DCHECK_LE(start, end);
+  tlsPtr_.thread_local_evac_pos = start;
+  tlsPtr_.thread_local_evac_end = end;
+  tlsPtr_.thread_local_evac_objects = 0;
+}
+
 bool Thread::HasTlab() const {
   bool has_tlab = tlsPtr_.thread_local_pos != nullptr;
   if (has_tlab) {
@@ -1061,6 +1061,26 @@ class Thread {
     return tlsPtr_.thread_local_pos;
   }
 
+  // The buffer the concurrent copying collector copies objects into on behalf of this thread.
+  size_t EvacBufferSize() const {
+    return tlsPtr_.thread_local_evac_end - tlsPtr_.thread_local_evac_pos;
+  }
+  // Doesn't check that there is room.
+  mirror::Object* AllocEvacBuffer(size_t bytes);
+  void SetEvacBuffer(uint8_t* start, uint8_t* end);
+  bool HasEvacBuffer() const {
+    return tlsPtr_.thread_local_evac_end != nullptr;
+  }
+  uint8_t* GetEvacBufferPos() const {
+    return tlsPtr_.thread_local_evac_pos;
+  }
+  uint8_t* GetEvacBufferEnd() const {
+    return tlsPtr_.thread_local_evac_end;
+  }
+  size_t GetEvacBufferObjectsAllocated() const {
+    return tlsPtr_.thread_local_evac_objects;
+  }
+
   // Remove the suspend trigger for this thread by making the suspend_trigger_ TLS value
   // equal to a valid pointer.
   // TODO: does this need to atomic?  I don't think so.
@@ -1469,7 +1489,9 @@ class Thread {
       thread_local_objects(0), mterp_current_ibase(nullptr), mterp_default_ibase(nullptr),
       mterp_alt_ibase(nullptr), thread_local_alloc_stack_top(nullptr),
       thread_local_alloc_stack_end(nullptr),
-      flip_function(nullptr), method_verifier(nullptr), thread_local_mark_stack(nullptr) {
+      flip_function(nullptr), method_verifier(nullptr), thread_local_mark_stack(nullptr),
+      thread_local_evac_pos(nullptr), thread_local_evac_end(nullptr),
+      thread_local_evac_objects(0) {
       std::fill(held_mutexes, held_mutexes + kLockLevelCount, nullptr);
     }
 
@@ -1626,6 +1648,11 @@ class Thread {
 
     // Thread-local mark stack for the concurrent copying collector.
     gc::accounting::AtomicStack<mirror::Object>* thread_local_mark_stack;
+
+    // Thread-local evacuation buffer for the concurrent copying collector.
+    uint8_t* thread_local_evac_pos;
+    uint8_t* thread_local_evac_end;
+    size_t thread_local_evac_objects;
   } tlsPtr_;
 
   // Guards the 'interrupted_' and 'wait_monitor_' members.
@@ -38,6 +38,10 @@ class Task : public Closure {
  public:
   // Called after Closure::Run has been called.
   virtual void Finalize() { }
+
+  // Tasks with a higher priority are run first, tasks of the same priority in the order they were
+  // added. Must not change while the task is queued.
+  virtual uint32_t GetPriority() const { return 0; }
 };
 
 class SelfDeletingTask : public Task {
@@ -99,7 +103,8 @@ class ThreadPool {
   void StopWorkers(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Add a new task, the first available started worker will process it. Does not delete the task
-  // after running it, it is the caller's responsibility.
+  // after running it, it is the caller's responsibility. The queued tasks are ordered by priority,
+  // see Task::GetPriority().
   void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
 
   // Remove all tasks in the queue.
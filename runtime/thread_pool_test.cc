@@ -122,6 +122,43 @@ TEST_F(ThreadPoolTest, StopWait) {
   thread_pool.Wait(self, /* do_work */ true, false);
 }
 
+class PriorityTask : public Task {
+ public:
+  PriorityTask(uint32_t priority, std::vector<uint32_t>* order)
+      : priority_(priority), order_(order) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) {
+    order_->push_back(priority_);
+  }
+
+  void Finalize() {
+    delete this;
+  }
+
+  uint32_t GetPriority() const OVERRIDE {
+    return priority_;
+  }
+
+ private:
+  const uint32_t priority_;
+  std::vector<uint32_t>* const order_;
+};
+
+// Check that the tasks are run by decreasing priority, and in FIFO order for the same priority.
+TEST_F(ThreadPoolTest, PriorityTest) {
+  Thread* self = Thread::Current();
+  ThreadPool thread_pool("Thread pool test thread pool", 1);
+  std::vector<uint32_t> order;
+  for (uint32_t priority : {0u, 2u, 1u, 2u, 0u, 3u}) {
+    thread_pool.AddTask(self, new PriorityTask(priority, &order));
+  }
+  EXPECT_EQ(6u, thread_pool.GetTaskCount(self));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  std::vector<uint32_t> expected = {3u, 2u, 2u, 1u, 0u, 0u};
+  EXPECT_EQ(expected, order);
+}
+
 class TreeTask : public Task {
  public:
   TreeTask(ThreadPool* const thread_pool, AtomicInteger* count, int depth)
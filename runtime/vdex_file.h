@@ -63,7 +63,7 @@ class VdexFile {
 
    private:
     static constexpr uint8_t kVdexMagic[] = { 'v', 'd', 'e', 'x' };
-    static constexpr uint8_t kVdexVersion[] = { '0', '0', '5', '\0' };  // access flags
+    static constexpr uint8_t kVdexVersion[] = { '0', '0', '6', '\0' };  // superinstructions
 
     uint8_t magic_[4];
     uint8_t version_[4];
@@ -3398,7 +3398,11 @@ bool MethodVerifier::CodeFlowVerifyInstruction(uint32_t* start_guess) {
     // Note: the following instructions encode offsets derived from class linking.
     // As such they use Class*/Field*/Executable* as these offsets only have
     // meaning if the class linking and resolution were successful.
+    // Fused superinstructions verify as their first instruction. The instruction they are fused
+    // with is left in place and verified on its own.
     case Instruction::IGET_QUICK:
+    case Instruction::IGET_QUICK_IF_EQZ:
+    case Instruction::IGET_QUICK_IF_NEZ:
       VerifyQuickFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Integer(), true);
       break;
     case Instruction::IGET_WIDE_QUICK:
@@ -3408,6 +3412,8 @@ bool MethodVerifier::CodeFlowVerifyInstruction(uint32_t* start_guess) {
       VerifyQuickFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.JavaLangObject(false), false);
       break;
     case Instruction::IGET_BOOLEAN_QUICK:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_EQZ:
+    case Instruction::IGET_BOOLEAN_QUICK_IF_NEZ:
       VerifyQuickFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Boolean(), true);
       break;
     case Instruction::IGET_BYTE_QUICK:
@@ -3441,6 +3447,8 @@ bool MethodVerifier::CodeFlowVerifyInstruction(uint32_t* start_guess) {
       VerifyQuickFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.JavaLangObject(false), false);
       break;
     case Instruction::INVOKE_VIRTUAL_QUICK:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT:
+    case Instruction::INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT:
     case Instruction::INVOKE_VIRTUAL_RANGE_QUICK: {
       bool is_range = (inst->Opcode() == Instruction::INVOKE_VIRTUAL_RANGE_QUICK);
       ArtMethod* called_method = VerifyInvokeVirtualQuickArgs(inst, is_range);
@@ -3459,7 +3467,7 @@ bool MethodVerifier::CodeFlowVerifyInstruction(uint32_t* start_guess) {
 
     /* These should never appear during verification. */
     case Instruction::UNUSED_3E ... Instruction::UNUSED_43:
-    case Instruction::UNUSED_F3 ... Instruction::UNUSED_F9:
+    case Instruction::UNUSED_F9:
     case Instruction::UNUSED_FE ... Instruction::UNUSED_FF:
     case Instruction::UNUSED_79:
     case Instruction::UNUSED_7A:
@@ -4430,7 +4438,7 @@ ArtMethod* MethodVerifier::GetQuickInvokedMethod(const Instruction* inst, Regist
   if (is_range) {
     DCHECK_EQ(inst->Opcode(), Instruction::INVOKE_VIRTUAL_RANGE_QUICK);
   } else {
-    DCHECK_EQ(inst->Opcode(), Instruction::INVOKE_VIRTUAL_QUICK);
+    DCHECK(IsInstructionQuickInvoke(inst->Opcode())) << inst->Opcode();
   }
   const RegType& actual_arg_type = reg_line->GetInvocationThis(this, inst, allow_failure);
   if (!actual_arg_type.HasClass()) {
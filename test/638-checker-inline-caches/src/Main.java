@@ -30,6 +30,18 @@ class SubE extends Super {
   int getValue() { return -4; }
 }
 
+class SubF extends Super {
+  int getValue() { return 7; }
+}
+
+class SubG extends Super {
+  int getValue() { return 3; }
+}
+
+class SubH extends Super {
+  int getValue() { return 1; }
+}
+
 public class Main {
 
   /// CHECK-START: int Main.inlineMonomorphicSubA(Super) inliner (before)
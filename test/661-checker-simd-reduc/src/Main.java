@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for simple reductions that get vectorized.
+ */
+public class Main {
+
+  static final int N = 1000;  // not a multiple of any vector length
+
+  //
+  // Sum reductions.
+  //
+
+  /// CHECK-START: int Main.reductionInt(int[]) loop_optimization (before)
+  /// CHECK-DAG: <<Cons0:i\d+>> IntConstant 0                 loop:none
+  /// CHECK-DAG: <<Cons1:i\d+>> IntConstant 1                 loop:none
+  /// CHECK-DAG: <<Phi1:i\d+>>  Phi [<<Cons0>>,{{i\d+}}]      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Phi2:i\d+>>  Phi [<<Cons0>>,{{i\d+}}]      loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Get:i\d+>>   ArrayGet [{{l\d+}},<<Phi1>>]  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                Add [<<Phi2>>,<<Get>>]        loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                Add [<<Phi1>>,<<Cons1>>]      loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                Return [<<Phi2>>]             loop:none
+  //
+  /// CHECK-START-ARM64: int Main.reductionInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Cons0:i\d+>> IntConstant 0                 loop:none
+  /// CHECK-DAG: <<Cons4:i\d+>> IntConstant 4                 loop:none
+  /// CHECK-DAG: <<Set:d\d+>>   VecSetScalars [<<Cons0>>]     loop:none
+  /// CHECK-DAG: <<Phi1:i\d+>>  Phi [<<Cons0>>,{{i\d+}}]      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi [<<Set>>,{{d\d+}}]        loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>  VecLoad [{{l\d+}},<<Phi1>>]   loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecAdd [<<Phi2>>,<<Load>>]    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                Add [<<Phi1>>,<<Cons4>>]      loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:sum loop:none
+  /// CHECK-DAG: <<Extr:i\d+>>  VecExtractScalar [<<Red>>]    loop:none
+  private static int reductionInt(int[] x) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i];
+    }
+    return sum;
+  }
+
+  /// CHECK-START-ARM64: long Main.reductionLong(long[]) loop_optimization (after)
+  /// CHECK-DAG: <<Cons2:i\d+>> IntConstant 2                 loop:none
+  /// CHECK-DAG: <<Set:d\d+>>   VecSetScalars [{{j\d+}}]      loop:none
+  /// CHECK-DAG: <<Phi1:i\d+>>  Phi                           loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi [<<Set>>,{{d\d+}}]        loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>  VecLoad [{{l\d+}},<<Phi1>>]   loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecAdd [<<Phi2>>,<<Load>>]    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                Add [<<Phi1>>,<<Cons2>>]      loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:sum loop:none
+  /// CHECK-DAG: <<Extr:j\d+>>  VecExtractScalar [<<Red>>]    loop:none
+  private static long reductionLong(long[] x) {
+    long sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i];
+    }
+    return sum;
+  }
+
+  /// CHECK-START-ARM64: int Main.reductionMinusInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi                           loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>  VecLoad                       loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecSub [<<Phi2>>,<<Load>>]    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:sum loop:none
+  /// CHECK-DAG:                VecExtractScalar [<<Red>>]    loop:none
+  private static int reductionMinusInt(int[] x) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum -= x[i];
+    }
+    return sum;
+  }
+
+  //
+  // Min/max reductions.
+  //
+
+  /// CHECK-START-ARM64: int Main.reductionMinInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Rep:d\d+>>   VecReplicateScalar            loop:none
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi [<<Rep>>,{{d\d+}}]        loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>  VecLoad                       loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecMin [<<Phi2>>,<<Load>>]    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:min loop:none
+  /// CHECK-DAG:                VecExtractScalar [<<Red>>]    loop:none
+  private static int reductionMinInt(int[] x) {
+    int min = Integer.MAX_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      min = Math.min(min, x[i]);
+    }
+    return min;
+  }
+
+  /// CHECK-START-ARM64: int Main.reductionMaxInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Rep:d\d+>>   VecReplicateScalar            loop:none
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi [<<Rep>>,{{d\d+}}]        loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Load:d\d+>>  VecLoad                       loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecMax [<<Phi2>>,<<Load>>]    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:max loop:none
+  /// CHECK-DAG:                VecExtractScalar [<<Red>>]    loop:none
+  private static int reductionMaxInt(int[] x) {
+    int max = Integer.MIN_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      max = Math.max(max, x[i]);
+    }
+    return max;
+  }
+
+  //
+  // Dot products.
+  //
+
+  /// CHECK-START-ARM64: int Main.dotProductByte(byte[], byte[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi                                      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Ld1:d\d+>>   VecLoad                                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Ld2:d\d+>>   VecLoad                                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecMultiplyAccumulate [<<Phi2>>,<<Ld1>>,<<Ld2>>] kind:Add widening:PrimByte loop:<<Loop>> outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:sum            loop:none
+  /// CHECK-DAG:                VecExtractScalar [<<Red>>]               loop:none
+  //
+  /// CHECK-START-X86_64: int Main.dotProductByte(byte[], byte[]) loop_optimization (after)
+  /// CHECK-NOT: VecMultiplyAccumulate
+  private static int dotProductByte(byte[] x, byte[] y) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i] * y[i];
+    }
+    return sum;
+  }
+
+  /// CHECK-START-ARM64: int Main.dotProductShort(short[], short[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi                                      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Ld1:d\d+>>   VecLoad                                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Ld2:d\d+>>   VecLoad                                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecMultiplyAccumulate [<<Phi2>>,<<Ld1>>,<<Ld2>>] kind:Add widening:PrimShort loop:<<Loop>> outer_loop:none
+  /// CHECK-DAG: <<Red:d\d+>>   VecReduce [<<Phi2>>] kind:sum            loop:none
+  /// CHECK-DAG:                VecExtractScalar [<<Red>>]               loop:none
+  //
+  /// CHECK-START-X86_64: int Main.dotProductShort(short[], short[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi2:d\d+>>  Phi                                      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Ld1:d\d+>>   VecLoad                                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Ld2:d\d+>>   VecLoad                                  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                VecMultiplyAccumulate [<<Phi2>>,<<Ld1>>,<<Ld2>>] kind:Add widening:PrimShort loop:<<Loop>> outer_loop:none
+  private static int dotProductShort(short[] x, short[] y) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i] * y[i];
+    }
+    return sum;
+  }
+
+  //
+  // Not vectorized: floating-point reductions depend on the order of operations.
+  //
+
+  /// CHECK-START: float Main.reductionFloat(float[]) loop_optimization (after)
+  /// CHECK-NOT: VecReduce
+  private static float reductionFloat(float[] x) {
+    float sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i];
+    }
+    return sum;
+  }
+
+  //
+  // Test driver.
+  //
+
+  public static void main(String[] args) {
+    byte[] xb = new byte[N];
+    byte[] yb = new byte[N];
+    short[] xs = new short[N];
+    short[] ys = new short[N];
+    int[] xi = new int[N];
+    long[] xl = new long[N];
+    float[] xf = new float[N];
+    int expectedSum = 0;
+    long expectedSumL = 0;
+    int expectedMin = Integer.MAX_VALUE;
+    int expectedMax = Integer.MIN_VALUE;
+    int expectedDotB = 0;
+    int expectedDotS = 0;
+    for (int i = 0; i < N; i++) {
+      xb[i] = (byte) (i * 7);
+      yb[i] = (byte) -(i * 3);
+      xs[i] = (short) (i * 1117);
+      ys[i] = (short) -(i * 713);
+      xi[i] = (i % 2 == 0) ? i * 12345 : -i * 54321;
+      xl[i] = (long) i * 0x100000001L;
+      xf[i] = i;
+      expectedSum += xi[i];
+      expectedSumL += xl[i];
+      expectedMin = Math.min(expectedMin, xi[i]);
+      expectedMax = Math.max(expectedMax, xi[i]);
+      expectedDotB += xb[i] * yb[i];
+      expectedDotS += xs[i] * ys[i];
+    }
+
+    // Test various reductions in loops.
+    expectEquals(expectedSum, reductionInt(xi));
+    expectEquals(expectedSumL, reductionLong(xl));
+    expectEquals(-expectedSum, reductionMinusInt(xi));
+    expectEquals(expectedMin, reductionMinInt(xi));
+    expectEquals(expectedMax, reductionMaxInt(xi));
+    expectEquals(expectedDotB, dotProductByte(xb, yb));
+    expectEquals(expectedDotS, dotProductShort(xs, ys));
+    expectEquals(499500.0f, reductionFloat(xf));
+
+    // Test empty and short loops with the cleanup code only.
+    expectEquals(0, reductionInt(new int[0]));
+    expectEquals(3, reductionInt(new int[] { 1, 2 }));
+    expectEquals(Integer.MAX_VALUE, reductionMinInt(new int[0]));
+    expectEquals(-1, reductionMinInt(new int[] { 5, -1, 3 }));
+    expectEquals(Integer.MIN_VALUE, reductionMaxInt(new int[0]));
+    expectEquals(5, reductionMaxInt(new int[] { 5, -1, 3 }));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(float expected, float result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for vectorized loops that are versioned with runtime tests.
+ */
+public class Main {
+
+  static final int N = 1000;  // not a multiple of any vector length
+
+  /// CHECK-START: void Main.shift(int[], int[], int) loop_optimization (before)
+  /// CHECK-DAG: ArrayGet loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: ArraySet loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-ARM64: void Main.shift(int[], int[], int) loop_optimization (after)
+  /// CHECK-DAG: NotEqual                    loop:none
+  /// CHECK-DAG: VecLoad  loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecStore loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet loop:<<Clean:B\d+>> outer_loop:none
+  /// CHECK-DAG: ArraySet loop:<<Clean>>      outer_loop:none
+  private static void shift(int[] a, int[] b, int n) {
+    for (int i = 0; i < n; i++) {
+      a[i + 1] = b[i];
+    }
+  }
+
+  // Four runtime disambiguation tests are needed.
+  //
+  /// CHECK-START-ARM64: void Main.shiftTwo(int[], int[], int[], int[]) loop_optimization (after)
+  /// CHECK-DAG: VecLoad  loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: VecLoad  loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: VecStore loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: VecStore loop:<<Loop>>      outer_loop:none
+  private static void shiftTwo(int[] a, int[] b, int[] c, int[] d) {
+    for (int i = 0; i < N; i++) {
+      a[i + 1] = b[i];
+      c[i + 1] = d[i];
+    }
+  }
+
+  // The bounds checks cannot be eliminated statically, so the vector loop
+  // without bounds checks is guarded by a runtime range test on each array
+  // length, and the cleanup loop retains the bounds checks.
+  //
+  /// CHECK-START: void Main.copy(int[], int[], int) loop_optimization (before)
+  /// CHECK-DAG: BoundsCheck loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: BoundsCheck loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet    loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArraySet    loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-ARM64: void Main.copy(int[], int[], int) loop_optimization (after)
+  /// CHECK-DAG: <<Zero:i\d+>>  IntConstant 0                          loop:none
+  /// CHECK-DAG: <<Len1:i\d+>>  ArrayLength                            loop:none
+  /// CHECK-DAG: <<Len2:i\d+>>  ArrayLength                            loop:none
+  /// CHECK-DAG: <<Test1:z\d+>> LessThanOrEqual [{{i\d+}},<<Len1>>]    loop:none
+  /// CHECK-DAG: <<Test2:z\d+>> LessThanOrEqual [{{i\d+}},<<Len2>>]    loop:none
+  /// CHECK-DAG:                Select [<<Zero>>,{{i\d+}},<<Test1>>]   loop:none
+  /// CHECK-DAG:                Select [<<Zero>>,{{i\d+}},<<Test2>>]   loop:none
+  /// CHECK-DAG:                VecLoad                                loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:                VecStore                               loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:                BoundsCheck                            loop:<<Clean:B\d+>> outer_loop:none
+  /// CHECK-DAG:                BoundsCheck                            loop:<<Clean>>     outer_loop:none
+  /// CHECK-DAG:                ArrayGet                               loop:<<Clean>>     outer_loop:none
+  /// CHECK-DAG:                ArraySet                               loop:<<Clean>>     outer_loop:none
+  private static void copy(int[] a, int[] b, int n) {
+    for (int i = 0; i < n; i++) {
+      a[i] = b[i] + 1;
+    }
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[N + 1];
+    int[] b = new int[N + 1];
+    int[] c = new int[N + 1];
+    int[] d = new int[N + 1];
+
+    // Distinct arrays run the vector loop.
+    for (int i = 0; i <= N; i++) {
+      b[i] = i;
+    }
+    shift(a, b, N);
+    expectEquals(0, a[0]);
+    for (int i = 1; i <= N; i++) {
+      expectEquals(i - 1, a[i]);
+    }
+
+    // Aliased arrays run the original loop.
+    shift(b, b, N);
+    for (int i = 0; i <= N; i++) {
+      expectEquals(0, b[i]);
+    }
+    for (int i = 0; i <= N; i++) {
+      b[i] = i;
+      d[i] = -i;
+    }
+    shiftTwo(a, b, c, d);
+    for (int i = 1; i <= N; i++) {
+      expectEquals(i - 1, a[i]);
+      expectEquals(1 - i, c[i]);
+    }
+    shiftTwo(a, a, c, d);
+    for (int i = 1; i <= N; i++) {
+      expectEquals(0, a[i]);
+    }
+    shiftTwo(a, b, d, d);
+    for (int i = 1; i <= N; i++) {
+      expectEquals(i - 1, a[i]);
+      expectEquals(0, d[i]);
+    }
+
+    // In-bounds accesses run the vector loop.
+    for (int i = 0; i <= N; i++) {
+      b[i] = i;
+    }
+    copy(a, b, N);
+    for (int i = 0; i < N; i++) {
+      expectEquals(i + 1, a[i]);
+    }
+
+    // Out-of-bounds accesses throw at the proper iteration.
+    int[] e = new int[N / 2];
+    for (int i = 0; i <= N; i++) {
+      b[i] = i;
+    }
+    try {
+      copy(e, b, N);
+      throw new Error("Expected exception");
+    } catch (ArrayIndexOutOfBoundsException expected) {
+    }
+    for (int i = 0; i < N / 2; i++) {
+      expectEquals(i + 1, e[i]);
+    }
+    try {
+      shift(e, b, N / 2);
+      throw new Error("Expected exception");
+    } catch (ArrayIndexOutOfBoundsException expected) {
+    }
+    for (int i = 1; i < N / 2; i++) {
+      expectEquals(i - 1, e[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for scalar loop unrolling and peeling.
+ */
+public class Main {
+
+  static final int N = 100;
+
+  // Small loop is fully unrolled.
+  //
+  /// CHECK-START: int Main.fullXor(int[]) loop_unrolling (before)
+  /// CHECK-DAG: Phi      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: ArrayGet loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: int Main.fullXor(int[]) loop_unrolling (after)
+  /// CHECK-NOT: Phi
+  //
+  /// CHECK-START: int Main.fullXor(int[]) loop_unrolling (after)
+  /// CHECK-DAG: ArrayGet loop:none
+  /// CHECK-DAG: ArrayGet loop:none
+  /// CHECK-DAG: ArrayGet loop:none
+  /// CHECK-DAG: ArrayGet loop:none
+  private static int fullXor(int[] a) {
+    int x = 0;
+    for (int i = 0; i < 4; i++) {
+      x ^= a[i];
+    }
+    return x;
+  }
+
+  // First iteration is peeled, which makes k invariant.
+  //
+  /// CHECK-START: void Main.peel(int[]) loop_unrolling (before)
+  /// CHECK-DAG: Phi      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: Phi      loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArraySet loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: void Main.peel(int[]) loop_unrolling (after)
+  /// CHECK-DAG: ArraySet loop:none
+  /// CHECK-DAG: Phi      loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: ArraySet loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: void Main.peel(int[]) loop_unrolling (after)
+  /// CHECK:     Phi
+  /// CHECK-NOT: Phi
+  private static void peel(int[] a) {
+    int k = 0;
+    for (int i = 0; i < N - 1; i++) {
+      a[i] += k;
+      k = 1;
+    }
+  }
+
+  // Loop is partially unrolled by a factor that divides the trip count.
+  //
+  /// CHECK-START: int Main.partialHash(int[]) loop_unrolling (after)
+  /// CHECK-DAG: ArrayGet loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: ArrayGet loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: ArrayGet loop:<<Loop>>      outer_loop:none
+  private static int partialHash(int[] a) {
+    int h = 0;
+    for (int i = 0; i < N; i++) {
+      h = h * 31 + a[i];
+    }
+    return h;
+  }
+
+  // Loop is not unrolled, since the trip count is unknown.
+  //
+  /// CHECK-START: int Main.unknownHash(int[], int) loop_unrolling (after)
+  /// CHECK-DAG: ArrayGet loop:<<Loop:B\d+>> outer_loop:none
+  //
+  /// CHECK-START: int Main.unknownHash(int[], int) loop_unrolling (after)
+  /// CHECK:     ArrayGet
+  /// CHECK-NOT: ArrayGet
+  private static int unknownHash(int[] a, int n) {
+    int h = 0;
+    for (int i = 0; i < n; i++) {
+      h = h * 31 + a[i];
+    }
+    return h;
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[N];
+    for (int i = 0; i < N; i++) {
+      a[i] = i + 1;
+    }
+
+    expectEquals(1 ^ 2 ^ 3 ^ 4, fullXor(a));
+
+    int h = 0;
+    for (int i = 0; i < N; i++) {
+      h = h * 31 + a[i];
+    }
+    expectEquals(h, partialHash(a));
+    expectEquals(h, unknownHash(a, N));
+
+    peel(a);
+    expectEquals(1, a[0]);
+    for (int i = 1; i < N - 1; i++) {
+      expectEquals(i + 2, a[i]);
+    }
+    expectEquals(N, a[N - 1]);
+
+    // Out-of-bounds accesses still throw in unrolled code.
+    try {
+      fullXor(new int[3]);
+      throw new Error("Expected exception");
+    } catch (ArrayIndexOutOfBoundsException expected) {
+    }
+    try {
+      partialHash(new int[N - 1]);
+      throw new Error("Expected exception");
+    } catch (ArrayIndexOutOfBoundsException expected) {
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
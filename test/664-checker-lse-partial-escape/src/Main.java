@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+class Point {
+  int x;
+  int y;
+}
+
+/**
+ * Tests for load/store elimination of allocations that only escape on some paths.
+ */
+public class Main {
+
+  /// CHECK-START: int Main.escapeOnThrow(int, int, boolean) load_store_elimination (before)
+  /// CHECK-DAG: <<Obj:l\d+>> NewInstance
+  /// CHECK-DAG:              InstanceFieldSet [<<Obj>>,{{i\d+}}]
+  /// CHECK-DAG:              InstanceFieldSet [<<Obj>>,{{i\d+}}]
+  /// CHECK-DAG:              InstanceFieldGet [<<Obj>>]
+  /// CHECK-DAG:              InstanceFieldGet [<<Obj>>]
+  /// CHECK-DAG:              InvokeStaticOrDirect [<<Obj>>{{(,[ij]\d+)?}}] method_name:Main.$noinline$describe
+  //
+  /// CHECK-START: int Main.escapeOnThrow(int, int, boolean) load_store_elimination (after)
+  /// CHECK-DAG: <<Obj:l\d+>> NewInstance
+  /// CHECK-DAG:              InstanceFieldSet [<<Obj>>,{{i\d+}}]
+  /// CHECK-DAG:              InstanceFieldSet [<<Obj>>,{{i\d+}}]
+  /// CHECK-DAG:              MemoryBarrier
+  /// CHECK-DAG:              InvokeStaticOrDirect [<<Obj>>{{(,[ij]\d+)?}}] method_name:Main.$noinline$describe
+  //
+  /// CHECK-START: int Main.escapeOnThrow(int, int, boolean) load_store_elimination (after)
+  /// CHECK-NOT: InstanceFieldGet
+  private static int escapeOnThrow(int x, int y, boolean fail) {
+    Point p = new Point();
+    p.x = x;
+    p.y = y;
+    if (fail) {
+      throw new IllegalArgumentException($noinline$describe(p));
+    }
+    return p.x + p.y;
+  }
+
+  // Not materialized, since the allocation is used after the paths merge again.
+  //
+  /// CHECK-START: int Main.escapeBeforeMerge(int, boolean) load_store_elimination (after)
+  /// CHECK:     NewInstance
+  /// CHECK-NOT: NewInstance
+  //
+  /// CHECK-START: int Main.escapeBeforeMerge(int, boolean) load_store_elimination (after)
+  /// CHECK-DAG: InstanceFieldGet
+  private static int escapeBeforeMerge(int x, boolean log) {
+    Point p = new Point();
+    p.x = x;
+    if (log) {
+      sink = $noinline$describe(p);
+    }
+    return p.x;
+  }
+
+  private static String $noinline$describe(Point p) {
+    return "(" + p.x + ", " + p.y + ")";
+  }
+
+  static String sink;
+
+  public static void main(String[] args) {
+    expectEquals(3, escapeOnThrow(1, 2, false));
+    try {
+      escapeOnThrow(1, 2, true);
+      throw new Error("Expected exception");
+    } catch (IllegalArgumentException expected) {
+      expectEquals("(1, 2)", expected.getMessage());
+    }
+    expectEquals(4, escapeBeforeMerge(4, false));
+    expectEquals(5, escapeBeforeMerge(5, true));
+    expectEquals("(5, 0)", sink);
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(String expected, String result) {
+    if (!expected.equals(result)) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for partial redundancy elimination.
+ */
+public class Main {
+
+  static class Holder {
+    int value;
+    int[] array;
+  }
+
+  static long sCount;
+
+  int field;
+
+  // The load and multiplication after the merge are available on one path only,
+  // so they are computed on the other path and merged with phis.
+  //
+  /// CHECK-START: int Main.merge(boolean) pre (before)
+  /// CHECK:     InstanceFieldGet
+  /// CHECK:     InstanceFieldGet
+  /// CHECK-NOT: InstanceFieldGet
+  //
+  /// CHECK-START: int Main.merge(boolean) pre (after)
+  /// CHECK-DAG: <<Add:i\d+>> Add [<<Phi1:i\d+>>,<<Phi2:i\d+>>]
+  /// CHECK-DAG: <<Phi1>>     Phi
+  /// CHECK-DAG: <<Phi2>>     Phi
+  //
+  /// CHECK-START: int Main.merge(boolean) pre (after)
+  /// CHECK:     InstanceFieldGet
+  /// CHECK:     InstanceFieldGet
+  /// CHECK-NOT: InstanceFieldGet
+  int merge(boolean b) {
+    int r = 0;
+    if (b) {
+      r = field * 3;
+      sCount++;  // Prevents select generation, without killing the int field.
+    }
+    return r + field * 3;
+  }
+
+  // A store to the field on the other path kills the available load.
+  //
+  /// CHECK-START: int Main.mergeKilled(boolean) pre (after)
+  /// CHECK:     Phi
+  /// CHECK-NOT: Phi
+  int mergeKilled(boolean b) {
+    int r = 0;
+    if (b) {
+      r = field * 3;
+      field = 2;
+    }
+    return r + field * 3;
+  }
+
+  // The null check in the loop-body is replaced by a deoptimization test under
+  // a loop-entry guard, where the invariant load is hoisted to.
+  //
+  /// CHECK-START: int Main.guarded(Main$Holder, int) pre (before)
+  /// CHECK-DAG: NullCheck        loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: InstanceFieldGet loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START: int Main.guarded(Main$Holder, int) pre (after)
+  /// CHECK-DAG: Deoptimize       loop:none
+  /// CHECK-DAG: InstanceFieldGet loop:none
+  //
+  /// CHECK-START: int Main.guarded(Main$Holder, int) pre (after)
+  /// CHECK-NOT: NullCheck
+  static int guarded(Holder h, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += h.value;
+    }
+    return sum;
+  }
+
+  // Hoisting the first load makes the second null check invariant as well.
+  //
+  /// CHECK-START: int Main.guardedChain(Main$Holder, int) pre (after)
+  /// CHECK-DAG: Deoptimize       loop:none
+  /// CHECK-DAG: Deoptimize       loop:none
+  /// CHECK-DAG: InstanceFieldGet loop:none
+  /// CHECK-DAG: ArrayLength      loop:none
+  //
+  /// CHECK-START: int Main.guardedChain(Main$Holder, int) pre (after)
+  /// CHECK-NOT: NullCheck
+  static int guardedChain(Holder h, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += h.array.length;
+    }
+    return sum;
+  }
+
+  // A store in the loop prevents hoisting the load.
+  //
+  /// CHECK-START: int Main.notGuarded(Main$Holder, int) pre (after)
+  /// CHECK-NOT: Deoptimize
+  static int notGuarded(Holder h, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += h.value;
+      h.value = i;
+    }
+    return sum;
+  }
+
+  public static void main(String[] args) {
+    Main m = new Main();
+    m.field = 5;
+    expectEquals(30, m.merge(true));
+    expectEquals(15, m.merge(false));
+    expectEquals(21, m.mergeKilled(true));
+    m.field = 5;
+    expectEquals(15, m.mergeKilled(false));
+
+    Holder h = new Holder();
+    h.value = 3;
+    h.array = new int[7];
+    expectEquals(30, guarded(h, 10));
+    expectEquals(0, guarded(h, 0));
+    expectEquals(0, guarded(null, 0));
+    try {
+      guarded(null, 1);
+      throw new Error("Expected exception");
+    } catch (NullPointerException expected) {
+    }
+    expectEquals(70, guardedChain(h, 10));
+    expectEquals(0, guardedChain(null, -1));
+    h.array = null;
+    expectEquals(0, guardedChain(h, 0));
+    try {
+      guardedChain(h, 1);
+      throw new Error("Expected exception");
+    } catch (NullPointerException expected) {
+    }
+    h.value = 3;
+    expectEquals(3 + 0 + 1, notGuarded(h, 3));
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
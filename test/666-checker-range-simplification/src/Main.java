@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for range based arithmetic simplifications.
+ */
+public class Main {
+
+  // 0 <= i < n in the loop-body, so i % n is i and cannot throw.
+  //
+  /// CHECK-START: int Main.remByBound(int) range_simplification (before)
+  /// CHECK-DAG: DivZeroCheck loop:<<Loop:B\d+>>
+  /// CHECK-DAG: Rem          loop:<<Loop>>
+  //
+  /// CHECK-START: int Main.remByBound(int) range_simplification (after)
+  /// CHECK-NOT: DivZeroCheck
+  /// CHECK-NOT: Rem
+  static int remByBound(int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += i % n;
+    }
+    return sum;
+  }
+
+  // 0 <= i < n in the loop-body, so i / n is zero.
+  //
+  /// CHECK-START: int Main.divByBound(int) range_simplification (before)
+  /// CHECK-DAG: Div loop:<<Loop:B\d+>>
+  //
+  /// CHECK-START: int Main.divByBound(int) range_simplification (after)
+  /// CHECK-NOT: DivZeroCheck
+  /// CHECK-NOT: Div
+  static int divByBound(int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += 1 + i / n;
+    }
+    return sum;
+  }
+
+  // The induction is non-negative, so division and remainder by powers
+  // of two are a shift and a mask.
+  //
+  /// CHECK-START: int Main.divRemPowerOfTwo(int[]) range_simplification (before)
+  /// CHECK-DAG: Div loop:<<Loop:B\d+>>
+  /// CHECK-DAG: Rem loop:<<Loop>>
+  //
+  /// CHECK-START: int Main.divRemPowerOfTwo(int[]) range_simplification (after)
+  /// CHECK-DAG: <<Phi:i\d+>> Phi                         loop:<<Loop:B\d+>>
+  /// CHECK-DAG: <<C2:i\d+>>  IntConstant 2               loop:none
+  /// CHECK-DAG: <<C7:i\d+>>  IntConstant 7               loop:none
+  /// CHECK-DAG:              Shr [<<Phi>>,<<C2>>]        loop:<<Loop>>
+  /// CHECK-DAG:              And [<<Phi>>,<<C7>>]        loop:<<Loop>>
+  //
+  /// CHECK-START: int Main.divRemPowerOfTwo(int[]) range_simplification (after)
+  /// CHECK-NOT: Div
+  /// CHECK-NOT: Rem
+  static int divRemPowerOfTwo(int[] a) {
+    int sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      sum += a[i] + i / 4 + i % 8;
+    }
+    return sum;
+  }
+
+  // The dividend may be negative, which requires rounding towards zero.
+  //
+  /// CHECK-START: int Main.divNegative(int) range_simplification (after)
+  /// CHECK-DAG: Div
+  static int divNegative(int x) {
+    return x / 4;
+  }
+
+  // The divisor is in [1, 8], so the division cannot throw.
+  //
+  /// CHECK-START: int Main.divByNonZero(int, int) range_simplification (before)
+  /// CHECK-DAG: DivZeroCheck
+  //
+  /// CHECK-START: int Main.divByNonZero(int, int) range_simplification (after)
+  /// CHECK-DAG: Div
+  /// CHECK-NOT: DivZeroCheck
+  static int divByNonZero(int x, int y) {
+    return x / ((y & 7) + 1);
+  }
+
+  // The induction is in [0, 99], so narrowing to byte and masking with 127
+  // do not change its value.
+  //
+  /// CHECK-START: int Main.narrowInduction() range_simplification (before)
+  /// CHECK-DAG: TypeConversion loop:<<Loop:B\d+>>
+  /// CHECK-DAG: And            loop:<<Loop>>
+  //
+  /// CHECK-START: int Main.narrowInduction() range_simplification (after)
+  /// CHECK-NOT: TypeConversion
+  /// CHECK-NOT: And
+  static int narrowInduction() {
+    int sum = 0;
+    for (int i = 0; i < 100; i++) {
+      sum += (byte) i + (i & 127);
+    }
+    return sum;
+  }
+
+  // The product of a 16-bit value and 1000 fits an int, so the
+  // multiplication is done in int and widened once.
+  //
+  /// CHECK-START: long Main.narrowLong(int[]) range_simplification (before)
+  /// CHECK-DAG: Mul [<<Conv:j\d+>>,<<C:j\d+>>] loop:<<Loop:B\d+>>
+  /// CHECK-DAG: <<C>>  LongConstant 1000         loop:none
+  //
+  /// CHECK-START: long Main.narrowLong(int[]) range_simplification (after)
+  /// CHECK-DAG: <<And:i\d+>> And                          loop:<<Loop:B\d+>>
+  /// CHECK-DAG: <<C:i\d+>>   IntConstant 1000             loop:none
+  /// CHECK-DAG: <<Mul:i\d+>> Mul [<<And>>,<<C>>]          loop:<<Loop>>
+  /// CHECK-DAG: <<Conv:j\d+>> TypeConversion [<<Mul>>]    loop:<<Loop>>
+  /// CHECK-DAG:              Add [{{j\d+}},<<Conv>>]      loop:<<Loop>>
+  static long narrowLong(int[] a) {
+    long sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      sum += (long) (a[i] & 0xffff) * 1000;
+    }
+    return sum;
+  }
+
+  // The product of arbitrary ints does not fit an int.
+  //
+  /// CHECK-START: long Main.notNarrowLong(int, int) range_simplification (after)
+  /// CHECK-DAG: Mul [{{j\d+}},{{j\d+}}]
+  static long notNarrowLong(int x, int y) {
+    return (long) x * y;
+  }
+
+  // The loop bound is simplified into a shift before the loop, so the trip-count
+  // of the vector loop must use the shift instead of the removed division.
+  //
+  /// CHECK-START: void Main.halfLoop(int[]) range_simplification (before)
+  /// CHECK-DAG: Div loop:none
+  //
+  /// CHECK-START: void Main.halfLoop(int[]) range_simplification (after)
+  /// CHECK-DAG: <<Len:i\d+>> ArrayLength               loop:none
+  /// CHECK-DAG: <<C1:i\d+>>  IntConstant 1             loop:none
+  /// CHECK-DAG:              Shr [<<Len>>,<<C1>>]      loop:none
+  //
+  /// CHECK-START: void Main.halfLoop(int[]) range_simplification (after)
+  /// CHECK-NOT: Div
+  //
+  /// CHECK-START-ARM64: void Main.halfLoop(int[]) loop_optimization (after)
+  /// CHECK-DAG:              Shr                       loop:none
+  /// CHECK-DAG: <<Phi:i\d+>> Phi                       loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:              VecLoad [{{l\d+}},<<Phi>>] loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:              VecStore                  loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-START-ARM64: void Main.halfLoop(int[]) loop_optimization (after)
+  /// CHECK-NOT: Div
+  static void halfLoop(int[] a) {
+    int m = a.length / 2;
+    for (int i = 0; i < m; i++) {
+      a[i] += 1;
+    }
+  }
+
+  public static void main(String[] args) {
+    expectEquals(45, remByBound(10));
+    expectEquals(0, remByBound(0));
+    expectEquals(0, remByBound(-5));
+    expectEquals(10, divByBound(10));
+    expectEquals(0, divByBound(-1));
+    int[] a = new int[20];
+    for (int i = 0; i < a.length; i++) {
+      a[i] = i - 10;
+    }
+    int expected = 0;
+    for (int i = 0; i < a.length; i++) {
+      expected += a[i] + i / 4 + i % 8;
+    }
+    expectEquals(expected, divRemPowerOfTwo(a));
+    expectEquals(-1, divNegative(-7));
+    expectEquals(-3, divNegative(-15));
+    expectEquals(12, divByNonZero(100, 7));
+    expectEquals(100, divByNonZero(100, 8));
+    expectEquals(-100, divByNonZero(-100, -8));
+    expectEquals(9900, narrowInduction());
+    long expectedLong = 0;
+    for (int i = 0; i < a.length; i++) {
+      expectedLong += (long) (a[i] & 0xffff) * 1000;
+    }
+    expectEquals(expectedLong, narrowLong(a));
+    expectEquals(4611686014132420609L, notNarrowLong(Integer.MAX_VALUE, Integer.MAX_VALUE));
+    int[] h = new int[21];
+    halfLoop(h);
+    for (int i = 0; i < h.length; i++) {
+      expectEquals(i < 10 ? 1 : 0, h[i]);
+    }
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
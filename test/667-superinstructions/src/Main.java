@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for fused quickened instruction pairs. Each method below contains a quickened
+ * instruction immediately followed by the instruction it is fused with.
+ */
+public class Main {
+
+  int i;
+  boolean z;
+
+  // IGET_QUICK_IF_NEZ.
+  static int igetIfEqualZero(Main m) {
+    if (m.i == 0) {
+      return 1;
+    }
+    return 2;
+  }
+
+  // IGET_QUICK_IF_EQZ.
+  static int igetIfNotEqualZero(Main m) {
+    if (m.i != 0) {
+      return 1;
+    }
+    return 2;
+  }
+
+  // IGET_BOOLEAN_QUICK_IF_EQZ.
+  static int igetBooleanIfTrue(Main m) {
+    if (m.z) {
+      return 1;
+    }
+    return 2;
+  }
+
+  // IGET_BOOLEAN_QUICK_IF_NEZ.
+  static int igetBooleanIfFalse(Main m) {
+    if (!m.z) {
+      return 1;
+    }
+    return 2;
+  }
+
+  int getInt() {
+    return i;
+  }
+
+  Object getObject() {
+    return z ? this : null;
+  }
+
+  // INVOKE_VIRTUAL_QUICK_MOVE_RESULT.
+  static int invokeMoveResult(Main m) {
+    int result = m.getInt();
+    return result + 1;
+  }
+
+  // INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT.
+  static Object invokeMoveResultObject(Main m) {
+    Object result = m.getObject();
+    return result;
+  }
+
+  // Loop whose back edge branches to the instruction following the fused one.
+  static int igetInLoop(Main m, int n) {
+    int count = 0;
+    for (int k = 0; k < n; k++) {
+      if (m.i == 0) {
+        count++;
+      }
+      m.i ^= 1;
+    }
+    return count;
+  }
+
+  public static void main(String[] args) {
+    Main m = new Main();
+
+    // Branches taken and not taken.
+    m.i = 0;
+    expectEquals(1, igetIfEqualZero(m));
+    expectEquals(2, igetIfNotEqualZero(m));
+    m.i = 42;
+    expectEquals(2, igetIfEqualZero(m));
+    expectEquals(1, igetIfNotEqualZero(m));
+    m.z = true;
+    expectEquals(1, igetBooleanIfTrue(m));
+    expectEquals(2, igetBooleanIfFalse(m));
+    m.z = false;
+    expectEquals(2, igetBooleanIfTrue(m));
+    expectEquals(1, igetBooleanIfFalse(m));
+
+    // Results of the fused calls.
+    m.i = 41;
+    expectEquals(42, invokeMoveResult(m));
+    m.z = true;
+    expectEquals(m, invokeMoveResultObject(m));
+    m.z = false;
+    expectEquals(null, invokeMoveResultObject(m));
+
+    m.i = 0;
+    expectEquals(5, igetInLoop(m, 10));
+
+    // Null receivers throw from the first half of the fused instruction.
+    for (int kind = 0; kind < 6; kind++) {
+      try {
+        callWithNull(kind);
+        throw new Error("Expected NullPointerException for kind " + kind);
+      } catch (NullPointerException e) {
+        // Expected.
+      }
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void callWithNull(int kind) {
+    switch (kind) {
+      case 0: igetIfEqualZero(null); break;
+      case 1: igetIfNotEqualZero(null); break;
+      case 2: igetBooleanIfTrue(null); break;
+      case 3: igetBooleanIfFalse(null); break;
+      case 4: invokeMoveResult(null); break;
+      case 5: invokeMoveResultObject(null); break;
+      default: throw new Error("Unexpected kind " + kind);
+    }
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(Object expected, Object result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -27,8 +27,38 @@ public class Main {
 
     // The checkcast will be quickened.
     m.foo(((Main)o).a);
+
+    // The field accesses and calls will be fused with the instruction following them.
+    m.fused();
+  }
+
+  int fused() {
+    int sum = 0;
+    // IGET_QUICK_IF_NEZ and IGET_QUICK_IF_EQZ.
+    if (a == 0) {
+      sum++;
+    }
+    if (a != 0) {
+      sum++;
+    }
+    // IGET_BOOLEAN_QUICK_IF_EQZ and IGET_BOOLEAN_QUICK_IF_NEZ.
+    if (b) {
+      sum++;
+    }
+    if (!b) {
+      sum++;
+    }
+    // INVOKE_VIRTUAL_QUICK_MOVE_RESULT and INVOKE_VIRTUAL_QUICK_MOVE_RESULT_OBJECT.
+    sum += bar();
+    if (baz() != null) {
+      sum++;
+    }
+    return sum;
   }
 
   int a;
+  boolean b;
   void foo(int a) {}
+  int bar() { return a; }
+  Object baz() { return this; }
 }
@@ -67,3 +67,15 @@ class SubD extends Super {
 class SubE extends Super {
   int getValue() { return 16; };
 }
+
+class SubF extends Super {
+  int getValue() { return 12; };
+}
+
+class SubG extends Super {
+  int getValue() { return 8; };
+}
+
+class SubH extends Super {
+  int getValue() { return 4; };
+}
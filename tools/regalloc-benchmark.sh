@@ -0,0 +1,93 @@
+#!/bin/bash
+#
+# Copyright (C) 2017 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Compares the register allocation strategies of the optimizing compiler on real
+# code: compiles the given jars with the host dex2oat once per strategy, and
+# reports the time spent in liveness analysis and register allocation, summed over
+# all methods, as well as the size of the generated code.
+#
+# Usage: regalloc-benchmark.sh [--isa=<isa>] <jar>...
+# Defaults to the framework jars of the current build.
+
+if [ -z "$ANDROID_BUILD_TOP" ] || [ -z "$ANDROID_HOST_OUT" ]; then
+  echo "Run lunch first."
+  exit 1
+fi
+
+ISA="x86_64"
+JARS=()
+for arg in "$@"; do
+  case "$arg" in
+    --isa=*) ISA="${arg#--isa=}" ;;
+    *) JARS+=("$arg") ;;
+  esac
+done
+
+if [ ${#JARS[@]} -eq 0 ]; then
+  for jar in core-oj core-libart framework services; do
+    JARS+=("$ANDROID_PRODUCT_OUT/system/framework/$jar.jar")
+  done
+fi
+
+# Use the release build: the debug build runs extra checks, such as the register
+# allocation validation, which would dominate the timings.
+DEX2OAT="$ANDROID_HOST_OUT/bin/dex2oat"
+BOOT_IMAGE="$ANDROID_HOST_OUT/framework/core.art"
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+# Sums the per method pass timings printed by --dump-passes, in milliseconds.
+function sum_pass() {
+  awk -v pass="$2" '
+    $NF == pass {
+      split($(NF - 1), times, "/");
+      value = times[1];
+      if (value ~ /ns$/) { factor = 1e-6; }
+      else if (value ~ /us$/) { factor = 1e-3; }
+      else if (value ~ /ms$/) { factor = 1; }
+      else { factor = 1e3; }
+      sub(/[a-z]+$/, "", value);
+      total += value * factor;
+    }
+    END { printf "%.1f", total; }' "$1"
+}
+
+printf "%-14s %-16s %12s %12s %12s\n" "strategy" "jar" "liveness(ms)" "regalloc(ms)" "oat(bytes)"
+for jar in "${JARS[@]}"; do
+  name=$(basename "$jar" .jar)
+  for strategy in linear-scan graph-color second-chance; do
+    log="$WORKDIR/$name-$strategy.log"
+    oat="$WORKDIR/$name-$strategy.oat"
+    "$DEX2OAT" --runtime-arg -Xnorelocate \
+               --boot-image="$BOOT_IMAGE" \
+               --dex-file="$jar" \
+               --oat-file="$oat" \
+               --instruction-set="$ISA" \
+               --register-allocation-strategy="$strategy" \
+               --dump-passes \
+               -j1 > "$log" 2>&1
+    if [ $? -ne 0 ]; then
+      echo "dex2oat failed for $name with $strategy, see $log"
+      trap - EXIT
+      exit 1
+    fi
+    printf "%-14s %-16s %12s %12s %12s\n" \
+           "$strategy" "$name" \
+           "$(sum_pass "$log" liveness)" \
+           "$(sum_pass "$log" register)" \
+           "$(stat -c %s "$oat")"
+  done
+done